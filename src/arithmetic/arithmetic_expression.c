@@ -448,6 +448,32 @@ static inline void _AR_EXP_FreeResultsArray(SIValue *results, int count) {
 	}
 }
 
+// build function's private data from its constant arguments
+// binding is attempted once, on the node's first evaluation
+// at which point parameters are known
+static void _AR_EXP_Bind
+(
+	AR_ExpNode *node,
+	SIValue *argv,
+	int argc
+) {
+	ASSERT(!node->op.bound);
+	ASSERT(node->op.private_data == NULL);
+
+	node->op.bound = true;
+	uint args = node->op.f->callbacks.bind_args;
+
+	// make sure every bound argument is constant
+	for(int i = 0; i < argc; i++) {
+		if(!(args & AR_FUNC_ARG(i))) continue;
+
+		AR_ExpNode *child = NODE_CHILD(node, i);
+		if(!AR_EXP_IsConstant(child) && !AR_EXP_IsParameter(child)) return;
+	}
+
+	node->op.private_data = node->op.f->callbacks.bind(argv, argc);
+}
+
 static AR_EXP_Result _AR_EXP_EvaluateFunctionCall
 (
 	AR_ExpNode *node,
@@ -495,6 +521,11 @@ static AR_EXP_Result _AR_EXP_EvaluateFunctionCall
 		goto cleanup;
 	}
 
+	// build private data from constant arguments
+	if(node->op.f->callbacks.bind != NULL && !node->op.bound) {
+		_AR_EXP_Bind(node, sub_trees, child_count);
+	}
+
 	// evaluate self
 	SIValue v = node->op.f->func(sub_trees, child_count, node->op.private_data);
 	ASSERT(node->op.f->aggregate || SI_TYPE(v) & AR_FuncDesc_RetType(node->op.f));
@@ -41,6 +41,7 @@ typedef enum {
 typedef struct {
 	AR_FuncDesc *f;                 // operation to perform on children
 	int child_count;                // number of children
+	bool bound;                     // bind attempted
 	void *private_data;             // additional data associated with function
 	struct AR_ExpNode **children;   // child nodes
 } AR_OpNode;
@@ -273,6 +273,16 @@ SIValue AR_PROPERTY(SIValue *argv, int argc, void *private_data) {
 			prop_idx = GraphContext_GetAttributeID(gc, prop_name);
 		}
 
+		// node attributes might be laid out in columns
+		if(SI_TYPE(obj) == T_NODE && prop_idx != ATTRIBUTE_ID_NONE) {
+			SIValue v;
+			Graph *g = QueryCtx_GetGraph();
+			if(Graph_GetNodeColumnarProperty(g, ENTITY_GET_ID(graph_entity),
+						prop_idx, &v)) {
+				return v;
+			}
+		}
+
 		// Retrieve the property.
 		SIValue *value = GraphEntity_GetProperty(graph_entity, prop_idx);
 		return SI_ConstValue(value);
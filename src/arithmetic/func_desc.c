@@ -64,6 +64,19 @@ inline void AR_SetPrivateDataRoutines
 	func_desc->callbacks.clone = clone;
 }
 
+inline void AR_SetBindRoutine
+(
+	AR_FuncDesc *func_desc,
+	AR_Func_Bind bind,
+	uint args
+) {
+	ASSERT(func_desc != NULL);
+	ASSERT(!func_desc->aggregate);
+
+	func_desc->callbacks.bind      = bind;
+	func_desc->callbacks.bind_args = args;
+}
+
 // get arithmetic function
 AR_FuncDesc *AR_GetFunc
 (
@@ -34,12 +34,22 @@ typedef void *(*AR_Func_Clone)(void *orig);
 // AR_Func_PrivateData - function pointer to a routine which produce function's private data
 typedef AggregateCtx *(*AR_Func_PrivateData)(void);
 
-// aggregation function callbacks
+// AR_Func_Bind - function pointer to a routine which builds a function's
+// private data from its constant arguments, e.g. a compiled regex
+// returns NULL if no private data was built
+typedef void *(*AR_Func_Bind)(SIValue *argv, int argc);
+
+// bind mask bit of the argument at position 'idx'
+#define AR_FUNC_ARG(idx) (1U << (idx))
+
+// function callbacks
 typedef struct {
 	AR_Func_Free free;                  // [optional] function pointer to cleanup routine
 	AR_Func_Clone clone;                // [optional] function pointer to clone routine
 	AR_Func_Finalize finalize;          // [optional] function pointer to finalizing aggregate value routine
 	AR_Func_PrivateData private_data;   // function pointer to private data generator
+	AR_Func_Bind bind;                  // [optional] function pointer to bind routine
+	uint bind_args;                     // arguments which must be constant to bind
 } AR_FuncCBs;
 
 typedef struct {
@@ -82,6 +92,17 @@ void AR_SetPrivateDataRoutines
 	AR_Func_Clone clone
 );
 
+// set the function pointer for building a function's private data
+// once per expression, when all arguments in 'args' are constants or parameters
+// the private data is released using the function's free routine
+// and is not cloned, each expression clone binds its own
+void AR_SetBindRoutine
+(
+	AR_FuncDesc *func_desc,
+	AR_Func_Bind bind,
+	uint args
+);
+
 // retrieves an arithmetic function by its name
 AR_FuncDesc *AR_GetFunc
 (
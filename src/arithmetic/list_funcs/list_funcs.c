@@ -18,6 +18,8 @@
 #include "../boolean_funcs/boolean_funcs.h"
 #include "../numeric_funcs/numeric_funcs.h"
 
+#include <math.h>
+
 //------------------------------------------------------------------------------
 // reduce context
 //------------------------------------------------------------------------------
@@ -353,6 +355,93 @@ SIValue AR_RANGE(SIValue *argv, int argc, void *private_data) {
 	return array;
 }
 
+//------------------------------------------------------------------------------
+// IN context
+//------------------------------------------------------------------------------
+
+// constant lists shorter than this are scanned rather than hashed
+#define IN_HASH_MIN_LEN 16
+
+// types a hashed IN list may hold, their hash agrees with value comparison
+#define IN_HASHABLE_TYPES (T_STRING | T_BOOL | SI_NUMERIC | T_NULL)
+
+// private data of the IN function when its list is constant
+typedef struct {
+	SIValue list;        // list's copy, owns the table's keys
+	dict *values;        // list's non-null elements
+	bool contains_null;  // list contains a null
+} InCtx;
+
+static uint64_t _InCtx_Hash
+(
+	const void *key
+) {
+	return SIValue_HashCode(*(SIValue *)key);
+}
+
+static int _InCtx_Compare
+(
+	dict *d,
+	const void *a,
+	const void *b
+) {
+	return SIValue_Compare(*(SIValue *)a, *(SIValue *)b, NULL) == 0;
+}
+
+static dictType _in_dt = {_InCtx_Hash, NULL, NULL, _InCtx_Compare, NULL, NULL,
+	NULL, NULL, NULL, NULL};
+
+// routine for freeing the IN function private data
+static void InCtx_Free
+(
+	void *ctx_ptr
+) {
+	InCtx *ctx = ctx_ptr;
+
+	HashTableRelease(ctx->values);
+	SIValue_Free(ctx->list);
+	rm_free(ctx);
+}
+
+// hash a constant lookup list, argv[1]
+static void *InCtx_Bind
+(
+	SIValue *argv,
+	int argc
+) {
+	SIValue list = argv[1];
+	if(SI_TYPE(list) != T_ARRAY) return NULL;
+
+	uint32_t len = SIArray_Length(list);
+	if(len < IN_HASH_MIN_LEN) return NULL;
+
+	// NaNs and nested values compare differently than they hash
+	for(uint32_t i = 0; i < len; i++) {
+		SIValue elem = SIArray_Get(list, i);
+		if(!(SI_TYPE(elem) & IN_HASHABLE_TYPES)) return NULL;
+		if(SI_TYPE(elem) == T_DOUBLE && isnan(elem.doubleval)) return NULL;
+	}
+
+	InCtx *ctx = rm_malloc(sizeof(InCtx));
+
+	ctx->list          = SI_CloneValue(list);
+	ctx->values        = HashTableCreate(&_in_dt);
+	ctx->contains_null = false;
+
+	HashTableExpand(ctx->values, len);
+	for(uint32_t i = 0; i < len; i++) {
+		SIValue *elem = ctx->list.array + i;
+		if(SIValue_IsNull(*elem)) {
+			ctx->contains_null = true;
+			continue;
+		}
+
+		HashTableAdd(ctx->values, elem, NULL);
+	}
+
+	return ctx;
+}
+
 /* Checks if a value is in a given list.
    "RETURN 3 IN [1, 2, 3]" will return true */
 SIValue AR_IN(SIValue *argv, int argc, void *private_data) {
@@ -361,6 +450,18 @@ SIValue AR_IN(SIValue *argv, int argc, void *private_data) {
 	ASSERT(SI_TYPE(argv[1]) == T_ARRAY);
 	SIValue lookupValue = argv[0];
 	SIValue lookupList = argv[1];
+
+	// constant list, probe its hash table
+	InCtx *ctx = private_data;
+	if(ctx != NULL &&
+	   !SIValue_IsNull(lookupValue) &&
+	   !(SI_TYPE(lookupValue) == T_DOUBLE && isnan(lookupValue.doubleval))) {
+		if(HashTableFind(ctx->values, &lookupValue) != NULL) {
+			return SI_BoolVal(true);
+		}
+		return ctx->contains_null ? SI_NullVal() : SI_BoolVal(false);
+	}
+
 	// indicate if there was a null comparison during the array scan
 	bool comparedNull = false;
 	if(SIArray_ContainsValue(lookupList, lookupValue, &comparedNull)) {
@@ -811,6 +912,8 @@ void Register_ListFuncs() {
 	array_append(types, T_ARRAY | T_NULL);
 	ret_type = T_NULL | T_BOOL;
 	func_desc = AR_FuncDescNew("in", AR_IN, 2, 2, types, ret_type, true, true);
+	AR_SetPrivateDataRoutines(func_desc, InCtx_Free, NULL);
+	AR_SetBindRoutine(func_desc, InCtx_Bind, AR_FUNC_ARG(1));
 	AR_RegFunc(func_desc);
 
 	types = array_new(SIType, 1);
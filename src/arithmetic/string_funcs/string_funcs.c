@@ -277,6 +277,57 @@ static int match_regex_scan_cb(int n, int pos, OnigRegion *region, void *arg) {
 	return 0;
 }
 
+// compile regular expression
+static inline int _NewRegex
+(
+	const char *pattern,   // regular expression
+	regex_t **regex,       // [output] compiled regex
+	OnigErrorInfo *einfo   // [output] compilation error
+) {
+	return onig_new(regex, (const UChar *)pattern,
+		(const UChar *)(pattern + strlen(pattern)), ONIG_OPTION_DEFAULT,
+		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, einfo);
+}
+
+// compile regular expression
+// returns false and sets the query-level error if `pattern` is invalid
+static bool _CompileRegex
+(
+	const char *pattern,  // regular expression
+	regex_t **regex       // [output] compiled regex
+) {
+	OnigErrorInfo einfo;
+	int rv = _NewRegex(pattern, regex, &einfo);
+	if(rv != ONIG_NORMAL) {
+		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
+		onig_error_code_to_str((UChar* )s, rv, &einfo);
+		ErrorCtx_SetError("Invalid regex, err=%s", s);
+		onig_free(*regex);
+		return false;
+	}
+
+	return true;
+}
+
+// precompile a constant regex pattern, argv[1]
+// an invalid pattern isn't compiled, its error is reported on evaluation
+static void *_BindRegex(SIValue *argv, int argc) {
+	if(SI_TYPE(argv[1]) != T_STRING) return NULL;
+
+	regex_t *regex;
+	OnigErrorInfo einfo;
+	if(_NewRegex(argv[1].stringval, &regex, &einfo) != ONIG_NORMAL) {
+		onig_free(regex);
+		return NULL;
+	}
+
+	return regex;
+}
+
+static void _FreeRegex(void *regex) {
+	onig_free((regex_t *)regex);
+}
+
 // given a string and a regular expression,
 // return an array of all matches and matching regions
 // string.matchRegEx(str, regex) -> array(array(string))
@@ -286,20 +337,13 @@ SIValue AR_MATCHREGEX(SIValue *argv, int argc, void *private_data) {
 		return list;
 	}
 
-	regex_t *regex;
-	OnigErrorInfo einfo;
+	// use precompiled regex if the pattern is constant
+	regex_t *regex        = private_data;
 	OnigRegion *region    = onig_region_new();
 	const char *str       = argv[0].stringval;
 	const char *regex_str = argv[1].stringval;
 
-	int rv = onig_new(&regex, (const UChar *)regex_str, 
-		(const UChar *)(regex_str + strlen(regex_str)), ONIG_OPTION_DEFAULT,
-		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, &einfo);
-	if(rv != ONIG_NORMAL) {
-		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
-		onig_error_code_to_str((UChar* )s, rv, &einfo);
-		ErrorCtx_SetError("Invalid regex, err=%s", s);
-		onig_free(regex);
+	if(regex == NULL && !_CompileRegex(regex_str, &regex)) {
 		onig_region_free(region, 1);
 		SIValue_Free(list);
 		return SI_NullVal();
@@ -310,20 +354,20 @@ SIValue AR_MATCHREGEX(SIValue *argv, int argc, void *private_data) {
 		.str = str
 	};
 
-	rv = onig_scan(regex, (const UChar *)str,
+	int rv = onig_scan(regex, (const UChar *)str,
 		(const UChar *)(str + strlen(str)), region, ONIG_OPTION_DEFAULT,
 		match_regex_scan_cb, &args);
 	if(rv < 0) {
 		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
 		onig_error_code_to_str((OnigUChar* )s, rv);
 		ErrorCtx_SetError("Invalid regex, err=%s", s);
-		onig_free(regex);
+		if(private_data == NULL) onig_free(regex);
 		onig_region_free(region, 1);
 		SIValue_Free(list);
 		return SI_NullVal();
 	}
 
-	onig_free(regex);
+	if(private_data == NULL) onig_free(regex);
 	onig_region_free(region, 1);
 
 	return list;
@@ -382,18 +426,11 @@ SIValue AR_REPLACEREGEX(SIValue *argv, int argc, void *private_data) {
 		replacement = argv[2].stringval;
 	}
 
-	regex_t *regex;
-	OnigErrorInfo einfo;
+	// use precompiled regex if the pattern is constant
+	regex_t *regex     = private_data;
 	OnigRegion *region = onig_region_new();
 
-	int rv = onig_new(&regex, (const UChar *)regex_str, 
-		(const UChar *)(regex_str + strlen(regex_str)), ONIG_OPTION_DEFAULT,
-		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, &einfo);
-	if(rv != ONIG_NORMAL) {
-		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
-		onig_error_code_to_str((UChar* )s, rv, &einfo);
-		ErrorCtx_SetError("Invalid regex, err=%s", s);
-		onig_free(regex);
+	if(regex == NULL && !_CompileRegex(regex_str, &regex)) {
 		onig_region_free(region, 1);
 		return SI_NullVal();
 	}
@@ -407,19 +444,19 @@ SIValue AR_REPLACEREGEX(SIValue *argv, int argc, void *private_data) {
 		.replacement_len = strlen(replacement)
 	};
 
-	rv = onig_scan(regex, (const UChar *)str,
+	int rv = onig_scan(regex, (const UChar *)str,
 		(const UChar *)(str + strlen(str)), region, ONIG_OPTION_DEFAULT,
 		replace_regex_scan_cb, &args);
 	if(rv < 0) {
 		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
 		onig_error_code_to_str((OnigUChar* )s, rv);
 		ErrorCtx_SetError("Invalid regex, err=%s", s);
-		onig_free(regex);
+		if(private_data == NULL) onig_free(regex);
 		onig_region_free(region, 1);
 		return SI_NullVal();
 	}
 
-	onig_free(regex);
+	if(private_data == NULL) onig_free(regex);
 	onig_region_free(region, 1);
 
 	// copy the remaining string
@@ -751,6 +788,8 @@ void Register_StringFuncs() {
 	array_append(types, (T_STRING | T_NULL));
 	ret_type = T_ARRAY | T_NULL;
 	func_desc = AR_FuncDescNew("string.matchRegEx", AR_MATCHREGEX, 2, 2, types, ret_type, false, true);
+	AR_SetPrivateDataRoutines(func_desc, _FreeRegex, NULL);
+	AR_SetBindRoutine(func_desc, _BindRegex, AR_FUNC_ARG(1));
 	AR_RegFunc(func_desc);
 
 	types = array_new(SIType, 3);
@@ -759,6 +798,8 @@ void Register_StringFuncs() {
 	array_append(types, (T_STRING | T_NULL));
 	ret_type = T_STRING | T_NULL;
 	func_desc = AR_FuncDescNew("string.replaceRegEx", AR_REPLACEREGEX, 2, 3, types, ret_type, false, true);
+	AR_SetPrivateDataRoutines(func_desc, _FreeRegex, NULL);
+	AR_SetBindRoutine(func_desc, _BindRegex, AR_FUNC_ARG(1));
 	AR_RegFunc(func_desc);
 
 	types = array_new(SIType, 1);
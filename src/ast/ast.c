@@ -85,27 +85,23 @@ static const cypher_astnode_t *_AST_parse_result_root
 	return NULL;
 }
 
-// this method extracts the query's parameters values, convert them into
-// constant SIValues and store them in a map of <name, value>
-// in the query context
-static void _AST_Extract_Params
+// evaluates the parameters of a parsed CYPHER prefix, converts them into
+// constant SIValues and adds them to the map of <name, value> `params`
+// returns false if a parameter is already defined in the map
+static bool _AST_Evaluate_Params
 (
-	const cypher_parse_result_t *parse_result
+	const cypher_astnode_t *statement,
+	rax *params
 ) {
-	// retrieve the AST root node from a parsed query
-	const cypher_astnode_t *statement = _AST_parse_result_root(parse_result);
+	bool res = true;
 	uint noptions = cypher_ast_statement_noptions(statement);
-	if(noptions == 0) {
-		return;
-	}
 
-	rax *params = raxNew();
-	for(uint i = 0; i < noptions; i++) {
+	for(uint i = 0; i < noptions && res; i++) {
 		const cypher_astnode_t *option =
 			cypher_ast_statement_get_option(statement, i);
 		uint nparams = cypher_ast_cypher_option_nparams(option);
 
-		for(uint j = 0; j < nparams; j++) {
+		for(uint j = 0; j < nparams && res; j++) {
 			const cypher_astnode_t *param =
 				cypher_ast_cypher_option_get_param(option, j);
 
@@ -120,12 +116,36 @@ static void _AST_Extract_Params
 			SIValue *v = rm_malloc(sizeof(SIValue));
 			SIValue _v = AR_EXP_Evaluate(exp, NULL);
 			*v = SI_CloneValue(_v);
-			raxInsert(params, (unsigned char *)paramName, strlen(paramName),
-					(void *)v, NULL);
+			res = raxTryInsert(params, (unsigned char *)paramName,
+					strlen(paramName), (void *)v, NULL);
+			if(!res) {
+				SIValue_Free(*v);
+				rm_free(v);
+			}
 			AR_EXP_Free(exp);
 		}
 	}
 
+	return res;
+}
+
+// this method extracts the query's parameters values, convert them into
+// constant SIValues and store them in a map of <name, value>
+// in the query context
+static void _AST_Extract_Params
+(
+	const cypher_parse_result_t *parse_result
+) {
+	// retrieve the AST root node from a parsed query
+	const cypher_astnode_t *statement = _AST_parse_result_root(parse_result);
+	uint noptions = cypher_ast_statement_noptions(statement);
+	if(noptions == 0) {
+		return;
+	}
+
+	rax *params = raxNew();
+	_AST_Evaluate_Params(statement, params);
+
 	// add the parameters map to the QueryCtx
 	QueryCtx_SetParams(params);
 }
@@ -812,6 +832,43 @@ cypher_parse_result_t *parse_params
 	return result;
 }
 
+bool AST_AddParams
+(
+	const char *params
+) {
+	ASSERT(params != NULL);
+
+	FILE *f = fmemopen((char *)params, strlen(params), "r");
+	cypher_parse_result_t *result = cypher_fparse(f, NULL, NULL,
+			CYPHER_PARSE_ONLY_PARAMETERS);
+	fclose(f);
+
+	if(!result) {
+		return false;
+	}
+
+	if(AST_Validate_QueryParams(result) != AST_VALID) {
+		parse_result_free(result);
+		return false;
+	}
+
+	// extend the query context parameters map
+	rax *query_params = QueryCtx_GetParams();
+	bool new_map = (query_params == NULL);
+	if(new_map) {
+		query_params = raxNew();
+		QueryCtx_SetParams(query_params);
+	}
+
+	const cypher_astnode_t *statement = _AST_parse_result_root(result);
+	bool res = _AST_Evaluate_Params(statement, query_params);
+
+	parse_result_free(result);
+
+	// see if we've encountered an error while evaluating parameter value
+	return res && !ErrorCtx_EncounteredError();
+}
+
 void parse_result_free
 (
 	cypher_parse_result_t *parse_result
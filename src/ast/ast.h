@@ -238,6 +238,14 @@ cypher_parse_result_t *parse_params
 	const char **query_body
 );
 
+// parse a CYPHER parameters prefix e.g. "CYPHER a=1 b='x'" and add its
+// parameters to the query context parameters map
+// returns false if a parameter is invalid or already defined
+bool AST_AddParams
+(
+	const char *params  // parameters prefix
+);
+
 // free the immutable AST generated by the parser
 void parse_result_free
 (
@@ -0,0 +1,584 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "query_normalizer.h"
+#include "../util/rmalloc.h"
+#include "../util/sds/sds.h"
+
+#include <stdio.h>
+#include <ctype.h>
+#include <string.h>
+#include <strings.h>
+
+// keywords emitted in upper case
+static const char *_keywords[] = {
+	"MATCH", "OPTIONAL", "WHERE", "WITH", "CREATE", "MERGE", "DELETE",
+	"DETACH", "SET", "REMOVE", "UNWIND", "FOREACH", "CALL", "YIELD", "ON",
+	"AS", "AND", "OR", "XOR", "NOT", "IN", "IS", "NULL", "TRUE", "FALSE",
+	"DISTINCT", "ORDER", "BY", "ASC", "DESC", "ASCENDING", "DESCENDING",
+	"CASE", "WHEN", "THEN", "ELSE", "END", "STARTS", "ENDS", "CONTAINS",
+	"UNION", "SKIP", "LIMIT", "RETURN", "INDEX", NULL
+};
+
+typedef struct {
+	const char *p;       // current position within the query
+	sds body;            // normalized query
+	sds params;          // lifted literals parameters prefix
+	uint nparams;        // number of lifted literals
+	uint depth;          // curly braces nesting depth
+	bool space;          // whitespace pending emission
+	bool keyword;        // last emitted token is a keyword
+	bool keep_literals;  // literals are kept in place e.g. LIMIT 10
+} _Normalizer;
+
+static inline bool _IsWordStart
+(
+	char c
+) {
+	return isalpha((unsigned char)c) || c == '_' || (unsigned char)c >= 0x80;
+}
+
+static inline bool _IsWordChar
+(
+	char c
+) {
+	return _IsWordStart(c) || isdigit((unsigned char)c);
+}
+
+// returns last emitted character, '\0' if nothing was emitted
+static inline char _Last
+(
+	const _Normalizer *n
+) {
+	size_t len = sdslen(n->body);
+	return (len == 0) ? '\0' : n->body[len - 1];
+}
+
+// append token to the normalized query
+// pending whitespace is emitted as a single space, which is dropped after an
+// opening bracket and before a closing bracket or a comma
+// commas are always followed by a space
+static void _Emit
+(
+	_Normalizer *n,
+	const char *s,
+	size_t len
+) {
+	ASSERT(len > 0);
+
+	char last = _Last(n);
+	if(last == ',') n->space = true;
+
+	if(n->space && last != '\0' && strchr("([{", last) == NULL &&
+	   strchr(")]},", s[0]) == NULL) {
+		n->body = sdscatlen(n->body, " ", 1);
+	}
+
+	n->body    = sdscatlen(n->body, s, len);
+	n->space   = false;
+	n->keyword = false;
+}
+
+// returns the end of a quoted token starting at `p`, NULL if unterminated
+// strings escape characters using a backslash
+// backtick quoted names escape backticks by doubling them
+static const char *_QuotedEnd
+(
+	const char *p
+) {
+	char quote = *p++;
+
+	while(*p != '\0') {
+		if(quote != '`' && *p == '\\') {
+			if(p[1] == '\0') return NULL;
+			p += 2;
+		} else if(*p == quote) {
+			if(quote == '`' && p[1] == '`') {
+				p += 2;
+				continue;
+			}
+			return p + 1;
+		} else {
+			p++;
+		}
+	}
+
+	return NULL;
+}
+
+// returns the end of a number literal starting at `p`
+// including an optional leading minus sign
+static const char *_NumberEnd
+(
+	const char *p
+) {
+	if(*p == '-') p++;
+	while(isdigit((unsigned char)*p)) p++;
+
+	// fraction, a range e.g. 1..3 isn't
+	if(p[0] == '.' && isdigit((unsigned char)p[1])) {
+		p++;
+		while(isdigit((unsigned char)*p)) p++;
+	}
+
+	// exponent
+	if(*p == 'e' || *p == 'E') {
+		const char *e = p + 1;
+		if(*e == '+' || *e == '-') e++;
+		if(isdigit((unsigned char)*e)) {
+			p = e;
+			while(isdigit((unsigned char)*p)) p++;
+		}
+	}
+
+	return p;
+}
+
+// returns the end of a list literal starting at `p`, made up solely of
+// number and string literals, NULL if `p` doesn't start such a list
+static const char *_LiteralListEnd
+(
+	const char *p
+) {
+	ASSERT(*p == '[');
+	p++;
+
+	while(true) {
+		while(isspace((unsigned char)*p)) p++;
+
+		const char *end;
+		if(*p == '\'' || *p == '"') {
+			end = _QuotedEnd(p);
+			if(end == NULL) return NULL;
+		} else if(isdigit((unsigned char)*p) ||
+				(*p == '-' && isdigit((unsigned char)p[1]))) {
+			end = _NumberEnd(p);
+			if(_IsWordChar(*end) || *end == '.') return NULL;
+		} else {
+			return NULL;
+		}
+
+		p = end;
+		while(isspace((unsigned char)*p)) p++;
+
+		if(*p == ']') return p + 1;
+		if(*p != ',') return NULL;
+		p++;
+	}
+}
+
+// skip whitespace and comments
+// returns false if the query contains an unterminated comment
+static bool _SkipWhitespace
+(
+	_Normalizer *n
+) {
+	const char *p = n->p;
+
+	while(true) {
+		if(isspace((unsigned char)*p)) {
+			p++;
+		} else if(p[0] == '/' && p[1] == '/') {
+			while(*p != '\0' && *p != '\n') p++;
+		} else if(p[0] == '/' && p[1] == '*') {
+			const char *end = strstr(p + 2, "*/");
+			if(end == NULL) return false;
+			p = end + 2;
+		} else {
+			break;
+		}
+	}
+
+	if(p != n->p) n->space = true;
+	n->p = p;
+
+	return true;
+}
+
+// returns true if a literal at the current position can be lifted
+static bool _CanLift
+(
+	const _Normalizer *n
+) {
+	if(n->keep_literals) return false;
+
+	// variable length traversal hops and ranges e.g. [*2], [*1..3], [1..3]
+	char last = _Last(n);
+	return last != '*' && last != '.';
+}
+
+// returns true if the minus sign at the current position is part of a literal
+// e.g. {v: -1} but not a - 1
+static bool _IsNegativeLiteral
+(
+	const _Normalizer *n
+) {
+	if(n->p[0] != '-' || !isdigit((unsigned char)n->p[1])) return false;
+
+	char last = _Last(n);
+	return last != '\0' && strchr("([{,:=>", last) != NULL;
+}
+
+// returns true if a list at the current position is a list literal
+// rather than a subscript e.g. xs[0] or a relationship pattern
+static bool _IsListLiteral
+(
+	const _Normalizer *n
+) {
+	char last = _Last(n);
+
+	if(_IsWordChar(last)) return n->keyword;  // IN [1, 2] vs. xs[0]
+	return last == '\0' || strchr(")]}`-", last) == NULL;
+}
+
+// replace literal with a synthetic parameter
+static void _Lift
+(
+	_Normalizer *n,
+	const char *literal,
+	size_t len
+) {
+	char name[32];
+	int name_len = snprintf(name, sizeof(name), "$"
+			QUERY_NORMALIZER_PARAM_PREFIX "%u", n->nparams++);
+
+	// assign literal to parameter e.g. lit_0=42
+	n->params = sdscatlen(n->params, " ", 1);
+	n->params = sdscatlen(n->params, name + 1, name_len - 1);
+	n->params = sdscatlen(n->params, "=", 1);
+	n->params = sdscatlen(n->params, literal, len);
+
+	// refer to parameter e.g. $lit_0
+	_Emit(n, name, name_len);
+}
+
+// returns the upper case form of the keyword `word`
+// NULL if `word` isn't a keyword at the current position
+static const char *_Keyword
+(
+	const _Normalizer *n,
+	const char *word,
+	size_t len
+) {
+	// attribute, label, relationship type or parameter
+	// e.g. n.limit, (:Match), [:A|in], $return
+	char last = _Last(n);
+	if(last != '\0' && strchr(".:|$", last) != NULL) return NULL;
+
+	// map key e.g. {limit: 10}
+	const char *next = word + len;
+	while(isspace((unsigned char)*next)) next++;
+	if(*next == ':') return NULL;
+
+	for(uint i = 0; _keywords[i] != NULL; i++) {
+		const char *keyword = _keywords[i];
+		if(strlen(keyword) == len && strncasecmp(keyword, word, len) == 0) {
+			return keyword;
+		}
+	}
+
+	return NULL;
+}
+
+// returns true if a RETURN clause ends at `p`
+// either at the end of the query, a UNION or the end of an enclosing subquery
+static bool _ReturnEnd
+(
+	const char *p,
+	uint depth,        // current curly braces depth
+	uint return_depth  // curly braces depth at the beginning of the clause
+) {
+	if(*p == '\0') return true;
+	if(depth != return_depth) return false;
+	if(*p == '}') return true;
+
+	return strncasecmp(p, "UNION", 5) == 0 && !_IsWordChar(p[5]) &&
+		p[-1] != '.';
+}
+
+// copy a RETURN clause as is
+// column names are derived from the projected expressions text
+// returns false if the clause contains an unterminated string or comment
+static bool _NormalizeReturn
+(
+	_Normalizer *n
+) {
+	const char *p     = n->p;
+	uint return_depth = n->depth;
+
+	while(true) {
+		const char *q = p;
+		while(isspace((unsigned char)*q)) q++;
+
+		if(_ReturnEnd(q, n->depth, return_depth)) {
+			if(q != p) n->space = true;
+			p = q;
+			break;
+		}
+
+		const char *end = p + 1;
+		if(q != p) {
+			end = q;
+		} else if(*p == '\'' || *p == '"' || *p == '`') {
+			end = _QuotedEnd(p);
+			if(end == NULL) return false;
+		} else if(p[0] == '/' && p[1] == '/') {
+			end = p + strcspn(p, "\n");
+		} else if(p[0] == '/' && p[1] == '*') {
+			end = strstr(p + 2, "*/");
+			if(end == NULL) return false;
+			end += 2;
+		} else if(_IsWordChar(*p)) {
+			while(_IsWordChar(*end)) end++;
+		} else if(*p == '{') {
+			n->depth++;
+		} else if(*p == '}') {
+			n->depth--;
+		}
+
+		n->body = sdscatlen(n->body, p, end - p);
+		p = end;
+	}
+
+	n->p = p;
+	return true;
+}
+
+// normalize the word at the current position
+// returns false if the query shouldn't be normalized
+static bool _NormalizeWord
+(
+	_Normalizer *n
+) {
+	const char *word = n->p;
+	const char *end  = word;
+	while(_IsWordChar(*end)) end++;
+
+	size_t len = end - word;
+	n->p = end;
+
+	const char *keyword = _Keyword(n, word, len);
+	if(keyword == NULL) {
+		n->keep_literals = false;
+		_Emit(n, word, len);
+		return true;
+	}
+
+	// index management queries aren't normalized
+	if(strcmp(keyword, "INDEX") == 0) return false;
+
+	_Emit(n, keyword, len);
+	n->keyword = true;
+
+	n->keep_literals = (strcmp(keyword, "SKIP") == 0 ||
+			strcmp(keyword, "LIMIT") == 0);
+
+	if(strcmp(keyword, "RETURN") == 0) return _NormalizeReturn(n);
+
+	return true;
+}
+
+// normalize the number at the current position
+static void _NormalizeNumber
+(
+	_Normalizer *n
+) {
+	const char *number = n->p;
+	const char *end    = _NumberEnd(number);
+
+	if(_IsWordChar(*end)) {
+		// hexadecimal or octal integer e.g. 0x1F
+		while(_IsWordChar(*end)) end++;
+		_Emit(n, number, end - number);
+	} else if(*end == '.' || !_CanLift(n)) {
+		// range boundary e.g. [1..3]
+		_Emit(n, number, end - number);
+	} else {
+		_Lift(n, number, end - number);
+	}
+
+	n->p = end;
+}
+
+// normalize query
+// returns false if the query shouldn't be normalized
+static bool _Normalize
+(
+	_Normalizer *n
+) {
+	while(true) {
+		if(!_SkipWhitespace(n)) return false;
+
+		const char *p = n->p;
+		const char *end;
+		char c = *p;
+
+		if(c == '\0') return true;
+
+		if(c == '\'' || c == '"') {
+			// string literal
+			end = _QuotedEnd(p);
+			if(end == NULL) return false;
+
+			if(_CanLift(n)) {
+				_Lift(n, p, end - p);
+			} else {
+				_Emit(n, p, end - p);
+			}
+			n->p = end;
+		} else if(c == '`') {
+			// quoted name
+			end = _QuotedEnd(p);
+			if(end == NULL) return false;
+
+			_Emit(n, p, end - p);
+			n->p = end;
+		} else if(c == '$') {
+			// parameter
+			end = p + 1;
+			if(*end == '`') {
+				end = _QuotedEnd(end);
+				if(end == NULL) return false;
+			} else {
+				while(_IsWordChar(*end)) end++;
+			}
+
+			_Emit(n, p, end - p);
+			n->p = end;
+		} else if(_IsWordStart(c)) {
+			if(!_NormalizeWord(n)) return false;
+		} else if(isdigit((unsigned char)c) || _IsNegativeLiteral(n)) {
+			_NormalizeNumber(n);
+		} else if(c == '[' && _CanLift(n) && _IsListLiteral(n) &&
+				(end = _LiteralListEnd(p)) != NULL) {
+			// list literal e.g. [1, 2, 3]
+			_Lift(n, p, end - p);
+			n->p = end;
+		} else {
+			if(c == '{') {
+				n->depth++;
+			} else if(c == '}') {
+				if(n->depth == 0) return false;
+				n->depth--;
+			}
+
+			_Emit(n, p, 1);
+			n->p++;
+		}
+	}
+}
+
+char *QueryNormalizer_Normalize
+(
+	const char *query,  // query to normalize
+	char **params       // [output] lifted literals parameters prefix
+) {
+	ASSERT(query  != NULL);
+	ASSERT(params != NULL);
+
+	*params = NULL;
+
+	_Normalizer n = {
+		.p             = query,
+		.body          = sdsempty(),
+		.params        = sdsnew("CYPHER"),
+		.nparams       = 0,
+		.depth         = 0,
+		.space         = false,
+		.keyword       = false,
+		.keep_literals = false
+	};
+
+	char *normalized = NULL;
+
+	if(_Normalize(&n) && sdslen(n.body) > 0 && strcmp(n.body, query) != 0) {
+		normalized = rm_strdup(n.body);
+		if(n.nparams > 0) *params = rm_strdup(n.params);
+	}
+
+	sdsfree(n.body);
+	sdsfree(n.params);
+
+	return normalized;
+}
+
+// returns the end of a parameter value starting at `p`, NULL if malformed
+// values are literals, maps and lists may span whitespace
+static const char *_ParamValueEnd
+(
+	const char *p
+) {
+	uint depth = 0;
+
+	while(*p != '\0') {
+		if(depth == 0 && isspace((unsigned char)*p)) break;
+
+		if(*p == '\'' || *p == '"') {
+			p = _QuotedEnd(p);
+			if(p == NULL) return NULL;
+			continue;
+		}
+
+		if(*p == '[' || *p == '{') {
+			depth++;
+		} else if(*p == ']' || *p == '}') {
+			if(depth == 0) return NULL;
+			depth--;
+		}
+
+		p++;
+	}
+
+	return (depth == 0) ? p : NULL;
+}
+
+// returns the query body, following the CYPHER parameters prefix if any
+static const char *_SkipParams
+(
+	const char *query
+) {
+	const char *p = query;
+	while(isspace((unsigned char)*p)) p++;
+
+	if(strncasecmp(p, "CYPHER", 6) != 0 || !isspace((unsigned char)p[6])) {
+		return p;
+	}
+	p += 6;
+
+	// name=value pairs, the body starts at the first word not assigned to
+	while(true) {
+		while(isspace((unsigned char)*p)) p++;
+
+		const char *name = p;
+		while(_IsWordChar(*p)) p++;
+
+		const char *eq = p;
+		while(isspace((unsigned char)*eq)) eq++;
+		if(p == name || *eq != '=') return name;
+
+		p = eq + 1;
+		while(isspace((unsigned char)*p)) p++;
+
+		p = _ParamValueEnd(p);
+		if(p == NULL) return query;
+	}
+}
+
+char *QueryNormalizer_CacheKey
+(
+	const char *query  // query including its parameters
+) {
+	ASSERT(query != NULL);
+
+	const char *body = _SkipParams(query);
+
+	char *params;
+	char *key = QueryNormalizer_Normalize(body, &params);
+	if(params != NULL) rm_free(params);
+
+	return (key != NULL) ? key : rm_strdup(body);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+// query normalization
+//
+// reduces queries which differ only by their literal values, whitespace
+// or keywords case to a single normalized form, allowing such queries to share
+// a cached execution plan, e.g.
+//
+// match (n:Person {id: 42})
+// where n.name =  'Alice' RETURN n
+//
+// is normalized to:
+//
+// MATCH (n:Person {id: $lit_0}) WHERE n.name = $lit_1 RETURN n
+//
+// the lifted literals are assigned to their synthetic parameters
+// via a CYPHER parameters prefix:
+//
+// CYPHER lit_0=42 lit_1='Alice'
+//
+// normalization is performed on the query text and is conservative,
+// literals are kept in place wherever they can't be replaced by a parameter:
+//
+// 1. RETURN clauses are kept verbatim as their text determines column names
+// 2. SKIP and LIMIT values
+// 3. variable length traversal hops e.g. [*1..3] and list slices e.g. [1..3]
+//
+// index management queries aren't normalized
+
+// synthetic parameters name prefix
+#define QUERY_NORMALIZER_PARAM_PREFIX "lit_"
+
+// normalize query
+// returns NULL if the query is already in its normalized form
+// otherwise returns the normalized query and sets `params` to the CYPHER
+// parameters prefix assigning the lifted literals, NULL if none were lifted
+// both strings should be freed by the caller using rm_free
+char *QueryNormalizer_Normalize
+(
+	const char *query,  // query to normalize
+	char **params       // [output] lifted literals parameters prefix
+);
+
+// returns the execution plan cache key of a query
+// the normalized query body, excluding the CYPHER parameters prefix
+// computed on the query text alone, without parsing the query
+// the returned string should be freed by the caller using rm_free
+char *QueryNormalizer_CacheKey
+(
+	const char *query  // query including its parameters
+);
@@ -10,6 +10,10 @@
 #include "../schema/schema.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
+#include "../util/thpool/pools.h"
+
+// number of entities decoded by a single task
+#define BULK_DECODE_CHUNK 4096
 
 // the first byte of each property in the binary stream
 // is used to indicate the type of the subsequent SIValue
@@ -194,6 +198,135 @@ static SIValue _BulkInsert_ReadProperty
     return v;
 }
 
+// advance the index past a property in the data stream
+static void _BulkInsert_SkipProperty
+(
+	const char* data,
+	size_t* data_idx
+) {
+	int64_t len;
+	TYPE t = data[*data_idx];
+	*data_idx += 1;
+
+	switch (t) {
+		case BI_NULL:
+			break;
+
+		case BI_BOOL:
+			*data_idx += 1;
+			break;
+
+		case BI_DOUBLE:
+			*data_idx += sizeof(double);
+			break;
+
+		case BI_LONG:
+			*data_idx += sizeof(int64_t);
+			break;
+
+		case BI_STRING:
+			*data_idx += strlen(data + *data_idx) + 1;
+			break;
+
+		case BI_ARRAY:
+			len = *(int64_t*)&data[*data_idx];
+			*data_idx += sizeof(int64_t);
+			for (int64_t i = 0; i < len; i++) {
+				_BulkInsert_SkipProperty(data, data_idx);
+			}
+			break;
+
+		default:
+			ASSERT(false);
+			break;
+	}
+}
+
+// decoding of a batch of entities
+typedef struct {
+	const char* data;                  // binary stream
+	const size_t* offsets;             // offset of each entity's properties
+	const Attribute_ID* prop_indices;  // attribute ID of each property
+	uint prop_count;                   // number of properties per entity
+	uint64_t n;                        // number of entities
+	AttributeSet* sets;                // [output] decoded attribute sets
+} _DecodeCtx;
+
+// decode the i'th chunk of entities
+static void _BulkInsert_DecodeChunk
+(
+	void* arg,
+	uint64_t chunk
+) {
+	_DecodeCtx* ctx = (_DecodeCtx*)arg;
+
+	uint64_t from = chunk * BULK_DECODE_CHUNK;
+	uint64_t to = MIN(ctx->n, from + BULK_DECODE_CHUNK);
+
+	for (uint64_t i = from; i < to; i++) {
+		AttributeSet set = NULL;
+		size_t data_idx = ctx->offsets[i];
+
+		for (uint j = 0; j < ctx->prop_count; j++) {
+			SIValue value = _BulkInsert_ReadProperty(ctx->data, &data_idx);
+			// skip invalid attribute values
+			if (!(SI_TYPE(value) & SI_VALID_PROPERTY_VALUE)) continue;
+
+			AttributeSet_Add(&set, ctx->prop_indices[j], value);
+			SIValue_Free(value);
+		}
+
+		ctx->sets[i] = set;
+	}
+}
+
+// decode the properties of 'n' entities into attribute sets
+// chunks of entities are decoded on the readers thread-pool
+// with the calling thread taking part
+static void _BulkInsert_DecodeProperties
+(
+	const char* data,
+	const size_t* offsets,
+	uint64_t n,
+	const Attribute_ID* prop_indices,
+	uint prop_count,
+	AttributeSet* sets
+) {
+	if (prop_count == 0 || n == 0) return;
+
+	_DecodeCtx ctx = {
+		.data = data,
+		.offsets = offsets,
+		.prop_indices = prop_indices,
+		.prop_count = prop_count,
+		.n = n,
+		.sets = sets
+	};
+
+	uint64_t chunks = (n + BULK_DECODE_CHUNK - 1) / BULK_DECODE_CHUNK;
+	ThreadPools_ReadersParallelFor(_BulkInsert_DecodeChunk, &ctx, chunks);
+}
+
+// introduce decoded attributes to the schemas statistics
+static void _BulkInsert_UpdateStatistics
+(
+	GraphContext* gc,
+	const int* label_ids,
+	uint label_count,
+	SchemaType t,
+	const AttributeSet set
+) {
+	uint attr_count = ATTRIBUTE_SET_COUNT(set);
+	for (uint i = 0; i < attr_count; i++) {
+		Attribute_ID attr_id;
+		SIValue value = AttributeSet_GetIdx(set, i, &attr_id);
+		for (uint j = 0; j < label_count; j++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, label_ids[j], t);
+			Schema_AddToStatistics(s, attr_id, value);
+		}
+	}
+}
+
 static int _BulkInsert_ProcessNodeFile
 (
 	GraphContext* gc,
@@ -210,6 +343,23 @@ static int _BulkInsert_ProcessNodeFile
     Attribute_ID* prop_indices = _BulkInsert_ReadHeaderProperties(gc, SCHEMA_NODE, data,
 	&data_idx, &prop_count);
 
+    //--------------------------------------------------------------------------
+    // locate and decode node properties
+    //--------------------------------------------------------------------------
+
+    size_t* offsets = array_new(size_t, 0);
+	while (data_idx < data_len) {
+		array_append(offsets, data_idx);
+		for (uint i = 0; i < prop_count; i++) {
+			_BulkInsert_SkipProperty(data, &data_idx);
+		}
+	}
+
+    uint64_t node_count = array_len(offsets);
+    AttributeSet* sets = rm_calloc(node_count, sizeof(AttributeSet));
+    _BulkInsert_DecodeProperties(data, offsets, node_count, prop_indices,
+		prop_count, sets);
+
     // sync each matrix once
     ASSERT(Graph_GetMatrixPolicy(gc->g) == SYNC_POLICY_RESIZE);
 
@@ -225,24 +375,19 @@ static int _BulkInsert_ProcessNodeFile
     // load nodes
     //--------------------------------------------------------------------------
 
-	while (data_idx < data_len) {
+	for (uint64_t i = 0; i < node_count; i++) {
 		Node n = GE_NEW_NODE();
-		GraphEntity* ge;
 		Graph_CreateNode(gc->g, &n, label_ids, label_count);
-		ge = (GraphEntity*)&n;
-		// process entity attributes
-		for (uint i = 0; i < prop_count; i++) {
-			SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
-			// skip invalid attribute values
-			if (!(SI_TYPE(value) & SI_VALID_PROPERTY_VALUE))
-				continue;
-			GraphEntity_AddProperty(ge, prop_indices[i], value);
-		}
+		*n.attributes = sets[i];
+		_BulkInsert_UpdateStatistics(gc, label_ids, label_count, SCHEMA_NODE,
+				sets[i]);
 	}
 
     Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
     if (prop_indices) rm_free(prop_indices);
     array_free(label_ids);
+    array_free(offsets);
+    rm_free(sets);
 
     return BULK_OK;
 }
@@ -253,7 +398,6 @@ static int _BulkInsert_ProcessEdgeFile
 	const char* data,
 	size_t data_len
 ) {
-    int relation_id;
     uint prop_count;
     size_t data_idx = 0;
 
@@ -269,45 +413,58 @@ static int _BulkInsert_ProcessEdgeFile
     Attribute_ID* prop_indices = _BulkInsert_ReadHeaderProperties(gc, SCHEMA_EDGE,
 	data, &data_idx, &prop_count);
 
-    // sync matrix once
-    ASSERT(Graph_GetMatrixPolicy(gc->g) == SYNC_POLICY_RESIZE);
-    Graph_GetRelationMatrix(gc->g, type_id, false);
-    Graph_GetAdjacencyMatrix(gc->g, false);
-    Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_NOP);
-
     //--------------------------------------------------------------------------
-    // load edges
+    // stage edges endpoints, locate and decode edge properties
     //--------------------------------------------------------------------------
 
-	while (data_idx < data_len) {
-		Edge e;
-		GraphEntity* ge;
+    NodeID* src = array_new(NodeID, 0);
+    NodeID* dest = array_new(NodeID, 0);
+    size_t* offsets = array_new(size_t, 0);
 
+	while (data_idx < data_len) {
 		// next 8 bytes are source ID
-		NodeID src = *(NodeID*)&data[data_idx];
+		array_append(src, *(NodeID*)&data[data_idx]);
 		data_idx += sizeof(NodeID);
 		// next 8 bytes are destination ID
-		NodeID dest = *(NodeID*)&data[data_idx];
+		array_append(dest, *(NodeID*)&data[data_idx]);
 		data_idx += sizeof(NodeID);
 
-		Graph_CreateEdge(gc->g, src, dest, type_id, &e);
-		ge = (GraphEntity*)&e;
-
-		// process entity attributes
+		array_append(offsets, data_idx);
 		for (uint i = 0; i < prop_count; i++) {
-			SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
-			// skip invalid attribute values
-			if (!(SI_TYPE(value) & SI_VALID_PROPERTY_VALUE)) {
-				continue;
-			}
-
-			GraphEntity_AddProperty(ge, prop_indices[i], value);
+			_BulkInsert_SkipProperty(data, &data_idx);
 		}
 	}
 
+    uint64_t edge_count = array_len(offsets);
+    AttributeSet* sets = rm_calloc(edge_count, sizeof(AttributeSet));
+    _BulkInsert_DecodeProperties(data, offsets, edge_count, prop_indices,
+		prop_count, sets);
+
+    //--------------------------------------------------------------------------
+    // load edges
+    //--------------------------------------------------------------------------
+
+    // sync matrix once
+    ASSERT(Graph_GetMatrixPolicy(gc->g) == SYNC_POLICY_RESIZE);
+
+    // relation and adjacency matrices are built in a single operation
+    EdgeID* ids = rm_malloc(edge_count * sizeof(EdgeID));
+    Graph_CreateEdges(gc->g, type_id, src, dest, ids, edge_count);
+
+	for (uint64_t i = 0; i < edge_count; i++) {
+		Edge e;
+		Graph_GetEdge(gc->g, ids[i], &e);
+		*e.attributes = sets[i];
+		_BulkInsert_UpdateStatistics(gc, &type_id, 1, SCHEMA_EDGE, sets[i]);
+	}
+
     array_free(type_ids);
     if (prop_indices) rm_free(prop_indices);
-    Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
+    array_free(src);
+    array_free(dest);
+    array_free(offsets);
+    rm_free(sets);
+    rm_free(ids);
 
     return BULK_OK;
 }
@@ -413,7 +570,11 @@ int BulkInsert
 cleanup:
 	// reset graph sync policy
 	Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
+	bool flush = Graph_RequiresFlush(g);
 	Graph_ReleaseLock(g);
+
+	if(flush) GraphContext_ScheduleFlush(gc);
+
 	return res;
 }
 
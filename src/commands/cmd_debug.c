@@ -6,7 +6,12 @@
 
 #include "RG.h"
 #include "../redismodule.h"
+#include "../graph/graphcontext.h"
 #include "../module_event_handlers.h"
+#include "../util/rmalloc.h"
+#include "../util/thpool/pools.h"
+#include "../util/blocked_client.h"
+#include "../graph/graph_compaction.h"
 
 #include <string.h>
 
@@ -27,11 +32,184 @@ static void Debug_AUX(RedisModuleString **argv, int argc) {
 	}
 }
 
+// GRAPH.DEBUG FRAGMENTATION <graph>
+// reports the number of live entities and holes in the graph's storage
+static int Debug_Fragmentation
+(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+) {
+	if(argc != 3) return RedisModule_WrongArity(ctx);
+
+	GraphContext *gc = GraphContext_Retrieve(ctx, argv[2], true, false);
+	if(gc == NULL) return REDISMODULE_OK;
+
+	Graph *g = GraphContext_GetGraph(gc);
+	Graph_AcquireReadLock(g);
+
+	uint64_t nodes         = Graph_NodeCount(g);
+	uint64_t deleted_nodes = Graph_DeletedNodeCount(g);
+	uint64_t edges         = Graph_EdgeCount(g);
+	uint64_t deleted_edges = Graph_DeletedEdgeCount(g);
+	uint64_t matrix_dim    = Graph_RequiredMatrixDim(g);
+
+	Graph_ReleaseLock(g);
+	GraphContext_DecreaseRefCount(gc);
+
+	RedisModule_ReplyWithArray(ctx, 10);
+
+	RedisModule_ReplyWithCString(ctx, "Nodes");
+	RedisModule_ReplyWithLongLong(ctx, nodes);
+	RedisModule_ReplyWithCString(ctx, "Deleted nodes");
+	RedisModule_ReplyWithLongLong(ctx, deleted_nodes);
+	RedisModule_ReplyWithCString(ctx, "Edges");
+	RedisModule_ReplyWithLongLong(ctx, edges);
+	RedisModule_ReplyWithCString(ctx, "Deleted edges");
+	RedisModule_ReplyWithLongLong(ctx, deleted_edges);
+	RedisModule_ReplyWithCString(ctx, "Matrix dimension");
+	RedisModule_ReplyWithLongLong(ctx, matrix_dim);
+
+	return REDISMODULE_OK;
+}
+
+// compaction slice requested by GRAPH.DEBUG COMPACT
+typedef struct {
+	GraphContext *gc;              // graph to compact
+	RedisModuleCtx *rm_ctx;        // redis module context
+	RedisModuleBlockedClient *bc;  // blocked client, NULL on main thread
+	CompactionCursor cursor;       // relocatable edges scan position
+	uint64_t budget;               // max number of entities to relocate
+} DebugCompactCtx;
+
+// run a single compaction slice, replicate it and reply
+static void _Debug_CompactSlice
+(
+	void *arg
+) {
+	DebugCompactCtx *ctx    = (DebugCompactCtx *)arg;
+	RedisModuleCtx  *rm_ctx = ctx->rm_ctx;
+	GraphContext    *gc     = ctx->gc;
+	Graph           *g      = GraphContext_GetGraph(gc);
+	CompactionCursor cursor = ctx->cursor;
+
+	if(ctx->bc != NULL) {
+		GraphContext_LockForCommit(rm_ctx, gc);
+		GraphContext_MarkWriter(rm_ctx, gc);
+	} else {
+		Graph_AcquireWriteLock(g);
+	}
+
+	uint64_t holes = GraphCompaction_Slice(gc, &ctx->cursor, ctx->budget);
+	bool     flush = Graph_RequiresFlush(g);
+
+	// replicas relocate the same entities
+	RedisModule_Replicate(rm_ctx, "GRAPH.DEBUG", "cclll", "COMPACT",
+			gc->graph_name, (long long)ctx->budget, (long long)cursor.relation,
+			(long long)cursor.row);
+
+	RedisModule_ReplyWithArray(rm_ctx, 3);
+	RedisModule_ReplyWithLongLong(rm_ctx, holes);
+	RedisModule_ReplyWithLongLong(rm_ctx, ctx->cursor.relation);
+	RedisModule_ReplyWithLongLong(rm_ctx, ctx->cursor.row);
+
+	if(ctx->bc != NULL) {
+		GraphContext_UnlockCommit(rm_ctx, gc);
+		RedisGraph_UnblockClient(ctx->bc);
+		RedisModule_FreeThreadSafeContext(rm_ctx);
+	} else {
+		Graph_ReleaseLock(g);
+	}
+
+	if(flush) GraphContext_ScheduleFlush(gc);
+
+	GraphContext_DecreaseRefCount(gc);
+	rm_free(ctx);
+}
+
+// GRAPH.DEBUG COMPACT <graph> <budget> [<relation> <row>]
+// runs a single compaction slice relocating at most budget entities
+// replies with the number of holes left and the scan position
+// to resume from on the next slice
+//
+// the slice runs on the writer thread, serialized with write queries
+// unless the command can't block, e.g. within MULTI or when replicated
+static int Debug_Compact
+(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+) {
+	if(argc != 4 && argc != 6) return RedisModule_WrongArity(ctx);
+
+	long long budget   = 0;
+	long long relation = 0;
+	long long row      = 0;
+
+	if(RedisModule_StringToLongLong(argv[3], &budget) != REDISMODULE_OK ||
+	   budget <= 0) {
+		return RedisModule_ReplyWithError(ctx, "ERR invalid compaction budget");
+	}
+
+	if(argc == 6 &&
+	   (RedisModule_StringToLongLong(argv[4], &relation) != REDISMODULE_OK ||
+		RedisModule_StringToLongLong(argv[5], &row)      != REDISMODULE_OK ||
+		relation < 0 || row < 0)) {
+		return RedisModule_ReplyWithError(ctx, "ERR invalid compaction position");
+	}
+
+	GraphContext *gc = GraphContext_Retrieve(ctx, argv[2], false, false);
+	if(gc == NULL) return REDISMODULE_OK;
+
+	DebugCompactCtx *compact_ctx = rm_malloc(sizeof(DebugCompactCtx));
+	compact_ctx->gc     = gc;
+	compact_ctx->rm_ctx = ctx;
+	compact_ctx->bc     = NULL;
+	compact_ctx->cursor = (CompactionCursor){.relation = relation, .row = row};
+	compact_ctx->budget = budget;
+
+	int flags = RedisModule_GetContextFlags(ctx);
+	if(flags & (REDISMODULE_CTX_FLAGS_REPLICATED |
+				REDISMODULE_CTX_FLAGS_MULTI      |
+				REDISMODULE_CTX_FLAGS_LUA        |
+				REDISMODULE_CTX_FLAGS_DENY_BLOCKING |
+				REDISMODULE_CTX_FLAGS_LOADING)) {
+		_Debug_CompactSlice(compact_ctx);
+		return REDISMODULE_OK;
+	}
+
+	compact_ctx->bc     = RedisGraph_BlockClient(ctx);
+	compact_ctx->rm_ctx = RedisModule_GetThreadSafeContext(compact_ctx->bc);
+
+	if(ThreadPools_AddWorkWriter(_Debug_CompactSlice, compact_ctx, false) != 0) {
+		RedisModule_ReplyWithError(ctx, "Max pending queries exceeded");
+		RedisGraph_UnblockClient(compact_ctx->bc);
+		RedisModule_FreeThreadSafeContext(compact_ctx->rm_ctx);
+		GraphContext_DecreaseRefCount(gc);
+		rm_free(compact_ctx);
+	}
+
+	return REDISMODULE_OK;
+}
+
 int Graph_Debug(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	ASSERT(ctx != NULL);
+
+	if(argc < 2) return RedisModule_WrongArity(ctx);
+
+	const char *sub_cmd = RedisModule_StringPtrLen(argv[1], NULL);
+
+	if(strcmp(sub_cmd, "FRAGMENTATION") == 0) {
+		return Debug_Fragmentation(ctx, argv, argc);
+	}
+
+	if(strcmp(sub_cmd, "COMPACT") == 0) {
+		return Debug_Compact(ctx, argv, argc);
+	}
+
 	RedisModule_ReplicateVerbatim(ctx);
 
-	if(strcmp(RedisModule_StringPtrLen(argv[1], NULL), "AUX") == 0) {
+	if(strcmp(sub_cmd, "AUX") == 0) {
 		Debug_AUX(argv + 1, argc - 1);
 	}
 
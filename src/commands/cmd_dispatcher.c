@@ -252,8 +252,16 @@ int CommandDispatch
 								 is_replicated, compact, timeout, timeout_rw,
 								 received_ts, timer);
 
-		if(ThreadPools_AddWorkReader(handler, context, false) ==
-				THPOOL_QUEUE_FULL) {
+		// queries known to run long are queued on the low priority lane
+		// allowing short queries to overtake them
+		thpool_priority priority = THPOOL_PRIORITY_HIGH;
+		if(query != NULL && GraphContext_ClassifyQuery(gc,
+					RedisModule_StringPtrLen(query, NULL)) == QUERY_CLASS_LONG) {
+			priority = THPOOL_PRIORITY_LOW;
+		}
+
+		if(ThreadPools_AddWorkReaderPriority(handler, context, priority,
+					false) == THPOOL_QUEUE_FULL) {
 			// report an error once our workers thread pool internal queue
 			// is full, this error usually happens when the server is
 			// under heavy load and is unable to catch up
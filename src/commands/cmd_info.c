@@ -7,6 +7,7 @@
 #include "RG.h"
 #include "commands.h"
 #include "../globals.h"
+#include "../graph/graphcontext.h"
 #include "redismodule.h"
 #include "cmd_context.h"
 #include "../util/thpool/pools.h"
@@ -20,9 +21,18 @@
 #define WAIT_DURATION_KEY_NAME      "Wait duration"
 #define RECEIVED_TIMESTAMP_KEY_NAME "Received at"
 #define EXECUTION_DURATION_KEY_NAME "Execution duration"
+#define CACHE_HITS_KEY_NAME         "Hits"
+#define CACHE_MISSES_KEY_NAME       "Misses"
+#define CACHE_EVICTIONS_KEY_NAME    "Evictions"
+#define SHORT_QUERIES_KEY_NAME      "Short queries"
+#define SHORT_WAIT_KEY_NAME         "Short queries avg wait duration"
+#define LONG_QUERIES_KEY_NAME       "Long queries"
+#define LONG_WAIT_KEY_NAME          "Long queries avg wait duration"
 
 #define SUBCOMMAND_NAME_RUNNING_QUERIES "RunningQueries"
 #define SUBCOMMAND_NAME_WAITING_QUERIES "WaitingQueries"
+#define SUBCOMMAND_NAME_PLAN_CACHE      "PlanCache"
+#define SUBCOMMAND_NAME_SCHEDULER       "Scheduler"
 
 //------------------------------------------------------------------------------
 // Info section API
@@ -240,6 +250,90 @@ static void _info_waiting_queries
 	free(cmds);
 }
 
+// handles the "GRAPH.INFO PlanCache" section
+// "GRAPH.INFO PlanCache"
+static void _info_plan_cache
+(
+	RedisModuleCtx *ctx       // redis context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO PlanCache
+	// reply:
+	// "# Plan cache"
+	//     "Hits"
+	//     "Misses"
+	//     "Evictions"
+
+	ASSERT(ctx != NULL);
+
+	//--------------------------------------------------------------------------
+	// sum up cache statistics across all graphs
+	//--------------------------------------------------------------------------
+
+	CacheStats total = {0};
+
+	GraphContext *gc = NULL;
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		CacheStats stats = Cache_GetStats(GraphContext_GetCache(gc));
+
+		total.hits      += stats.hits;
+		total.misses    += stats.misses;
+		total.evictions += stats.evictions;
+
+		GraphContext_DecreaseRefCount(gc);
+	}
+
+	// create a new subsection in the reply
+	Info_AddSection(ctx, "# Plan cache", 6);
+
+	Info_SectionAddEntryLongLong(ctx, CACHE_HITS_KEY_NAME, total.hits);
+	Info_SectionAddEntryLongLong(ctx, CACHE_MISSES_KEY_NAME, total.misses);
+	Info_SectionAddEntryLongLong(ctx, CACHE_EVICTIONS_KEY_NAME,
+			total.evictions);
+}
+
+// handles the "GRAPH.INFO Scheduler" section
+// "GRAPH.INFO Scheduler"
+static void _info_scheduler
+(
+	RedisModuleCtx *ctx       // redis context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO Scheduler
+	// reply:
+	// "# Scheduler"
+	//     "Short queries"
+	//     "Short queries avg wait duration"
+	//     "Long queries"
+	//     "Long queries avg wait duration"
+
+	ASSERT(ctx != NULL);
+
+	// readers pool serves short and long queries on separate priority lanes
+	uint64_t short_n;
+	uint64_t long_n;
+	double   short_wait;
+	double   long_wait;
+
+	ThreadPools_ReadersWaitStats(THPOOL_PRIORITY_HIGH, &short_n, &short_wait);
+	ThreadPools_ReadersWaitStats(THPOOL_PRIORITY_LOW,  &long_n,  &long_wait);
+
+	// create a new subsection in the reply
+	Info_AddSection(ctx, "# Scheduler", 8);
+
+	Info_SectionAddEntryLongLong(ctx, SHORT_QUERIES_KEY_NAME, short_n);
+	Info_SectionAddEntryDouble(ctx, SHORT_WAIT_KEY_NAME,
+			(short_n > 0) ? short_wait / short_n : 0);
+	Info_SectionAddEntryLongLong(ctx, LONG_QUERIES_KEY_NAME, long_n);
+	Info_SectionAddEntryDouble(ctx, LONG_WAIT_KEY_NAME,
+			(long_n > 0) ? long_wait / long_n : 0);
+}
+
 // attempts to find the specified sections of "GRAPH.INFO" and dispatch it
 static void _handle_sections
 (
@@ -253,6 +347,8 @@ static void _handle_sections
 	int section_count = 0;
 	bool running_queries = false;
 	bool waiting_queries = false;
+	bool plan_cache      = false;
+	bool scheduler       = false;
 
 	if(argc == 0) {
 		running_queries = true;
@@ -269,6 +365,14 @@ static void _handle_sections
 					  !strcasecmp(subcmd, SUBCOMMAND_NAME_WAITING_QUERIES)) {
 				waiting_queries = true;
 				section_count++;
+			} else if(!plan_cache &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_PLAN_CACHE)) {
+				plan_cache = true;
+				section_count++;
+			} else if(!scheduler &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_SCHEDULER)) {
+				scheduler = true;
+				section_count++;
 			}
 		}
 	}
@@ -285,11 +389,17 @@ static void _handle_sections
 	if(waiting_queries) {
 		_info_waiting_queries(ctx);
 	}
+	if(plan_cache) {
+		_info_plan_cache(ctx);
+	}
+	if(scheduler) {
+		_info_scheduler(ctx);
+	}
 }
 
 // graph.info command handler
 // GRAPH.INFO [Section [Section ...]]
-// GRAPH.INFO RunningQueries WaitingQueries
+// GRAPH.INFO RunningQueries WaitingQueries PlanCache Scheduler
 int Graph_Info
 (
 	RedisModuleCtx *ctx,       // redis module context
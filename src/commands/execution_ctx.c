@@ -8,6 +8,7 @@
 #include "RG.h"
 #include "../errors.h"
 #include "../query_ctx.h"
+#include "../ast/query_normalizer.h"
 #include "../execution_plan/execution_plan_clone.h"
 
 static ExecutionType _GetExecutionTypeFromAST
@@ -89,55 +90,52 @@ ExecutionCtx *ExecutionCtx_Clone
 	return clone;
 }
 
-// returns the objects and information required for query execution
-// if the query contains error, a ExecutionCtx struct with the AST
-// and Execution plan objects will be NULL
-// and EXECUTION_TYPE_INVALID is returned
-// returns ExecutionCtx populated with the current execution relevant objects
-ExecutionCtx *ExecutionCtx_FromQuery
+// normalize query, lifting its literals into query parameters
+// returns NULL if the query isn't normalized
+static char *_ExecutionCtx_Normalize
 (
-	const char *q  // string representing the query
+	const char *q_str  // query string excluding query parameters
 ) {
-	ASSERT(q != NULL);
-
-	ExecutionCtx *ret;
-	const char *q_str;  // query string excluding query parameters
+	char *params;
+	char *normalized = QueryNormalizer_Normalize(q_str, &params);
 
-	if(unlikely(strlen(q) == 0)) {
-		ErrorCtx_SetError("Error: empty query.");
+	if(normalized == NULL) {
 		return NULL;
 	}
 
-	// parse and validate parameters only
-	// extract query string
-	// return invalid execution context if failed to parse params
-	cypher_parse_result_t *params_parse_result = parse_params(q, &q_str);
+	if(params != NULL) {
+		bool added = AST_AddParams(params);
+		rm_free(params);
 
-	// parameter parsing failed, return NULL
-	if(params_parse_result == NULL) {
-		return NULL;
+		// a lifted literal collides with a user specified parameter
+		if(!added) {
+			ErrorCtx_Clear();
+			rm_free(normalized);
+			return NULL;
+		}
 	}
 
-	// seems like we should be able to free 'params_parse_result'
-	// at this point but this messes up the parsing of the actual query
-
-	// query included only params e.g. 'cypher a=1' was provided
-	if(unlikely(strlen(q_str) == 0)) {
-		parse_result_free(params_parse_result);
-		ErrorCtx_SetError("Error: empty query.");
-		return NULL;
-	}
+	return normalized;
+}
 
-	// update query context with the query without params
-	// (here the QueryInfo is created as well, starting the stage timer)
+// returns the execution ctx of query `q_str`
+// either from cache or by building a new one
+// NULL is returned if the query contains an error
+// on success the parameters parse result is owned by the execution ctx
+static ExecutionCtx *_ExecutionCtx_FromQueryString
+(
+	Cache *cache,                              // execution ctx cache
+	const char *q_str,                         // query string without params
+	cypher_parse_result_t *params_parse_result  // parsed params
+) {
+	// execution time is logged under the plan cache key, allowing
+	// the dispatcher to classify future runs of the query
+	// hash the key now, it is released along with the parsed params
 	QueryCtx *ctx = QueryCtx_GetQueryCtx();
-	ctx->query_data.query_no_params = q_str;
-
-	// get cache
-	Cache *cache = GraphContext_GetCache(QueryCtx_GetGraphCtx());
+	ctx->query_data.key_hash = QueriesLog_HashQueryKey(q_str);
 
 	// see if we already have a cached execution-ctx for given query
-	ret = Cache_GetValue(cache, q_str);
+	ExecutionCtx *ret = Cache_GetValue(cache, q_str);
 
 	//--------------------------------------------------------------------------
 	// cache hit
@@ -158,8 +156,6 @@ ExecutionCtx *ExecutionCtx_FromQuery
 
 	// parser failed
 	if(ast == NULL) {
-		parse_result_free(params_parse_result);  // free parsed params
-
 		// if no error has been set, emit one now
 		if(!ErrorCtx_EncounteredError()) {
 			ErrorCtx_SetError("Error: could not parse query");
@@ -167,9 +163,6 @@ ExecutionCtx *ExecutionCtx_FromQuery
 		return NULL;
 	}
 
-	// associate parameters with AST
-	AST_SetParamsParseResult(ast, params_parse_result);
-
 	ExecutionType exec_type = _GetExecutionTypeFromAST(ast);
 	// in case of valid query
 	// create execution plan, and cache it and the AST
@@ -177,7 +170,12 @@ ExecutionCtx *ExecutionCtx_FromQuery
 		//----------------------------------------------------------------------
 		// build execution-plan
 		//----------------------------------------------------------------------
+		// the planner consults attribute statistics
+		// which writers update while committing, hold the read lock
+		Graph *g = QueryCtx_GetGraph();
+		Graph_AcquireReadLock(g);
 		ExecutionPlan *plan = ExecutionPlan_FromTLS_AST();
+		Graph_ReleaseLock(g);
 
 		// TODO: there must be a better way to understand if the execution-plan
 		// was constructed correctly,
@@ -191,15 +189,97 @@ ExecutionCtx *ExecutionCtx_FromQuery
 			return NULL;
 		}
 
+		// associate parameters with AST
+		AST_SetParamsParseResult(ast, params_parse_result);
+
 		ExecutionCtx *exec_ctx = _ExecutionCtx_New(ast, plan, exec_type);
 		ret = Cache_SetGetValue(cache, q_str, exec_ctx);
 	} else {
+		// associate parameters with AST
+		AST_SetParamsParseResult(ast, params_parse_result);
+
 		ret = _ExecutionCtx_New(ast, NULL, exec_type);
 	}
 
 	return ret;
 }
 
+// returns the objects and information required for query execution
+// if the query contains error, a ExecutionCtx struct with the AST
+// and Execution plan objects will be NULL
+// and EXECUTION_TYPE_INVALID is returned
+// returns ExecutionCtx populated with the current execution relevant objects
+ExecutionCtx *ExecutionCtx_FromQuery
+(
+	const char *q  // string representing the query
+) {
+	ASSERT(q != NULL);
+
+	ExecutionCtx *ret = NULL;
+	const char *q_str;  // query string excluding query parameters
+
+	if(unlikely(strlen(q) == 0)) {
+		ErrorCtx_SetError("Error: empty query.");
+		return NULL;
+	}
+
+	// parse and validate parameters only
+	// extract query string
+	// return invalid execution context if failed to parse params
+	cypher_parse_result_t *params_parse_result = parse_params(q, &q_str);
+
+	// parameter parsing failed, return NULL
+	if(params_parse_result == NULL) {
+		return NULL;
+	}
+
+	// seems like we should be able to free 'params_parse_result'
+	// at this point but this messes up the parsing of the actual query
+
+	// query included only params e.g. 'cypher a=1' was provided
+	if(unlikely(strlen(q_str) == 0)) {
+		parse_result_free(params_parse_result);
+		ErrorCtx_SetError("Error: empty query.");
+		return NULL;
+	}
+
+	// update query context with the query without params
+	// (here the QueryInfo is created as well, starting the stage timer)
+	QueryCtx *ctx = QueryCtx_GetQueryCtx();
+	ctx->query_data.query_no_params = q_str;
+
+	// get cache
+	Cache *cache = GraphContext_GetCache(QueryCtx_GetGraphCtx());
+
+	// queries which differ only by their literals, whitespace or keywords
+	// case share the same normalized form and as such a cached execution-ctx
+	char *normalized = _ExecutionCtx_Normalize(q_str);
+	if(normalized != NULL) {
+		ctx->query_data.query_normalized = normalized;
+		ctx->query_data.query_no_params  = normalized;
+
+		ret = _ExecutionCtx_FromQueryString(cache, normalized,
+				params_parse_result);
+
+		if(ret == NULL) {
+			// fallback to the original query
+			// errors are reported against the query as it was given
+			ErrorCtx_Clear();
+			ctx->query_data.query_no_params = q_str;
+		}
+	}
+
+	if(ret == NULL) {
+		ret = _ExecutionCtx_FromQueryString(cache, q_str, params_parse_result);
+	}
+
+	if(ret == NULL) {
+		parse_result_free(params_parse_result);  // free parsed params
+	}
+
+	return ret;
+}
+
 // free an ExecutionCTX struct and its inner fields
 void ExecutionCtx_Free
 (
@@ -64,6 +64,18 @@
 // effects replication threshold
 #define EFFECTS_THRESHOLD "EFFECTS_THRESHOLD"
 
+// max number of threads scanning on behalf of a single read query
+#define PARALLEL_SCAN_WORKERS "PARALLEL_SCAN_WORKERS"
+
+// min number of nodes a label must have to lay its attributes out in columns
+#define COLUMNAR_MIN_LABEL_SIZE "COLUMNAR_MIN_LABEL_SIZE"
+
+// number of entities relocated by each background compaction slice
+#define COMPACTION_BATCH_SIZE "COMPACTION_BATCH_SIZE"
+
+// number of build side records a hash join holds in memory before spilling
+#define HASH_JOIN_SPILL_THRESHOLD "HASH_JOIN_SPILL_THRESHOLD"
+
 
 //------------------------------------------------------------------------------
 // Configuration defaults
@@ -94,6 +106,10 @@ typedef struct {
 	bool cmd_info_on;                  // If true, the GRAPH.INFO is enabled.
 	uint64_t effects_threshold;        // replicate via effects when runtime exceeds threshold
 	uint32_t max_info_queries_count;   // Maximum number of query info elements.
+	uint64_t parallel_scan_workers;    // max number of threads scanning for a single read query
+	uint64_t columnar_min_label_size;  // min label size for columnar layout, 0 disabled
+	uint64_t compaction_batch_size;    // entities relocated per compaction slice, 0 disabled
+	uint64_t hash_join_spill_threshold; // hash join records held in memory, 0 disabled
 } RG_Config;
 
 RG_Config config; // global module configuration
@@ -436,6 +452,66 @@ static uint64_t Config_effects_threshold_get (void) {
 	return config.effects_threshold;
 }
 
+//------------------------------------------------------------------------------
+// parallel scan workers
+//------------------------------------------------------------------------------
+
+static void Config_parallel_scan_workers_set
+(
+	uint64_t workers
+) {
+	config.parallel_scan_workers = workers;
+}
+
+static uint64_t Config_parallel_scan_workers_get(void) {
+	return config.parallel_scan_workers;
+}
+
+//------------------------------------------------------------------------------
+// columnar min label size
+//------------------------------------------------------------------------------
+
+static void Config_columnar_min_label_size_set
+(
+	uint64_t min_label_size
+) {
+	config.columnar_min_label_size = min_label_size;
+}
+
+static uint64_t Config_columnar_min_label_size_get(void) {
+	return config.columnar_min_label_size;
+}
+
+//------------------------------------------------------------------------------
+// compaction batch size
+//------------------------------------------------------------------------------
+
+static void Config_compaction_batch_size_set
+(
+	uint64_t batch_size
+) {
+	config.compaction_batch_size = batch_size;
+}
+
+static uint64_t Config_compaction_batch_size_get(void) {
+	return config.compaction_batch_size;
+}
+
+//------------------------------------------------------------------------------
+// hash join spill threshold
+//------------------------------------------------------------------------------
+
+static void Config_hash_join_spill_threshold_set
+(
+	uint64_t threshold
+) {
+	config.hash_join_spill_threshold = threshold;
+}
+
+static uint64_t Config_hash_join_spill_threshold_get(void) {
+	return config.hash_join_spill_threshold;
+}
+
 bool Config_Contains_field
 (
 	const char *field_str,
@@ -477,6 +553,14 @@ bool Config_Contains_field
 		f = Config_CMD_INFO_MAX_QUERY_COUNT;
 	} else if (!(strcasecmp(field_str, EFFECTS_THRESHOLD))) {
 		f = Config_EFFECTS_THRESHOLD;
+	} else if (!(strcasecmp(field_str, PARALLEL_SCAN_WORKERS))) {
+		f = Config_PARALLEL_SCAN_WORKERS;
+	} else if (!(strcasecmp(field_str, COLUMNAR_MIN_LABEL_SIZE))) {
+		f = Config_COLUMNAR_MIN_LABEL_SIZE;
+	} else if (!(strcasecmp(field_str, COMPACTION_BATCH_SIZE))) {
+		f = Config_COMPACTION_BATCH_SIZE;
+	} else if (!(strcasecmp(field_str, HASH_JOIN_SPILL_THRESHOLD))) {
+		f = Config_HASH_JOIN_SPILL_THRESHOLD;
 	} else {
 		return false;
 	}
@@ -555,6 +639,22 @@ const char *Config_Field_name
 			name = EFFECTS_THRESHOLD;
 			break;
 
+		case Config_PARALLEL_SCAN_WORKERS:
+			name = PARALLEL_SCAN_WORKERS;
+			break;
+
+		case Config_COLUMNAR_MIN_LABEL_SIZE:
+			name = COLUMNAR_MIN_LABEL_SIZE;
+			break;
+
+		case Config_COMPACTION_BATCH_SIZE:
+			name = COMPACTION_BATCH_SIZE;
+			break;
+
+		case Config_HASH_JOIN_SPILL_THRESHOLD:
+			name = HASH_JOIN_SPILL_THRESHOLD;
+			break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -622,6 +722,18 @@ static void _Config_SetToDefaults(void) {
 
 	// replicate effects if avg change time μs > effects_threshold μs
 	config.effects_threshold = 300 ;
+
+	// read queries are executed by a single thread by default
+	config.parallel_scan_workers = PARALLEL_SCAN_WORKERS_DISABLED;
+
+	// attributes are only stored within each entity's attribute-set by default
+	config.columnar_min_label_size = COLUMNAR_MIN_LABEL_SIZE_DISABLED;
+
+	// deleted entities' positions are only reused by later creations by default
+	config.compaction_batch_size = COMPACTION_BATCH_SIZE_DISABLED;
+
+	// hash joins hold their entire build side in memory by default
+	config.hash_join_spill_threshold = HASH_JOIN_SPILL_THRESHOLD_DISABLED;
 }
 
 int Config_Init
@@ -930,6 +1042,62 @@ bool Config_Option_get
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// parallel scan workers
+		//----------------------------------------------------------------------
+
+		case Config_PARALLEL_SCAN_WORKERS: {
+			va_start(ap, field);
+			uint64_t *workers = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(workers != NULL);
+			(*workers) = Config_parallel_scan_workers_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// columnar min label size
+		//----------------------------------------------------------------------
+
+		case Config_COLUMNAR_MIN_LABEL_SIZE: {
+			va_start(ap, field);
+			uint64_t *min_label_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(min_label_size != NULL);
+			(*min_label_size) = Config_columnar_min_label_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// compaction batch size
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_BATCH_SIZE: {
+			va_start(ap, field);
+			uint64_t *batch_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(batch_size != NULL);
+			(*batch_size) = Config_compaction_batch_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// hash join spill threshold
+		//----------------------------------------------------------------------
+
+		case Config_HASH_JOIN_SPILL_THRESHOLD: {
+			va_start(ap, field);
+			uint64_t *threshold = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(threshold != NULL);
+			(*threshold) = Config_hash_join_spill_threshold_get();
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -1169,6 +1337,58 @@ bool Config_Option_set
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// parallel scan workers
+		//----------------------------------------------------------------------
+
+		case Config_PARALLEL_SCAN_WORKERS: {
+			long long workers;
+			if(!_Config_ParseNonNegativeInteger(val, &workers)) {
+				return false;
+			}
+			Config_parallel_scan_workers_set(workers);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// columnar min label size
+		//----------------------------------------------------------------------
+
+		case Config_COLUMNAR_MIN_LABEL_SIZE: {
+			long long min_label_size;
+			if(!_Config_ParseNonNegativeInteger(val, &min_label_size)) {
+				return false;
+			}
+			Config_columnar_min_label_size_set(min_label_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// compaction batch size
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_BATCH_SIZE: {
+			long long batch_size;
+			if(!_Config_ParseNonNegativeInteger(val, &batch_size)) {
+				return false;
+			}
+			Config_compaction_batch_size_set(batch_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// hash join spill threshold
+		//----------------------------------------------------------------------
+
+		case Config_HASH_JOIN_SPILL_THRESHOLD: {
+			long long threshold;
+			if(!_Config_ParseNonNegativeInteger(val, &threshold)) {
+				return false;
+			}
+			Config_hash_join_spill_threshold_set(threshold);
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
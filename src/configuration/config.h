@@ -15,6 +15,10 @@
 #define QUERY_MEM_CAPACITY_UNLIMITED       0
 #define NODE_CREATION_BUFFER_DEFAULT       16384
 #define DELTA_MAX_PENDING_CHANGES_DEFAULT  10000
+#define PARALLEL_SCAN_WORKERS_DISABLED     0
+#define COLUMNAR_MIN_LABEL_SIZE_DISABLED   0
+#define COMPACTION_BATCH_SIZE_DISABLED     0
+#define HASH_JOIN_SPILL_THRESHOLD_DISABLED 0
 
 typedef enum {
 	Config_TIMEOUT                   = 0,   // timeout value for queries
@@ -33,7 +37,11 @@ typedef enum {
 	Config_CMD_INFO                  = 13,  // toggle on/off the GRAPH.INFO
 	Config_CMD_INFO_MAX_QUERY_COUNT  = 14,  // the max number of info queries count
 	Config_EFFECTS_THRESHOLD         = 15,  // replicate queries via effects
-	Config_END_MARKER                = 16
+	Config_PARALLEL_SCAN_WORKERS     = 16,  // max number of threads scanning for a single read query
+	Config_COLUMNAR_MIN_LABEL_SIZE   = 17,  // min label size for columnar attribute layout
+	Config_COMPACTION_BATCH_SIZE     = 18,  // entities relocated per background compaction slice
+	Config_HASH_JOIN_SPILL_THRESHOLD = 19,  // hash join build side records kept in memory
+	Config_END_MARKER                = 20
 } Config_Option_Field;
 
 // callback function, invoked once configuration changes as a result of
@@ -53,7 +61,11 @@ static const Config_Option_Field RUNTIME_CONFIGS[] = {
 	Config_DELTA_MAX_PENDING_CHANGES,
 	Config_CMD_INFO,
 	Config_CMD_INFO_MAX_QUERY_COUNT,
-	Config_EFFECTS_THRESHOLD
+	Config_EFFECTS_THRESHOLD,
+	Config_PARALLEL_SCAN_WORKERS,
+	Config_COLUMNAR_MIN_LABEL_SIZE,
+	Config_COMPACTION_BATCH_SIZE,
+	Config_HASH_JOIN_SPILL_THRESHOLD
 };
 static const size_t RUNTIME_CONFIG_COUNT = sizeof(RUNTIME_CONFIGS) / sizeof(RUNTIME_CONFIGS[0]);
 
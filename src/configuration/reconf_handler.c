@@ -9,6 +9,7 @@
 #include "util/rmalloc.h"
 #include "reconf_handler.h"
 #include "util/thpool/pools.h"
+#include "graph/property_columns.h"
 
 // handler function invoked when config changes
 void reconf_handler(Config_Option_Field type) {
@@ -51,6 +52,27 @@ void reconf_handler(Config_Option_Field type) {
 			}
 			break;
 
+		//----------------------------------------------------------------------
+		// compaction batch size
+		//----------------------------------------------------------------------
+
+		case Config_COMPACTION_BATCH_SIZE:
+			CronTask_AddCompactGraphs();
+			break;
+
+		//----------------------------------------------------------------------
+		// columnar min label size
+		//----------------------------------------------------------------------
+
+		case Config_COLUMNAR_MIN_LABEL_SIZE:
+			{
+				uint64_t min_label_size;
+				bool res = Config_Option_get(type, &min_label_size);
+				ASSERT(res);
+				PropertyColumns_SetMinLabelSize(min_label_size);
+			}
+			break;
+
         //----------------------------------------------------------------------
         // all other options
         //----------------------------------------------------------------------
@@ -62,6 +62,104 @@ static void* _GetPrivateData
 	return _c->idx;
 }
 
+// compose constraint violation error message
+static void _ReportViolation
+(
+	const UniqueConstraint c,  // violated constraint
+	char **err_msg             // [output] error message
+) {
+	int res;
+	UNUSED(res);
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	SchemaType st = (c->et == GETYPE_NODE) ? SCHEMA_NODE : SCHEMA_EDGE;
+	Schema *s = GraphContext_GetSchemaByID(gc, c->schema_id, st);
+	if(c->et == GETYPE_NODE) {
+		res = asprintf(err_msg, _node_violation_err_msg, Schema_GetName(s));
+	} else {
+		res = asprintf(err_msg, _edge_violation_err_msg, Schema_GetName(s));
+	}
+}
+
+// returns true if node `id` holds values equal to `values`
+// under each of the constrained attributes
+static bool _NodeHoldsValues
+(
+	const UniqueConstraint c,  // constraint
+	const Graph *g,            // graph
+	EntityID id,               // node to inspect
+	SIValue **values           // constrained values
+) {
+	Node n;
+	if(!Graph_GetNode(g, id, &n)) return false;
+
+	const AttributeSet attributes = GraphEntity_GetAttributes((GraphEntity *)&n);
+	for(uint8_t i = 0; i < c->n_attr; i++) {
+		SIValue *v = AttributeSet_Get(attributes, c->attrs[i]);
+		if(v == ATTRIBUTE_NOTFOUND) return false;
+
+		int disjointOrNull = 0;
+		if(SIValue_Compare(*v, *values[i], &disjointOrNull) != 0 ||
+		   disjointOrNull == COMPARED_NULL) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// enforces unique constraint on a node using its native ordered index
+// returns true if no other node shares the node's constrained values
+static bool _EnforceUniqueNodeNative
+(
+	const UniqueConstraint c,  // constraint to enforce
+	OrderedIndex *idx,         // supporting native index
+	const GraphEntity *e       // enforced node
+) {
+	EntityID id = ENTITY_GET_ID(e);
+	const AttributeSet attributes = GraphEntity_GetAttributes(e);
+
+	// validate constrained values
+	SIValue *values[c->n_attr];
+	for(uint8_t i = 0; i < c->n_attr; i++) {
+		values[i] = AttributeSet_Get(attributes, c->attrs[i]);
+
+		// entity satisfies constraint in a vacuous truth manner
+		if(values[i] == ATTRIBUTE_NOTFOUND) return true;
+	}
+
+	// scan nodes sharing the encoding of the first constrained value
+	// values of none indexable types share a single encoding
+	// and numerics beyond 2^53 may share an encoding with their neighbours
+	// as such each candidate's values are compared with the node's values
+	OrderedIndexRange range = (SI_TYPE(*values[0]) & SI_INDEXABLE) ?
+		OrderedIndexRange_Point(c->attrs[0], *values[0]) :
+		OrderedIndexRange_NoneIndexable(c->attrs[0]);
+	OrderedIndexIterator *it = OrderedIndex_Scan(idx, &range, 1);
+
+	bool holds = true;
+	EntityID candidate;
+	const Graph *g = QueryCtx_GetGraph();
+
+	while(holds && OrderedIndexIterator_Next(it, &candidate)) {
+		if(candidate == id) continue;
+
+		// discard candidates missing from the index under the other attributes
+		bool indexed = true;
+		for(uint8_t i = 1; i < c->n_attr && indexed; i++) {
+			indexed = OrderedIndex_Contains(idx, c->attrs[i], *values[i],
+					candidate);
+		}
+
+		holds = !(indexed && _NodeHoldsValues(c, g, candidate, values));
+	}
+
+	OrderedIndexIterator_Free(it);
+	OrderedIndexRange_Free(&range);
+
+	return holds;
+}
+
 // enforces unique constraint on given entity
 // returns true if entity confirms with constraint false otherwise
 bool EnforceUniqueEntity
@@ -80,6 +178,14 @@ bool EnforceUniqueEntity
 	bool    holds   = false;  // return value none-optimistic
 	RSIndex *rs_idx = Index_RSIndex(idx);
 
+	// natively indexed nodes are checked without consulting RediSearch
+	OrderedIndex *ordered = Index_OrderedIndex(idx);
+	if(ordered != NULL) {
+		holds = _EnforceUniqueNodeNative(_c, ordered, e);
+		if(holds == false && err_msg != NULL) _ReportViolation(_c, err_msg);
+		return holds;
+	}
+
 	//--------------------------------------------------------------------------
 	// construct a RediSearch query locating entity
 	//--------------------------------------------------------------------------
@@ -195,19 +301,7 @@ cleanup:
 		}
 	}
 
-	if(holds == false && err_msg != NULL) {
-		int res;
-		UNUSED(res);
-		// entity violates constraint, compose error message
-		GraphContext *gc = QueryCtx_GetGraphCtx();
-		SchemaType st = (_c->et == GETYPE_NODE) ? SCHEMA_NODE : SCHEMA_EDGE;
-		Schema *s = GraphContext_GetSchemaByID(gc, _c->schema_id, st);
-		if(Constraint_GetEntityType(c) == GETYPE_NODE) {
-			res = asprintf(err_msg, _node_violation_err_msg, Schema_GetName(s));
-		} else {
-			res = asprintf(err_msg, _edge_violation_err_msg, Schema_GetName(s));
-		}
-	}
+	if(holds == false && err_msg != NULL) _ReportViolation(_c, err_msg);
 
 	return holds;
 }
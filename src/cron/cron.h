@@ -33,6 +33,9 @@ void Cron_AddRecurringTasks(void);
 // add stream finished queries task
 void CronTask_AddStreamFinishedQueries();
 
+// add graph compaction task
+void CronTask_AddCompactGraphs(void);
+
 // create a new CRON task
 CronTaskHandle Cron_AddTask
 (
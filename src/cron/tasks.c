@@ -8,6 +8,7 @@
 #include "cron.h"
 #include "util/rmalloc.h"
 #include "configuration/config.h"
+#include "tasks/compact_graphs.h"
 #include "tasks/stream_finished_queries.h"
 
 typedef struct RecurringTaskCtx {
@@ -80,8 +81,27 @@ void CronTask_AddStreamFinishedQueries() {
 	}
 }
 
+void CronTask_AddCompactGraphs(void) {
+	//--------------------------------------------------------------------------
+	// add graph compaction task
+	//--------------------------------------------------------------------------
+
+	// make sure compaction is enabled
+	uint64_t batch_size = COMPACTION_BATCH_SIZE_DISABLED;
+	if(Config_Option_get(Config_COMPACTION_BATCH_SIZE, &batch_size) &&
+	   batch_size != COMPACTION_BATCH_SIZE_DISABLED) {
+		// task context is NULL if the task is already scheduled
+		CompactGraphsCtx *ctx = CronTask_newCompactGraphs();
+		if(ctx != NULL) {
+			// the task reschedules itself, reusing its context
+			Cron_AddTask(0, CronTask_compactGraphs, NULL, (void*)ctx);
+		}
+	}
+}
+
 // add recurring tasks
 void Cron_AddRecurringTasks(void) {
 	CronTask_AddStreamFinishedQueries();
+	CronTask_AddCompactGraphs();
 }
 
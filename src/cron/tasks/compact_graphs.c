@@ -0,0 +1,178 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "globals.h"
+#include "cron/cron.h"
+#include "redismodule.h"
+#include "util/rmalloc.h"
+#include "compact_graphs.h"
+#include "configuration/config.h"
+#include "util/thpool/pools.h"
+
+// a graph is compacted once at least 10% of its storage are holes
+// and it holds at least COMPACTION_MIN_HOLES holes
+#define COMPACTION_MIN_HOLES 1024
+#define COMPACTION_HOLES_RATIO 10
+
+// delay between slices while compacting a graph
+#define COMPACTION_SLICE_INTERVAL 10  // 10ms
+
+// delay between checks for fragmented graphs
+#define COMPACTION_IDLE_INTERVAL 1000  // 1sec
+
+// set while the task is scheduled, a single task compacts graphs
+static bool _scheduled = false;
+
+// returns true if graph is fragmented enough to be compacted
+static bool _Fragmented
+(
+	Graph *g
+) {
+	Graph_AcquireReadLock(g);
+
+	uint64_t holes = GraphCompaction_Holes(g);
+	uint64_t slots = Graph_UncompactedNodeCount(g) + Graph_EdgeCount(g) +
+		Graph_DeletedEdgeCount(g);
+
+	Graph_ReleaseLock(g);
+
+	return holes >= COMPACTION_MIN_HOLES &&
+		holes * COMPACTION_HOLES_RATIO >= slots;
+}
+
+// run a single slice over gc and replicate it
+static uint64_t _CompactGraph
+(
+	RedisModuleCtx *rm_ctx,  // redis module context
+	GraphContext *gc,        // graph to compact
+	CompactGraphsCtx *ctx,   // task context
+	uint64_t batch_size      // max number of entities to relocate
+) {
+	Graph *g = GraphContext_GetGraph(gc);
+	CompactionCursor cursor = ctx->cursor;
+
+	// GIL is acquired before the graph's write lock
+	// same as committing queries
+	GraphContext_LockForCommit(rm_ctx, gc);
+	GraphContext_MarkWriter(rm_ctx, gc);
+
+	uint64_t holes = GraphCompaction_Slice(gc, &ctx->cursor, batch_size);
+	bool     flush = Graph_RequiresFlush(g);
+
+	// replicas replay the slice from the same scan position
+	RedisModule_Replicate(rm_ctx, "GRAPH.DEBUG", "cclll", "COMPACT",
+			gc->graph_name, (long long)batch_size, (long long)cursor.relation,
+			(long long)cursor.row);
+
+	GraphContext_UnlockCommit(rm_ctx, gc);
+
+	if(flush) GraphContext_ScheduleFlush(gc);
+
+	return holes;
+}
+
+// compact a single slice of ctx->gc and reschedule the cron task
+// executed on the writer thread, such that slices never interleave with
+// a write query matching without holding the graph lock
+static void _CompactGraphSlice
+(
+	void *pdata  // task context
+) {
+	CompactGraphsCtx *ctx = (CompactGraphsCtx*)pdata;
+	GraphContext     *gc  = ctx->gc;
+
+	uint64_t batch_size = COMPACTION_BATCH_SIZE_DISABLED;
+	Config_Option_get(Config_COMPACTION_BATCH_SIZE, &batch_size);
+
+	// compaction might have been disabled while the slice was queued
+	if(batch_size != COMPACTION_BATCH_SIZE_DISABLED) {
+		RedisModuleCtx *rm_ctx = RedisModule_GetThreadSafeContext(NULL);
+
+		uint64_t holes = _CompactGraph(rm_ctx, gc, ctx, batch_size);
+
+		// holes are only reclaimed once every entity positioned beyond them
+		// is relocated, stop once few holes are left, such that graphs
+		// which keep on deleting entities do not hold on to the task
+		ctx->active = holes >= COMPACTION_MIN_HOLES;
+
+		RedisModule_FreeThreadSafeContext(rm_ctx);
+	}
+
+	if(!ctx->active) {
+		ctx->graph_idx++;
+		ctx->cursor = (CompactionCursor){0};
+	}
+
+	ctx->gc = NULL;
+	GraphContext_DecreaseRefCount(gc);
+
+	Cron_AddTask(COMPACTION_SLICE_INTERVAL, CronTask_compactGraphs, NULL, ctx);
+}
+
+CompactGraphsCtx *CronTask_newCompactGraphs(void) {
+	if(__atomic_test_and_set(&_scheduled, __ATOMIC_SEQ_CST)) return NULL;
+	return rm_calloc(1, sizeof(CompactGraphsCtx));
+}
+
+void CronTask_compactGraphs
+(
+	void *pdata  // task context
+) {
+	ASSERT(pdata != NULL);
+
+	CompactGraphsCtx *ctx = (CompactGraphsCtx*)pdata;
+
+	uint64_t batch_size = COMPACTION_BATCH_SIZE_DISABLED;
+	Config_Option_get(Config_COMPACTION_BATCH_SIZE, &batch_size);
+
+	// compaction disabled, stop rescheduling
+	if(batch_size == COMPACTION_BATCH_SIZE_DISABLED) {
+		rm_free(ctx);
+		__atomic_clear(&_scheduled, __ATOMIC_SEQ_CST);
+		return;
+	}
+
+	uint when = COMPACTION_IDLE_INTERVAL;
+
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+
+	// pick up from where we've left
+	GraphIterator_Seek(&it, ctx->graph_idx);
+
+	// look for a graph to compact
+	GraphContext *gc = NULL;
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		if(ctx->active || _Fragmented(GraphContext_GetGraph(gc))) break;
+
+		// move on to the next graph
+		GraphContext_DecreaseRefCount(gc);
+		ctx->graph_idx++;
+	}
+
+	if(gc != NULL) {
+		// hand the slice over to the writer thread
+		// which reschedules the task once the slice is done
+		ctx->gc = gc;
+		if(ThreadPools_AddWorkWriter(_CompactGraphSlice, ctx, false) == 0) {
+			return;
+		}
+
+		// writer queue is full, retry later
+		ctx->gc = NULL;
+		GraphContext_DecreaseRefCount(gc);
+		when = COMPACTION_SLICE_INTERVAL;
+	} else {
+		// iterator depleted, start over
+		ctx->graph_idx = 0;
+		ctx->active    = false;
+		ctx->cursor    = (CompactionCursor){0};
+	}
+
+	Cron_AddTask(when, CronTask_compactGraphs, NULL, ctx);
+}
+
@@ -0,0 +1,31 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "graph/graph_compaction.h"
+
+// task context
+typedef struct {
+	uint32_t graph_idx;       // index of graph being compacted
+	bool active;              // graph compaction in progress
+	CompactionCursor cursor;  // graph's relocatable edges scan position
+	GraphContext *gc;         // graph compacted by the queued slice
+} CompactGraphsCtx;
+
+// create task context
+// returns NULL if the task is already scheduled
+CompactGraphsCtx *CronTask_newCompactGraphs(void);
+
+// cron task
+// compact fragmented graphs, one slice at a time
+// slices run on the writer thread, serialized with write queries
+// the task reschedules itself for as long as compaction is enabled
+void CronTask_compactGraphs
+(
+	void *pdata  // task context
+);
+
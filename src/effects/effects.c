@@ -424,8 +424,8 @@ void EffectsBuffer_AddCreateEdgeEffect
 	EffectsBuffer_IncEffectCount(buff);
 }
 
-// add a node deletion effect to buffer
-void EffectsBuffer_AddDeleteNodeEffect
+// write a node deletion effect to buffer
+static void EffectsBuffer_WriteDeleteNodeEffect
 (
 	EffectsBuffer *buff,  // effect buffer
 	const Node *node      // node deleted
@@ -436,8 +436,6 @@ void EffectsBuffer_AddDeleteNodeEffect
 	//    node ID
 	//--------------------------------------------------------------------------
 
-	QueryCtx_GetResultSetStatistics()->nodes_deleted++;
-
 	EffectType t = EFFECT_DELETE_NODE;
 	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
 
@@ -447,8 +445,32 @@ void EffectsBuffer_AddDeleteNodeEffect
 	EffectsBuffer_IncEffectCount(buff);
 }
 
-// add a edge deletion effect to buffer
-void EffectsBuffer_AddDeleteEdgeEffect
+// add a node deletion effect to buffer
+void EffectsBuffer_AddDeleteNodeEffect
+(
+	EffectsBuffer *buff,  // effect buffer
+	const Node *node      // node deleted
+) {
+	QueryCtx_GetResultSetStatistics()->nodes_deleted++;
+	EffectsBuffer_WriteDeleteNodeEffect(buff, node);
+}
+
+// add nodes deletion effects to buffer
+void EffectsBuffer_AddDeleteNodesEffect
+(
+	EffectsBuffer *buff,  // effect buffer
+	const Node *nodes,    // nodes deleted
+	uint64_t n            // number of nodes
+) {
+	QueryCtx_GetResultSetStatistics()->nodes_deleted += n;
+
+	for(uint64_t i = 0; i < n; i++) {
+		EffectsBuffer_WriteDeleteNodeEffect(buff, nodes + i);
+	}
+}
+
+// write a edge deletion effect to buffer
+static void EffectsBuffer_WriteDeleteEdgeEffect
 (
 	EffectsBuffer *eb,  // effect buffer
 	const Edge *edge    // edge deleted
@@ -462,8 +484,6 @@ void EffectsBuffer_AddDeleteEdgeEffect
 	//    dest ID
 	//--------------------------------------------------------------------------
 
-	QueryCtx_GetResultSetStatistics()->relationships_deleted++;
-
 	EffectType t = EFFECT_DELETE_EDGE;
 	EffectsBuffer_WriteBytes(&t, sizeof(t), eb);
 
@@ -479,7 +499,31 @@ void EffectsBuffer_AddDeleteEdgeEffect
 	EffectsBuffer_WriteBytes(&dest_id, sizeof(EntityID), eb);
 
 	EffectsBuffer_IncEffectCount(eb);
-};
+}
+
+// add a edge deletion effect to buffer
+void EffectsBuffer_AddDeleteEdgeEffect
+(
+	EffectsBuffer *eb,  // effect buffer
+	const Edge *edge    // edge deleted
+) {
+	QueryCtx_GetResultSetStatistics()->relationships_deleted++;
+	EffectsBuffer_WriteDeleteEdgeEffect(eb, edge);
+}
+
+// add edges deletion effects to buffer
+void EffectsBuffer_AddDeleteEdgesEffect
+(
+	EffectsBuffer *eb,  // effect buffer
+	const Edge *edges,  // edges deleted
+	uint64_t n          // number of edges
+) {
+	QueryCtx_GetResultSetStatistics()->relationships_deleted += n;
+
+	for(uint64_t i = 0; i < n; i++) {
+		EffectsBuffer_WriteDeleteEdgeEffect(eb, edges + i);
+	}
+}
 
 // add an entity update effect to buffer
 static void EffectsBuffer_AddNodeUpdateEffect
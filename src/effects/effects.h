@@ -86,6 +86,22 @@ void EffectsBuffer_AddDeleteEdgeEffect
 	const Edge *edge      // edge deleted
 );
 
+// add nodes deletion effects to buffer
+void EffectsBuffer_AddDeleteNodesEffect
+(
+	EffectsBuffer *buff,  // effect buffer
+	const Node *nodes,    // nodes deleted
+	uint64_t n            // number of nodes
+);
+
+// add edges deletion effects to buffer
+void EffectsBuffer_AddDeleteEdgesEffect
+(
+	EffectsBuffer *buff,  // effect buffer
+	const Edge *edges,    // edges deleted
+	uint64_t n            // number of edges
+);
+
 // add an entity attribute removal effect to buffer
 void EffectsBuffer_AddEntityRemoveAttributeEffect
 (
@@ -445,9 +445,12 @@ ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan) {
 
 	ExecutionPlan_Init(plan);
 
-	Record r = NULL;
-	// Execute the root operation and free the processed Record until the data stream is depleted.
-	while((r = OpBase_Consume(plan->root)) != NULL) ExecutionPlan_ReturnRecord(r->owner, r);
+	uint n = 0;
+	Record batch[OP_BATCH_SIZE];
+	// Execute the root operation and free the processed Records until the data stream is depleted.
+	while((n = OpBase_ConsumeBatch(plan->root, batch, OP_BATCH_SIZE)) > 0) {
+		for(uint i = 0; i < n; i++) ExecutionPlan_ReturnRecord(batch[i]->owner, batch[i]);
+	}
 
 	return QueryCtx_GetResultSet();
 }
@@ -471,6 +474,7 @@ bool ExecutionPlan_Drained(ExecutionPlan *plan) {
 
 static void _ExecutionPlan_Drain(OpBase *root) {
 	root->consume = deplete_consume;
+	root->consumeBatch = NULL;
 	for(int i = 0; i < root->childCount; i++) {
 		_ExecutionPlan_Drain(root->children[i]);
 	}
@@ -490,6 +494,8 @@ void ExecutionPlan_Drain(ExecutionPlan *plan) {
 static void _ExecutionPlan_InitProfiling(OpBase *root) {
 	root->profile = root->consume;
 	root->consume = OpBase_Profile;
+	// profiled operations are consumed one record at a time
+	root->consumeBatch = NULL;
 	root->stats = rm_malloc(sizeof(OpStats));
 	root->stats->profileExecTime = 0;
 	root->stats->profileRecordCount = 0;
@@ -80,3 +80,20 @@ ExecutionPlan *ExecutionPlan_Clone(const ExecutionPlan *template) {
 	return clone;
 }
 
+
+// clones the op tree rooted at `root` into a standalone ExecutionPlan
+// the clone's root is the clone of `root`, ops belonging to other plan
+// segments are cloned along with their segments
+ExecutionPlan *ExecutionPlan_CloneOpTree(const OpBase *root) {
+	ASSERT(root != NULL);
+	// Store the original AST pointer.
+	AST *master_ast = QueryCtx_GetAST();
+
+	dict *old_to_new = HashTableCreate(&def_dt);
+	OpBase *clone_root = _CloneOpTree((OpBase *)root, old_to_new);
+	HashTableRelease(old_to_new);
+
+	// Restore the original AST pointer.
+	QueryCtx_SetAST(master_ast);
+	return (ExecutionPlan *)clone_root->plan;
+}
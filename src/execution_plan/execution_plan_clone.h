@@ -11,3 +11,6 @@
 /* Clones an execution plan */
 ExecutionPlan *ExecutionPlan_Clone(const ExecutionPlan *plan);
 
+
+/* Clones the op tree rooted at `root` into a standalone execution plan */
+ExecutionPlan *ExecutionPlan_CloneOpTree(const OpBase *root);
@@ -59,6 +59,9 @@ void OpBase_Init
 	op->profile  = NULL;
 	op->consume  = consume;
 	op->toString = toString;
+
+	op->consumeBatch  = NULL;
+	op->statsToString = NULL;
 }
 
 inline Record OpBase_Consume
@@ -68,6 +71,28 @@ inline Record OpBase_Consume
 	return op->consume(op);
 }
 
+uint OpBase_ConsumeBatch
+(
+	OpBase *op,
+	Record *batch,
+	uint cap
+) {
+	ASSERT(op    != NULL);
+	ASSERT(batch != NULL);
+
+	if(op->consumeBatch != NULL) return op->consumeBatch(op, batch, cap);
+
+	// op doesn't support batching, pull records one by one
+	uint n = 0;
+	while(n < cap) {
+		Record r = OpBase_Consume(op);
+		if(r == NULL) break;
+		batch[n++] = r;
+	}
+
+	return n;
+}
+
 // mark alias as being modified by operation
 // returns the ID associated with alias
 int OpBase_Modifies
@@ -214,7 +239,10 @@ void OpBase_ToString
 	if(op->toString) op->toString(op, buff);
 	else *buff = sdscatprintf(*buff, "%s", op->name);
 
-	if(op->stats) _OpBase_StatsToString(op, buff);
+	if(op->stats) {
+		_OpBase_StatsToString(op, buff);
+		if(op->statsToString) op->statsToString(op, buff);
+	}
 }
 
 Record OpBase_Profile
@@ -248,6 +276,24 @@ void OpBase_UpdateConsume
 	// otherwise update consume function
 	if(op->profile != NULL) op->profile = consume;
 	else op->consume = consume;
+
+	// a native batch implementation is bound to a specific consume function
+	// drop it, the op is responsible for re-enabling batching if applicable
+	op->consumeBatch = NULL;
+}
+
+void OpBase_UpdateConsumeBatch
+(
+	OpBase *op,
+	fpConsumeBatch consumeBatch
+) {
+	ASSERT(op != NULL);
+
+	// profiled ops are consumed one record at a time
+	// such that per-op statistics remain accurate
+	if(op->profile != NULL) return;
+
+	op->consumeBatch = consumeBatch;
 }
 
 // updates the plan of an operation
@@ -16,6 +16,9 @@
 
 #define OP_REQUIRE_NEW_DATA(opRes) (opRes & (OP_DEPLETED | OP_REFRESH)) > 0
 
+// default number of records exchanged by a single batch consume call
+#define OP_BATCH_SIZE 64
+
 typedef enum {
 	OPType_ALL_NODE_SCAN,
 	OPType_NODE_BY_LABEL_SCAN,
@@ -55,6 +58,7 @@ typedef enum {
 	OPType_OR_APPLY_MULTIPLEXER,
 	OPType_AND_APPLY_MULTIPLEXER,
 	OPType_OPTIONAL,
+	OPType_EXCHANGE,
 } OPType;
 
 typedef enum {
@@ -111,6 +115,7 @@ struct ExecutionPlan;
 typedef void (*fpFree)(struct OpBase *);
 typedef OpResult(*fpInit)(struct OpBase *);
 typedef Record(*fpConsume)(struct OpBase *);
+typedef uint(*fpConsumeBatch)(struct OpBase *, Record *, uint);
 typedef OpResult(*fpReset)(struct OpBase *);
 typedef void (*fpToString)(const struct OpBase *, sds *);
 typedef struct OpBase *(*fpClone)(const struct ExecutionPlan *, const struct OpBase *);
@@ -128,8 +133,10 @@ struct OpBase {
 	fpReset reset;              // Reset operation state.
 	fpClone clone;              // Operation clone.
 	fpConsume consume;          // Produce next record.
+	fpConsumeBatch consumeBatch;  // Produce a batch of records, optional.
 	fpConsume profile;          // Profiled version of consume.
 	fpToString toString;        // Operation string representation.
+	fpToString statsToString;   // Operation specific profiling statistics, optional.
 	const char *name;           // Operation name.
 	int childCount;             // Number of children.
 	bool op_initialized;        // True if the operation has already been initialized.
@@ -170,6 +177,17 @@ Record OpBase_Consume
 	OpBase *op
 );
 
+// consume up to `cap` records from op into `batch`
+// uses the op's native batch implementation when available, otherwise
+// falls back to pulling records one at a time via OpBase_Consume
+// returns the number of records produced, 0 once op is depleted
+uint OpBase_ConsumeBatch
+(
+	OpBase *op,     // op to consume from
+	Record *batch,  // [output] produced records
+	uint cap        // max number of records to produce
+);
+
 // profile op
 Record OpBase_Profile
 (
@@ -261,6 +279,14 @@ void OpBase_UpdateConsume
 	fpConsume consume
 );
 
+// update operation batch consume function
+// a NULL batch consume reverts the op to the record-at-a-time path
+void OpBase_UpdateConsumeBatch
+(
+	OpBase *op,
+	fpConsumeBatch consumeBatch
+);
+
 // updates the plan of an operation
 void OpBase_BindOpToPlan
 (
@@ -14,30 +14,12 @@
 // forward declarations
 static void AggregateFree(OpBase *opBase);
 static Record AggregateConsume(OpBase *opBase);
+static uint AggregateConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpResult AggregateReset(OpBase *opBase);
 static OpBase *AggregateClone(const ExecutionPlan *plan, const OpBase *opBase);
 
-// fake hash function
-// hash of key is simply key
-static uint64_t _id_hash
-(
-	const void *key
-) {
-	return ((uint64_t)key);
-}
-
-// hashtable entry free callback
-static void freeCallback
-(
-	dict *d,
-	void *val
-) {
-	Group_Free((Group*)val);
-}
-
-// hashtable callbacks
-static dictType _dt = { _id_hash, NULL, NULL, NULL, NULL, freeCallback, NULL,
-	NULL, NULL, NULL};
+// initial number of groups to accommodate
+#define GROUP_TABLE_INITIAL_CAP 1024
 
 // migrate each expression projected by this operation to either
 // the array of keys or the array of aggregate functions as appropriate
@@ -63,51 +45,27 @@ static void _migrate_expressions
 	op->aggregate_count = array_len(op->aggregate_exps);
 }
 
-// clone all aggregate expression templates to associate with a new group
-static inline AR_ExpNode **_build_aggregate_exps
-(
-	OpAggregate *op
-) {
-	AR_ExpNode **agg_exps =
-		rm_malloc(op->aggregate_count * sizeof(AR_ExpNode *));
-
-	for(uint i = 0; i < op->aggregate_count; i++) {
-		agg_exps[i] = AR_EXP_Clone(op->aggregate_exps[i]);
-	}
-
-	return agg_exps;
-}
-
-// build a new group key from the SIValue results of non-aggregate expressions
-static inline SIValue *_build_group_key
-(
-	SIValue *keys,
-	uint n
-) {
-	// TODO: might be expensive incase we're generating lots of groups
-	SIValue *group_keys = rm_malloc(sizeof(SIValue) * n);
-
-	for(uint i = 0; i < n; i++) {
-		SIValue key = SI_TransferOwnership(keys + i);
-		SIValue_Persist(&key);
-		group_keys[i] = key;
-	}
-
-	return group_keys;
-}
-
 static Group *_CreateGroup
 (
 	OpAggregate *op,
+	XXH64_hash_t hash,
 	SIValue *keys
 ) {
-	// create a new group, clone group keys
-	SIValue *group_keys = _build_group_key(keys, op->key_count);
+	// take ownership over group keys
+	for(uint i = 0; i < op->key_count; i++) {
+		SIValue key = SI_TransferOwnership(keys + i);
+		SIValue_Persist(&key);
+		keys[i] = key;
+	}
 
 	// get a fresh copy of aggregation functions
-	AR_ExpNode **agg_exps = _build_aggregate_exps(op);
+	AR_ExpNode *agg_exps[op->aggregate_count];
+	for(uint i = 0; i < op->aggregate_count; i++) {
+		agg_exps[i] = AR_EXP_Clone(op->aggregate_exps[i]);
+	}
 
-	return Group_New(group_keys, op->key_count, agg_exps, op->aggregate_count);
+	// keys and aggregation functions are copied into the group table
+	return GroupTable_Add(op->groups, hash, keys, agg_exps);
 }
 
 static XXH64_hash_t _ComputeGroupKey
@@ -146,25 +104,17 @@ static Group *_GetGroup
 	SIValue keys[op->key_count];
 	XXH64_hash_t hash = _ComputeGroupKey(keys, op, r);
 
-	// lookup group by hashed key
-	Group *g;
-	dictEntry *existing;
-	dictEntry *entry = HashTableAddRaw(op->groups, (void *)hash, &existing);
-	if(entry == NULL) {
+	// lookup group by hashed key, keys are compared on hash match
+	Group *g = GroupTable_Lookup(op->groups, hash, keys);
+	if(g != NULL) {
 		// group exists
-		ASSERT(existing != NULL);
-
 		// free computed keys
 		for(uint i = 0; i < op->key_count; i++) {
 			SIValue_Free(keys[i]);
 		}
-
-		g = HashTableGetVal(existing);
 	} else {
-		// entry missing
 		// group does not exists, create it
-		g = _CreateGroup(op, keys);
-		HashTableSetVal(op->groups, entry, g);
+		g = _CreateGroup(op, hash, keys);
 	}
 
 	return g;
@@ -193,13 +143,12 @@ static Record _handoff
 (
 	OpAggregate *op
 ) {
-	dictEntry *entry = HashTableNext(op->group_iter);
-	if(entry == NULL) {
+	if(op->group_idx == GroupTable_Count(op->groups)) {
 		return NULL;
 	}
 
 	Record   r    = OpBase_CreateRecord((OpBase*)op);
-	Group   *g    = (Group*)HashTableGetVal(entry);
+	Group   *g    = GroupTable_GetGroup(op->groups, op->group_idx++);
 	SIValue *keys = g->keys;
 
 	// add all projected keys to the Record
@@ -229,22 +178,22 @@ OpBase *NewAggregateOp
 ) {
 	OpAggregate *op = rm_malloc(sizeof(OpAggregate));
 
-	op->groups               = HashTableCreate(&_dt);
-	op->group_iter           = NULL;
+	op->group_idx            = 0;
+	op->emitting             = false;
 
 	OpBase_Init((OpBase *)op, OPType_AGGREGATE, "Aggregate", NULL,
 			AggregateConsume, AggregateReset, NULL, AggregateClone,
 			AggregateFree, false, plan);
-
-	// expand hashtable to 2048 slots
-	int res = HashTableExpand(op->groups, 2048);
-	ASSERT(res == DICT_OK);
+	OpBase_UpdateConsumeBatch((OpBase *)op, AggregateConsumeBatch);
 
 	// migrate each expression to the keys array or
 	// the aggregations array as appropriate
 	_migrate_expressions(op, exps);
 	array_free(exps);
 
+	op->groups = GroupTable_New(op->key_count, op->aggregate_count,
+			GROUP_TABLE_INITIAL_CAP);
+
 	// the projected record will associate values with their resolved name
 	// to ensure that space is allocated for each entry
 	op->record_offsets = array_new(uint, op->aggregate_count + op->key_count);
@@ -269,7 +218,7 @@ static Record AggregateConsume
 	OpBase *opBase
 ) {
 	OpAggregate *op = (OpAggregate *)opBase;
-	if(op->group_iter != NULL) {
+	if(op->emitting) {
 		return _handoff(op);
 	}
 
@@ -282,8 +231,10 @@ static Record AggregateConsume
 	} else {
 		OpBase *child = op->op.children[0];
 		// eager consumption!
-		while((r = OpBase_Consume(child))) {
-			_aggregateRecord(op, r);
+		uint n;
+		Record batch[OP_BATCH_SIZE];
+		while((n = OpBase_ConsumeBatch(child, batch, OP_BATCH_SIZE)) > 0) {
+			for(uint i = 0; i < n; i++) _aggregateRecord(op, batch[i]);
 		}
 	}
 
@@ -291,7 +242,7 @@ static Record AggregateConsume
 	// does aggregation contains keys?
 	// e.g.
 	// MATCH (n:N) WHERE n.noneExisting = 2 RETURN count(n)
-	if(HashTableElemCount(op->groups) == 0 && op->key_count == 0) {
+	if(GroupTable_Count(op->groups) == 0 && op->key_count == 0) {
 
 		// no data was processed and aggregation doesn't have a key
 		// in this case we want to return aggregation default value
@@ -315,32 +266,55 @@ static Record AggregateConsume
 		OpBase_DeleteRecord(r);
 	}
 
-	// create group iterator
-	op->group_iter = HashTableGetIterator(op->groups);
+	// emit groups
+	op->emitting = true;
 
 	return _handoff(op);
 }
 
-static OpResult AggregateReset
+// emits up to cap group records
+static uint AggregateConsumeBatch
 (
-	OpBase *opBase
+	OpBase *opBase,
+	Record *batch,
+	uint cap
 ) {
 	OpAggregate *op = (OpAggregate *)opBase;
 
-	if(op->group_iter != NULL) {
-		HashTableReleaseIterator(op->group_iter);
-		op->group_iter = NULL;
+	// first call, aggregate child records and emit the first group
+	if(!op->emitting) {
+		Record r = AggregateConsume(opBase);
+		if(r == NULL) return 0;
+		batch[0] = r;
+		if(cap == 1) return 1;
+		return 1 + AggregateConsumeBatch(opBase, batch + 1, cap - 1);
 	}
 
-	// re-create hashtable
-	unsigned long elem_count = HashTableElemCount(op->groups);
-	HashTableRelease(op->groups);
+	uint n = 0;
+	while(n < cap) {
+		Record r = _handoff(op);
+		if(r == NULL) break;
+		batch[n++] = r;
+	}
 
-	op->groups = HashTableCreate(&_dt);
+	return n;
+}
 
-	// expand hashtable to previous element count
-	int res = HashTableExpand(op->groups, elem_count);
-	ASSERT(res == DICT_OK);
+static OpResult AggregateReset
+(
+	OpBase *opBase
+) {
+	OpAggregate *op = (OpAggregate *)opBase;
+
+	op->group_idx = 0;
+	op->emitting  = false;
+
+	// re-create group table, sized to previous group count
+	uint64_t group_count = GroupTable_Count(op->groups);
+	GroupTable_Free(op->groups);
+
+	op->groups = GroupTable_New(op->key_count, op->aggregate_count,
+			group_count);
 
 	return OP_OK;
 }
@@ -404,11 +378,6 @@ static void AggregateFree
 		return;
 	}
 
-	if(op->group_iter) {
-		HashTableReleaseIterator(op->group_iter);
-		op->group_iter = NULL;
-	}
-
 	if(op->key_exps) {
 		for(uint i = 0; i < op->key_count; i++) {
 			AR_EXP_Free(op->key_exps[i]);
@@ -426,7 +395,7 @@ static void AggregateFree
 	}
 
 	if(op->groups) {
-		HashTableRelease(op->groups);
+		GroupTable_Free(op->groups);
 		op->groups = NULL;
 	}
 
@@ -7,9 +7,8 @@
 #pragma once
 
 #include "op.h"
-#include "../../util/dict.h"
 #include "../execution_plan.h"
-#include "../../grouping/group.h"
+#include "../../grouping/group_table.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
 typedef struct {
@@ -17,8 +16,9 @@ typedef struct {
 	uint *record_offsets;         // record IDs for key and aggregate exps
 	AR_ExpNode **key_exps;        // array of expressions used to calculate the group key
 	AR_ExpNode **aggregate_exps;  // array of expressions that aggregate data for each key
-	dict *groups;                 // map of all groups built by this operation
-	dictIterator *group_iter;     // iterator for walking all groups
+	GroupTable *groups;           // map of all groups built by this operation
+	uint64_t group_idx;           // index of next group to emit
+	bool emitting;                // aggregation done, emitting groups
 	uint key_count;               // number of key expressions
 	uint aggregate_count;         // number of aggregating expressions
 } OpAggregate;
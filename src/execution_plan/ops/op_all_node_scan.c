@@ -11,6 +11,7 @@
 /* Forward declarations. */
 static OpResult AllNodeScanInit(OpBase *opBase);
 static Record AllNodeScanConsume(OpBase *opBase);
+static uint AllNodeScanConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static Record AllNodeScanConsumeFromChild(OpBase *opBase);
 static OpResult AllNodeScanReset(OpBase *opBase);
 static OpBase *AllNodeScanClone(const ExecutionPlan *plan, const OpBase *opBase);
@@ -24,6 +25,8 @@ OpBase *NewAllNodeScanOp(const ExecutionPlan *plan, const char *alias) {
 	AllNodeScan *op = rm_malloc(sizeof(AllNodeScan));
 	op->iter = NULL;
 	op->alias = alias;
+	op->id_start = 0;
+	op->id_end = UINT64_MAX;
 	op->child_record = NULL;
 
 	// Set our Op operations
@@ -34,10 +37,28 @@ OpBase *NewAllNodeScanOp(const ExecutionPlan *plan, const char *alias) {
 	return (OpBase *)op;
 }
 
+void AllNodeScanOp_SetIDRange(AllNodeScan *op, NodeID start, NodeID end) {
+	ASSERT(op->op.childCount == 0);
+
+	op->id_start = start;
+	op->id_end = end;
+
+	// op already initialized, replace iterator
+	if(op->iter) {
+		DataBlockIterator_Free(op->iter);
+		op->iter = Graph_ScanNodesRange(QueryCtx_GetGraph(), start, end);
+	}
+}
+
 static OpResult AllNodeScanInit(OpBase *opBase) {
 	AllNodeScan *op = (AllNodeScan *)opBase;
-	if(opBase->childCount > 0) OpBase_UpdateConsume(opBase, AllNodeScanConsumeFromChild);
-	else op->iter = Graph_ScanNodes(QueryCtx_GetGraph());
+	if(opBase->childCount > 0) {
+		OpBase_UpdateConsume(opBase, AllNodeScanConsumeFromChild);
+	} else {
+		op->iter = Graph_ScanNodesRange(QueryCtx_GetGraph(), op->id_start,
+				op->id_end);
+		OpBase_UpdateConsumeBatch(opBase, AllNodeScanConsumeBatch);
+	}
 	return OP_OK;
 }
 
@@ -89,6 +110,23 @@ static Record AllNodeScanConsume(OpBase *opBase) {
 	return r;
 }
 
+static uint AllNodeScanConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	AllNodeScan *op = (AllNodeScan *)opBase;
+
+	uint n = 0;
+	Node node = GE_NEW_NODE();
+	while(n < cap) {
+		node.attributes = DataBlockIterator_Next(op->iter, &node.id);
+		if(node.attributes == NULL) break;
+
+		Record r = OpBase_CreateRecord(opBase);
+		Record_AddNode(r, op->nodeRecIdx, node);
+		batch[n++] = r;
+	}
+
+	return n;
+}
+
 static OpResult AllNodeScanReset(OpBase *op) {
 	AllNodeScan *allNodeScan = (AllNodeScan *)op;
 	if(allNodeScan->iter) DataBlockIterator_Reset(allNodeScan->iter);
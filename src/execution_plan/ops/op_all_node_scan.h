@@ -20,8 +20,13 @@ typedef struct {
 	const char *alias;          /* Alias of the node being scanned by this op. */
 	uint nodeRecIdx;
 	DataBlockIterator *iter;
+	NodeID id_start;            /* Scan nodes with ID >= id_start. */
+	NodeID id_end;              /* Scan nodes with ID < id_end. */
 	Record child_record;        /* The Record this op acts on if it is not a tap. */
 } AllNodeScan;
 
 OpBase *NewAllNodeScanOp(const ExecutionPlan *plan, const char *alias);
 
+/* Restrict a tap scan to nodes with IDs within [start, end). */
+void AllNodeScanOp_SetIDRange(AllNodeScan *op, NodeID start, NodeID end);
+
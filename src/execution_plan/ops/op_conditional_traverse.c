@@ -9,12 +9,18 @@
 #include "shared/print_functions.h"
 #include "../../query_ctx.h"
 
-// default number of records to accumulate before traversing
+// initial number of records to accumulate before traversing
 #define BATCH_SIZE 16
+// max number of records to accumulate before traversing
+#define MAX_BATCH_SIZE 2048
+// max number of expected entries in a single traversal result
+// bounds the memory consumed by the result matrix M
+#define MAX_BATCH_OUTPUT 65536
 
 /* Forward declarations. */
 static OpResult CondTraverseInit(OpBase *opBase);
 static Record CondTraverseConsume(OpBase *opBase);
+static uint CondTraverseConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpResult CondTraverseReset(OpBase *opBase);
 static OpBase *CondTraverseClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void CondTraverseFree(OpBase *opBase);
@@ -23,6 +29,44 @@ static void CondTraverseToString(const OpBase *ctx, sds *buf) {
 	TraversalToString(ctx, buf, ((const OpCondTraverse *)ctx)->ae);
 }
 
+static void CondTraverseStatsToString(const OpBase *ctx, sds *buf) {
+	const OpCondTraverse *op = (const OpCondTraverse *)ctx;
+	*buf = sdscatprintf(*buf, ", Batches: %u, Batch size: %u, Max batch size: %u",
+			op->batch_count, op->record_cap, op->max_batch);
+}
+
+// double the batch size as long as the expected traversal output
+// remains within bounds
+// called once all tuples of the previous batch were consumed
+static void _grow_batch(OpCondTraverse *op) {
+	// previous batch wasn't full, child is about to deplete
+	if(op->record_count < op->record_cap) return;
+
+	// reached max batch size
+	if(op->record_cap >= op->batch_limit) return;
+
+	uint cap = MIN(op->record_cap * 2, op->batch_limit);
+
+	// estimate traversal output according to the observed density
+	double density = (double)op->output_count / op->record_count;
+	if(cap * density > MAX_BATCH_OUTPUT) return;
+
+	op->records = rm_realloc(op->records, cap * sizeof(Record));
+	op->record_cap = cap;
+
+	// resize filter and result matrices to accommodate the larger batch
+	if(op->F != NULL) {
+		GrB_Index ncols;
+		GrB_Info info = RG_Matrix_ncols(&ncols, op->F);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = RG_Matrix_resize(op->F, cap, ncols);
+		ASSERT(info == GrB_SUCCESS);
+		info = RG_Matrix_resize(op->M, cap, ncols);
+		ASSERT(info == GrB_SUCCESS);
+	}
+}
+
 static void _populate_filter_matrix(OpCondTraverse *op) {
 	GrB_Matrix FM = RG_MATRIX_M(op->F);
 
@@ -66,6 +110,13 @@ void _traverse(OpCondTraverse *op) {
 	// evaluate expression
 	AlgebraicExpression_Eval(op->ae, op->M);
 
+	// track traversal output for batch sizing
+	GrB_Info info = RG_Matrix_nvals(&op->output_count, op->M);
+	ASSERT(info == GrB_SUCCESS);
+
+	op->batch_count++;
+	op->max_batch = MAX(op->max_batch, op->record_count);
+
 	RG_MatrixTupleIter_attach(&op->iter, op->M);
 }
 
@@ -77,15 +128,18 @@ OpBase *NewCondTraverseOp
 ) {
 	OpCondTraverse *op = rm_calloc(sizeof(OpCondTraverse), 1);
 
-	op->ae         = ae;
-	op->graph      = g;
-	op->record_cap = BATCH_SIZE;
+	op->ae          = ae;
+	op->graph       = g;
+	op->record_cap  = BATCH_SIZE;
+	op->batch_limit = MAX_BATCH_SIZE;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_CONDITIONAL_TRAVERSE,
 			"Conditional Traverse", CondTraverseInit, CondTraverseConsume,
 			CondTraverseReset, CondTraverseToString, CondTraverseClone,
 			CondTraverseFree, false, plan);
+	OpBase_UpdateConsumeBatch((OpBase *)op, CondTraverseConsumeBatch);
+	op->op.statsToString = CondTraverseStatsToString;
 
 	bool aware = OpBase_Aware((OpBase *)op, AlgebraicExpression_Src(ae),
 			&op->srcNodeIdx);
@@ -109,23 +163,51 @@ OpBase *NewCondTraverseOp
 
 static OpResult CondTraverseInit(OpBase *opBase) {
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
-	// Create 'records' with this Init function as 'record_cap'
+	// Create 'records' with this Init function as 'batch_limit'
 	// might be set during optimization time (applyLimit)
-	// If cap greater than BATCH_SIZE is specified,
-	// use BATCH_SIZE as the value.
-	if(op->record_cap > BATCH_SIZE) op->record_cap = BATCH_SIZE;
-	op->records = rm_calloc(op->record_cap, sizeof(Record));
+	// batches start at BATCH_SIZE records and grow up to 'batch_limit'
+	op->batch_limit = MIN(op->batch_limit, MAX_BATCH_SIZE);
+	op->record_cap  = MIN(op->batch_limit, BATCH_SIZE);
+	op->records     = rm_calloc(op->record_cap, sizeof(Record));
 
 	return OP_OK;
 }
 
-/* Each call to CondTraverseConsume emits a Record containing the
- * traversal's endpoints and, if required, an edge.
- * Returns NULL once all traversals have been performed. */
-static Record CondTraverseConsume(OpBase *opBase) {
-	OpCondTraverse *op = (OpCondTraverse *)opBase;
+// refill op->records with up to record_cap records from child
+// child records are drawn in batches
+static void _pull_records(OpCondTraverse *op) {
 	OpBase *child = op->op.children[0];
+	op->record_count = 0;
+
+	while(op->record_count < op->record_cap) {
+		// request exactly the number of missing records
+		// such that no more records are drawn from child than required
+		Record *batch = op->records + op->record_count;
+		uint n = OpBase_ConsumeBatch(child, batch,
+				op->record_cap - op->record_count);
 
+		// child depleted
+		if(n == 0) break;
+
+		for(uint i = 0; i < n; i++) {
+			Record childRecord = batch[i];
+			if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
+				/* The child Record may not contain the source node in scenarios like
+				 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
+				OpBase_DeleteRecord(childRecord);
+				continue;
+			}
+
+			// Store received record.
+			Record_PersistScalars(childRecord);
+			op->records[op->record_count++] = childRecord;
+		}
+	}
+}
+
+/* Emits a Record containing the traversal's endpoints and, if required, an edge.
+ * Returns NULL once all traversals have been performed. */
+static inline Record _CondTraverse_Next(OpCondTraverse *op) {
 	/* If we're required to update an edge and have one queued, we can return early.
 	 * Otherwise, try to get a new pair of source and destination nodes. */
 	if(op->r         != NULL  &&
@@ -151,24 +233,8 @@ static Record CondTraverseConsume(OpBase *opBase) {
 		}
 
 		// Ask child operations for data.
-		for(op->record_count = 0; op->record_count < op->record_cap; op->record_count++) {
-			Record childRecord = OpBase_Consume(child);
-			// If the Record is NULL, the child has been depleted.
-			if(childRecord == NULL) {
-				break;
-			}
-			if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
-				/* The child Record may not contain the source node in scenarios like
-				 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
-				OpBase_DeleteRecord(childRecord);
-				op->record_count--;
-				continue;
-			}
-
-			// Store received record.
-			Record_PersistScalars(childRecord);
-			op->records[op->record_count] = childRecord;
-		}
+		_grow_batch(op);
+		_pull_records(op);
 
 		// No data.
 		if(op->record_count == 0) return NULL;
@@ -194,6 +260,27 @@ static Record CondTraverseConsume(OpBase *opBase) {
 	return OpBase_DeepCloneRecord(op->r);
 }
 
+/* Each call to CondTraverseConsume emits a Record containing the
+ * traversal's endpoints and, if required, an edge.
+ * Returns NULL once all traversals have been performed. */
+static Record CondTraverseConsume(OpBase *opBase) {
+	return _CondTraverse_Next((OpCondTraverse *)opBase);
+}
+
+// emits up to cap traversal records
+static uint CondTraverseConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	OpCondTraverse *op = (OpCondTraverse *)opBase;
+
+	uint n = 0;
+	while(n < cap) {
+		Record r = _CondTraverse_Next(op);
+		if(r == NULL) break;
+		batch[n++] = r;
+	}
+
+	return n;
+}
+
 static OpResult CondTraverseReset(OpBase *ctx) {
 	OpCondTraverse *op = (OpCondTraverse *)ctx;
 
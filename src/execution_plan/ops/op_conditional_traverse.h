@@ -25,7 +25,11 @@ typedef struct {
 	int srcNodeIdx;             // Source node index into record.
 	int destNodeIdx;            // Destination node index into record.
 	uint record_count;          // Number of held records.
-	uint record_cap;            // Max number of records to process.
+	uint record_cap;            // Current batch size, number of records to process.
+	uint batch_limit;           // Max batch size, bounded by downstream LIMIT.
+	uint batch_count;           // Number of batches traversed.
+	uint max_batch;             // Largest batch traversed.
+	GrB_Index output_count;     // Number of entries produced by last traversal.
 	Record *records;            // Array of records.
 	Record r;                   // Currently selected record.
 } OpCondTraverse;
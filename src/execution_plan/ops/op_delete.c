@@ -14,6 +14,10 @@
 
 #include <stdlib.h>
 
+// min number of deleted nodes for which incident edges are collected
+// in bulk using matrix operations rather than node by node
+#define BULK_DELETE_THRESHOLD 256
+
 // forward declarations
 static Record DeleteConsume(OpBase *opBase);
 static OpBase *DeleteClone(const ExecutionPlan *plan, const OpBase *opBase);
@@ -25,7 +29,28 @@ static int entity_cmp
 	const GraphEntity *a,
 	const GraphEntity *b
 ) {
-	return ENTITY_GET_ID(a) - ENTITY_GET_ID(b);
+	EntityID x = ENTITY_GET_ID(a);
+	EntityID y = ENTITY_GET_ID(b);
+	return (x > y) - (x < y);
+}
+
+// returns true if node ID is one of the sorted distinct nodes
+static bool _NodeDeleted
+(
+	const Node *nodes,  // sorted nodes
+	uint n,             // number of nodes
+	NodeID id           // node ID to look for
+) {
+	uint lo = 0;
+	uint hi = n;
+	while(lo < hi) {
+		uint mid = lo + (hi - lo) / 2;
+		NodeID x = ENTITY_GET_ID(nodes + mid);
+		if(x == id) return true;
+		if(x < id) lo = mid + 1;
+		else hi = mid;
+	}
+	return false;
 }
 
 static void _DeleteEntities
@@ -68,13 +93,22 @@ static void _DeleteEntities
 		}
 
 		array_append(distinct_nodes, *n);
+	}
+
+	node_count = array_len(distinct_nodes);
 
+	// when deleting many nodes, their edges are collected in bulk
+	// once explicitly deleted edges are deduplicated
+	bool bulk = node_count >= BULK_DELETE_THRESHOLD;
+
+	if(!bulk) {
 		// mark node's edges for deletion
-		Graph_GetNodeEdges(g, n, GRAPH_EDGE_DIR_BOTH, GRAPH_NO_RELATION,
-				&op->deleted_edges);
+		for(uint i = 0; i < node_count; i++) {
+			Graph_GetNodeEdges(g, distinct_nodes + i, GRAPH_EDGE_DIR_BOTH,
+					GRAPH_NO_RELATION, &op->deleted_edges);
+		}
 	}
 
-	node_count = array_len(distinct_nodes);
 	edge_count = array_len(op->deleted_edges);
 
 	//--------------------------------------------------------------------------
@@ -100,9 +134,25 @@ static void _DeleteEntities
 			continue;
 		}
 
+		// skip edges which are about to be collected in bulk
+		if(bulk) {
+			NodeID src  = Edge_GetSrcNodeID(e);
+			NodeID dest = Edge_GetDestNodeID(e);
+			if(_NodeDeleted(distinct_nodes, node_count, src) ||
+			   _NodeDeleted(distinct_nodes, node_count, dest)) {
+				continue;
+			}
+		}
+
 		array_append(distinct_edges, *e);
 	}
 
+	if(bulk) {
+		// mark nodes edges for deletion
+		// each edge is collected once, no need to deduplicate
+		Graph_GetNodesEdges(g, distinct_nodes, node_count, &distinct_edges);
+	}
+
 	edge_count = array_len(distinct_edges);
 
 	if((node_count + edge_count) > 0) {
@@ -0,0 +1,536 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "op_exchange.h"
+#include "op_all_node_scan.h"
+#include "op_node_by_label_scan.h"
+#include "../../errors.h"
+#include "../../util/arr.h"
+#include "../../util/thpool/pools.h"
+#include "../../ast/ast_shared.h"
+#include "../../configuration/config.h"
+#include "../execution_plan_clone.h"
+#include "../../util/range/unsigned_range.h"
+
+// forward declarations
+static OpResult ExchangeInit(OpBase *opBase);
+static Record ExchangeConsume(OpBase *opBase);
+static uint ExchangeConsumeBatch(OpBase *opBase, Record *batch, uint cap);
+static Record ExchangeSerialConsume(OpBase *opBase);
+static uint ExchangeSerialConsumeBatch(OpBase *opBase, Record *batch, uint cap);
+static OpResult ExchangeReset(OpBase *opBase);
+static OpBase *ExchangeClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void ExchangeFree(OpBase *opBase);
+
+OpBase *NewExchangeOp
+(
+	const ExecutionPlan *plan
+) {
+	OpExchange *op = rm_calloc(1, sizeof(OpExchange));
+
+	// set our Op operations
+	OpBase_Init((OpBase *)op, OPType_EXCHANGE, "Exchange", ExchangeInit,
+			ExchangeConsume, ExchangeReset, NULL, ExchangeClone, ExchangeFree,
+			false, plan);
+
+	return (OpBase *)op;
+}
+
+bool ExchangeOp_SplittableScan
+(
+	const OpBase *op
+) {
+	ASSERT(op != NULL);
+
+	if(op->childCount != 0) return false;
+
+	return (op->type == OPType_ALL_NODE_SCAN ||
+			op->type == OPType_NODE_BY_LABEL_SCAN);
+}
+
+//------------------------------------------------------------------------------
+// run
+//------------------------------------------------------------------------------
+
+static ExchangeRun *_ExchangeRun_New
+(
+	OpExchange *op,
+	uint refs
+) {
+	ExchangeRun *run = rm_calloc(1, sizeof(ExchangeRun));
+
+	run->exchange     = op;
+	run->morsel_count = op->morsel_count;
+	run->next_worker  = 1;  // first worker is executed inline
+	run->refs         = refs;
+
+	pthread_mutex_init(&run->lock, NULL);
+	pthread_cond_init(&run->worker_cond, NULL);
+	pthread_cond_init(&run->consumer_cond, NULL);
+
+	return run;
+}
+
+// drop a reference to run, the last reference frees it
+static void _ExchangeRun_Release
+(
+	ExchangeRun *run
+) {
+	pthread_mutex_lock(&run->lock);
+	bool last = (--run->refs == 0);
+	pthread_mutex_unlock(&run->lock);
+
+	if(!last) return;
+
+	if(run->error != NULL) free(run->error);
+	pthread_mutex_destroy(&run->lock);
+	pthread_cond_destroy(&run->worker_cond);
+	pthread_cond_destroy(&run->consumer_cond);
+	rm_free(run);
+}
+
+// record the first error encountered by a worker and wake the consumer
+static void _ExchangeRun_Fail
+(
+	ExchangeRun *run,
+	const char *error
+) {
+	pthread_mutex_lock(&run->lock);
+	if(run->error == NULL) {
+		run->error = strdup(error ? error : "Parallel scan failed");
+	}
+	pthread_cond_signal(&run->consumer_cond);
+	pthread_mutex_unlock(&run->lock);
+}
+
+//------------------------------------------------------------------------------
+// worker
+//------------------------------------------------------------------------------
+
+// restrict worker's tap to the IDs covered by morsel
+static void _ExchangeWorker_SetMorsel
+(
+	ExchangeWorker *w,
+	uint64_t morsel
+) {
+	NodeID start = morsel * EXCHANGE_MORSEL_SIZE;
+	NodeID end   = start + EXCHANGE_MORSEL_SIZE;
+
+	if(w->tap->type == OPType_ALL_NODE_SCAN) {
+		AllNodeScanOp_SetIDRange((AllNodeScan *)w->tap, start, end);
+	} else {
+		UnsignedRange *range = UnsignedRange_New();
+		UnsignedRange_TightenRange(range, OP_GE, start);
+		UnsignedRange_TightenRange(range, OP_LT, end);
+		NodeByLabelScanOp_SetIDRange((NodeByLabelScan *)w->tap, range);
+		UnsignedRange_Free(range);
+	}
+}
+
+// discard records produced by worker
+static void _ExchangeWorker_ClearRecords
+(
+	ExchangeWorker *w
+) {
+	uint n = array_len(w->records);
+	for(uint i = 0; i < n; i++) OpBase_DeleteRecord(w->records[i]);
+	array_clear(w->records);
+}
+
+// collect all records produced by morsel
+// errors are raised within the worker's private error context
+// and reported to the run, returns false if the morsel failed
+static bool _ExchangeWorker_RunMorsel
+(
+	ExchangeWorker *w,
+	ExchangeRun *run,
+	uint64_t morsel
+) {
+	ErrorCtx *prev = pthread_getspecific(_tlsErrorCtx);
+	pthread_setspecific(_tlsErrorCtx, &w->error_ctx);
+
+	volatile bool success = false;
+
+	if(SET_EXCEPTION_HANDLER()) {
+		// encountered a runtime error
+		goto cleanup;
+	}
+
+	_ExchangeWorker_SetMorsel(w, morsel);
+
+	if(!w->initialized) {
+		ExecutionPlan_Init(w->plan);
+		w->initialized = true;
+	} else {
+		OpBase_PropagateReset(w->plan->root);
+	}
+
+	uint n;
+	Record batch[OP_BATCH_SIZE];
+	while((n = OpBase_ConsumeBatch(w->plan->root, batch, OP_BATCH_SIZE)) > 0) {
+		array_ensure_append(w->records, batch, n, Record);
+	}
+
+	success = !ErrorCtx_EncounteredError();
+
+cleanup:
+	if(!success) {
+		_ExchangeRun_Fail(run, w->error_ctx.error);
+		_ExchangeWorker_ClearRecords(w);
+	}
+
+	// release the private error context and restore the thread's own
+	ErrorCtx_Clear();
+	pthread_setspecific(_tlsErrorCtx, prev);
+
+	w->morsel = morsel;
+	return success;
+}
+
+// hand morsel's records over to the exchange and wait for them to be consumed
+// returns false if the worker should quit
+static bool _ExchangeWorker_Publish
+(
+	ExchangeWorker *w,
+	ExchangeRun *run
+) {
+	pthread_mutex_lock(&run->lock);
+
+	w->ready = true;
+	pthread_cond_signal(&run->consumer_cond);
+
+	while(w->ready && !run->stop) {
+		pthread_cond_wait(&run->worker_cond, &run->lock);
+	}
+	bool stop = run->stop;
+
+	pthread_mutex_unlock(&run->lock);
+
+	// exchange holds its own copy of the records
+	_ExchangeWorker_ClearRecords(w);
+	w->ready = false;
+
+	return !stop;
+}
+
+// reader thread-pool task, runs one of the exchange's workers
+static void _ExchangeWorker_Task
+(
+	void *arg
+) {
+	ExchangeRun *run = (ExchangeRun *)arg;
+	ExchangeWorker *w = NULL;
+
+	// claim a worker, unless the run is over by the time the task is picked
+	pthread_mutex_lock(&run->lock);
+	if(!run->stop && run->next_worker < run->exchange->worker_count) {
+		w = run->exchange->workers + run->next_worker++;
+		run->active_workers++;
+	}
+	pthread_mutex_unlock(&run->lock);
+
+	if(w != NULL) {
+		QueryCtx_SetTLS(&w->query_ctx);
+
+		uint64_t morsel;
+		while(!__atomic_load_n(&run->stop, __ATOMIC_RELAXED) &&
+			  (morsel = __atomic_fetch_add(&run->next_morsel, 1,
+					__ATOMIC_RELAXED)) < run->morsel_count) {
+			if(!_ExchangeWorker_RunMorsel(w, run, morsel)) break;
+			if(!_ExchangeWorker_Publish(w, run)) break;
+		}
+
+		QueryCtx_RemoveFromTLS();
+
+		pthread_mutex_lock(&run->lock);
+		run->active_workers--;
+		pthread_cond_signal(&run->consumer_cond);
+		pthread_mutex_unlock(&run->lock);
+	}
+
+	_ExchangeRun_Release(run);
+}
+
+//------------------------------------------------------------------------------
+// exchange
+//------------------------------------------------------------------------------
+
+// submit workers to the reader thread-pool
+static void _Exchange_Start
+(
+	OpExchange *op
+) {
+	ASSERT(op->run == NULL);
+
+	// the first worker is executed inline by the consumer
+	uint tasks = MIN(op->worker_count - 1, ThreadPools_ReadersCount());
+
+	// a reference for the exchange and one for each task
+	ExchangeRun *run = _ExchangeRun_New(op, tasks + 1);
+
+	op->run      = run;
+	op->current  = NULL;
+	op->expected = 0;
+	op->consumed = 0;
+
+	for(uint i = 0; i < tasks; i++) {
+		// morsels not picked up by tasks are processed inline
+		if(ThreadPools_AddWorkReader(_ExchangeWorker_Task, run, 0) != 0) {
+			_ExchangeRun_Release(run);
+		}
+	}
+}
+
+// signal workers to quit and wait for running workers to exit
+// tasks yet to start find the run stopped and exit right away
+static void _Exchange_Stop
+(
+	OpExchange *op
+) {
+	ExchangeRun *run = op->run;
+	if(run == NULL) return;
+
+	pthread_mutex_lock(&run->lock);
+	__atomic_store_n(&run->stop, true, __ATOMIC_RELAXED);
+	pthread_cond_broadcast(&run->worker_cond);
+	while(run->active_workers > 0) {
+		pthread_cond_wait(&run->consumer_cond, &run->lock);
+	}
+	pthread_mutex_unlock(&run->lock);
+
+	// discard inline records which weren't emitted
+	_ExchangeWorker_ClearRecords(op->workers);
+
+	op->run     = NULL;
+	op->current = NULL;
+
+	_ExchangeRun_Release(run);
+}
+
+// make the records of the expected morsel current
+// waits for the worker which claimed it, or processes it inline if unclaimed
+static void _Exchange_AcquireMorsel
+(
+	OpExchange *op
+) {
+	ExchangeRun *run = op->run;
+	ExchangeWorker *w = NULL;
+	bool run_inline = false;
+
+	pthread_mutex_lock(&run->lock);
+	while(run->error == NULL) {
+		// morsel published by a worker
+		for(uint i = 1; i < op->worker_count; i++) {
+			ExchangeWorker *candidate = op->workers + i;
+			if(candidate->ready && candidate->morsel == op->expected) {
+				w = candidate;
+				break;
+			}
+		}
+		if(w != NULL) break;
+
+		// claim morsel if no worker did
+		uint64_t morsel = op->expected;
+		if(__atomic_compare_exchange_n(&run->next_morsel, &morsel, morsel + 1,
+					false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			run_inline = true;
+			break;
+		}
+
+		pthread_cond_wait(&run->consumer_cond, &run->lock);
+	}
+	pthread_mutex_unlock(&run->lock);
+
+	if(run_inline) {
+		w = op->workers;
+		if(!_ExchangeWorker_RunMorsel(w, run, op->expected)) w = NULL;
+	}
+
+	if(w == NULL) {
+		// a worker failed, merge its error into the query's error context
+		ErrorCtx_SetError("%s", run->error);
+		_Exchange_Stop(op);
+		ErrorCtx_RaiseRuntimeException(NULL);
+		return;
+	}
+
+	op->current  = w;
+	op->consumed = 0;
+}
+
+// done emitting the current morsel, release its worker
+static void _Exchange_ReleaseMorsel
+(
+	OpExchange *op
+) {
+	ExchangeRun *run = op->run;
+	ExchangeWorker *w = op->current;
+
+	if(w == op->workers) {
+		_ExchangeWorker_ClearRecords(w);
+	} else {
+		pthread_mutex_lock(&run->lock);
+		w->ready = false;
+		pthread_cond_broadcast(&run->worker_cond);
+		pthread_mutex_unlock(&run->lock);
+	}
+
+	op->current = NULL;
+	op->expected++;
+}
+
+static OpResult ExchangeInit
+(
+	OpBase *opBase
+) {
+	OpExchange *op = (OpExchange *)opBase;
+	OpBase *child = opBase->children[0];
+
+	uint64_t worker_count;
+	Config_Option_get(Config_PARALLEL_SCAN_WORKERS, &worker_count);
+
+	// locate child's leaf scan
+	OpBase *tap = child;
+	while(tap->childCount > 0) tap = tap->children[0];
+
+	Graph *g = QueryCtx_GetGraph();
+	uint64_t node_count = Graph_UncompactedNodeCount(g);
+	uint64_t morsel_count = (node_count + EXCHANGE_MORSEL_SIZE - 1) /
+		EXCHANGE_MORSEL_SIZE;
+	worker_count = MIN(worker_count, morsel_count);
+
+	// run serially when parallelism is disabled, the scanned graph is small
+	// or the operation is profiled
+	if(worker_count < 2 || opBase->stats != NULL ||
+	   !ExchangeOp_SplittableScan(tap)) {
+		OpBase_UpdateConsume(opBase, ExchangeSerialConsume);
+		OpBase_UpdateConsumeBatch(opBase, ExchangeSerialConsumeBatch);
+		return OP_OK;
+	}
+
+	op->morsel_count = morsel_count;
+	op->worker_count = worker_count;
+	op->workers      = rm_calloc(worker_count, sizeof(ExchangeWorker));
+
+	// clone child op tree for each worker
+	// children are yet to be initialized as ops are initialized top-down
+	// workers read the graph through a private copy of the query context
+	QueryCtx *query_ctx = QueryCtx_GetQueryCtx();
+	for(uint i = 0; i < worker_count; i++) {
+		ExchangeWorker *w = op->workers + i;
+		w->query_ctx = *query_ctx;
+		w->records   = array_new(Record, OP_BATCH_SIZE);
+		w->plan      = ExecutionPlan_CloneOpTree(child);
+		w->tap       = w->plan->root;
+		while(w->tap->childCount > 0) w->tap = w->tap->children[0];
+	}
+
+	OpBase_UpdateConsumeBatch(opBase, ExchangeConsumeBatch);
+	return OP_OK;
+}
+
+static uint ExchangeConsumeBatch
+(
+	OpBase *opBase,
+	Record *batch,
+	uint cap
+) {
+	OpExchange *op = (OpExchange *)opBase;
+
+	if(op->run == NULL) _Exchange_Start(op);
+
+	uint n = 0;
+	while(n == 0) {
+		if(op->current == NULL) {
+			// all morsels been emitted
+			if(op->expected == op->morsel_count) return 0;
+			_Exchange_AcquireMorsel(op);
+		}
+
+		// copy records into this plan, a worker is blocked until its records
+		// are consumed, as such it is safe to access them without the lock
+		ExchangeWorker *w = op->current;
+		uint count = array_len(w->records);
+		n = MIN(cap, count - op->consumed);
+		for(uint i = 0; i < n; i++) {
+			Record r = OpBase_CreateRecord(opBase);
+			Record_DeepClone(w->records[op->consumed + i], r);
+			batch[i] = r;
+		}
+
+		op->consumed += n;
+		if(op->consumed == count) _Exchange_ReleaseMorsel(op);
+	}
+
+	return n;
+}
+
+static Record ExchangeConsume
+(
+	OpBase *opBase
+) {
+	Record r;
+	if(ExchangeConsumeBatch(opBase, &r, 1) == 0) return NULL;
+	return r;
+}
+
+// parallelism is disabled, pass child records through
+static Record ExchangeSerialConsume
+(
+	OpBase *opBase
+) {
+	return OpBase_Consume(opBase->children[0]);
+}
+
+static uint ExchangeSerialConsumeBatch
+(
+	OpBase *opBase,
+	Record *batch,
+	uint cap
+) {
+	return OpBase_ConsumeBatch(opBase->children[0], batch, cap);
+}
+
+static OpResult ExchangeReset
+(
+	OpBase *opBase
+) {
+	OpExchange *op = (OpExchange *)opBase;
+
+	// workers reset their plans once they pick up a morsel
+	_Exchange_Stop(op);
+
+	return OP_OK;
+}
+
+static OpBase *ExchangeClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_EXCHANGE);
+	return NewExchangeOp(plan);
+}
+
+static void ExchangeFree
+(
+	OpBase *opBase
+) {
+	OpExchange *op = (OpExchange *)opBase;
+
+	_Exchange_Stop(op);
+
+	if(op->workers != NULL) {
+		for(uint i = 0; i < op->worker_count; i++) {
+			ExecutionPlan_Free(op->workers[i].plan);
+			array_free(op->workers[i].records);
+		}
+		rm_free(op->workers);
+		op->workers = NULL;
+	}
+}
+
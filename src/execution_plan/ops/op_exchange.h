@@ -0,0 +1,82 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../errors.h"
+#include "../../query_ctx.h"
+#include <pthread.h>
+
+// number of node IDs scanned by a single morsel
+#define EXCHANGE_MORSEL_SIZE 4096
+
+// Exchange merges the record streams produced by multiple workers
+// each worker executes a private clone of the exchange's child op tree
+// over a disjoint range of node IDs (morsel) taken from a shared counter
+// once a worker depletes its morsel it grabs the next one, until the
+// entire ID space has been scanned
+//
+// workers run as reader thread-pool tasks, the thread executing the query
+// processes morsels itself whenever the next morsel is yet to be claimed
+// as such the query completes even if none of its tasks gets to run
+//
+// a worker buffers its morsel's records entirely before handing them over
+// morsels are emitted in ID order, keeping the exchange's output order
+// identical to a serial scan
+
+struct OpExchange;
+
+// state shared between an exchange and the tasks it submitted
+// reference counted, as queued tasks may outlive a run of the exchange
+typedef struct {
+	struct OpExchange *exchange;   // exchange op, valid while not stopped
+	uint64_t next_morsel;          // next morsel to claim
+	uint64_t morsel_count;         // number of morsels
+	uint next_worker;              // next worker to be claimed by a task
+	uint active_workers;           // number of tasks running a worker
+	uint refs;                     // number of references to this state
+	bool stop;                     // signal workers to quit
+	char *error;                   // first error encountered by a worker
+	pthread_mutex_t lock;          // guards the state and workers
+	pthread_cond_t worker_cond;    // signaled when a morsel been consumed
+	pthread_cond_t consumer_cond;  // signaled when a morsel is ready
+} ExchangeRun;
+
+typedef struct {
+	QueryCtx query_ctx;            // worker's private copy of the query context
+	ErrorCtx error_ctx;            // worker's private error context
+	ExecutionPlan *plan;           // worker's private clone of the op tree
+	OpBase *tap;                   // plan's leaf scan, consumes morsels
+	Record *records;               // records produced by the current morsel
+	uint64_t morsel;               // morsel records belong to
+	bool ready;                    // records are ready to be consumed
+	bool initialized;              // plan been initialized
+} ExchangeWorker;
+
+typedef struct OpExchange {
+	OpBase op;
+	ExchangeRun *run;              // current run, NULL if not started
+	ExchangeWorker *workers;       // workers, the first is executed inline
+	uint worker_count;             // number of workers
+	uint64_t morsel_count;         // number of morsels
+	uint64_t expected;             // next morsel to emit
+	ExchangeWorker *current;       // worker whose records are being emitted
+	uint consumed;                 // number of records emitted from current
+} OpExchange;
+
+OpBase *NewExchangeOp
+(
+	const ExecutionPlan *plan
+);
+
+// returns true if `op` is a scan which can be split into morsels
+bool ExchangeOp_SplittableScan
+(
+	const OpBase *op
+);
+
@@ -8,11 +8,13 @@
 #include "../../query_ctx.h"
 #include "shared/print_functions.h"
 #include "../../filter_tree/ft_to_rsq.h"
+#include "../../filter_tree/ft_to_ordered_ranges.h"
 
 // forward declarations
 static OpResult IndexScanInit(OpBase *opBase);
 static Record IndexScanConsume(OpBase *opBase);
 static Record IndexScanConsumeFromChild(OpBase *opBase);
+static Record IndexScanConsumeBatchFromChild(OpBase *opBase);
 static OpResult IndexScanReset(OpBase *opBase);
 static void IndexScanFree(OpBase *opBase);
 
@@ -22,7 +24,7 @@ static void IndexScanToString(const OpBase *ctx, sds *buf) {
 }
 
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
-		RSIndex *idx, FT_FilterNode *filter) {
+		Index idx, FT_FilterNode *filter) {
 	// validate inputs
 	ASSERT(g      != NULL);
 	ASSERT(idx    != NULL);
@@ -34,10 +36,19 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
 	op->n                    =  n;
 	op->idx                  =  idx;
 	op->iter                 =  NULL;
+	op->ordered_iter         =  NULL;
 	op->filter               =  filter;
 	op->child_record         =  NULL;
 	op->unresolved_filters   =  NULL;
 	op->rebuild_index_query  =  false;
+	op->ids                  =  NULL;
+	op->batch                =  NULL;
+	op->batch_ids            =  NULL;
+	op->batch_filters        =  NULL;
+	op->batch_idx            =  0;
+	op->id_idx               =  0;
+	op->order_range          =  NULL;
+	op->descending           =  false;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_NODE_BY_INDEX_SCAN, "Node By Index Scan", IndexScanInit, IndexScanConsume,
@@ -47,11 +58,23 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
 	return (OpBase *)op;
 }
 
+void IndexScanOp_SetOrder(IndexScan *op, OrderedIndexRange *range,
+		bool descending) {
+	ASSERT(op != NULL);
+	ASSERT(range != NULL);
+	ASSERT(op->order_range == NULL);
+	ASSERT(op->op.childCount == 0);
+	ASSERT(Index_OrderedIndex(op->idx) != NULL);
+
+	op->order_range = range;
+	op->descending  = descending;
+}
+
 static OpResult IndexScanInit(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
 	if(opBase->childCount > 0) {
-		// find out how many different entities are refered to 
+		// find out how many different entities are refered to
 		// within the filter tree, if number of entities equals 1
 		// (current node being scanned) there's no need to re-build the index
 		// query for every input record
@@ -59,7 +82,16 @@ static OpResult IndexScanInit(OpBase *opBase) {
 		op->rebuild_index_query = raxSize(entities) > 1; // this is us
 		raxFree(entities);
 
-		OpBase_UpdateConsume(opBase, IndexScanConsumeFromChild);
+		if(Index_OrderedIndex(op->idx) != NULL) {
+			// probe native index once per batch of child records
+			op->batch         = array_new(Record, INDEX_SCAN_BATCH_SIZE);
+			op->batch_ids     = array_new(EntityID *, INDEX_SCAN_BATCH_SIZE);
+			op->batch_filters = array_new(FT_FilterNode *,
+					INDEX_SCAN_BATCH_SIZE);
+			OpBase_UpdateConsume(opBase, IndexScanConsumeBatchFromChild);
+		} else {
+			OpBase_UpdateConsume(opBase, IndexScanConsumeFromChild);
+		}
 	}
 
 	// resolve label ID now if it is still unknown
@@ -87,20 +119,117 @@ static inline bool _PassUnresolvedFilters(const IndexScan *op, Record r) {
 	return FilterTree_applyFilters(unresolved_filters, r) == FILTER_PASS;
 }
 
+// free index iterator and the filters it couldn't resolve
+static void _FreeIterator(IndexScan *op) {
+	if(op->iter != NULL) {
+		RediSearch_ResultsIteratorFree(op->iter);
+		op->iter = NULL;
+	}
+
+	if(op->ordered_iter != NULL) {
+		OrderedIndexIterator_Free(op->ordered_iter);
+		op->ordered_iter = NULL;
+	}
+
+	if(op->unresolved_filters != NULL) {
+		FilterTree_Free(op->unresolved_filters);
+		op->unresolved_filters = NULL;
+	}
+}
+
+// convert filter into native index ranges
+static OrderedIndexRange *_FilterToRanges
+(
+	const IndexScan *op,
+	const FT_FilterNode *filter
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	OrderedIndexRange *ranges = NULL;
+
+	if(!FilterTreeToOrderedRanges(&ranges, filter, gc)) {
+		// filter couldn't be converted, scan all indexed nodes
+		uint fields_count = Index_FieldsCount(op->idx);
+		const IndexField *fields = Index_GetFields(op->idx);
+
+		ranges = array_new(OrderedIndexRange, fields_count);
+		for(uint i = 0; i < fields_count; i++) {
+			array_append(ranges, OrderedIndexRange_All(fields[i].id));
+		}
+	}
+
+	return ranges;
+}
+
+// scan native ordered index
+// scanned ranges might be a superset of the filter
+// as such the entire filter is applied to each scanned node
+static void _BuildOrderedIterator(IndexScan *op, const FT_FilterNode *filter) {
+	OrderedIndex *ordered = Index_OrderedIndex(op->idx);
+	ASSERT(ordered != NULL);
+
+	op->unresolved_filters = FilterTree_Clone(filter);
+
+	// stream a single range in value order
+	if(op->order_range != NULL) {
+		op->ordered_iter = op->descending ?
+			OrderedIndex_ScanReverse(ordered, op->order_range) :
+			OrderedIndex_Scan(ordered, op->order_range, 1);
+		return;
+	}
+
+	OrderedIndexRange *ranges = _FilterToRanges(op, filter);
+
+	op->ordered_iter = OrderedIndex_Scan(ordered, ranges, array_len(ranges));
+
+	OrderedRanges_Free(ranges);
+}
+
+// create index iterator from filter
+static void _BuildIterator(IndexScan *op, const FT_FilterNode *filter) {
+	ASSERT(op->iter == NULL && op->ordered_iter == NULL);
+	ASSERT(op->unresolved_filters == NULL);
+
+	if(Index_OrderedIndex(op->idx) != NULL) {
+		_BuildOrderedIterator(op, filter);
+		return;
+	}
+
+	// convert filter into a RediSearch query
+	RSIndex *rs_idx = Index_RSIndex(op->idx);
+	RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
+			filter, rs_idx);
+	ASSERT(rs_query_node != NULL);
+	op->iter = RediSearch_GetResultsIterator(rs_query_node, rs_idx);
+}
+
+// advance index iterator, returns false once depleted
+static bool _NextNodeID(IndexScan *op, EntityID *id) {
+	if(op->ordered_iter != NULL) {
+		return OrderedIndexIterator_Next(op->ordered_iter, id);
+	}
+
+	const EntityID *nodeId = RediSearch_ResultsIteratorNext(op->iter,
+			Index_RSIndex(op->idx), NULL);
+	if(nodeId == NULL) return false;
+
+	*id = *nodeId;
+	return true;
+}
+
 static Record IndexScanConsumeFromChild(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
-	const EntityID *nodeId = NULL;
+	EntityID nodeId;
 
 pull_index:
 	//--------------------------------------------------------------------------
 	// pull from index
 	//--------------------------------------------------------------------------
 
-	if(op->iter != NULL && op->child_record != NULL) {
-		while((nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
-				!= NULL) {
+	if((op->iter != NULL || op->ordered_iter != NULL) &&
+	   op->child_record != NULL) {
+		while(_NextNodeID(op, &nodeId)) {
 			// populate record with node
-			_UpdateRecord(op, op->child_record, *nodeId);
+			_UpdateRecord(op, op->child_record, nodeId);
 			// apply unresolved filters
 			if(_PassUnresolvedFilters(op, op->child_record)) {
 				// clone the held Record, as it will be freed upstream
@@ -131,17 +260,8 @@ pull_index:
 	//--------------------------------------------------------------------------
 
 	if(op->rebuild_index_query) {
-		// free previous iterator
-		if(op->iter != NULL) {
-			RediSearch_ResultsIteratorFree(op->iter);
-			op->iter = NULL;
-		}
-
-		// free previous unresolved filters
-		if(op->unresolved_filters != NULL) {
-			FilterTree_Free(op->unresolved_filters);
-			op->unresolved_filters = NULL;
-		}
+		// free previous iterator and unresolved filters
+		_FreeIterator(op);
 
 		// rebuild index query, probably relies on runtime values
 		// resolve runtime variables within filter
@@ -157,51 +277,220 @@ pull_index:
 		}
 		#endif
 
-		// convert filter into a RediSearch query
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				filter, op->idx);
+		_BuildIterator(op, filter);
 		FilterTree_Free(filter);
-
-		// create iterator
-		ASSERT(rs_query_node != NULL);
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
+	} else if(op->iter != NULL) {
+		// reset existing iterator
+		RediSearch_ResultsIteratorReset(op->iter);
 	} else {
-		// build index query only once (first call)
-		// reset it if already initialized
-		if(op->iter == NULL) {
-			// first call to consume, create query and iterator
-			RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters, op->filter, op->idx);
-			ASSERT(rs_query_node != NULL);
-			op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
-		} else {
-			// reset existing iterator
-			RediSearch_ResultsIteratorReset(op->iter);
-		}
+		// build index query, native iterators are rebuilt rather than reset
+		_FreeIterator(op);
+		_BuildIterator(op, op->filter);
 	}
 
 	// repull from index
 	goto pull_index;
 }
 
+//------------------------------------------------------------------------------
+// batched probing
+//------------------------------------------------------------------------------
+
+static int _CompareIDs(const void *a, const void *b) {
+	EntityID x = *(const EntityID *)a;
+	EntityID y = *(const EntityID *)b;
+	return (x > y) - (x < y);
+}
+
+// sort IDs and drop duplicates
+static void _SortUniqueIDs(EntityID **ids) {
+	uint count = array_len(*ids);
+	if(count < 2) return;
+
+	qsort(*ids, count, sizeof(EntityID), _CompareIDs);
+
+	uint j = 0;
+	for(uint i = 1; i < count; i++) {
+		if((*ids)[i] != (*ids)[j]) (*ids)[++j] = (*ids)[i];
+	}
+	*ids = array_trimm_len(*ids, j + 1);
+}
+
+// free batched records and their matches
+static void _ClearBatch(IndexScan *op) {
+	uint n = array_len(op->batch);
+	for(uint i = 0; i < n; i++) OpBase_DeleteRecord(op->batch[i]);
+	array_clear(op->batch);
+
+	n = array_len(op->batch_ids);
+	for(uint i = 0; i < n; i++) array_free(op->batch_ids[i]);
+	array_clear(op->batch_ids);
+
+	n = array_len(op->batch_filters);
+	for(uint i = 0; i < n; i++) FilterTree_Free(op->batch_filters[i]);
+	array_clear(op->batch_filters);
+
+	op->batch_idx = 0;
+	op->id_idx    = 0;
+}
+
+// probe native index on behalf of all batched records
+// ranges of all records are probed at once
+// matches are routed back to the record which introduced each range
+static void _ProbeBatch(IndexScan *op) {
+	uint n = array_len(op->batch);
+	ASSERT(n > 0);
+
+	OrderedIndex *ordered = Index_OrderedIndex(op->idx);
+
+	// filter doesn't depend on child records, probe once
+	if(!op->rebuild_index_query) {
+		if(op->ids == NULL) {
+			OrderedIndexRange *ranges = _FilterToRanges(op, op->filter);
+			uint range_count = array_len(ranges);
+			EntityID **matches = rm_malloc(sizeof(EntityID *) * range_count);
+
+			OrderedIndex_Probe(ordered, ranges, range_count, matches);
+
+			op->ids = array_new(EntityID, 0);
+			for(uint i = 0; i < range_count; i++) {
+				array_ensure_append(op->ids, matches[i],
+						array_len(matches[i]), EntityID);
+				array_free(matches[i]);
+			}
+			if(range_count > 1) _SortUniqueIDs(&op->ids);
+
+			rm_free(matches);
+			OrderedRanges_Free(ranges);
+		}
+		return;
+	}
+
+	//--------------------------------------------------------------------------
+	// collect ranges of all records
+	//--------------------------------------------------------------------------
+
+	OrderedIndexRange *ranges = array_new(OrderedIndexRange, n);
+	uint *owners = array_new(uint, n);  // record introducing each range
+	uint range_counts[n];               // number of ranges per record
+
+	for(uint i = 0; i < n; i++) {
+		// resolve runtime variables within filter
+		FT_FilterNode *filter = FilterTree_Clone(op->filter);
+		FilterTree_ResolveVariables(filter, op->batch[i]);
+		array_append(op->batch_filters, filter);
+
+		OrderedIndexRange *record_ranges = _FilterToRanges(op, filter);
+		range_counts[i] = array_len(record_ranges);
+		for(uint j = 0; j < range_counts[i]; j++) {
+			array_append(ranges, record_ranges[j]);
+			array_append(owners, i);
+		}
+		array_free(record_ranges);
+	}
+
+	//--------------------------------------------------------------------------
+	// probe and route matches back to records
+	//--------------------------------------------------------------------------
+
+	uint range_count = array_len(ranges);
+	EntityID **matches = rm_malloc(sizeof(EntityID *) * range_count);
+	OrderedIndex_Probe(ordered, ranges, range_count, matches);
+
+	for(uint i = 0; i < n; i++) {
+		array_append(op->batch_ids, array_new(EntityID, 0));
+	}
+
+	for(uint i = 0; i < range_count; i++) {
+		EntityID **ids = op->batch_ids + owners[i];
+		array_ensure_append(*ids, matches[i], array_len(matches[i]),
+				EntityID);
+		array_free(matches[i]);
+	}
+
+	// a node might fall within multiple ranges of the same record
+	for(uint i = 0; i < n; i++) {
+		if(range_counts[i] > 1) _SortUniqueIDs(op->batch_ids + i);
+	}
+
+	rm_free(matches);
+	array_free(owners);
+	OrderedRanges_Free(ranges);
+}
+
+static Record IndexScanConsumeBatchFromChild(OpBase *opBase) {
+	IndexScan *op = (IndexScan *)opBase;
+
+	while(true) {
+		//----------------------------------------------------------------------
+		// emit matches of batched records
+		//----------------------------------------------------------------------
+
+		uint n = array_len(op->batch);
+		while(op->batch_idx < n) {
+			Record r = op->batch[op->batch_idx];
+			EntityID *ids;
+			FT_FilterNode *filter;
+
+			if(op->rebuild_index_query) {
+				ids    = op->batch_ids[op->batch_idx];
+				filter = op->batch_filters[op->batch_idx];
+			} else {
+				ids    = op->ids;
+				filter = op->filter;
+			}
+
+			uint count = array_len(ids);
+			while(op->id_idx < count) {
+				// populate record with node
+				_UpdateRecord(op, r, ids[op->id_idx++]);
+				// scanned ranges might be a superset of the filter
+				if(FilterTree_applyFilters(filter, r) == FILTER_PASS) {
+					// clone the batched Record, as it will be freed upstream
+					return OpBase_CloneRecord(r);
+				}
+			}
+
+			// current record exhausted
+			op->batch_idx++;
+			op->id_idx = 0;
+		}
+
+		//----------------------------------------------------------------------
+		// pull next batch from child
+		//----------------------------------------------------------------------
+
+		_ClearBatch(op);
+
+		Record r;
+		OpBase *child = op->op.children[0];
+		while(array_len(op->batch) < INDEX_SCAN_BATCH_SIZE &&
+			  (r = OpBase_Consume(child)) != NULL) {
+			array_append(op->batch, r);
+		}
+
+		// child depleted
+		if(array_len(op->batch) == 0) return NULL;
+
+		_ProbeBatch(op);
+	}
+}
+
 static Record IndexScanConsume(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
 	// create iterator on first call
-	if(op->iter == NULL) {
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				op->filter, op->idx);
-
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
+	if(op->iter == NULL && op->ordered_iter == NULL) {
+		_BuildIterator(op, op->filter);
 	}
 
-	const EntityID *nodeId = NULL;
+	EntityID nodeId;
 
 	// populate the Record with the actual node
 	Record r = OpBase_CreateRecord((OpBase *)op);
-	while((nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
-			!= NULL) {
+	while(_NextNodeID(op, &nodeId)) {
 		// populate record with node
-		_UpdateRecord(op, r, *nodeId);
+		_UpdateRecord(op, r, nodeId);
 		// apply unresolved filters
 		if(_PassUnresolvedFilters(op, r)) {
 			return r;
@@ -216,14 +505,13 @@ static Record IndexScanConsume(OpBase *opBase) {
 static OpResult IndexScanReset(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
-	if(op->iter) {
-		RediSearch_ResultsIteratorFree(op->iter);
-		op->iter = NULL;
-	}
+	_FreeIterator(op);
 
-	if(op->unresolved_filters) {
-		FilterTree_Free(op->unresolved_filters);
-		op->unresolved_filters = NULL;
+	if(op->batch != NULL) _ClearBatch(op);
+
+	if(op->ids != NULL) {
+		array_free(op->ids);
+		op->ids = NULL;
 	}
 
 	return OP_OK;
@@ -235,29 +523,42 @@ static void IndexScanFree(OpBase *opBase) {
 	 * read locked, if this index scan operation is part of
 	 * a query which will modified this index we'll be stuck in
 	 * a dead lock, as we're unable to acquire index write lock. */
-	if(op->iter != NULL) {
-		RediSearch_ResultsIteratorFree(op->iter);
-		op->iter = NULL;
-	}
+	_FreeIterator(op);
 
 	if(op->child_record != NULL) {
 		OpBase_DeleteRecord(op->child_record);
 		op->child_record = NULL;
 	}
 
+	if(op->batch != NULL) {
+		_ClearBatch(op);
+		array_free(op->batch);
+		array_free(op->batch_ids);
+		array_free(op->batch_filters);
+		op->batch         = NULL;
+		op->batch_ids     = NULL;
+		op->batch_filters = NULL;
+	}
+
+	if(op->ids != NULL) {
+		array_free(op->ids);
+		op->ids = NULL;
+	}
+
 	if(op->filter != NULL) {
 		FilterTree_Free(op->filter);
 		op->filter = NULL;
 	}
 
-	if(op->unresolved_filters != NULL) {
-		FilterTree_Free(op->unresolved_filters);
-		op->unresolved_filters = NULL;
-	}
-
 	if(op->n != NULL) {
 		NodeScanCtx_Free(op->n);
 		op->n = NULL;
 	}
+
+	if(op->order_range != NULL) {
+		OrderedIndexRange_Free(op->order_range);
+		rm_free(op->order_range);
+		op->order_range = NULL;
+	}
 }
 
@@ -13,20 +13,38 @@
 #include "shared/scan_functions.h"
 #include "redisearch_api.h"
 
+// max number of child records probed against the index at once
+#define INDEX_SCAN_BATCH_SIZE 1024
+
 typedef struct {
 	OpBase op;
 	Graph *g;
 	bool rebuild_index_query;           // should we rebuild RediSearch index query for each input record
-	RSIndex *idx;                       // index to query
+	Index idx;                          // index to query
 	NodeScanCtx *n;                     // label data of node being scanned
 	uint nodeRecIdx;                    // index of the node being scanned in the Record
 	RSResultsIterator *iter;            // rediSearch iterator over an index with the appropriate filters
+	OrderedIndexIterator *ordered_iter; // native iterator, used when index is natively backed
 	FT_FilterNode *filter;              // filter from which to compose index query
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
 	Record child_record;                // the Record this op acts on if it is not a tap
+	Record *batch;                      // child records probed together, native index
+	FT_FilterNode **batch_filters;      // resolved filter of each batched record
+	EntityID **batch_ids;               // matching node IDs of each batched record
+	EntityID *ids;                      // matching node IDs when filter doesn't depend on child
+	uint batch_idx;                     // current record within batch
+	uint id_idx;                        // current ID of current record
+	OrderedIndexRange *order_range;     // scanned in value order, NULL if unordered
+	bool descending;                    // scan order_range in descending order
 } IndexScan;
 
 // creates a new IndexScan operation
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
-		RSIndex *idx, FT_FilterNode *filter);
+		Index idx, FT_FilterNode *filter);
+
+// produce nodes in value order by scanning a single range of the native index
+// the range must cover every node satisfying the operation's filter
+// the operation takes ownership of the range
+void IndexScanOp_SetOrder(IndexScan *op, OrderedIndexRange *range,
+		bool descending);
 
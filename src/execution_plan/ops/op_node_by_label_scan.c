@@ -13,6 +13,7 @@
 /* Forward declarations. */
 static OpResult NodeByLabelScanInit(OpBase *opBase);
 static Record NodeByLabelScanConsume(OpBase *opBase);
+static uint NodeByLabelScanConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static Record NodeByLabelScanConsumeFromChild(OpBase *opBase);
 static Record NodeByLabelScanNoOp(OpBase *opBase);
 static OpResult NodeByLabelScanReset(OpBase *opBase);
@@ -133,6 +134,9 @@ static OpResult NodeByLabelScanInit
 		return OP_OK;
 	}
 
+	// tap with a valid iterator, label scan can produce records in batches
+	OpBase_UpdateConsumeBatch(opBase, NodeByLabelScanConsumeBatch);
+
 	return OP_OK;
 }
 
@@ -218,6 +222,30 @@ static Record NodeByLabelScanConsume(OpBase *opBase) {
 	return r;
 }
 
+static uint NodeByLabelScanConsumeBatch
+(
+	OpBase *opBase,
+	Record *batch,
+	uint cap
+) {
+	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
+
+	uint n = 0;
+	GrB_Index nodeId;
+	while(n < cap) {
+		GrB_Info info = RG_MatrixTupleIter_next_BOOL(&op->iter, &nodeId, NULL,
+				NULL);
+		if(info == GxB_EXHAUSTED) break;
+		ASSERT(info == GrB_SUCCESS);
+
+		Record r = OpBase_CreateRecord(opBase);
+		_UpdateRecord(op, r, nodeId);
+		batch[n++] = r;
+	}
+
+	return n;
+}
+
 // this function is invoked when the op has no children
 // and no valid label is requested (either no label, or non existing label)
 // the op simply needs to return NULL
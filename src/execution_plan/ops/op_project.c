@@ -13,6 +13,7 @@
 
 /* Forward declarations. */
 static Record ProjectConsume(OpBase *opBase);
+static uint ProjectConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpResult ProjectReset(OpBase *opBase);
 static OpBase *ProjectClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void ProjectFree(OpBase *opBase);
@@ -29,6 +30,7 @@ OpBase *NewProjectOp(const ExecutionPlan *plan, AR_ExpNode **exps) {
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_PROJECT, "Project", NULL, ProjectConsume,
 				ProjectReset, NULL, ProjectClone, ProjectFree, false, plan);
+	OpBase_UpdateConsumeBatch((OpBase *)op, ProjectConsumeBatch);
 
 	for(uint i = 0; i < op->exp_count; i ++) {
 		// The projected record will associate values with their resolved name
@@ -40,26 +42,15 @@ OpBase *NewProjectOp(const ExecutionPlan *plan, AR_ExpNode **exps) {
 	return (OpBase *)op;
 }
 
-static Record ProjectConsume(OpBase *opBase) {
-	OpProject *op = (OpProject *)opBase;
-
-	if(op->op.childCount) {
-		OpBase *child = op->op.children[0];
-		op->r = OpBase_Consume(child);
-		if(!op->r) return NULL;
-	} else {
-		// QUERY: RETURN 1+2
-		// Return a single record followed by NULL on the second call.
-		if(op->singleResponse) return NULL;
-		op->singleResponse = true;
-		op->r = OpBase_CreateRecord(opBase);
-	}
-
-	op->projection = OpBase_CreateRecord(opBase);
+// project op->r into op->projection
+static void _ProjectRecord(OpProject *op) {
+	Record r = op->r;
+	Record projection = OpBase_CreateRecord((OpBase *)op);
+	op->projection = projection;
 
 	for(uint i = 0; i < op->exp_count; i++) {
 		AR_ExpNode *exp = op->exps[i];
-		SIValue v = AR_EXP_Evaluate(exp, op->r);
+		SIValue v = AR_EXP_Evaluate(exp, r);
 		int rec_idx = op->record_offsets[i];
 		/* Persisting a value is only necessary here if 'v' refers to a scalar held in Record 'r'.
 		 * Graph entities don't need to be persisted here as Record_Add will copy them internally.
@@ -67,12 +58,30 @@ static Record ProjectConsume(OpBase *opBase) {
 		 * MATCH (a) WITH toUpper(a.name) AS e RETURN e
 		 * TODO This is a rare case; the logic of when to persist can be improved.  */
 		if(!(v.type & SI_GRAPHENTITY)) SIValue_Persist(&v);
-		Record_Add(op->projection, rec_idx, v);
+		Record_Add(projection, rec_idx, v);
 		/* If the value was a graph entity with its own allocation, as with a query like:
 		 * MATCH p = (src) RETURN nodes(p)[0]
 		 * Ensure that the allocation is freed here. */
 		if((v.type & SI_GRAPHENTITY)) SIValue_Free(v);
 	}
+}
+
+static Record ProjectConsume(OpBase *opBase) {
+	OpProject *op = (OpProject *)opBase;
+
+	if(op->op.childCount) {
+		OpBase *child = op->op.children[0];
+		op->r = OpBase_Consume(child);
+		if(!op->r) return NULL;
+	} else {
+		// QUERY: RETURN 1+2
+		// Return a single record followed by NULL on the second call.
+		if(op->singleResponse) return NULL;
+		op->singleResponse = true;
+		op->r = OpBase_CreateRecord(opBase);
+	}
+
+	_ProjectRecord(op);
 
 	OpBase_DeleteRecord(op->r);
 	op->r = NULL;
@@ -83,6 +92,35 @@ static Record ProjectConsume(OpBase *opBase) {
 	return projection;
 }
 
+// projects an entire batch of child records, replacing each record in place
+static uint ProjectConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	OpProject *op = (OpProject *)opBase;
+
+	// QUERY: RETURN 1+2
+	// no child to draw a batch from, emit the single record
+	if(op->op.childCount == 0) {
+		Record r = ProjectConsume(opBase);
+		if(r == NULL) return 0;
+		batch[0] = r;
+		return 1;
+	}
+
+	OpBase *child = op->op.children[0];
+	uint n = OpBase_ConsumeBatch(child, batch, cap);
+
+	for(uint i = 0; i < n; i++) {
+		op->r = batch[i];
+		_ProjectRecord(op);
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+
+		batch[i] = op->projection;
+		op->projection = NULL;
+	}
+
+	return n;
+}
+
 static OpResult ProjectReset(OpBase *opBase) {
 	OpProject *op = (OpProject *)opBase;
 	op->singleResponse = false;
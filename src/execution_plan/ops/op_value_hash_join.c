@@ -6,9 +6,32 @@
 
 #include "op_value_hash_join.h"
 #include "../../value.h"
+#include "../../errors.h"
 #include "../../util/arr.h"
-#include "../../util/qsort.h"
 #include "../../util/rmalloc.h"
+#include "../../configuration/config.h"
+
+// marks the end of a bucket chain
+#define HASH_JOIN_END UINT32_MAX
+
+// max number of cached records per partition
+#define HASH_JOIN_PARTITION_SIZE 32768
+
+// number of bloom filter bits per cached record
+#define HASH_JOIN_BLOOM_BITS_PER_RECORD 8
+
+// bucket a hash maps to, buckets of the same partition are consecutive
+#define HASH_JOIN_BUCKET(op, h)                                           \
+	((((op)->partition_bits == 0) ? 0 :                                   \
+	  ((h) >> (64 - (op)->partition_bits)) * ((op)->bucket_mask + 1)) +   \
+	 ((h) & (op)->bucket_mask))
+
+// number of hash ranges a spilled join is split into
+#define HASH_JOIN_SPILL_COUNT 16
+
+// spill a hash maps to, bits are taken from the middle of the hash
+// as the high bits pick the in-memory partition and the low bits the bucket
+#define HASH_JOIN_SPILL(h) (((h) >> 48) & (HASH_JOIN_SPILL_COUNT - 1))
 
 // forward declarations
 static Record ValueHashJoinConsume(OpBase *opBase);
@@ -16,161 +39,233 @@ static OpResult ValueHashJoinReset(OpBase *opBase);
 static OpBase *ValueHashJoinClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void ValueHashJoinFree(OpBase *opBase);
 
-// Determins order between two records by inspecting
-// element stored at postion idx
-static inline int _record_cmp
+// returns the smallest power of 2 >= n
+static inline uint64_t _next_pow2
 (
-	Record *l,
-	Record *r,
-	uint *_idx
+	uint64_t n
 ) {
-	uint    idx = *_idx;
-	SIValue lv  = Record_Get(*l, idx);
-	SIValue rv  = Record_Get(*r, idx);
-	return SIValue_Compare(lv, rv, NULL);
+	uint64_t p = 1;
+	while(p < n) p <<= 1;
+	return p;
 }
 
-// performs binary search, returns the leftmost index of a match
-static bool _binarySearchLeftmost
+// bloom filter bit positions of hash
+#define BLOOM_BIT_A(op, h) ((h) & (op)->bloom_mask)
+#define BLOOM_BIT_B(op, h) (((h) >> 32 | (h) << 32) & (op)->bloom_mask)
+
+static inline void _bloom_add
 (
-	uint *idx,
-	Record *array,
-	uint array_len,
-	int join_key_idx,
-	SIValue v
+	OpValueHashJoin *op,
+	XXH64_hash_t h
 ) {
-	ASSERT(idx != NULL);
-
-	SIValue x;
-	uint pos = 0;
-	uint left = 0;
-	uint right = array_len;
-
-	while(left < right) {
-		pos = (right + left) / 2;
-		x = Record_Get(array[pos], join_key_idx);
-		if(SIValue_Compare(x, v, NULL) < 0) left = pos + 1;
-		else right = pos;
-	}
+	uint64_t a = BLOOM_BIT_A(op, h);
+	uint64_t b = BLOOM_BIT_B(op, h);
+	op->bloom[a / 64] |= (1ULL << (a % 64));
+	op->bloom[b / 64] |= (1ULL << (b % 64));
+}
 
-	// make sure value was found
-	*idx = left;
+// returns false if hash is definitely not in the build side
+static inline bool _bloom_test
+(
+	const OpValueHashJoin *op,
+	XXH64_hash_t h
+) {
+	uint64_t a = BLOOM_BIT_A(op, h);
+	uint64_t b = BLOOM_BIT_B(op, h);
+	return (op->bloom[a / 64] & (1ULL << (a % 64))) &&
+		   (op->bloom[b / 64] & (1ULL << (b % 64)));
+}
 
-	if(left == array_len) return false;
+// retrive the next cached record intersecting with the current
+// right hand side record, if such exists, otherwise returns NULL
+static Record _get_intersecting_record
+(
+	OpValueHashJoin *op
+) {
+	while(op->intersect_idx != HASH_JOIN_END) {
+		uint32_t idx = op->intersect_idx;
+		op->intersect_idx = op->next[idx];
+
+		// different hash, different value
+		if(op->hashes[idx] != op->rhs_hash) continue;
+
+		// hash match, compare values
+		Record cr = op->cached_records[idx];
+		SIValue x = Record_Get(cr, op->join_value_rec_idx);
+		int disjointOrNull = 0;
+		if(SIValue_Compare(x, op->rhs_value, &disjointOrNull) == 0 &&
+		   disjointOrNull != COMPARED_NULL) {
+			return cr;
+		}
+	}
 
-	x = Record_Get(array[*idx], join_key_idx);
-	// return false if the value wasn't found or evaluated to NULL
-	int disjointOrNull = 0;
-	return (SIValue_Compare(x, v, &disjointOrNull) == 0 &&
-			disjointOrNull != COMPARED_NULL);
+	return NULL;
 }
 
-// performs binary search, returns the rightmost index of a match
-// assuming 'v' exists in 'array'
-static bool _binarySearchRightmost
+// position intersect_idx at the head of the bucket rhs_value maps to
+// returns false if no cached record can intersect with rhs_value
+static bool _set_intersection_idx
 (
-	uint *idx,
-	Record *array,
-	uint array_len,
-	int join_key_idx,
-	SIValue v
+	OpValueHashJoin *op
 ) {
-	ASSERT(idx != NULL);
-
-	SIValue x;
-	uint pos = 0;
-	uint left = 0;
-	uint right = array_len;
-
-	while(left < right) {
-		pos = (right + left) / 2;
-		x = Record_Get(array[pos], join_key_idx);
-		if(SIValue_Compare(v, x, NULL) < 0) right = pos;
-		else left = pos + 1;
-	}
+	op->intersect_idx = HASH_JOIN_END;
+
+	// NULL can't be compared to other values
+	if(SIValue_IsNull(op->rhs_value)) return false;
 
-	*idx = right - 1;
-	return true;
+	// empty build side
+	if(array_len(op->cached_records) == 0) return false;
+
+	XXH64_hash_t h = SIValue_HashCode(op->rhs_value);
+	if(!_bloom_test(op, h)) return false;
+
+	op->rhs_hash = h;
+	op->intersect_idx = op->buckets[HASH_JOIN_BUCKET(op, h)];
+
+	return op->intersect_idx != HASH_JOIN_END;
 }
 
-// retrive the next intersecting record
-// if such exists, otherwise returns NULL
-static Record _get_intersecting_record
+// build hash table over cached records
+static void _build_hash_table
 (
 	OpValueHashJoin *op
 ) {
-	// no more intersecting records
-	if(op->intersect_idx == -1 ||
-	   op->number_of_intersections == 0) return NULL;
+	uint32_t n = array_len(op->cached_records);
+
+	// split large build sides into partitions
+	uint64_t partition_count = 1;
+	op->partition_bits = 0;
+	while(partition_count * HASH_JOIN_PARTITION_SIZE < n) {
+		partition_count <<= 1;
+		op->partition_bits++;
+	}
+
+	uint64_t bucket_count = _next_pow2(MAX(1, n / partition_count));
+	op->bucket_mask = bucket_count - 1;
+
+	uint64_t bloom_bits = _next_pow2(MAX(64,
+				(uint64_t)n * HASH_JOIN_BLOOM_BITS_PER_RECORD));
+	op->bloom_mask = bloom_bits - 1;
+
+	op->next    = rm_malloc(sizeof(uint32_t) * MAX(1, n));
+	op->bloom   = rm_calloc(bloom_bits / 64, sizeof(uint64_t));
+	op->buckets = rm_malloc(sizeof(uint32_t) * bucket_count * partition_count);
+	memset(op->buckets, 0xFF, sizeof(uint32_t) * bucket_count * partition_count);
+
+	// order records by partition, such that each partition is built
+	// while its buckets are hot in cache
+	uint32_t *order = NULL;
+	uint64_t *offsets = NULL;
+	if(partition_count > 1) {
+		offsets = rm_calloc(partition_count + 1, sizeof(uint64_t));
+		for(uint32_t i = 0; i < n; i++) {
+			offsets[(op->hashes[i] >> (64 - op->partition_bits)) + 1]++;
+		}
+		for(uint64_t p = 0; p < partition_count; p++) {
+			offsets[p + 1] += offsets[p];
+		}
+
+		order = rm_malloc(sizeof(uint32_t) * n);
+		uint64_t *pos = rm_malloc(sizeof(uint64_t) * partition_count);
+		memcpy(pos, offsets, sizeof(uint64_t) * partition_count);
+		for(uint32_t i = 0; i < n; i++) {
+			order[pos[op->hashes[i] >> (64 - op->partition_bits)]++] = i;
+		}
+		rm_free(pos);
+	}
 
-	Record cr = op->cached_records[op->intersect_idx];
+	// insert records in reverse, such that each chain lists records
+	// in the order they were produced by the left hand side
+	for(int64_t i = (int64_t)n - 1; i >= 0; i--) {
+		uint32_t idx = (order != NULL) ? order[i] : i;
+		XXH64_hash_t h = op->hashes[idx];
+		uint64_t bucket = HASH_JOIN_BUCKET(op, h);
 
-	// update intersection trackers
-	op->intersect_idx++;
-	op->number_of_intersections--;
+		op->next[idx] = op->buckets[bucket];
+		op->buckets[bucket] = idx;
+		_bloom_add(op, h);
+	}
 
-	return cr;
+	if(order != NULL) {
+		rm_free(order);
+		rm_free(offsets);
+	}
 }
 
-// look up first intersecting cached record CR position
-// returns false if no intersecting record is found
-static bool _set_intersection_idx
+// write record to a spill file, creating it on first use
+// records which can't be written are kept in memory
+static void _spill_record
 (
-	OpValueHashJoin *op,
-	SIValue v
+	FILE **file,        // spill file
+	uint64_t *count,    // number of records written to file
+	Record **resident,  // records kept in memory
+	Record r            // record to spill
 ) {
-	op->intersect_idx = -1;
-	op->number_of_intersections = 0;
-	uint record_count = array_len(op->cached_records);
+	if(Record_Spillable(r)) {
+		if(*file == NULL) *file = tmpfile();
+		if(*file != NULL) {
+			Record_ToStream(r, *file);
+			OpBase_DeleteRecord(r);
+			(*count)++;
 
-	uint leftmost_idx  = 0;
-	uint rightmost_idx = 0;
+			if(ferror(*file)) {
+				ErrorCtx_RaiseRuntimeException(
+						"Value Hash Join failed to spill records to disk");
+			}
+			return;
+		}
+	}
+
+	// record can't be written, keep it in memory
+	if(*resident == NULL) *resident = array_new(Record, 1);
+	array_append(*resident, r);
+}
 
-	if(!_binarySearchLeftmost(&leftmost_idx, op->cached_records,
-				array_len(op->cached_records), op->join_value_rec_idx, v)) {
-		return false;
+// move cached records into spills
+// from here on build side records are written directly to their spill
+static void _spill_cache
+(
+	OpValueHashJoin *op
+) {
+	ASSERT(op->spills == NULL);
+
+	op->spills = rm_calloc(HASH_JOIN_SPILL_COUNT, sizeof(HashJoinSpill));
+	op->spill_idx = -1;
+
+	uint32_t n = array_len(op->cached_records);
+	for(uint32_t i = 0; i < n; i++) {
+		HashJoinSpill *spill = op->spills + HASH_JOIN_SPILL(op->hashes[i]);
+		_spill_record(&spill->build, &spill->build_count,
+				&spill->build_resident, op->cached_records[i]);
 	}
 
-	// value was found
-	// idx points to the first intersecting record
-	// update number_of_intersections to count how many
-	// records share the same value
-	op->intersect_idx = leftmost_idx;
-
-	// count how many records share the same node
-	// reduce search space by truncating left bound
-	bool found = _binarySearchRightmost(&rightmost_idx,
-			op->cached_records + leftmost_idx, record_count - leftmost_idx,
-			op->join_value_rec_idx, v);
-	UNUSED(found);
-	ASSERT(found == true);
-
-	// compensate index
-	rightmost_idx += leftmost_idx;
-	// +1 consider rightmost_idx == leftmost_idx
-	op->number_of_intersections = rightmost_idx - leftmost_idx + 1;
-	ASSERT(op->number_of_intersections > 0);
-
-	return true;
+	array_clear(op->cached_records);
+	array_clear(op->hashes);
 }
 
-// sorts cached records by joined value
-void _sort_cached_records
+// free spills, closing their files
+static void _free_spills
 (
 	OpValueHashJoin *op
 ) {
-	uint idx = op->join_value_rec_idx;
-	sort_r(
-			op->cached_records,
-			array_len(op->cached_records),
-			sizeof(Record),
-			(int(*)(const void*, const void*, void*))_record_cmp,
-			&idx
-		);
+	if(op->spills == NULL) return;
+
+	for(uint i = 0; i < HASH_JOIN_SPILL_COUNT; i++) {
+		HashJoinSpill *spill = op->spills + i;
+		if(spill->build != NULL) fclose(spill->build);
+		if(spill->probe != NULL) fclose(spill->probe);
+
+		array_free_cb(spill->build_resident, OpBase_DeleteRecord);
+		array_free_cb(spill->probe_resident, OpBase_DeleteRecord);
+	}
+
+	rm_free(op->spills);
+	op->spills = NULL;
+	op->spill_idx = -1;
 }
 
 // caches all records coming from left branch
-void _cache_records
+static void _cache_records
 (
 	OpValueHashJoin *op
 ) {
@@ -178,25 +273,253 @@ void _cache_records
 
 	OpBase *left_child = op->op.children[0];
 	op->cached_records = array_new(Record, 32);
+	op->hashes = array_new(XXH64_hash_t, 32);
 
-	Record r = left_child->consume(left_child);
-	if(!r) return;
+	uint n;
+	Record batch[OP_BATCH_SIZE];
 
 	// as long as there's data coming in from left branch
-	do {
-		// evaluate joined expression
-		SIValue v = AR_EXP_Evaluate(op->lhs_exp, r);
+	while((n = OpBase_ConsumeBatch(left_child, batch, OP_BATCH_SIZE)) > 0) {
+		for(uint i = 0; i < n; i++) {
+			Record r = batch[i];
+
+			// evaluate joined expression
+			SIValue v = AR_EXP_Evaluate(op->lhs_exp, r);
+
+			// if the joined value is NULL
+			// it cannot be compared to other values - skip this record
+			if(SIValue_IsNull(v)) {
+				OpBase_DeleteRecord(r);
+				continue;
+			}
+
+			// add joined value to record
+			Record_AddScalar(r, op->join_value_rec_idx, v);
+			XXH64_hash_t h = SIValue_HashCode(v);
+
+			// build side already spilled, write record to its spill
+			if(op->spills != NULL) {
+				HashJoinSpill *spill = op->spills + HASH_JOIN_SPILL(h);
+				_spill_record(&spill->build, &spill->build_count,
+						&spill->build_resident, r);
+				continue;
+			}
+
+			// cache the record
+			array_append(op->cached_records, r);
+			array_append(op->hashes, h);
+
+			if(op->spill_threshold != HASH_JOIN_SPILL_THRESHOLD_DISABLED &&
+			   array_len(op->cached_records) >= op->spill_threshold) {
+				_spill_cache(op);
+			}
+		}
+	}
+}
+
+// free right hand side record and its joined value
+static void _discard_rhs
+(
+	OpValueHashJoin *op
+) {
+	SIValue_Free(op->rhs_value);
+	op->rhs_value = SI_NullVal();
+
+	if(op->rhs_rec) {
+		OpBase_DeleteRecord(op->rhs_rec);
+		op->rhs_rec = NULL;
+	}
+}
+
+// free cached records and hash table
+static void _free_cache
+(
+	OpValueHashJoin *op
+) {
+	if(op->cached_records) {
+		uint record_count = array_len(op->cached_records);
+		for(uint i = 0; i < record_count; i++) {
+			Record r = op->cached_records[i];
+			OpBase_DeleteRecord(r);
+		}
+		array_free(op->cached_records);
+		op->cached_records = NULL;
+	}
 
-		// if the joined value is NULL
-		// it cannot be compared to other values - skip this record
-		if(SIValue_IsNull(v)) continue;
+	if(op->hashes) {
+		array_free(op->hashes);
+		op->hashes = NULL;
+	}
+
+	if(op->next) {
+		rm_free(op->next);
+		op->next = NULL;
+	}
 
-		// add joined value to record
-		Record_AddScalar(r, op->join_value_rec_idx, v);
+	if(op->buckets) {
+		rm_free(op->buckets);
+		op->buckets = NULL;
+	}
 
-		// cache the record
-		array_append(op->cached_records, r);
-	} while((r = left_child->consume(left_child)));
+	if(op->bloom) {
+		rm_free(op->bloom);
+		op->bloom = NULL;
+	}
+}
+
+// split the right hand side into spills
+// records whose spill holds no build side records are discarded
+static void _spill_probe_side
+(
+	OpValueHashJoin *op
+) {
+	ASSERT(op->spills != NULL);
+
+	OpBase *right_child = op->op.children[1];
+
+	uint n;
+	Record batch[OP_BATCH_SIZE];
+
+	while((n = OpBase_ConsumeBatch(right_child, batch, OP_BATCH_SIZE)) > 0) {
+		for(uint i = 0; i < n; i++) {
+			Record r = batch[i];
+			SIValue v = AR_EXP_Evaluate(op->rhs_exp, r);
+
+			// NULL can't be compared to other values
+			if(SIValue_IsNull(v)) {
+				OpBase_DeleteRecord(r);
+				continue;
+			}
+
+			HashJoinSpill *spill = op->spills + HASH_JOIN_SPILL(SIValue_HashCode(v));
+			if(spill->build_count == 0 && array_len(spill->build_resident) == 0) {
+				SIValue_Free(v);
+				OpBase_DeleteRecord(r);
+				continue;
+			}
+
+			// the joined value is carried within the record's pivot entry
+			// which is never set by the right hand side
+			Record_AddScalar(r, op->join_value_rec_idx, v);
+			_spill_record(&spill->probe, &spill->probe_count,
+					&spill->probe_resident, r);
+		}
+	}
+}
+
+// replace cached records with the build side of the next non empty spill
+// and build a hash table over it
+static void _load_next_spill
+(
+	OpValueHashJoin *op
+) {
+	ASSERT(op->spills != NULL);
+
+	_free_cache(op);
+	op->cached_records = array_new(Record, 32);
+	op->hashes = array_new(XXH64_hash_t, 32);
+	op->probe_read = 0;
+
+	// release the disk space of the spill we're done with
+	if(op->spill_idx >= 0) {
+		HashJoinSpill *spill = op->spills + op->spill_idx;
+		if(spill->probe != NULL) {
+			fclose(spill->probe);
+			spill->probe = NULL;
+		}
+	}
+
+	while(++op->spill_idx < HASH_JOIN_SPILL_COUNT) {
+		HashJoinSpill *spill = op->spills + op->spill_idx;
+
+		if(spill->build != NULL) {
+			rewind(spill->build);
+			for(uint64_t i = 0; i < spill->build_count; i++) {
+				Record r = OpBase_CreateRecord((OpBase *)op);
+				Record_FromStream(r, spill->build);
+				array_append(op->cached_records, r);
+			}
+			fclose(spill->build);
+			spill->build = NULL;
+			spill->build_count = 0;
+		}
+
+		if(spill->build_resident != NULL) {
+			uint resident_count = array_len(spill->build_resident);
+			for(uint i = 0; i < resident_count; i++) {
+				array_append(op->cached_records, spill->build_resident[i]);
+			}
+			array_clear(spill->build_resident);
+		}
+
+		if(array_len(op->cached_records) > 0) break;
+	}
+
+	if(op->spill_idx == HASH_JOIN_SPILL_COUNT) return;
+
+	uint32_t n = array_len(op->cached_records);
+	for(uint32_t i = 0; i < n; i++) {
+		SIValue v = Record_Get(op->cached_records[i], op->join_value_rec_idx);
+		array_append(op->hashes, SIValue_HashCode(v));
+	}
+
+	HashJoinSpill *spill = op->spills + op->spill_idx;
+	if(spill->probe != NULL) rewind(spill->probe);
+
+	_build_hash_table(op);
+}
+
+// pull the next right hand side record and evaluate its joined value
+// once spilled, probe records are read off the current spill
+// returns false when the right hand side is depleted
+static bool _pull_rhs
+(
+	OpValueHashJoin *op
+) {
+	if(op->spills == NULL) {
+		OpBase *right_child = op->op.children[1];
+		op->rhs_rec = right_child->consume(right_child);
+		if(op->rhs_rec == NULL) return false;
+
+		op->rhs_value = AR_EXP_Evaluate(op->rhs_exp, op->rhs_rec);
+		return true;
+	}
+
+	while(op->spill_idx < HASH_JOIN_SPILL_COUNT) {
+		HashJoinSpill *spill = op->spills + op->spill_idx;
+
+		if(op->probe_read < spill->probe_count) {
+			op->rhs_rec = OpBase_CreateRecord((OpBase *)op);
+			Record_FromStream(op->rhs_rec, spill->probe);
+			op->probe_read++;
+		} else if(array_len(spill->probe_resident) > 0) {
+			op->rhs_rec = array_pop(spill->probe_resident);
+		} else {
+			_load_next_spill(op);
+			continue;
+		}
+
+		// take ownership over the joined value carried by the pivot entry
+		op->rhs_value = Record_Get(op->rhs_rec, op->join_value_rec_idx);
+		Record_Remove(op->rhs_rec, op->join_value_rec_idx);
+		return true;
+	}
+
+	return false;
+}
+
+// merge cached record l with the current right hand side record
+static Record _join
+(
+	OpValueHashJoin *op,
+	Record l
+) {
+	// cached records of a spill are freed once the next spill is loaded
+	// while produced records may outlive them
+	Record c = (op->spills == NULL) ?
+		OpBase_CloneRecord(l) : OpBase_DeepCloneRecord(l);
+	Record_Merge(c, op->rhs_rec);
+	return c;
 }
 
 // string representation of operation
@@ -234,14 +557,19 @@ OpBase *NewValueHashJoin
 	AR_ExpNode *lhs_exp,
 	AR_ExpNode *rhs_exp
 ) {
-	OpValueHashJoin *op = rm_malloc(sizeof(OpValueHashJoin));
+	OpValueHashJoin *op = rm_calloc(1, sizeof(OpValueHashJoin));
+
+	op->rhs_rec        = NULL;
+	op->rhs_value      = SI_NullVal();
+	op->lhs_exp        = lhs_exp;
+	op->rhs_exp        = rhs_exp;
+	op->intersect_idx  = HASH_JOIN_END;
+	op->cached_records = NULL;
+	op->spills         = NULL;
+	op->spill_idx      = -1;
 
-	op->rhs_rec                 = NULL;
-	op->lhs_exp                 = lhs_exp;
-	op->rhs_exp                 = rhs_exp;
-	op->intersect_idx           = -1;
-	op->cached_records          = NULL;
-	op->number_of_intersections = 0;
+	op->spill_threshold = HASH_JOIN_SPILL_THRESHOLD_DISABLED;
+	Config_Option_get(Config_HASH_JOIN_SPILL_THRESHOLD, &op->spill_threshold);
 
 	// set our Op operations
 	OpBase_Init((OpBase *)op, OPType_VALUE_HASH_JOIN, "Value Hash Join",
@@ -261,13 +589,18 @@ static Record ValueHashJoinConsume
 	OpBase *opBase
 ) {
 	OpValueHashJoin *op = (OpValueHashJoin *)opBase;
-	OpBase *right_child = op->op.children[1];
 
 	// eager, pull from left branch until depleted
 	if(op->cached_records == NULL) {
 		_cache_records(op);
-		// sort cache on intersect node ID
-		_sort_cached_records(op);
+		if(op->spills == NULL) {
+			// hash cache on joined value
+			_build_hash_table(op);
+		} else {
+			// build side spilled, spill right branch and join the first spill
+			_spill_probe_side(op);
+			_load_next_spill(op);
+		}
 	}
 
 	// try to produce a record:
@@ -280,46 +613,30 @@ static Record ValueHashJoinConsume
 	// X merged with R
 
 	Record l;
-	if(op->number_of_intersections > 0) {
-		while((l = _get_intersecting_record(op))) {
-			// clone cached record before merging rhs
-			Record c = OpBase_CloneRecord(l);
-			Record_Merge(c, op->rhs_rec);
-			return c;
-		}
-	}
+	if(op->rhs_rec) {
+		l = _get_intersecting_record(op);
+		if(l) return _join(op, l);
 
-	// if we're here there are no more
-	// left hand side records which intersect with R
-	// discard R
-	if(op->rhs_rec) OpBase_DeleteRecord(op->rhs_rec);
+		// if we're here there are no more
+		// left hand side records which intersect with R
+		// discard R
+		_discard_rhs(op);
+	}
 
 	// try to get new right hand side record
 	// which intersect with a left hand side record
 	while(true) {
 		// pull from right branch
-		op->rhs_rec = right_child->consume(right_child);
-		if(!op->rhs_rec) return NULL;
-
-		// get value on which we're intersecting
-		SIValue v = AR_EXP_Evaluate(op->rhs_exp, op->rhs_rec);
+		// and get value on which we're intersecting
+		if(!_pull_rhs(op)) return NULL;
 
-		bool found_intersection = _set_intersection_idx(op, v);
-		SIValue_Free(v);
-		// no intersection, discard R
-		if(!found_intersection) {
-			OpBase_DeleteRecord(op->rhs_rec);
-			continue;
+		if(_set_intersection_idx(op)) {
+			l = _get_intersecting_record(op);
+			if(l) return _join(op, l);
 		}
 
-		// found atleast one intersecting record
-		l = _get_intersecting_record(op);
-
-		// clone cached record before merging rhs
-		Record c = OpBase_CloneRecord(l);
-		Record_Merge(c, op->rhs_rec);
-
-		return c;
+		// no intersection, discard R
+		_discard_rhs(op);
 	}
 }
 
@@ -328,24 +645,12 @@ static OpResult ValueHashJoinReset
 	OpBase *ctx
 ) {
 	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
-	op->intersect_idx = -1;
-	op->number_of_intersections = 0;
+	op->intersect_idx = HASH_JOIN_END;
 
 	// clear cached records
-	if(op->rhs_rec) {
-		OpBase_DeleteRecord(op->rhs_rec);
-		op->rhs_rec = NULL;
-	}
-
-	if(op->cached_records) {
-		uint record_count = array_len(op->cached_records);
-		for(uint i = 0; i < record_count; i++) {
-			Record r = op->cached_records[i];
-			OpBase_DeleteRecord(r);
-		}
-		array_free(op->cached_records);
-		op->cached_records = NULL;
-	}
+	_discard_rhs(op);
+	_free_cache(op);
+	_free_spills(op);
 
 	return OP_OK;
 }
@@ -365,20 +670,9 @@ static inline OpBase *ValueHashJoinClone
 static void ValueHashJoinFree(OpBase *ctx) {
 	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
 	// free cached records
-	if(op->rhs_rec) {
-		OpBase_DeleteRecord(op->rhs_rec);
-		op->rhs_rec = NULL;
-	}
-
-	if(op->cached_records) {
-		uint record_count = array_len(op->cached_records);
-		for(uint i = 0; i < record_count; i++) {
-			Record r = op->cached_records[i];
-			OpBase_DeleteRecord(r);
-		}
-		array_free(op->cached_records);
-		op->cached_records = NULL;
-	}
+	_discard_rhs(op);
+	_free_cache(op);
+	_free_spills(op);
 
 	if(op->lhs_exp) {
 		AR_EXP_Free(op->lhs_exp);
@@ -390,4 +684,3 @@ static void ValueHashJoinFree(OpBase *ctx) {
 		op->rhs_exp = NULL;
 	}
 }
-
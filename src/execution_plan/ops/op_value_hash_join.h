@@ -10,15 +10,52 @@
 #include "../execution_plan.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
+// ValueHashJoin caches its left hand side stream in a hash table keyed by
+// the left hand side joined value, each right hand side record probes the
+// table for left hand side records sharing its joined value
+//
+// the table is chained through arrays indexed by cached record position
+// large build sides are split into partitions by the high bits of the hash
+// such that each partition's buckets fit in cache while being built
+// a bloom filter discards most non-matching probes without touching buckets
+//
+// once the build side exceeds HASH_JOIN_SPILL_THRESHOLD records both sides
+// are split by hash into spills written to temporary files, spills are then
+// joined one at a time such that only a single spill's build side is held in
+// memory, in this mode records are produced grouped by spill rather than in
+// the order of the right hand side stream
+
+// a hash range of a spilled join
+typedef struct {
+	FILE *build;                        // Build side records written to disk.
+	FILE *probe;                        // Probe side records written to disk.
+	uint64_t build_count;               // Number of records in build.
+	uint64_t probe_count;               // Number of records in probe.
+	Record *build_resident;             // Build side records which can't be written.
+	Record *probe_resident;             // Probe side records which can't be written.
+} HashJoinSpill;
+
 typedef struct {
 	OpBase op;
 	Record rhs_rec;                     // Right hand side record.
+	SIValue rhs_value;                  // Right hand side joined value.
+	XXH64_hash_t rhs_hash;              // Hash of right hand side joined value.
 	AR_ExpNode *lhs_exp;                // Left hand side expression to join on.
 	AR_ExpNode *rhs_exp;                // Right hand side expression to join on.
-	int64_t intersect_idx;              // Current intersection, < number_of_intersections
+	uint32_t intersect_idx;             // Next cached record to inspect.
 	Record *cached_records;             // Cached left hand side records.
 	uint join_value_rec_idx;            // position on joined expression within record.
-	int64_t number_of_intersections;    // Number of intersections located.
+	XXH64_hash_t *hashes;               // Hash of each cached record's joined value.
+	uint32_t *next;                     // Next cached record within bucket.
+	uint32_t *buckets;                  // First cached record within bucket.
+	uint64_t bucket_mask;               // Number of buckets per partition - 1.
+	uint partition_bits;                // Log2 of the number of partitions.
+	uint64_t *bloom;                    // Bloom filter over joined value hashes.
+	uint64_t bloom_mask;                // Number of bloom filter bits - 1.
+	uint64_t spill_threshold;           // Cached records before spilling, 0 disabled.
+	HashJoinSpill *spills;              // Spilled hash ranges, NULL if in memory.
+	int spill_idx;                      // Spill currently joined.
+	uint64_t probe_read;                // Probe records read off current spill.
 } OpValueHashJoin;
 
 /* Creates a new ValueHashJoin operation */
@@ -24,6 +24,7 @@
 #include "op_optional.h"
 #include "op_argument.h"
 #include "op_distinct.h"
+#include "op_exchange.h"
 #include "op_aggregate.h"
 #include "op_semi_apply.h"
 #include "op_expand_into.h"
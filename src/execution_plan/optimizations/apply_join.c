@@ -8,6 +8,7 @@
 #include "../ops/op_filter.h"
 #include "../ops/op_value_hash_join.h"
 #include "../../util/rax_extensions.h"
+#include "cost_model.h"
 #include "../ops/op_cartesian_product.h"
 #include "../execution_plan_build/execution_plan_util.h"
 #include "../execution_plan_build/execution_plan_modify.h"
@@ -16,7 +17,7 @@
 
 /* applyJoin will try to locate situations where two disjoint
  * streams can be joined on a key attribute, in which case the
- * runtime complaxity is reduced from O(n^2) to O(nlogn + 2n)
+ * runtime complaxity is reduced from O(n^2) to O(n + m) using a hash table
  * consider MATCH (a), (b) where a.v = b.v RETURN a,b
  * prior to this optimization a and b will be combined via a
  * cartesian product O(n^2) because a and b are related,
@@ -77,11 +78,19 @@ static OpBase *_build_hash_join_op(const ExecutionPlan *plan, OpBase *left_branc
 
 	/* The Value Hash Join will cache its left-hand stream. To reduce the cache size,
 	 * prefer to cache the stream which will produce the smallest number of records.
-	 * Our current heuristic for this is to prefer a stream which contains a filter operation. */
-	bool left_branch_filtered = (ExecutionPlan_LocateOp(left_branch, OPType_FILTER) != NULL);
-	bool right_branch_filtered = (ExecutionPlan_LocateOp(right_branch, OPType_FILTER) != NULL);
-	if(!left_branch_filtered && right_branch_filtered) {
-		// Only the RHS stream is filtered, swap the input streams and expressions.
+	 * When the graph holds no statistics, prefer a stream which contains a filter operation. */
+	bool swap;
+	if(CostModel_HasStatistics()) {
+		swap = CostModel_OpCardinality(right_branch) <
+			CostModel_OpCardinality(left_branch);
+	} else {
+		bool left_branch_filtered = (ExecutionPlan_LocateOp(left_branch, OPType_FILTER) != NULL);
+		bool right_branch_filtered = (ExecutionPlan_LocateOp(right_branch, OPType_FILTER) != NULL);
+		swap = (!left_branch_filtered && right_branch_filtered);
+	}
+
+	if(swap) {
+		// The RHS stream is expected to be smaller, swap the input streams and expressions.
 		value_hash_join = NewValueHashJoin(plan, rhs_join_exp, lhs_join_exp);
 		OpBase *t = left_branch;
 		left_branch = right_branch;
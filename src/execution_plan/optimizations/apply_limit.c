@@ -39,7 +39,7 @@ static void notify_limit(OpBase *op, uint limit) {
 			((OpExpandInto *)op)->record_cap = limit;
 			break;
 		case OPType_CONDITIONAL_TRAVERSE:
-			((OpCondTraverse *)op)->record_cap = limit;
+			((OpCondTraverse *)op)->batch_limit = limit;
 			break;
 		default:
 			break;
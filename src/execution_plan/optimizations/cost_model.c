@@ -0,0 +1,577 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "cost_model.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../ops/op_filter.h"
+#include "../ops/op_expand_into.h"
+#include "../ops/op_node_by_id_seek.h"
+#include "../../schema/schema.h"
+#include "../../datatypes/array.h"
+#include "../ops/op_node_by_label_scan.h"
+#include "../ops/op_node_by_index_scan.h"
+#include "../ops/op_conditional_traverse.h"
+#include "../ops/op_cond_var_len_traverse.h"
+#include "../../filter_tree/filter_tree_utils.h"
+
+#include <math.h>
+#include <float.h>
+
+// number of elements assumed for an IN list of unknown length
+#define COST_DEFAULT_IN_LIST_LEN 3
+
+// max number of hops considered when estimating variable length traversals
+#define COST_MAX_HOPS 3
+
+static inline double _NodeCount(void) {
+	return Graph_NodeCount(QueryCtx_GetGraph());
+}
+
+// estimated number of nodes with label `label`
+static double _LabelCardinality
+(
+	const char *label
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+	if(s == NULL) return 0;
+
+	return Graph_LabeledNodeCount(gc->g, Schema_GetID(s));
+}
+
+// estimated number of edges of relationship type `relation`
+// NULL relation stands for any relationship type
+static double _RelationCardinality
+(
+	const char *relation
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	if(relation == NULL) return Graph_EdgeCount(gc->g);
+
+	Schema *s = GraphContext_GetSchema(gc, relation, SCHEMA_EDGE);
+	if(s == NULL) return 0;
+
+	return Graph_RelationEdgeCount(gc->g, Schema_GetID(s));
+}
+
+// returns true if exp is a call to the id function
+static inline bool _IsIDFunc
+(
+	const AR_ExpNode *exp
+) {
+	return (AR_EXP_IsOperation(exp) &&
+			strcasecmp(AR_EXP_GetFuncName(exp), "id") == 0);
+}
+
+// schema of node label `label`, NULL if label doesn't exist
+static const Schema *_LabelSchema
+(
+	const char *label
+) {
+	if(label == NULL) return NULL;
+	return GraphContext_GetSchema(QueryCtx_GetGraphCtx(), label, SCHEMA_NODE);
+}
+
+// value statistics of the attribute accessed by `exp` under schema `s`
+// NULL if `exp` isn't an attribute access or the attribute has no statistics
+static const AttributeStatistics *_AttributeStatistics
+(
+	const Schema *s,
+	const AR_ExpNode *exp
+) {
+	char *attr;
+	if(s == NULL || !AR_EXP_IsAttribute(exp, &attr)) return NULL;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID id = GraphContext_GetAttributeID(gc, attr);
+	if(id == ATTRIBUTE_ID_NONE) return NULL;
+
+	return Schema_GetStatistics(s, id);
+}
+
+// fraction of schema `s` entities holding the attribute described by `stats`
+static double _AttributeShare
+(
+	const Schema *s,
+	const AttributeStatistics *stats
+) {
+	double card = Graph_LabeledNodeCount(QueryCtx_GetGraph(), Schema_GetID(s));
+	if(card == 0) return 0;
+
+	return MIN(1.0, AttributeStatistics_Count(stats) / card);
+}
+
+// retrieves the value of a constant or parameter expression
+// returns false if the value is only known at runtime
+static bool _ExpressionValue
+(
+	AR_ExpNode *exp,
+	SIValue *v
+) {
+	if(AR_EXP_IsConstant(exp)) {
+		*v = exp->operand.constant;
+		return true;
+	}
+
+	if(AR_EXP_IsParameter(exp)) {
+		*v = AR_EXP_Evaluate(exp, NULL);
+		return true;
+	}
+
+	return false;
+}
+
+// mirror operator, a < b <=> b > a
+static AST_Operator _MirrorOp
+(
+	AST_Operator op
+) {
+	switch(op) {
+		case OP_LT:
+			return OP_GT;
+		case OP_GT:
+			return OP_LT;
+		case OP_LE:
+			return OP_GE;
+		case OP_GE:
+			return OP_LE;
+		default:
+			return op;
+	}
+}
+
+// estimate predicate selectivity using the value statistics of schema `s`
+// returns false if the predicate isn't of the form `n.attr OP exp`
+// or the attribute has no statistics
+static bool _StatisticsPredicateSelectivity
+(
+	const FT_FilterNode *f,
+	const Schema *s,
+	double *sel
+) {
+	AST_Operator op = f->pred.op;
+	AR_ExpNode *value_exp = f->pred.rhs;
+	const AttributeStatistics *stats = _AttributeStatistics(s, f->pred.lhs);
+
+	if(stats == NULL) {
+		// exp OP n.attr
+		op = _MirrorOp(op);
+		value_exp = f->pred.lhs;
+		stats = _AttributeStatistics(s, f->pred.rhs);
+	}
+
+	if(stats == NULL) return false;
+
+	SIValue v;
+	bool known = _ExpressionValue(value_exp, &v);
+	double share = _AttributeShare(s, stats);
+
+	bool res = true;
+	switch(op) {
+		case OP_EQUAL:
+			*sel = share *
+				AttributeStatistics_EqualitySelectivity(stats, known ? &v : NULL);
+			break;
+		case OP_NEQUAL:
+			*sel = share * (1.0 -
+				AttributeStatistics_EqualitySelectivity(stats, known ? &v : NULL));
+			break;
+		case OP_LT:
+		case OP_LE:
+		case OP_GT:
+		case OP_GE:
+			if(known && SI_TYPE(v) & SI_NUMERIC) {
+				bool less = (op == OP_LT || op == OP_LE);
+				*sel = share * AttributeStatistics_RangeSelectivity(stats,
+						SI_GET_NUMERIC(v), less);
+			} else {
+				*sel = share * COST_RANGE_SELECTIVITY;
+			}
+			break;
+		default:
+			res = false;
+			break;
+	}
+
+	if(known) SIValue_Free(v);
+	return res;
+}
+
+static double _PredicateSelectivity
+(
+	const FT_FilterNode *f,
+	const Schema *s
+) {
+	ASSERT(f->t == FT_N_PRED);
+
+	double sel;
+	if(_StatisticsPredicateSelectivity(f, s, &sel)) return sel;
+
+	double eq = COST_EQ_SELECTIVITY;
+
+	// ID(n) = x matches a single node
+	if(_IsIDFunc(f->pred.lhs) || _IsIDFunc(f->pred.rhs)) {
+		eq = 1.0 / MAX(1.0, _NodeCount());
+	}
+
+	switch(f->pred.op) {
+		case OP_EQUAL:
+			return eq;
+		case OP_NEQUAL:
+			return 1.0 - eq;
+		case OP_LT:
+		case OP_GT:
+		case OP_LE:
+		case OP_GE:
+			return COST_RANGE_SELECTIVITY;
+		default:
+			return COST_DEFAULT_SELECTIVITY;
+	}
+}
+
+static double _ExpressionSelectivity
+(
+	const FT_FilterNode *f,
+	const Schema *s
+) {
+	ASSERT(f->t == FT_N_EXP);
+
+	if(!isInFilter(f)) return COST_DEFAULT_SELECTIVITY;
+
+	AR_ExpNode *list = f->exp.exp->op.children[1];
+	bool constant_list = (AR_EXP_IsConstant(list) &&
+			SI_TYPE(list->operand.constant) == T_ARRAY);
+
+	// n.attr IN [v0, v1, ...] sums the frequencies of each value
+	const AttributeStatistics *stats =
+		_AttributeStatistics(s, f->exp.exp->op.children[0]);
+	if(stats != NULL && constant_list) {
+		SIValue values = list->operand.constant;
+		uint32_t n = SIArray_Length(values);
+		double sel = 0;
+		for(uint32_t i = 0; i < n; i++) {
+			SIValue v = SIArray_Get(values, i);
+			sel += AttributeStatistics_EqualitySelectivity(stats, &v);
+		}
+		return _AttributeShare(s, stats) * MIN(1.0, sel);
+	}
+
+	// x IN [v0, v1, ...] behaves like a disjunction of equalities
+	double n = COST_DEFAULT_IN_LIST_LEN;
+	if(constant_list) n = SIArray_Length(list->operand.constant);
+
+	return 1.0 - pow(1.0 - COST_EQ_SELECTIVITY, n);
+}
+
+// estimated fraction of schema `s` entities passing filter `f`
+// `s` may be NULL in which case default selectivities are used
+static double _FilterSelectivity
+(
+	const FT_FilterNode *f,
+	const Schema *s
+) {
+	ASSERT(f != NULL);
+
+	switch(f->t) {
+		case FT_N_PRED:
+			return _PredicateSelectivity(f, s);
+		case FT_N_EXP:
+			return _ExpressionSelectivity(f, s);
+		case FT_N_COND: {
+			double l = _FilterSelectivity(f->cond.left, s);
+			// NOT has a single child
+			if(f->cond.op == OP_NOT) return 1.0 - l;
+			double r = _FilterSelectivity(f->cond.right, s);
+			switch(f->cond.op) {
+				case OP_AND:
+					return l * r;
+				case OP_OR:
+					return l + r - l * r;
+				case OP_XOR:
+					return l + r - 2 * l * r;
+				default:
+					return COST_DEFAULT_SELECTIVITY;
+			}
+		}
+		default:
+			ASSERT(false);
+			return COST_DEFAULT_SELECTIVITY;
+	}
+}
+
+// returns true if the selectivity of every predicate in `f`
+// is estimated using the value statistics of schema `s`
+static bool _InformedSelectivity
+(
+	const FT_FilterNode *f,
+	const Schema *s
+) {
+	switch(f->t) {
+		case FT_N_PRED:
+			return (_AttributeStatistics(s, f->pred.lhs) != NULL ||
+					_AttributeStatistics(s, f->pred.rhs) != NULL);
+		case FT_N_EXP:
+			return (isInFilter(f) &&
+					_AttributeStatistics(s, f->exp.exp->op.children[0]) != NULL);
+		case FT_N_COND:
+			if(!_InformedSelectivity(f->cond.left, s)) return false;
+			return (f->cond.op == OP_NOT ||
+					_InformedSelectivity(f->cond.right, s));
+		default:
+			return false;
+	}
+}
+
+bool CostModel_HasStatistics(void) {
+	return _NodeCount() > 0;
+}
+
+// estimated number of nodes matching query node `n` labels
+double CostModel_NodeCardinality
+(
+	const QGNode *n  // query node
+) {
+	ASSERT(n != NULL);
+
+	uint label_count = QGNode_LabelCount(n);
+	if(label_count == 0) return _NodeCount();
+
+	// nodes must carry every label, bounded by the smallest label
+	double card = DBL_MAX;
+	for(uint i = 0; i < label_count; i++) {
+		card = MIN(card, _LabelCardinality(QGNode_GetLabel(n, i)));
+	}
+
+	return card;
+}
+
+// estimated fraction of entities passing filter `f`
+double CostModel_FilterSelectivity
+(
+	const FT_FilterNode *f  // filter
+) {
+	return _FilterSelectivity(f, NULL);
+}
+
+// estimated fraction of nodes labeled `label` passing filter `f`
+double CostModel_LabelFilterSelectivity
+(
+	const FT_FilterNode *f,  // filter
+	const char *label        // filtered nodes label
+) {
+	return _FilterSelectivity(f, _LabelSchema(label));
+}
+
+// estimated fraction of query node `n` entities passing the filters in `ft`
+// only filters referring to `n` alone are considered
+double CostModel_AliasSelectivity
+(
+	const FT_FilterNode *ft,  // filter tree
+	const QGNode *n           // filtered query node
+) {
+	ASSERT(n != NULL);
+
+	if(ft == NULL) return 1.0;
+
+	// estimate using the statistics of the node's smallest label
+	const char *label = NULL;
+	double card = DBL_MAX;
+	uint label_count = QGNode_LabelCount(n);
+	for(uint i = 0; i < label_count; i++) {
+		double c = _LabelCardinality(QGNode_GetLabel(n, i));
+		if(c < card) {
+			card  = c;
+			label = QGNode_GetLabel(n, i);
+		}
+	}
+	const Schema *s = _LabelSchema(label);
+
+	double sel = 1.0;
+	const char *alias = n->alias;
+	size_t len = strlen(alias);
+	const FT_FilterNode **sub_trees = FilterTree_SubTrees(ft);
+	uint sub_tree_count = array_len(sub_trees);
+
+	for(uint i = 0; i < sub_tree_count; i++) {
+		const FT_FilterNode *t = sub_trees[i];
+		rax *modified = FilterTree_CollectModified(t);
+
+		// filter applies to alias alone
+		if(raxSize(modified) == 1 &&
+		   raxFind(modified, (unsigned char *)alias, len) != raxNotFound) {
+			sel *= _FilterSelectivity(t, s);
+		}
+
+		raxFree(modified);
+	}
+
+	array_free(sub_trees);
+	return sel;
+}
+
+// returns true if an index scan over nodes labeled `label` resolving
+// filter `f` is expected to be cheaper than scanning the label
+bool CostModel_IndexScanBeneficial
+(
+	const FT_FilterNode *f,  // filter resolved by the index
+	const char *label        // scanned label
+) {
+	ASSERT(f     != NULL);
+	ASSERT(label != NULL);
+
+	if(_LabelCardinality(label) < COST_INDEX_SCAN_MIN_NODES) return true;
+
+	// without value statistics the index is assumed to be selective
+	const Schema *s = _LabelSchema(label);
+	if(s == NULL || !_InformedSelectivity(f, s)) return true;
+
+	// an index scan producing most of the label's nodes costs more than
+	// scanning the label and evaluating the filter
+	return _FilterSelectivity(f, s) <= COST_INDEX_SCAN_MAX_SELECTIVITY;
+}
+
+// estimated number of records produced for a single input record
+// by evaluating `exp`
+double CostModel_ExpressionFanout
+(
+	const AlgebraicExpression *exp  // traversal expression
+) {
+	ASSERT(exp != NULL);
+
+	if(exp->type == AL_OPERAND) {
+		double nodes = _NodeCount();
+		if(nodes == 0) return 0;
+
+		if(exp->operand.diagonal) {
+			// label matrix, fraction of nodes carrying the label
+			if(exp->operand.label == NULL) return 1.0;
+			return _LabelCardinality(exp->operand.label) / nodes;
+		}
+
+		// relation matrix, average number of outgoing edges per node
+		return _RelationCardinality(exp->operand.label) / nodes;
+	}
+
+	uint child_count = AlgebraicExpression_ChildCount(exp);
+	AlgebraicExpression **children = exp->operation.children;
+
+	switch(exp->operation.op) {
+		case AL_EXP_MUL: {
+			double fanout = 1.0;
+			for(uint i = 0; i < child_count; i++) {
+				fanout *= CostModel_ExpressionFanout(children[i]);
+			}
+			return fanout;
+		}
+		case AL_EXP_ADD: {
+			double fanout = 0.0;
+			for(uint i = 0; i < child_count; i++) {
+				fanout += CostModel_ExpressionFanout(children[i]);
+			}
+			return fanout;
+		}
+		case AL_EXP_TRANSPOSE:
+			// average in-degree equals average out-degree
+			return CostModel_ExpressionFanout(children[0]);
+		default:
+			return 1.0;
+	}
+}
+
+// estimated number of records produced by a variable length traversal
+// for a single input record
+static double _VarLenFanout
+(
+	const CondVarLenTraverse *op
+) {
+	double fanout = 0;
+	double step = CostModel_ExpressionFanout(op->ae);
+	uint max_hops = MIN(op->maxHops, COST_MAX_HOPS);
+
+	// sum number of paths for each considered length
+	for(uint hops = op->minHops; hops <= max_hops; hops++) {
+		fanout += pow(step, hops);
+	}
+
+	return MAX(fanout, 1.0);
+}
+
+// estimated number of records produced by the op tree rooted at `op`
+double CostModel_OpCardinality
+(
+	const OpBase *op  // root of op tree
+) {
+	ASSERT(op != NULL);
+
+	// number of records fed into op
+	double input = 1.0;
+	if(op->childCount > 0) input = CostModel_OpCardinality(op->children[0]);
+
+	switch(op->type) {
+		case OPType_ALL_NODE_SCAN:
+			return input * _NodeCount();
+
+		case OPType_NODE_BY_LABEL_SCAN:
+		case OPType_NODE_BY_LABEL_AND_ID_SCAN: {
+			const NodeByLabelScan *scan = (const NodeByLabelScan *)op;
+			return input * _LabelCardinality(scan->n->label);
+		}
+
+		case OPType_NODE_BY_INDEX_SCAN: {
+			const IndexScan *scan = (const IndexScan *)op;
+			return input * _LabelCardinality(scan->n->label) *
+				CostModel_LabelFilterSelectivity(scan->filter, scan->n->label);
+		}
+
+		case OPType_NODE_BY_ID_SEEK: {
+			const NodeByIdSeek *seek = (const NodeByIdSeek *)op;
+			double range = (double)seek->maxId - (double)seek->minId + 1;
+			return input * MAX(0, MIN(range, _NodeCount()));
+		}
+
+		case OPType_CONDITIONAL_TRAVERSE: {
+			const OpCondTraverse *traverse = (const OpCondTraverse *)op;
+			return input * CostModel_ExpressionFanout(traverse->ae);
+		}
+
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO:
+			return input * _VarLenFanout((const CondVarLenTraverse *)op);
+
+		case OPType_EXPAND_INTO: {
+			// probability of both ends being connected
+			const OpExpandInto *expand = (const OpExpandInto *)op;
+			double fanout = CostModel_ExpressionFanout(expand->ae);
+			return input * MIN(1.0, fanout / MAX(1.0, _NodeCount()));
+		}
+
+		case OPType_FILTER: {
+			const OpFilter *filter = (const OpFilter *)op;
+			return input * CostModel_FilterSelectivity(filter->filterTree);
+		}
+
+		case OPType_CARTESIAN_PRODUCT: {
+			double card = 1.0;
+			for(uint i = 0; i < op->childCount; i++) {
+				card *= CostModel_OpCardinality(op->children[i]);
+			}
+			return card;
+		}
+
+		case OPType_VALUE_HASH_JOIN: {
+			// assume each joined value appears once on the larger side
+			double l = input;
+			double r = CostModel_OpCardinality(op->children[1]);
+			return (l * r) / MAX(1.0, MAX(l, r));
+		}
+
+		default:
+			// assume op doesn't change the number of records
+			return input;
+	}
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../ops/op.h"
+#include "../../graph/query_graph.h"
+#include "../../filter_tree/filter_tree.h"
+#include "../../arithmetic/algebraic_expression.h"
+
+// the cost model estimates the number of records produced by parts of a plan
+// estimates are derived from the graph statistics, per label node counts
+// and per relationship-type edge counts, combined with predicate selectivities
+// predicates on attributes of a known label are estimated using the label's
+// attribute value statistics, otherwise default selectivities are used
+//
+// estimates are only meaningful relative to one another, optimizations use
+// them to choose between alternative plans e.g. which end of a pattern to
+// start traversing from or which stream to cache when joining
+
+// default selectivity of an equality predicate
+#define COST_EQ_SELECTIVITY 0.1
+
+// default selectivity of a range predicate
+#define COST_RANGE_SELECTIVITY (1.0 / 3.0)
+
+// default selectivity of a predicate we can't reason about
+#define COST_DEFAULT_SELECTIVITY 0.5
+
+// max fraction of a label's nodes an index scan is expected to produce
+// for it to be preferred over a label scan
+#define COST_INDEX_SCAN_MAX_SELECTIVITY 0.5
+
+// min number of labeled nodes for an index scan to be reconsidered
+// estimates over few nodes are unreliable and both scans are cheap
+#define COST_INDEX_SCAN_MIN_NODES 1000
+
+// returns true if the graph holds entities, otherwise all estimates are 0
+// and callers should fall back to heuristics
+bool CostModel_HasStatistics(void);
+
+// estimated number of nodes matching query node `n` labels
+double CostModel_NodeCardinality
+(
+	const QGNode *n  // query node
+);
+
+// estimated fraction of entities passing filter `f`
+double CostModel_FilterSelectivity
+(
+	const FT_FilterNode *f  // filter
+);
+
+// estimated fraction of nodes labeled `label` passing filter `f`
+double CostModel_LabelFilterSelectivity
+(
+	const FT_FilterNode *f,  // filter
+	const char *label        // filtered nodes label
+);
+
+// estimated fraction of query node `n` entities passing the filters in `ft`
+// only filters referring to `n` alone are considered
+double CostModel_AliasSelectivity
+(
+	const FT_FilterNode *ft,  // filter tree
+	const QGNode *n           // filtered query node
+);
+
+// returns true if an index scan over nodes labeled `label` resolving
+// filter `f` is expected to be cheaper than scanning the label
+bool CostModel_IndexScanBeneficial
+(
+	const FT_FilterNode *f,  // filter resolved by the index
+	const char *label        // scanned label
+);
+
+// estimated number of records produced for a single input record
+// by evaluating `exp`
+double CostModel_ExpressionFanout
+(
+	const AlgebraicExpression *exp  // traversal expression
+);
+
+// estimated number of records produced by the op tree rooted at `op`
+double CostModel_OpCardinality
+(
+	const OpBase *op  // root of op tree
+);
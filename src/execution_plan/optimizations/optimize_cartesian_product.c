@@ -5,6 +5,7 @@
  */
 
 #include "RG.h"
+#include "cost_model.h"
 #include "../../errors.h"
 #include "../ops/op_filter.h"
 #include "../ops/op_cartesian_product.h"
@@ -118,12 +119,73 @@ static OpBase **_find_entities_solving_branches(rax *entities, OpBase *cp) {
 	return solving_branches;
 }
 
+// estimated number of records passing the filter
+// if it was applied to a cartesian product of the branches solving it
+static double _estimate_filtered_product
+(
+	const FilterCtx *ctx,
+	OpBase *cp
+) {
+	rax *entities = raxClone(ctx->entities);
+	uint64_t entities_count = raxSize(entities);
+	double card = 1;
+
+	for(int i = 0; i < cp->childCount && entities_count > 0; i++) {
+		OpBase *branch = cp->children[i];
+		OpBase *recurse_limit = ExecutionPlan_LocateOpMatchingTypes(branch,
+				PROJECT_OPS, PROJECT_OP_COUNT);
+		ExecutionPlan_LocateReferences(branch, recurse_limit, entities);
+		if(raxSize(entities) != entities_count) {
+			entities_count = raxSize(entities);
+			card *= CostModel_OpCardinality(branch);
+		}
+	}
+
+	raxFree(entities);
+	return card * CostModel_FilterSelectivity(ctx->filter->filterTree);
+}
+
+// greedy join ordering
+// moves the filter estimated to produce the fewest records out of
+// the first `n` filters to the front
+// the branches combined by each filter depend on the filters applied before it
+// as such estimates are recomputed after every filter is placed
+static void _select_next_filter
+(
+	FilterCtx *filters,
+	uint n,
+	OpBase *cp
+) {
+	if(n < 2) return;
+
+	uint best = 0;
+	double best_card = _estimate_filtered_product(filters, cp);
+	for(uint i = 1; i < n; i++) {
+		double card = _estimate_filtered_product(filters + i, cp);
+		if(card < best_card) {
+			best = i;
+			best_card = card;
+		}
+	}
+
+	FilterCtx tmp = filters[0];
+	filters[0]    = filters[best];
+	filters[best] = tmp;
+}
+
 static void _optimize_cartesian_product(ExecutionPlan *plan, OpBase *cp) {
 	// Retrieve all filter operations located upstream from the Cartesian Product.
 	FilterCtx *filter_ctx_arr = _locate_filters_and_entities(cp);
 	uint filter_count = array_len(filter_ctx_arr);
 
+	// without statistics filters are applied by their number of references
+	bool estimate = CostModel_HasStatistics();
+
 	for(uint i = 0; i < filter_count; i ++) {
+		if(estimate) {
+			_select_next_filter(filter_ctx_arr + i, filter_count - i, cp);
+		}
+
 		// Try to create a cartesian product, followed by the current filter.
 		OpFilter *filter_op = filter_ctx_arr[i].filter;
 		OpBase **solving_branches = _find_entities_solving_branches(filter_ctx_arr[i].entities, cp);
@@ -198,3 +260,44 @@ void reduceCartesianProductStreamCount(ExecutionPlan *plan) {
 	array_free(cps);
 }
 
+// orders cartesian product streams by their estimated number of records
+// the first stream is re-evaluated for every combination of records produced
+// by the following streams, while the last stream is evaluated only once
+// the total work is minimized by placing the smallest stream last
+static void _order_cartesian_product_streams
+(
+	OpBase *cp
+) {
+	uint n = cp->childCount;
+	double card[n];
+	for(uint i = 0; i < n; i++) {
+		card[i] = CostModel_OpCardinality(cp->children[i]);
+	}
+
+	// stable insertion sort, descending by estimated cardinality
+	for(uint i = 1; i < n; i++) {
+		double c = card[i];
+		OpBase *child = cp->children[i];
+		int j = i - 1;
+		while(j >= 0 && card[j] < c) {
+			card[j + 1] = card[j];
+			cp->children[j + 1] = cp->children[j];
+			j--;
+		}
+		card[j + 1] = c;
+		cp->children[j + 1] = child;
+	}
+}
+
+void orderCartesianProductStreams(ExecutionPlan *plan) {
+	// without statistics all streams are estimated equally
+	if(!CostModel_HasStatistics()) return;
+
+	OpBase **cps = ExecutionPlan_CollectOps(plan->root, OPType_CARTESIAN_PRODUCT);
+	uint cp_count = array_len(cps);
+
+	for(uint i = 0; i < cp_count ; i++) {
+		_order_cartesian_product_streams(cps[i]);
+	}
+	array_free(cps);
+}
@@ -42,6 +42,9 @@ void optimizePlan(ExecutionPlan *plan) {
 	// try to match disjoint entities by applying a join
 	applyJoin(plan);
 
+	// order remaining cartesian product streams by their estimated size
+	orderCartesianProductStreams(plan);
+
 	// try to reduce a number of filters into a single filter op
 	reduceFilters(plan);
 
@@ -58,7 +61,13 @@ void optimizePlan(ExecutionPlan *plan) {
 	// let operations know about specified limit(s)
 	applyLimit(plan);
 
+	// replace limited sorts with index scans producing the requested order
+	utilizeIndexOrder(plan);
+
 	// let operations know about specified skip(s)
 	applySkip(plan);
+
+	// split large scans feeding eager operations across multiple threads
+	parallelizeScans(plan);
 }
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../ops/op_exchange.h"
+#include "../execution_plan.h"
+#include "../../configuration/config.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// parallelizeScans looks for a stream of record independent operations
+// e.g. filters and traversals fed by a label or full node scan
+// which is consumed by an aggregation, sort or the final projection
+// once found, an Exchange operation is placed on top of the stream
+// at runtime the exchange splits the scan into node ID ranges (morsels)
+// each processed by a private clone of the stream on a reader thread
+// morsels are emitted in ID order, records are produced in the same order
+// as a serial scan would, making the final projection a valid anchor
+//
+// MATCH (a:A)-[:R]->(b) WHERE b.v > 1 RETURN count(a)
+//
+// Aggregate
+//     Filter
+//         Conditional Traverse
+//             Node By Label Scan
+//
+// becomes:
+//
+// Aggregate
+//     Exchange
+//         Filter
+//             Conditional Traverse
+//                 Node By Label Scan
+//
+// only read-only plans consisting of a single stream are considered
+
+// returns true if op processes each record independently
+static bool _StreamingOp
+(
+	const OpBase *op
+) {
+	switch(op->type) {
+		case OPType_FILTER:
+		case OPType_EXPAND_INTO:
+		case OPType_CONDITIONAL_TRAVERSE:
+			return true;
+		default:
+			return false;
+	}
+}
+
+// returns true if the ops under `op` form a stream of streaming ops
+// ending with a scan which can be split into morsels
+static bool _ParallelizableStream
+(
+	const OpBase *op
+) {
+	const ExecutionPlan *plan = op->plan;
+
+	while(op->childCount > 0) {
+		if(op->childCount != 1) return false;
+		if(op->plan != plan)    return false;
+		if(!_StreamingOp(op))   return false;
+		op = op->children[0];
+	}
+
+	return (op->plan == plan && ExchangeOp_SplittableScan(op));
+}
+
+// returns true if op consumes its entire input stream
+// and is a valid merge point for parallel streams
+static bool _ExchangeAnchor
+(
+	const OpBase *op
+) {
+	switch(op->type) {
+		case OPType_SORT:
+		case OPType_AGGREGATE:
+			return true;
+		case OPType_PROJECT:
+			// final projection
+			return (op->parent != NULL && op->parent->type == OPType_RESULTS);
+		default:
+			return false;
+	}
+}
+
+void parallelizeScans
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	uint64_t workers;
+	Config_Option_get(Config_PARALLEL_SCAN_WORKERS, &workers);
+	if(workers < 2) return;
+
+	// walk down the plan, making sure it is a read-only single stream
+	OpBase *op = plan->root;
+	while(op != NULL && op->childCount == 1) {
+		if(OpBase_IsWriter(op)) return;
+
+		OpBase *child = op->children[0];
+		if(_ExchangeAnchor(op) && _ParallelizableStream(child)) {
+			// place exchange between anchor and the stream feeding it
+			ExecutionPlan_PushBelow(child, NewExchangeOp(child->plan));
+			return;
+		}
+
+		op = child;
+	}
+}
+
@@ -8,10 +8,54 @@
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 #include "../../arithmetic/algebraic_expression/utils.h"
+#include "cost_model.h"
 #include "traverse_order_utils.h"
 
+#include <float.h>
 #include <stdlib.h>
 
+// estimated number of records produced by scanning `alias`
+// bound aliases are already resolved and cost nothing
+static double _alias_cost
+(
+	const QueryGraph *qg,
+	const char *alias,
+	const FT_FilterNode *ft,
+	rax *bound_vars
+) {
+	if(bound_vars != NULL &&
+	   raxFind(bound_vars, (unsigned char *)alias, strlen(alias)) != raxNotFound) {
+		return 0;
+	}
+
+	QGNode *n = QueryGraph_GetNodeByAlias(qg, alias);
+	ASSERT(n != NULL);
+
+	return CostModel_NodeCardinality(n) * CostModel_AliasSelectivity(ft, n);
+}
+
+// estimated number of records produced by the cheapest end of `exp`
+static double _expression_cost
+(
+	const QueryGraph *qg,
+	AlgebraicExpression *exp,
+	const FT_FilterNode *ft,
+	rax *bound_vars
+) {
+	// variable length traversals should never be the opening expression
+	// unless there's no other alternative
+	const char *edge_alias = AlgebraicExpression_Edge(exp);
+	if(edge_alias != NULL) {
+		QGEdge *e = QueryGraph_GetEdgeByAlias(qg, edge_alias);
+		if(e != NULL && QGEdge_VariableLength(e)) return DBL_MAX;
+	}
+
+	double src  = _alias_cost(qg, AlgebraicExpression_Src(exp), ft, bound_vars);
+	double dest = _alias_cost(qg, AlgebraicExpression_Dest(exp), ft, bound_vars);
+
+	return MIN(src, dest);
+}
+
 // having chosen which algebraic expression will be evaluated first
 // determine whether it is worthwhile to transpose it
 // thus swap the source and destination
@@ -19,6 +63,7 @@ static bool _should_transpose_entry_point
 (
 	const QueryGraph *qg,
 	AlgebraicExpression *ae,
+	const FT_FilterNode *ft,
 	rax *filtered_entities,
 	rax *bound_vars
 ) {
@@ -32,6 +77,13 @@ static bool _should_transpose_entry_point
 	const char *src  = AlgebraicExpression_Src(ae);
 	const char *dest = AlgebraicExpression_Dest(ae);
 
+	// start from the end expected to produce fewer records
+	if(CostModel_HasStatistics()) {
+		double src_cost  = _alias_cost(qg, src, ft, bound_vars);
+		double dest_cost = _alias_cost(qg, dest, ft, bound_vars);
+		if(src_cost != dest_cost) return dest_cost < src_cost;
+	}
+
 	ScoredExp scored_exp[2];
 	AlgebraicExpression *exps[2];
 	exps[0] = AlgebraicExpression_NewOperand(GrB_NULL, false, src, src, NULL,
@@ -199,11 +251,13 @@ static void _order_expressions
 	ASSERT(res == true);
 }
 
+// orders expressions by estimated cost, ties are broken by score
 static int _score_cmp
 (
 	const ScoredExp *a,
 	const ScoredExp *b
 ) {
+	if(a->cost != b->cost) return (a->cost < b->cost) ? -1 : 1;
 	return b->score - a->score;
 }
 
@@ -244,7 +298,17 @@ void orderExpressions
 	TraverseOrder_ScoreExpressions(scored_exps, exps, _exp_count, bound_vars,
 								   filtered_entities, qg);
 
-	// sort scored_exps on score in descending order
+	// estimate the cost of opening with each expression
+	// without statistics all costs are equal and ordering is left to scores
+	bool has_statistics = CostModel_HasStatistics();
+	for(uint i = 0; i < _exp_count; i++) {
+		scored_exps[i].cost = (has_statistics)
+			? _expression_cost(qg, scored_exps[i].exp, ft, bound_vars)
+			: 0;
+	}
+
+	// sort scored_exps on cost in ascending order, then on score in
+	// descending order
 	qsort(scored_exps, _exp_count, sizeof(ScoredExp),
 			(int(*)(const void*, const void*))_score_cmp);
 
@@ -263,7 +327,7 @@ void orderExpressions
 
 	// transpose the winning expression if the destination node is a more
 	// efficient starting point
-	if(_should_transpose_entry_point(qg, exps[0], filtered_entities,
+	if(_should_transpose_entry_point(qg, exps[0], ft, filtered_entities,
 									 bound_vars)) {
 		AlgebraicExpression_Transpose(exps);
 	}
@@ -13,6 +13,7 @@
 // algebraic expression associated with a score
 typedef struct {
 	int score;                 // score given to expression
+	double cost;               // estimated number of records to start from
 	AlgebraicExpression *exp;  // algebraic expression
 } ScoredExp;
 
@@ -0,0 +1,161 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../../query_ctx.h"
+#include "../ops/op_sort.h"
+#include "../ops/op_project.h"
+#include "../execution_plan.h"
+#include "../ops/op_node_by_index_scan.h"
+#include "../../ast/ast_build_op_contexts.h"
+#include "../../filter_tree/ft_to_ordered_ranges.h"
+#include "../execution_plan_build/execution_plan_util.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// utilizeIndexOrder looks for a limited sort over a single attribute
+// of nodes produced by a native index scan
+// when the scanned range covers values of a single type, the index
+// produces nodes in the requested order and the sort is redundant
+//
+// MATCH (n:Event) WHERE n.ts > $t RETURN n ORDER BY n.ts DESC LIMIT 20
+//
+// Results
+//     Limit
+//         Sort
+//             Project
+//                 Node By Index Scan
+//
+// becomes:
+//
+// Results
+//     Limit
+//         Project
+//             Node By Index Scan (descending)
+//
+// the limit stops pulling from the scan once enough records were produced
+// only read-only plans are considered, as modifications made while streaming
+// might reorder the index
+
+// returns true if plan contains an operation which modifies the graph
+static bool _ContainsWriter
+(
+	const OpBase *op
+) {
+	if(OpBase_IsWriter((OpBase *)op)) return true;
+
+	for(uint i = 0; i < op->childCount; i++) {
+		if(_ContainsWriter(op->children[i])) return true;
+	}
+
+	return false;
+}
+
+// returns projected expression named `name`, NULL if missing
+static AR_ExpNode *_ProjectedExp
+(
+	const OpProject *project,
+	const char *name
+) {
+	uint n = array_len(project->exps);
+	for(uint i = 0; i < n; i++) {
+		AR_ExpNode *exp = project->exps[i];
+		if(strcmp(exp->resolved_name, name) == 0) return exp;
+	}
+
+	return NULL;
+}
+
+// returns the index scan feeding `op` through filters, NULL if missing
+static IndexScan *_FeedingIndexScan
+(
+	OpBase *op
+) {
+	while(op->type == OPType_FILTER) {
+		if(op->childCount != 1) return NULL;
+		op = op->children[0];
+	}
+
+	// scans fed by child records restart for every input record
+	if(op->type != OPType_NODE_BY_INDEX_SCAN || op->childCount != 0) {
+		return NULL;
+	}
+
+	return (IndexScan *)op;
+}
+
+// try to replace `sort` with an ordered index scan
+static void _SortByIndex
+(
+	ExecutionPlan *plan,
+	OpSort *sort
+) {
+	// sort must be limited and order by a single expression
+	if(sort->limit == UNLIMITED)     return;
+	if(array_len(sort->exps) != 1)   return;
+	if(sort->op.childCount != 1)     return;
+
+	OpBase *child = sort->op.children[0];
+	if(child->type != OPType_PROJECT || child->childCount != 1) return;
+
+	// sort expression is projected as an attribute of a node: n.ts
+	AR_ExpNode *exp = _ProjectedExp((OpProject *)child,
+			sort->exps[0]->resolved_name);
+	if(exp == NULL) return;
+
+	char *attr_name = NULL;
+	if(!AR_EXP_IsAttribute(exp, &attr_name)) return;
+
+	AR_ExpNode *entity = exp->op.children[0];
+	if(!AR_EXP_IsVariadic(entity)) return;
+
+	// node is produced by a native index over the sorted attribute
+	IndexScan *scan = _FeedingIndexScan(child->children[0]);
+	if(scan == NULL) return;
+	if(strcmp(scan->n->alias, entity->operand.variadic.entity_alias) != 0) {
+		return;
+	}
+	if(Index_OrderedIndex(scan->idx) == NULL) return;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr = GraphContext_GetAttributeID(gc, attr_name);
+	if(attr == ATTRIBUTE_ID_NONE) return;
+	if(!Index_ContainsAttribute(scan->idx, attr)) return;
+
+	// the scan's filter must reduce to a single range over the attribute
+	// parameters are known at this point
+	OrderedIndexRange *ranges = NULL;
+	if(!FilterTreeToOrderedRanges(&ranges, scan->filter, gc)) return;
+
+	if(array_len(ranges) == 1 && ranges[0].attr == attr &&
+	   OrderedIndexRange_Ordered(ranges)) {
+		OrderedIndexRange *range = rm_malloc(sizeof(OrderedIndexRange));
+		*range = OrderedIndexRange_Clone(ranges);
+		IndexScanOp_SetOrder(scan, range, sort->directions[0] == DIR_DESC);
+
+		ExecutionPlan_RemoveOp(plan, (OpBase *)sort);
+		OpBase_Free((OpBase *)sort);
+	}
+
+	OrderedRanges_Free(ranges);
+}
+
+void utilizeIndexOrder
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	if(_ContainsWriter(plan->root)) return;
+
+	OpBase **sorts = ExecutionPlan_CollectOps(plan->root, OPType_SORT);
+
+	uint n = array_len(sorts);
+	for(uint i = 0; i < n; i++) {
+		_SortByIndex(plan, (OpSort *)sorts[i]);
+	}
+
+	array_free(sorts);
+}
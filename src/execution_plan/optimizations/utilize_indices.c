@@ -5,6 +5,7 @@
  */
 
 #include "RG.h"
+#include "cost_model.h"
 #include "../../value.h"
 #include "../../util/arr.h"
 #include "../../query_ctx.h"
@@ -25,6 +26,8 @@
 #include "../execution_plan_build/execution_plan_util.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
+#include <float.h>
+
 //------------------------------------------------------------------------------
 // Filter normalization
 //------------------------------------------------------------------------------
@@ -300,10 +303,10 @@ void reduce_scan_op
 	QueryGraph   *qg  =  scan->op.plan->query_graph;
 
 	// find label with filtered indexed properties
-	// that has the minimum NNZ entries
+	// that is expected to produce the fewest entries
 	int         min_label_id;                 // tracks min label ID
-	uint64_t    min_nnz        = UINT64_MAX;  // tracks min entries
-	RSIndex     *rs_idx        = NULL;        // the index to be applied
+	double      min_cost       = DBL_MAX;     // tracks min estimated entries
+	Index       min_idx        = NULL;        // the index to be applied
 	OpFilter    **filters      = NULL;        // tracks indexed filters to apply
 	uint        filters_count  = 0;           // number of matching filters
 	const char  *min_label_str = NULL;        // tracks min label name
@@ -316,7 +319,7 @@ void reduce_scan_op
 	uint label_count = QGNode_LabelCount(qn);
 	for(uint i = 0; i < label_count; i++) {
 		Index idx;
-		uint64_t nnz;
+		double cost;
 		int label_id = QGNode_GetLabelID(qn, i);
 		const char *label = QGNode_GetLabel(qn, i);
 
@@ -334,9 +337,6 @@ void reduce_scan_op
 		// TODO switch to reusable array
 		OpFilter **cur_filters = _applicableFilters((OpBase *)scan, scan->n->alias, idx);
 
-		// TODO consider heuristic which combines max
-		// number / restrictiveness of applicable filters
-		// vs. the label's NNZ?
 		uint cur_filters_count = array_len(cur_filters);
 		if(cur_filters_count == 0) {
 			// no filters
@@ -344,13 +344,17 @@ void reduce_scan_op
 			continue;
 		}
 
-		// get all applicable filter for index
-		RSIndex *cur_idx = Index_RSIndex(idx);
+		// estimate number of entries the index will produce
+		// combining the label's NNZ with the restrictiveness of the filters
+		cost = Graph_LabeledNodeCount(g, label_id);
+		for(uint j = 0; j < cur_filters_count; j++) {
+			cost *= CostModel_LabelFilterSelectivity(cur_filters[j]->filterTree,
+					label);
+		}
 
-		nnz = Graph_LabeledNodeCount(g, label_id);
-		if(min_nnz > nnz) {
-			rs_idx         =  cur_idx;
-			min_nnz        =  nnz;
+		if(min_idx == NULL || min_cost > cost) {
+			min_idx        =  idx;
+			min_cost       =  cost;
 			min_label_str  =  label;
 			min_label_id   =  label_id;
 
@@ -363,7 +367,14 @@ void reduce_scan_op
 	}
 
 	// no label possessed indexed and filtered attributes, return early
-	if(rs_idx == NULL) goto cleanup;
+	if(min_idx == NULL) goto cleanup;
+
+	// keep the label scan if the index isn't expected to be selective
+	FT_FilterNode *root = _Concat_Filters(filters);
+	if(!CostModel_IndexScanBeneficial(root, min_label_str)) {
+		FilterTree_Free(root);
+		goto cleanup;
+	}
 
 	// did we found a better label to utilize? if so swap
 	if(scan->n->label_id != min_label_id) {
@@ -396,8 +407,7 @@ void reduce_scan_op
 		scan->n->label_id = min_label_id;
 	}
 
-	FT_FilterNode *root = _Concat_Filters(filters);
-	OpBase *indexOp = NewIndexScanOp(scan->op.plan, scan->g, scan->n, rs_idx,
+	OpBase *indexOp = NewIndexScanOp(scan->op.plan, scan->g, scan->n, min_idx,
 			root);
 	scan->n = NULL;
 
@@ -7,7 +7,11 @@
 #include "RG.h"
 #include "record.h"
 #include "../errors.h"
+#include "../util/arr.h"
 #include "../util/rmalloc.h"
+#include "../datatypes/map.h"
+#include "../datatypes/array.h"
+#include "../datatypes/path/sipath.h"
 
 // migrate the entry at the given index in the source Record to the same index
 // in the destination. Ownership is transferred according to transfer_ownership
@@ -376,3 +380,289 @@ void Record_Free
 	rm_free(r);
 }
 
+
+// returns true if v can be written to a stream by _Record_WriteValue
+static bool _Record_SpillableValue
+(
+	SIValue v
+) {
+	switch(SI_TYPE(v)) {
+		case T_NULL:
+		case T_BOOL:
+		case T_INT64:
+		case T_DOUBLE:
+		case T_STRING:
+		case T_POINT:
+		case T_NODE:
+		case T_EDGE:
+		case T_PATH:
+			return true;
+		case T_ARRAY: {
+			uint32_t n = SIArray_Length(v);
+			for(uint32_t i = 0; i < n; i++) {
+				if(!_Record_SpillableValue(SIArray_Get(v, i))) return false;
+			}
+			return true;
+		}
+		case T_MAP: {
+			uint n = Map_KeyCount(v);
+			for(uint i = 0; i < n; i++) {
+				SIValue key;
+				SIValue val;
+				Map_GetIdx(v, i, &key, &val);
+				if(!_Record_SpillableValue(val)) return false;
+			}
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+// writes a binary representation of v to stream
+// nodes and edges are written as is, their attribute-set pointers
+// remain valid for as long as the graph isn't modified
+static void _Record_WriteValue
+(
+	SIValue v,
+	FILE *stream
+) {
+	SIType t = SI_TYPE(v);
+	fwrite_assert(&t, sizeof(SIType), stream);
+
+	switch(t) {
+		case T_NULL:
+			break;
+		case T_BOOL:
+		case T_INT64:
+			fwrite_assert(&v.longval, sizeof(v.longval), stream);
+			break;
+		case T_DOUBLE:
+			fwrite_assert(&v.doubleval, sizeof(v.doubleval), stream);
+			break;
+		case T_POINT:
+			fwrite_assert(&v.point, sizeof(v.point), stream);
+			break;
+		case T_STRING: {
+			size_t len = strlen(v.stringval) + 1;
+			fwrite_assert(&len, sizeof(len), stream);
+			fwrite_assert(v.stringval, len, stream);
+			break;
+		}
+		case T_NODE:
+			fwrite_assert(v.ptrval, sizeof(Node), stream);
+			break;
+		case T_EDGE:
+			fwrite_assert(v.ptrval, sizeof(Edge), stream);
+			break;
+		case T_PATH: {
+			Path *p = v.ptrval;
+			size_t node_count = Path_NodeCount(p);
+			size_t edge_count = Path_EdgeCount(p);
+			fwrite_assert(&node_count, sizeof(node_count), stream);
+			for(size_t i = 0; i < node_count; i++) {
+				fwrite_assert(Path_GetNode(p, i), sizeof(Node), stream);
+			}
+			fwrite_assert(&edge_count, sizeof(edge_count), stream);
+			for(size_t i = 0; i < edge_count; i++) {
+				fwrite_assert(Path_GetEdge(p, i), sizeof(Edge), stream);
+			}
+			break;
+		}
+		case T_ARRAY: {
+			uint32_t n = SIArray_Length(v);
+			fwrite_assert(&n, sizeof(n), stream);
+			for(uint32_t i = 0; i < n; i++) {
+				_Record_WriteValue(SIArray_Get(v, i), stream);
+			}
+			break;
+		}
+		case T_MAP: {
+			uint n = Map_KeyCount(v);
+			fwrite_assert(&n, sizeof(n), stream);
+			for(uint i = 0; i < n; i++) {
+				SIValue key;
+				SIValue val;
+				Map_GetIdx(v, i, &key, &val);
+				_Record_WriteValue(key, stream);
+				_Record_WriteValue(val, stream);
+			}
+			break;
+		}
+		default:
+			ASSERT(false && "unexpected spilled value type");
+			break;
+	}
+}
+
+// reads a value written by _Record_WriteValue off of stream
+// the returned value owns all of its allocations
+static SIValue _Record_ReadValue
+(
+	FILE *stream
+) {
+	SIType t;
+	SIValue v = SI_NullVal();
+	fread_assert(&t, sizeof(SIType), stream);
+
+	switch(t) {
+		case T_NULL:
+			break;
+		case T_BOOL:
+		case T_INT64:
+			v.type = t;
+			v.allocation = M_NONE;
+			fread_assert(&v.longval, sizeof(v.longval), stream);
+			break;
+		case T_DOUBLE:
+			v.type = t;
+			v.allocation = M_NONE;
+			fread_assert(&v.doubleval, sizeof(v.doubleval), stream);
+			break;
+		case T_POINT:
+			v.type = t;
+			v.allocation = M_NONE;
+			fread_assert(&v.point, sizeof(v.point), stream);
+			break;
+		case T_STRING: {
+			size_t len;
+			fread_assert(&len, sizeof(len), stream);
+			char *s = rm_malloc(sizeof(char) * len);
+			fread_assert(s, sizeof(char) * len, stream);
+			v = SI_TransferStringVal(s);
+			break;
+		}
+		case T_NODE: {
+			Node n;
+			fread_assert(&n, sizeof(Node), stream);
+			v = SI_CloneValue(SI_Node(&n));
+			break;
+		}
+		case T_EDGE: {
+			Edge e;
+			fread_assert(&e, sizeof(Edge), stream);
+			v = SI_CloneValue(SI_Edge(&e));
+			break;
+		}
+		case T_PATH: {
+			Node n;
+			Edge e;
+			size_t node_count;
+			size_t edge_count;
+			fread_assert(&node_count, sizeof(node_count), stream);
+			Path *p = Path_New(node_count);
+			for(size_t i = 0; i < node_count; i++) {
+				fread_assert(&n, sizeof(Node), stream);
+				Path_AppendNode(p, n);
+			}
+			fread_assert(&edge_count, sizeof(edge_count), stream);
+			for(size_t i = 0; i < edge_count; i++) {
+				fread_assert(&e, sizeof(Edge), stream);
+				Path_AppendEdge(p, e);
+			}
+			v = SIPath_New(p);
+			Path_Free(p);
+			break;
+		}
+		case T_ARRAY: {
+			uint32_t n;
+			fread_assert(&n, sizeof(n), stream);
+			v = SIArray_New(n);
+			for(uint32_t i = 0; i < n; i++) {
+				array_append(v.array, _Record_ReadValue(stream));
+			}
+			break;
+		}
+		case T_MAP: {
+			uint n;
+			fread_assert(&n, sizeof(n), stream);
+			v = Map_New(n);
+			for(uint i = 0; i < n; i++) {
+				// keys are unique, append pairs without looking keys up
+				Pair pair;
+				pair.key = _Record_ReadValue(stream);
+				pair.val = _Record_ReadValue(stream);
+				array_append(v.map, pair);
+			}
+			break;
+		}
+		default:
+			ASSERT(false && "unexpected spilled value type");
+			break;
+	}
+
+	return v;
+}
+
+bool Record_Spillable
+(
+	const Record r
+) {
+	uint length = Record_length(r);
+	for(uint i = 0; i < length; i++) {
+		switch(r->entries[i].type) {
+			case REC_TYPE_UNKNOWN:
+			case REC_TYPE_NODE:
+			case REC_TYPE_EDGE:
+				break;
+			case REC_TYPE_SCALAR:
+				if(!_Record_SpillableValue(r->entries[i].value.s)) return false;
+				break;
+			default:
+				return false;
+		}
+	}
+	return true;
+}
+
+void Record_ToStream
+(
+	const Record r,
+	FILE *stream
+) {
+	ASSERT(Record_Spillable(r));
+
+	uint length = Record_length(r);
+	for(uint i = 0; i < length; i++) {
+		Entry *e = r->entries + i;
+		fwrite_assert(&e->type, sizeof(RecordEntryType), stream);
+		switch(e->type) {
+			case REC_TYPE_NODE:
+				fwrite_assert(&e->value.n, sizeof(Node), stream);
+				break;
+			case REC_TYPE_EDGE:
+				fwrite_assert(&e->value.e, sizeof(Edge), stream);
+				break;
+			case REC_TYPE_SCALAR:
+				_Record_WriteValue(e->value.s, stream);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+void Record_FromStream
+(
+	Record r,
+	FILE *stream
+) {
+	uint length = Record_length(r);
+	for(uint i = 0; i < length; i++) {
+		Entry *e = r->entries + i;
+		fread_assert(&e->type, sizeof(RecordEntryType), stream);
+		switch(e->type) {
+			case REC_TYPE_NODE:
+				fread_assert(&e->value.n, sizeof(Node), stream);
+				break;
+			case REC_TYPE_EDGE:
+				fread_assert(&e->value.e, sizeof(Edge), stream);
+				break;
+			case REC_TYPE_SCALAR:
+				e->value.s = _Record_ReadValue(stream);
+				break;
+			default:
+				break;
+		}
+	}
+}
@@ -197,6 +197,30 @@ void Record_FreeEntry
 	int idx
 );
 
+// returns true if record can be written to a stream by Record_ToStream
+// records holding pointers or temporal values can't be written
+bool Record_Spillable
+(
+	const Record r
+);
+
+// writes a binary representation of record to stream
+// nodes and edges are written by value, and so they are only valid
+// to read back while the graph remains locked
+void Record_ToStream
+(
+	const Record r,
+	FILE *stream
+);
+
+// populates record from its binary representation
+// this is the reverse of Record_ToStream
+void Record_FromStream
+(
+	Record r,
+	FILE *stream
+);
+
 // free record entries
 void Record_FreeEntries
 (
@@ -0,0 +1,352 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "ft_to_ordered_ranges.h"
+#include "RG.h"
+#include "../util/arr.h"
+#include "filter_tree_utils.h"
+#include "../datatypes/point.h"
+#include "../datatypes/array.h"
+
+// approximate number of meters within a single degree of latitude
+// rounded down such that latitude bands are never too narrow
+#define METERS_PER_LAT_DEGREE 110000.0
+
+// relative cost of scanning a range, used when choosing between
+// the two sides of an AND
+#define RANGE_COST_POINT          1
+#define RANGE_COST_BOUNDED        10
+#define RANGE_COST_OPEN           100
+
+//------------------------------------------------------------------------------
+// forward declarations
+//------------------------------------------------------------------------------
+
+// returns true if 'tree' been converted into ranges, false otherwise
+static bool _FilterTreeToRanges
+(
+	OrderedIndexRange **ranges,  // [output] ranges
+	const FT_FilterNode *tree,   // filter to convert
+	GraphContext *gc             // graph context
+);
+
+//------------------------------------------------------------------------------
+// utils
+//------------------------------------------------------------------------------
+
+// resolve attribute accessed by expression
+// returns false if expression isn't an attribute access
+static bool _ResolveAttribute
+(
+	const AR_ExpNode *exp,  // expression to inspect
+	GraphContext *gc,       // graph context
+	Attribute_ID *attr      // [output] attribute ID
+) {
+	char *field = NULL;
+	if(!AR_EXP_IsAttribute(exp, &field)) return false;
+
+	*attr = GraphContext_GetAttributeID(gc, field);
+	return true;
+}
+
+// estimate the cost of scanning ranges
+static uint64_t _RangesCost
+(
+	OrderedIndexRange *ranges  // ranges to estimate
+) {
+	uint64_t cost = 0;
+	uint n = array_len(ranges);
+
+	for(uint i = 0; i < n; i++) {
+		const OrderedIndexRange *r = ranges + i;
+		if(OrderedIndexRange_IsPoint(r)) {
+			cost += RANGE_COST_POINT;
+		} else if(OrderedIndexRange_IsOpen(r)) {
+			cost += RANGE_COST_OPEN;
+		} else {
+			cost += RANGE_COST_BOUNDED;
+		}
+	}
+
+	return cost;
+}
+
+//------------------------------------------------------------------------------
+// filter conversion
+//------------------------------------------------------------------------------
+
+// n.v IN [1, 2, 3]
+// a point range for each element in the list
+static bool _InFilterToRanges
+(
+	OrderedIndexRange **ranges,  // [output] ranges
+	const FT_FilterNode *tree,   // filter to convert
+	GraphContext *gc             // graph context
+) {
+	AR_ExpNode *inOp = tree->exp.exp;
+
+	Attribute_ID attr;
+	if(!_ResolveAttribute(inOp->op.children[0], gc, &attr)) return false;
+
+	// unknown attribute, no entity can match
+	if(attr == ATTRIBUTE_ID_NONE) return true;
+
+	SIValue list = AR_EXP_Evaluate(inOp->op.children[1], NULL);
+	if(SI_TYPE(list) != T_ARRAY) {
+		SIValue_Free(list);
+		return false;
+	}
+
+	bool res = true;
+	uint list_len = SIArray_Length(list);
+	for(uint i = 0; i < list_len; i++) {
+		SIValue v = SIArray_Get(list, i);
+		SIType  t = SI_TYPE(v);
+
+		// null never equals any value
+		if(t == T_NULL) continue;
+
+		if(!(t & (SI_NUMERIC | T_STRING | T_BOOL))) {
+			res = false;
+			break;
+		}
+
+		array_append(*ranges, OrderedIndexRange_Point(attr, v));
+	}
+
+	SIValue_Free(list);
+	return res;
+}
+
+// distance(n.location, point) < radius
+// all points within a latitude band around the origin
+static bool _DistanceFilterToRanges
+(
+	OrderedIndexRange **ranges,  // [output] ranges
+	const FT_FilterNode *tree,   // filter to convert
+	GraphContext *gc             // graph context
+) {
+	char     *field  =  NULL;          // field being filtered
+	SIValue  origin  =  SI_NullVal();  // center of circle
+	SIValue  radius  =  SI_NullVal();  // circle radius
+
+	if(!extractOriginAndRadius(tree, &origin, &radius, &field)) return false;
+
+	bool res = false;
+	if(SI_TYPE(origin) == T_POINT) {
+		Attribute_ID attr = GraphContext_GetAttributeID(gc, field);
+		if(attr != ATTRIBUTE_ID_NONE) {
+			double lat   = Point_lat(origin);
+			double delta = SI_GET_NUMERIC(radius) / METERS_PER_LAT_DEGREE;
+			array_append(*ranges,
+					OrderedIndexRange_Latitude(attr, lat - delta, lat + delta));
+		}
+		res = true;
+	}
+
+	SIValue_Free(origin);
+	SIValue_Free(radius);
+	return res;
+}
+
+// n.v op constant
+static bool _PredicateToRanges
+(
+	OrderedIndexRange **ranges,  // [output] ranges
+	const FT_FilterNode *tree,   // filter to convert
+	GraphContext *gc             // graph context
+) {
+	Attribute_ID attr;
+	if(!_ResolveAttribute(tree->pred.lhs, gc, &attr)) return false;
+
+	AST_Operator op = tree->pred.op;
+	if(op != OP_LT && op != OP_LE && op != OP_GT && op != OP_GE &&
+	   op != OP_EQUAL) {
+		return false;
+	}
+
+	// unknown attribute, no entity can match
+	if(attr == ATTRIBUTE_ID_NONE) return true;
+
+	SIValue v = AR_EXP_Evaluate(tree->pred.rhs, NULL);
+	SIType  t = SI_TYPE(v);
+
+	if(t == T_NULL) {
+		// comparing against null never holds
+	} else if(t & (SI_NUMERIC | T_STRING | T_BOOL)) {
+		OrderedIndexRange r;
+		switch(op) {
+			case OP_LT:
+				r = OrderedIndexRange_New(attr, NULL, false, &v, false);
+				break;
+			case OP_LE:
+				r = OrderedIndexRange_New(attr, NULL, false, &v, true);
+				break;
+			case OP_GT:
+				r = OrderedIndexRange_New(attr, &v, false, NULL, false);
+				break;
+			case OP_GE:
+				r = OrderedIndexRange_New(attr, &v, true, NULL, false);
+				break;
+			default:
+				r = OrderedIndexRange_Point(attr, v);
+				break;
+		}
+		array_append(*ranges, r);
+	} else if(t == T_POINT) {
+		// points are only comparable for equality
+		if(op == OP_EQUAL) {
+			array_append(*ranges, OrderedIndexRange_Point(attr, v));
+		}
+	} else {
+		// none indexable type e.g. array
+		array_append(*ranges, OrderedIndexRange_NoneIndexable(attr));
+	}
+
+	SIValue_Free(v);
+	return true;
+}
+
+// A AND B
+// intersect ranges when possible, otherwise scan the cheaper side
+static bool _AndToRanges
+(
+	OrderedIndexRange **ranges,  // [output] ranges
+	const FT_FilterNode *tree,   // filter to convert
+	GraphContext *gc             // graph context
+) {
+	OrderedIndexRange *left  = array_new(OrderedIndexRange, 1);
+	OrderedIndexRange *right = array_new(OrderedIndexRange, 1);
+
+	bool l = _FilterTreeToRanges(&left,  tree->cond.left,  gc);
+	bool r = _FilterTreeToRanges(&right, tree->cond.right, gc);
+
+	// either side restricts the result set
+	if(!l) {
+		OrderedRanges_Free(left);
+		left = NULL;
+	}
+	if(!r) {
+		OrderedRanges_Free(right);
+		right = NULL;
+	}
+
+	if(left == NULL && right == NULL) return false;
+
+	OrderedIndexRange *chosen = NULL;
+	if(left == NULL) {
+		chosen = right;
+	} else if(right == NULL) {
+		chosen = left;
+	} else if(array_len(left) == 0 || array_len(right) == 0) {
+		// one of the sides can't be satisfied
+		OrderedRanges_Free(left);
+		OrderedRanges_Free(right);
+		return true;
+	} else if(array_len(left) == 1 && array_len(right) == 1 &&
+			left[0].attr == right[0].attr) {
+		// n.v > 1 AND n.v < 5
+		if(!OrderedIndexRange_Intersect(left, right)) {
+			OrderedIndexRange_Free(left);
+			array_clear(left);
+		}
+		OrderedRanges_Free(right);
+		chosen = left;
+	} else if(_RangesCost(left) <= _RangesCost(right)) {
+		OrderedRanges_Free(right);
+		chosen = left;
+	} else {
+		OrderedRanges_Free(left);
+		chosen = right;
+	}
+
+	uint n = array_len(chosen);
+	for(uint i = 0; i < n; i++) array_append(*ranges, chosen[i]);
+	array_free(chosen);
+
+	return true;
+}
+
+// A OR B
+// union of both sides, both must be converted
+static bool _OrToRanges
+(
+	OrderedIndexRange **ranges,  // [output] ranges
+	const FT_FilterNode *tree,   // filter to convert
+	GraphContext *gc             // graph context
+) {
+	OrderedIndexRange *both = array_new(OrderedIndexRange, 2);
+
+	if(!_FilterTreeToRanges(&both, tree->cond.left,  gc) ||
+	   !_FilterTreeToRanges(&both, tree->cond.right, gc)) {
+		OrderedRanges_Free(both);
+		return false;
+	}
+
+	uint n = array_len(both);
+	for(uint i = 0; i < n; i++) array_append(*ranges, both[i]);
+	array_free(both);
+
+	return true;
+}
+
+static bool _FilterTreeToRanges
+(
+	OrderedIndexRange **ranges,
+	const FT_FilterNode *tree,
+	GraphContext *gc
+) {
+	ASSERT(tree   != NULL);
+	ASSERT(ranges != NULL);
+
+	if(isInFilter(tree)) return _InFilterToRanges(ranges, tree, gc);
+
+	if(isDistanceFilter(tree)) return _DistanceFilterToRanges(ranges, tree, gc);
+
+	switch(tree->t) {
+		case FT_N_PRED:
+			return _PredicateToRanges(ranges, tree, gc);
+		case FT_N_COND:
+			if(tree->cond.op == OP_AND) return _AndToRanges(ranges, tree, gc);
+			if(tree->cond.op == OP_OR)  return _OrToRanges(ranges, tree, gc);
+			return false;
+		default:
+			return false;
+	}
+}
+
+bool FilterTreeToOrderedRanges
+(
+	OrderedIndexRange **ranges,
+	const FT_FilterNode *tree,
+	GraphContext *gc
+) {
+	ASSERT(gc     != NULL);
+	ASSERT(tree   != NULL);
+	ASSERT(ranges != NULL);
+
+	*ranges = array_new(OrderedIndexRange, 1);
+
+	if(!_FilterTreeToRanges(ranges, tree, gc)) {
+		OrderedRanges_Free(*ranges);
+		*ranges = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+void OrderedRanges_Free
+(
+	OrderedIndexRange *ranges
+) {
+	ASSERT(ranges != NULL);
+
+	uint n = array_len(ranges);
+	for(uint i = 0; i < n; i++) OrderedIndexRange_Free(ranges + i);
+	array_free(ranges);
+}
+
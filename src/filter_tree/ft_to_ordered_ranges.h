@@ -0,0 +1,30 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "filter_tree.h"
+#include "../index/ordered_index.h"
+#include "../graph/graphcontext.h"
+
+// convert filter tree into a set of ordered index ranges
+// every entity satisfying the filter falls within one of the ranges
+// the ranges might contain entities which do not satisfy the filter
+// the filter must be re-evaluated against scanned entities
+// returns false if the filter could not be converted
+bool FilterTreeToOrderedRanges
+(
+	OrderedIndexRange **ranges,  // [output] ranges to scan
+	const FT_FilterNode *tree,   // filter to convert, variables resolved
+	GraphContext *gc             // graph context, resolves attribute names
+);
+
+// free ranges array
+void OrderedRanges_Free
+(
+	OrderedIndexRange *ranges  // ranges to free
+);
+
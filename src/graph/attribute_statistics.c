@@ -0,0 +1,425 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "attribute_statistics.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+// histogram is rebuilt once 1/ATTR_STATS_HISTOGRAM_REFRESH of the sample
+// been replaced, amortizing the cost of sorting the sample
+#define ATTR_STATS_HISTOGRAM_REFRESH 8
+
+// value types tracked by the most-common-values list
+#define ATTR_STATS_MCV_TYPES (SI_NUMERIC | T_BOOL | T_STRING)
+
+// xorshift64* pseudo random generator
+static inline uint64_t _NextRandom
+(
+	uint64_t *state
+) {
+	uint64_t x = *state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int _CompareDoubles
+(
+	const void *a,
+	const void *b
+) {
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+// returns true if `a` and `b` represent the same value
+static inline bool _SameValue
+(
+	SIValue a,
+	SIValue b
+) {
+	int disjoint;
+	return (SIValue_Compare(a, b, &disjoint) == 0 && disjoint == 0);
+}
+
+//------------------------------------------------------------------------------
+// distinct values sketch
+//------------------------------------------------------------------------------
+
+static void _HLL_Add
+(
+	uint8_t *registers,
+	SIValue v
+) {
+	uint64_t h   = SIValue_HashCode(v);
+	uint64_t idx = h >> (64 - ATTR_STATS_HLL_PRECISION);
+	uint64_t w   = h << ATTR_STATS_HLL_PRECISION;
+
+	// position of the leftmost set bit among the remaining bits
+	uint8_t rank = (w == 0)
+		? (64 - ATTR_STATS_HLL_PRECISION + 1)
+		: (__builtin_clzll(w) + 1);
+
+	if(registers[idx] < rank) registers[idx] = rank;
+}
+
+static double _HLL_Estimate
+(
+	const uint8_t *registers
+) {
+	double m     = ATTR_STATS_HLL_REGISTERS;
+	double sum   = 0;
+	uint   zeros = 0;
+
+	for(uint i = 0; i < ATTR_STATS_HLL_REGISTERS; i++) {
+		sum += ldexp(1.0, -registers[i]);
+		zeros += (registers[i] == 0);
+	}
+
+	double alpha    = 0.7213 / (1.0 + 1.079 / m);
+	double estimate = alpha * m * m / sum;
+
+	// small range correction, linear counting
+	if(estimate <= 2.5 * m && zeros > 0) {
+		estimate = m * log(m / zeros);
+	}
+
+	return estimate;
+}
+
+//------------------------------------------------------------------------------
+// most common values
+//------------------------------------------------------------------------------
+
+// returns index of `v` within the MCV list, -1 if `v` isn't tracked
+static int _MCV_Find
+(
+	const AttributeMCV *mcv,
+	SIValue v
+) {
+	uint n = array_len((AttributeMCV *)mcv);
+	for(uint i = 0; i < n; i++) {
+		if(_SameValue(mcv[i].value, v)) return i;
+	}
+	return -1;
+}
+
+// space-saving, once the list is full the least frequent value is
+// replaced by the new value, which inherits its count as error
+static void _MCV_Add
+(
+	AttributeMCV **mcv,
+	SIValue v
+) {
+	int i = _MCV_Find(*mcv, v);
+	if(i != -1) {
+		(*mcv)[i].count++;
+		return;
+	}
+
+	uint n = array_len(*mcv);
+	if(n < ATTR_STATS_MCV_CAPACITY) {
+		AttributeMCV entry = {.value = SI_CloneValue(v), .count = 1,
+			.error = 0};
+		array_append(*mcv, entry);
+		return;
+	}
+
+	// evict least frequent value
+	uint min = 0;
+	for(uint j = 1; j < n; j++) {
+		if((*mcv)[j].count < (*mcv)[min].count) min = j;
+	}
+
+	AttributeMCV *entry = (*mcv) + min;
+	SIValue_Free(entry->value);
+	entry->value = SI_CloneValue(v);
+	entry->error = entry->count;
+	entry->count++;
+}
+
+static void _MCV_Remove
+(
+	AttributeMCV **mcv,
+	SIValue v
+) {
+	int i = _MCV_Find(*mcv, v);
+	if(i == -1) return;
+
+	AttributeMCV *entry = (*mcv) + i;
+	entry->count--;
+	entry->error = MIN(entry->error, entry->count);
+
+	if(entry->count == 0) {
+		SIValue_Free(entry->value);
+		array_del_fast(*mcv, i);
+	}
+}
+
+//------------------------------------------------------------------------------
+// numeric sample & histogram
+//------------------------------------------------------------------------------
+
+static void _Sample_Add
+(
+	AttributeStatistics *stats,
+	double v
+) {
+	stats->numeric_seen++;
+
+	if(array_len(stats->sample) < ATTR_STATS_SAMPLE_CAPACITY) {
+		array_append(stats->sample, v);
+		stats->sample_changes++;
+	} else {
+		// reservoir sampling
+		// each value seen so far is sampled with equal probability
+		uint64_t j = _NextRandom(&stats->rng) % stats->numeric_seen;
+		if(j >= ATTR_STATS_SAMPLE_CAPACITY) return;
+		stats->sample[j] = v;
+		stats->sample_changes++;
+	}
+
+	if(stats->sample_changes * ATTR_STATS_HISTOGRAM_REFRESH >=
+	   array_len(stats->sample)) {
+		AttributeStatistics_RefreshHistogram(stats);
+	}
+}
+
+void AttributeStatistics_RefreshHistogram
+(
+	AttributeStatistics *stats
+) {
+	ASSERT(stats != NULL);
+
+	stats->sample_changes = 0;
+	array_clear(stats->histogram);
+
+	uint n = array_len(stats->sample);
+	if(n == 0) return;
+
+	// sample order is irrelevant, sort in place
+	qsort(stats->sample, n, sizeof(double), _CompareDoubles);
+
+	// pick boundaries at equally spaced ranks
+	uint buckets = MAX(1, MIN(ATTR_STATS_HISTOGRAM_BUCKETS, n - 1));
+	for(uint i = 0; i <= buckets; i++) {
+		uint64_t rank = ((uint64_t)i * (n - 1)) / buckets;
+		array_append(stats->histogram, stats->sample[rank]);
+	}
+}
+
+//------------------------------------------------------------------------------
+// statistics API
+//------------------------------------------------------------------------------
+
+AttributeStatistics *AttributeStatistics_New(void) {
+	AttributeStatistics *stats = rm_calloc(1, sizeof(AttributeStatistics));
+
+	stats->hll       = rm_calloc(ATTR_STATS_HLL_REGISTERS, sizeof(uint8_t));
+	stats->mcv       = array_new(AttributeMCV, ATTR_STATS_MCV_CAPACITY);
+	stats->sample    = array_new(double, 0);
+	stats->histogram = array_new(double, ATTR_STATS_HISTOGRAM_BUCKETS + 1);
+	stats->rng       = 0x9E3779B97F4A7C15ULL;
+
+	return stats;
+}
+
+void AttributeStatistics_Add
+(
+	AttributeStatistics *stats,
+	SIValue v
+) {
+	ASSERT(stats != NULL);
+
+	stats->count++;
+	_HLL_Add(stats->hll, v);
+
+	SIType t = SI_TYPE(v);
+	if(t & ATTR_STATS_MCV_TYPES) _MCV_Add(&stats->mcv, v);
+
+	if(t & SI_NUMERIC) {
+		stats->numeric_count++;
+		_Sample_Add(stats, SI_GET_NUMERIC(v));
+	}
+}
+
+void AttributeStatistics_Remove
+(
+	AttributeStatistics *stats,
+	SIValue v
+) {
+	ASSERT(stats != NULL);
+
+	if(stats->count == 0) return;
+	stats->count--;
+
+	SIType t = SI_TYPE(v);
+	if(t & ATTR_STATS_MCV_TYPES) _MCV_Remove(&stats->mcv, v);
+
+	if(t & SI_NUMERIC && stats->numeric_count > 0) stats->numeric_count--;
+}
+
+uint64_t AttributeStatistics_Count
+(
+	const AttributeStatistics *stats
+) {
+	ASSERT(stats != NULL);
+	return stats->count;
+}
+
+uint64_t AttributeStatistics_DistinctCount
+(
+	const AttributeStatistics *stats
+) {
+	ASSERT(stats != NULL);
+
+	if(stats->count == 0) return 0;
+
+	// the sketch never forgets removed values, bound it by the number of
+	// entities currently holding the attribute
+	double estimate = round(_HLL_Estimate(stats->hll));
+	return MAX(1, MIN((uint64_t)estimate, stats->count));
+}
+
+uint AttributeStatistics_MostCommonValues
+(
+	const AttributeStatistics *stats,
+	SIValue *values,
+	uint64_t *counts
+) {
+	ASSERT(stats  != NULL);
+	ASSERT(values != NULL);
+	ASSERT(counts != NULL);
+
+	// insertion sort by descending guaranteed frequency
+	uint n = array_len(stats->mcv);
+	for(uint i = 0; i < n; i++) {
+		AttributeMCV *entry = stats->mcv + i;
+		uint64_t count = entry->count - entry->error;
+
+		uint j = i;
+		while(j > 0 && counts[j - 1] < count) {
+			values[j] = values[j - 1];
+			counts[j] = counts[j - 1];
+			j--;
+		}
+		values[j] = entry->value;
+		counts[j] = count;
+	}
+
+	return n;
+}
+
+uint AttributeStatistics_Histogram
+(
+	const AttributeStatistics *stats,
+	const double **bounds
+) {
+	ASSERT(stats  != NULL);
+	ASSERT(bounds != NULL);
+
+	*bounds = stats->histogram;
+	return (stats->numeric_count > 0) ? array_len(stats->histogram) : 0;
+}
+
+double AttributeStatistics_EqualitySelectivity
+(
+	const AttributeStatistics *stats,
+	const SIValue *v
+) {
+	ASSERT(stats != NULL);
+
+	if(stats->count == 0) return 0;
+
+	double count = stats->count;
+	double ndv   = AttributeStatistics_DistinctCount(stats);
+
+	// unknown value, assume uniform distribution
+	if(v == NULL) return 1.0 / ndv;
+
+	// tracked value
+	int i = _MCV_Find(stats->mcv, *v);
+	if(i != -1) {
+		const AttributeMCV *entry = stats->mcv + i;
+		if(entry->count > entry->error) {
+			return (entry->count - entry->error) / count;
+		}
+	}
+
+	// spread the occurrences not accounted for by the MCV list
+	// evenly among the remaining distinct values
+	uint     n   = array_len(stats->mcv);
+	uint64_t mcv = 0;
+	for(uint j = 0; j < n; j++) {
+		mcv += stats->mcv[j].count - stats->mcv[j].error;
+	}
+
+	double rest     = (mcv < stats->count) ? stats->count - mcv : 0;
+	double distinct = (ndv > n) ? ndv - n : 1;
+
+	return rest / distinct / count;
+}
+
+double AttributeStatistics_RangeSelectivity
+(
+	const AttributeStatistics *stats,
+	double v,
+	bool less
+) {
+	ASSERT(stats != NULL);
+
+	if(stats->count == 0 || stats->numeric_count == 0) return 0;
+
+	// only numeric values satisfy a numeric range
+	double numeric = (double)stats->numeric_count / stats->count;
+
+	uint n = array_len(stats->histogram);
+	if(n == 0) return numeric / 2;
+
+	// fraction of numeric values below v
+	// interpolating linearly within the bucket containing v
+	double below = 0;
+	const double *bounds = stats->histogram;
+	for(uint i = 0; i < n - 1; i++) {
+		double lo = bounds[i];
+		double hi = bounds[i + 1];
+		if(v >= hi) {
+			below += 1;
+		} else {
+			if(v > lo) below += (v - lo) / (hi - lo);
+			break;
+		}
+	}
+
+	below /= (n - 1);
+
+	return numeric * (less ? below : 1.0 - below);
+}
+
+void AttributeStatistics_Free
+(
+	AttributeStatistics *stats
+) {
+	ASSERT(stats != NULL);
+
+	uint n = array_len(stats->mcv);
+	for(uint i = 0; i < n; i++) {
+		SIValue_Free(stats->mcv[i].value);
+	}
+
+	rm_free(stats->hll);
+	array_free(stats->mcv);
+	array_free(stats->sample);
+	array_free(stats->histogram);
+	rm_free(stats);
+}
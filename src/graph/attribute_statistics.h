@@ -0,0 +1,137 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "../value.h"
+
+// value distribution statistics of a single attribute within a schema
+// e.g. the `status` attribute of nodes labeled `Order`
+//
+// the statistics are maintained incrementally as entities are created,
+// updated and deleted and consist of:
+//
+// 1. a HyperLogLog sketch estimating the number of distinct values
+// 2. a most-common-values list (space-saving top-k)
+// 3. an equi-depth histogram of numeric values
+//    derived from a reservoir sample of the attribute's numeric values
+//
+// both the sketch and the sample only ever grow, removing a value
+// decrements the attribute's counters and the value's MCV frequency
+// but doesn't retract it from the sketch or sample
+
+// number of HyperLogLog index bits
+#define ATTR_STATS_HLL_PRECISION 10
+
+// number of HyperLogLog registers
+#define ATTR_STATS_HLL_REGISTERS (1 << ATTR_STATS_HLL_PRECISION)
+
+// max number of tracked most common values
+#define ATTR_STATS_MCV_CAPACITY 16
+
+// max number of sampled numeric values
+#define ATTR_STATS_SAMPLE_CAPACITY 1024
+
+// max number of histogram buckets
+#define ATTR_STATS_HISTOGRAM_BUCKETS 16
+
+typedef struct {
+	SIValue value;   // tracked value
+	uint64_t count;  // number of occurrences, upper bound
+	uint64_t error;  // max overestimation of count
+} AttributeMCV;
+
+typedef struct {
+	uint64_t count;          // number of entities holding the attribute
+	uint64_t numeric_count;  // number of entities holding a numeric value
+	uint64_t numeric_seen;   // number of numeric values ever sampled
+	uint8_t *hll;            // distinct values sketch registers
+	AttributeMCV *mcv;       // most common values
+	double *sample;          // reservoir sample of numeric values
+	double *histogram;       // equi-depth histogram bucket boundaries
+	uint sample_changes;     // sample modifications since histogram was built
+	uint64_t rng;            // sampling random state
+} AttributeStatistics;
+
+// create a new empty statistics object
+AttributeStatistics *AttributeStatistics_New(void);
+
+// introduce value `v` to statistics
+void AttributeStatistics_Add
+(
+	AttributeStatistics *stats,  // statistics to update
+	SIValue v                    // added value
+);
+
+// remove value `v` from statistics
+void AttributeStatistics_Remove
+(
+	AttributeStatistics *stats,  // statistics to update
+	SIValue v                    // removed value
+);
+
+// returns number of entities holding the attribute
+uint64_t AttributeStatistics_Count
+(
+	const AttributeStatistics *stats
+);
+
+// returns estimated number of distinct values
+uint64_t AttributeStatistics_DistinctCount
+(
+	const AttributeStatistics *stats
+);
+
+// returns most common values ordered by descending frequency
+// frequencies are returned via `counts`, which must be able to hold
+// ATTR_STATS_MCV_CAPACITY entries
+// returns number of values
+uint AttributeStatistics_MostCommonValues
+(
+	const AttributeStatistics *stats,  // statistics
+	SIValue *values,                   // [output] most common values
+	uint64_t *counts                   // [output] values frequencies
+);
+
+// returns histogram bucket boundaries, buckets hold an equal share of the
+// attribute's numeric values, bucket i covers [bounds[i], bounds[i+1]]
+// returns number of boundaries, 0 if there are no numeric values
+uint AttributeStatistics_Histogram
+(
+	const AttributeStatistics *stats,  // statistics
+	const double **bounds              // [output] bucket boundaries
+);
+
+// estimated fraction of entities holding the attribute whose value equals `v`
+// a NULL `v` stands for an unknown value
+double AttributeStatistics_EqualitySelectivity
+(
+	const AttributeStatistics *stats,  // statistics
+	const SIValue *v                   // compared value
+);
+
+// estimated fraction of entities holding the attribute whose value is
+// less than `v` (or greater than `v` when `less` is false)
+double AttributeStatistics_RangeSelectivity
+(
+	const AttributeStatistics *stats,  // statistics
+	double v,                          // range boundary
+	bool less                          // direction of range
+);
+
+// rebuild histogram from sample
+// called once the sample been modified outside of Add e.g. after load
+void AttributeStatistics_RefreshHistogram
+(
+	AttributeStatistics *stats
+);
+
+// free statistics
+void AttributeStatistics_Free
+(
+	AttributeStatistics *stats
+);
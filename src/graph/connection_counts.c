@@ -0,0 +1,158 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "xxhash.h"
+#include "../util/dict.h"
+#include "../util/rmalloc.h"
+#include "connection_counts.h"
+
+// pair of connected nodes
+typedef struct {
+	NodeID src;   // source node
+	NodeID dest;  // destination node
+} _Pair;
+
+struct _ConnectionCounts {
+	dict *pairs;  // pair -> number of relationship-types connecting the pair
+};
+
+static uint64_t _hash
+(
+	const void *key
+) {
+	return XXH64(key, sizeof(_Pair), 0);
+}
+
+static int _compare
+(
+	dict *d,
+	const void *a,
+	const void *b
+) {
+	const _Pair *x = a;
+	const _Pair *y = b;
+	return x->src == y->src && x->dest == y->dest;
+}
+
+// lookups use stack allocated pairs, copy pair when added to the table
+static void *_dup
+(
+	dict *d,
+	const void *key
+) {
+	_Pair *pair = rm_malloc(sizeof(_Pair));
+	*pair = *(const _Pair *)key;
+	return pair;
+}
+
+static void _free
+(
+	dict *d,
+	void *key
+) {
+	rm_free(key);
+}
+
+static dictType _dt = {_hash, _dup, NULL, _compare, _free, NULL, NULL, NULL,
+	NULL, NULL};
+
+ConnectionCounts *ConnectionCounts_New(void) {
+	ConnectionCounts *counts = rm_malloc(sizeof(ConnectionCounts));
+	counts->pairs = HashTableCreate(&_dt);
+	return counts;
+}
+
+void ConnectionCounts_Inc
+(
+	ConnectionCounts *counts,
+	NodeID src,
+	NodeID dest
+) {
+	ASSERT(counts != NULL);
+
+	_Pair key = {src, dest};
+	dictEntry *existing;
+	dictEntry *de = HashTableAddRaw(counts->pairs, &key, &existing);
+
+	if(de != NULL) {
+		// pair was connected once
+		HashTableSetVal(counts->pairs, de, (void *)2);
+	} else {
+		uint64_t n = (uint64_t)HashTableGetVal(existing);
+		HashTableSetVal(counts->pairs, existing, (void *)(n + 1));
+	}
+}
+
+uint64_t ConnectionCounts_Dec
+(
+	ConnectionCounts *counts,
+	NodeID src,
+	NodeID dest
+) {
+	ASSERT(counts != NULL);
+
+	_Pair key = {src, dest};
+	dictEntry *de = HashTableFind(counts->pairs, &key);
+
+	// pair was connected once
+	if(de == NULL) return 0;
+
+	uint64_t n = (uint64_t)HashTableGetVal(de) - 1;
+	ASSERT(n > 0);
+
+	if(n == 1) {
+		// pair is now connected once, drop count
+		int res = HashTableDelete(counts->pairs, &key);
+		ASSERT(res == DICT_OK);
+		UNUSED(res);
+	} else {
+		HashTableSetVal(counts->pairs, de, (void *)n);
+	}
+
+	return n;
+}
+
+uint64_t ConnectionCounts_Get
+(
+	const ConnectionCounts *counts,
+	NodeID src,
+	NodeID dest
+) {
+	ASSERT(counts != NULL);
+
+	_Pair key = {src, dest};
+	dictEntry *de = HashTableFind(counts->pairs, &key);
+
+	return (de == NULL) ? 1 : (uint64_t)HashTableGetVal(de);
+}
+
+uint64_t ConnectionCounts_Size
+(
+	const ConnectionCounts *counts
+) {
+	ASSERT(counts != NULL);
+	return HashTableElemCount(counts->pairs);
+}
+
+void ConnectionCounts_Clear
+(
+	ConnectionCounts *counts
+) {
+	ASSERT(counts != NULL);
+	HashTableEmpty(counts->pairs, NULL);
+}
+
+void ConnectionCounts_Free
+(
+	ConnectionCounts *counts
+) {
+	ASSERT(counts != NULL);
+
+	HashTableRelease(counts->pairs);
+	rm_free(counts);
+}
+
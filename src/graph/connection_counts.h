@@ -0,0 +1,73 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "entities/node.h"
+
+// number of relationship-types connecting pairs of nodes
+//
+// the adjacency matrix holds an entry for every pair of nodes (src, dest)
+// connected by at least one relationship-type
+// once the last edge of a relationship-type connecting src to dest is removed
+// the adjacency entry should only be cleared if no other relationship-type
+// connects the two nodes
+//
+// instead of probing each relation matrix, every connected pair counts
+// the number of relationship-types connecting it
+// the vast majority of pairs are connected by a single relationship-type
+// as such only counts greater than one are stored, a pair present in the
+// adjacency matrix and missing from the table is connected exactly once
+
+typedef struct _ConnectionCounts ConnectionCounts;
+
+// create a new empty connection counts table
+ConnectionCounts *ConnectionCounts_New(void);
+
+// an already connected pair gained an additional relationship-type
+void ConnectionCounts_Inc
+(
+	ConnectionCounts *counts,  // connection counts
+	NodeID src,                // source node
+	NodeID dest                // destination node
+);
+
+// a connected pair lost one of its relationship-types
+// returns the number of relationship-types still connecting the pair
+uint64_t ConnectionCounts_Dec
+(
+	ConnectionCounts *counts,  // connection counts
+	NodeID src,                // source node
+	NodeID dest                // destination node
+);
+
+// returns the number of relationship-types connecting a connected pair
+uint64_t ConnectionCounts_Get
+(
+	const ConnectionCounts *counts,  // connection counts
+	NodeID src,                      // source node
+	NodeID dest                      // destination node
+);
+
+// number of pairs connected by more than one relationship-type
+uint64_t ConnectionCounts_Size
+(
+	const ConnectionCounts *counts  // connection counts
+);
+
+// remove all counts, every connected pair is considered connected once
+void ConnectionCounts_Clear
+(
+	ConnectionCounts *counts  // connection counts
+);
+
+// free connection counts
+void ConnectionCounts_Free
+(
+	ConnectionCounts *counts  // connection counts to free
+);
+
@@ -112,6 +112,16 @@ SIValue AttributeSet_GetIdx
 	return attr->value;
 }
 
+// copy value into the set, strings are interned
+// sharing a single copy among all the sets holding them
+static inline SIValue _AttributeSet_CloneValue
+(
+	SIValue v  // value to copy
+) {
+	if(SI_TYPE(v) == T_STRING) return SI_InternValue(SI_ConstValue(&v));
+	return SI_CloneValue(v);
+}
+
 static AttributeSet AttributeSet_AddPrepare
 (
 	AttributeSet *set,  // set to update
@@ -155,7 +165,7 @@ void AttributeSet_AddNoClone
 		// make sure attribute isn't already in set
 		ASSERT(AttributeSet_Get(*set, ids[i]) == ATTRIBUTE_NOTFOUND);
 		// make sure value isn't volotile
-		ASSERT(SI_ALLOCATION(values + i) != M_VOLATILE);
+		ASSERT(!(SI_ALLOCATION(values + i) & M_VOLATILE));
 	}
 #endif
 
@@ -167,7 +177,7 @@ void AttributeSet_AddNoClone
 	for(ushort i = 0; i < n; i++) {
 		Attribute *attr = attrs + i;
 		attr->id    = ids[i];
-		attr->value = values[i];
+		attr->value = SI_InternValue(values[i]);
 	}
 
 	// update pointer
@@ -193,7 +203,7 @@ void AttributeSet_Add
 	// set attribute
 	Attribute *attr = _set->attributes + _set->attr_count - 1;
 	attr->id = attr_id;
-	attr->value = SI_CloneValue(value);
+	attr->value = _AttributeSet_CloneValue(value);
 
 	// update pointer
 	*set = _set;
@@ -239,7 +249,7 @@ AttributeSetChangeType AttributeSet_Set_Allow_Null
 	// set attribute
 	Attribute *attr = _set->attributes + _set->attr_count - 1;
 	attr->id = attr_id;
-	attr->value = SI_CloneValue(value);
+	attr->value = _AttributeSet_CloneValue(value);
 
 	// update pointer
 	*set = _set;
@@ -269,7 +279,7 @@ bool AttributeSet_UpdateNoClone
 
 	// value != current, update entity
 	SIValue_Free(*current);  // free previous value
-	*current = value;
+	*current = SI_InternValue(value);
 
 	return true;
 }
@@ -299,7 +309,7 @@ bool AttributeSet_Update
 
 	// value != current, update entity
 	SIValue_Free(*current);  // free previous value
-	*current = SI_CloneValue(value);
+	*current = _AttributeSet_CloneValue(value);
 
 	return true;
 }
@@ -15,6 +15,7 @@
 // Forward declarations
 //------------------------------------------------------------------------------
 void _MatrixResizeToCapacity(const Graph *g, RG_Matrix m);
+static void _Graph_ApplyFlush(Graph *g);
 
 //------------------------------------------------------------------------------
 // Synchronization functions
@@ -66,6 +67,9 @@ void Graph_AcquireWriteLock(Graph *g) {
 
 	pthread_rwlock_wrlock(&g->_rwlock);
 	g->_writelocked = true;
+
+	// no reader is active, swap in matrices flushed in the background
+	_Graph_ApplyFlush(g);
 }
 
 // Release the held lock
@@ -217,8 +221,10 @@ void _MatrixSynchronize
 	// flush pending changes if dirty
 	// we need to call 'RG_Matrix_isDirty' again
 	// as 'RG_Matrix_resize' might require 'wait' for HyperSparse matrices
+	// merging deltas is deferred to a background flush
+	// see Graph_PrepareFlush
 	if(RG_Matrix_isDirty(m)) {
-		info = RG_Matrix_wait(m, false);
+		info = RG_Matrix_waitDeferred(m);
 		ASSERT(info == GrB_SUCCESS);
 	}
 
@@ -306,6 +312,18 @@ void Graph_SetMatrixPolicy
 }
 
 // synchronize and resize all matrices in graph
+// flush matrix pending changes
+// the matrix lock is held as a background flush might be prepared concurrently
+static void _Graph_WaitMatrix
+(
+	RG_Matrix M,
+	bool force_flush
+) {
+	RG_Matrix_Lock(M);
+	RG_Matrix_wait(M, force_flush);
+	RG_Matrix_Unlock(M);
+}
+
 void Graph_ApplyAllPending
 (
 	Graph *g,
@@ -328,28 +346,28 @@ void Graph_ApplyAllPending
 
 	// sync the adjacency matrix
 	M = Graph_GetAdjacencyMatrix(g, false);
-	RG_Matrix_wait(M, force_flush);
+	_Graph_WaitMatrix(M, force_flush);
 
 	// sync node labels matrix
 	M = Graph_GetNodeLabelMatrix(g);
-	RG_Matrix_wait(M, force_flush);
+	_Graph_WaitMatrix(M, force_flush);
 
 	// sync the zero matrix
 	M = Graph_GetZeroMatrix(g);
-	RG_Matrix_wait(M, force_flush);
+	_Graph_WaitMatrix(M, force_flush);
 
 	// sync each label matrix
 	n = array_len(g->labels);
 	for(int i = 0; i < n; i ++) {
 		M = Graph_GetLabelMatrix(g, i);
-		RG_Matrix_wait(M, force_flush);
+		_Graph_WaitMatrix(M, force_flush);
 	}
 
 	// sync each relation matrix
 	n = array_len(g->relations);
 	for(int i = 0; i < n; i ++) {
 		M = Graph_GetRelationMatrix(g, i, false);
-		RG_Matrix_wait(M, force_flush);
+		_Graph_WaitMatrix(M, force_flush);
 	}
 
 	// restore previous matrix sync policy
@@ -433,6 +451,133 @@ bool Graph_Pending
 	return false;
 }
 
+//------------------------------------------------------------------------------
+// Background flush
+//------------------------------------------------------------------------------
+
+// returns the graph's i'th modifiable matrix
+// NULL once i exceeds the number of matrices
+static RG_Matrix _Graph_GetMatrix
+(
+	const Graph *g,
+	uint i
+) {
+	if(i == 0) return g->adjacency_matrix;
+	if(i == 1) return g->node_labels;
+	i -= 2;
+
+	uint n = array_len(g->labels);
+	if(i < n) return g->labels[i];
+	i -= n;
+
+	n = array_len(g->relations);
+	if(i < n) return g->relations[i];
+
+	return NULL;
+}
+
+// swap in prepared flushes, requires exclusive access to the graph
+static void _Graph_ApplyFlush
+(
+	Graph *g
+) {
+	RG_Matrix M;
+	for(uint i = 0; (M = _Graph_GetMatrix(g, i)) != NULL; i++) {
+		RG_Matrix_applyFlush(M);
+	}
+}
+
+bool Graph_RequiresFlush
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+
+	RG_Matrix M;
+	for(uint i = 0; (M = _Graph_GetMatrix(g, i)) != NULL; i++) {
+		if(RG_Matrix_requiresFlush(M)) return true;
+	}
+
+	return false;
+}
+
+bool Graph_PrepareFlush
+(
+	Graph *g,
+	uint i
+) {
+	ASSERT(g != NULL);
+
+	RG_Matrix M = _Graph_GetMatrix(g, i);
+	if(M == NULL) return false;
+
+	// resize and materialize the matrix upfront
+	// readers won't need the matrix lock while the flush is prepared
+	g->SynchronizeMatrix(g, M);
+
+	// the matrix lock is taken internally, only for the duration of
+	// snapshotting the deltas and publishing the merged matrix
+	GrB_Info info = RG_Matrix_prepareFlush(M);
+	ASSERT(info == GrB_SUCCESS);
+	UNUSED(info);
+
+	return true;
+}
+
+void Graph_ApplyFlush
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+
+	// wait for active readers to drain
+	// attributes are untouched, columnar copies remain valid
+	pthread_rwlock_wrlock(&g->_rwlock);
+	g->_writelocked = true;
+
+	_Graph_ApplyFlush(g);
+
+	Graph_ReleaseLock(g);
+}
+
+void Graph_LockMatrices
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+
+	RG_Matrix M;
+	for(uint i = 0; (M = _Graph_GetMatrix(g, i)) != NULL; i++) {
+		RG_Matrix_Lock(M);
+	}
+	RG_Matrix_Lock(g->_zero_matrix);
+}
+
+void Graph_UnlockMatrices
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+
+	RG_Matrix M;
+	for(uint i = 0; (M = _Graph_GetMatrix(g, i)) != NULL; i++) {
+		RG_Matrix_Unlock(M);
+	}
+	RG_Matrix_Unlock(g->_zero_matrix);
+}
+
+void Graph_WaitMatrices
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+
+	RG_Matrix M;
+	for(uint i = 0; (M = _Graph_GetMatrix(g, i)) != NULL; i++) {
+		RG_Matrix_waitNoSync(M);
+	}
+}
+
 //------------------------------------------------------------------------------
 // Graph API
 //------------------------------------------------------------------------------
@@ -460,9 +605,13 @@ Graph *Graph_New
 	RG_Matrix_new(&g->adjacency_matrix->transposed, GrB_BOOL, n, n);
 	RG_Matrix_new(&g->_zero_matrix, GrB_BOOL, n, n);
 
+	g->connections = ConnectionCounts_New();
+
 	// init graph statistics
 	GraphStatistics_init(&g->stats);
 
+	g->columns = PropertyColumns_New();
+
 	// initialize a read-write lock scoped to the individual graph
 	_CreateRWLock(g);
 	g->_writelocked = false;
@@ -552,6 +701,92 @@ bool Graph_GetNode
 	return (n->attributes != NULL);
 }
 
+// lay out attribute in a column covering every label large enough
+static void _Graph_BuildColumns
+(
+	Graph *g,
+	Attribute_ID attr
+) {
+	uint64_t min_label_size = PropertyColumns_GetMinLabelSize();
+
+	RG_Matrix *labels = array_new(RG_Matrix, 0);
+
+	int n = Graph_LabelTypeCount(g);
+	for(LabelID l = 0; l < n; l++) {
+		GrB_Index nvals;
+		RG_Matrix L = Graph_GetLabelMatrix(g, l);
+		RG_Matrix_nvals(&nvals, L);
+		if(nvals >= min_label_size) array_append(labels, L);
+	}
+
+	PropertyColumn *col = PropertyColumn_Build(labels, array_len(labels),
+			g->nodes, attr);
+	array_free(labels);
+
+	// publish even if no column was built
+	// so the attribute isn't considered again until the graph is modified
+	PropertyColumns_Publish(g->columns, attr, col);
+}
+
+bool Graph_GetNodeColumnarProperty
+(
+	Graph *g,
+	NodeID id,
+	Attribute_ID attr,
+	SIValue *v
+) {
+	ASSERT(g != NULL);
+	ASSERT(v != NULL);
+
+	// columns are invalidated by the writer while it modifies nodes
+	if(g->_writelocked) return false;
+
+	bool build;
+	if(PropertyColumns_Get(g->columns, attr, id, v, &build)) return true;
+	if(likely(!build)) return false;
+
+	_Graph_BuildColumns(g, attr);
+
+	return PropertyColumns_Get(g->columns, attr, id, v, &build);
+}
+
+void Graph_InvalidateNodeColumn
+(
+	Graph *g,
+	Attribute_ID attr
+) {
+	ASSERT(g != NULL);
+
+	PropertyColumns_Invalidate(g->columns, attr);
+}
+
+void Graph_InvalidateNodeColumns
+(
+	Graph *g,
+	const AttributeSet prev,
+	const AttributeSet set
+) {
+	ASSERT(g != NULL);
+
+	uint16_t n = ATTRIBUTE_SET_COUNT(prev);
+	for(uint16_t i = 0; i < n; i++) {
+		Attribute_ID attr;
+		SIValue v = AttributeSet_GetIdx(prev, i, &attr);
+
+		// attributes added by `set` aren't held by any column
+		// only modified and removed attributes are invalidated
+		if(set != NULL) {
+			SIValue *u = AttributeSet_Get(set, attr);
+			if(u != ATTRIBUTE_NOTFOUND && SI_TYPE(*u) == SI_TYPE(v) &&
+			   SIValue_Compare(*u, v, NULL) == 0) {
+				continue;
+			}
+		}
+
+		PropertyColumns_Invalidate(g->columns, attr);
+	}
+}
+
 bool Graph_GetEdge
 (
 	const Graph *g,
@@ -792,11 +1027,19 @@ bool Graph_FormConnection
 ) {
 	ASSERT(g != NULL);
 
+	bool     x;
+	uint64_t v;
 	GrB_Info info;
 	UNUSED(info);
 	RG_Matrix M   = Graph_GetRelationMatrix(g, r, false);
 	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
 
+	// src is connected to dest by a relationship-type other than r
+	// r is about to connect the pair as well
+	bool additional_connection =
+		RG_Matrix_extractElement_BOOL(&x, adj, src, dest) == GrB_SUCCESS &&
+		RG_Matrix_extractElement_UINT64(&v, M, src, dest) != GrB_SUCCESS;
+
 	// rows represent source nodes, columns represent destination nodes
 	info = RG_Matrix_setElement_BOOL(adj, src, dest);
 	// incase of decoding it is possible to write outside of matrix bounds
@@ -806,6 +1049,10 @@ bool Graph_FormConnection
 	info = RG_Matrix_setElement_UINT64(M, edge_id, src, dest);
 	if(info != GrB_SUCCESS) return false;
 
+	if(additional_connection) {
+		ConnectionCounts_Inc(g->connections, src, dest);
+	}
+
 	// an edge of type r has just been created, update statistics
 	GraphStatistics_IncEdgeCount(&g->stats, r, 1);
 
@@ -843,6 +1090,113 @@ void Graph_CreateEdge
 	Graph_FormConnection(g, src, dest, id, r);
 }
 
+// count pairs which are about to be connected by relation matrix `M`
+// while already connected by another relationship-type
+// both `M` and `adj` are expected to be synced
+static void _Graph_CountConnections
+(
+	Graph *g,            // graph
+	RG_Matrix M,         // relation matrix
+	RG_Matrix adj,       // adjacency matrix
+	const NodeID *src,   // source node IDs
+	const NodeID *dest,  // destination node IDs
+	uint64_t n           // number of pairs
+) {
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Index  nvals;
+	GrB_Scalar s;
+	GrB_Matrix T;
+
+	UNUSED(info);
+
+	GrB_Matrix m     = RG_MATRIX_M(M);
+	GrB_Matrix adj_m = RG_MATRIX_M(adj);
+
+	GrB_Matrix_nrows(&nrows, adj_m);
+	GrB_Matrix_ncols(&ncols, adj_m);
+
+	// T holds the pairs about to be connected, duplicates are merged
+	info = GrB_Matrix_new(&T, GrB_BOOL, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Scalar_new(&s, GrB_BOOL);
+	GrB_Scalar_setElement_BOOL(s, true);
+	info = GxB_Matrix_build_Scalar(T, src, dest, s, n);
+	ASSERT(info == GrB_SUCCESS);
+	GrB_Scalar_free(&s);
+
+	// T<!M> = T .* adj
+	// pairs new to M which are already connected
+	info = GrB_Matrix_eWiseMult_BinaryOp(T, m, NULL, GrB_ONEB_BOOL, T, adj_m,
+			GrB_DESC_RSC);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix_nvals(&nvals, T);
+	if(nvals > 0) {
+		GrB_Index *I = rm_malloc(sizeof(GrB_Index) * nvals);
+		GrB_Index *J = rm_malloc(sizeof(GrB_Index) * nvals);
+
+		info = GrB_Matrix_extractTuples_BOOL(I, J, NULL, &nvals, T);
+		ASSERT(info == GrB_SUCCESS);
+
+		for(GrB_Index i = 0; i < nvals; i++) {
+			ConnectionCounts_Inc(g->connections, I[i], J[i]);
+		}
+
+		rm_free(I);
+		rm_free(J);
+	}
+
+	GrB_Matrix_free(&T);
+}
+
+void Graph_CreateEdges
+(
+	Graph *g,
+	RelationID r,
+	const NodeID *src,
+	const NodeID *dest,
+	EdgeID *ids,
+	uint64_t n
+) {
+	ASSERT(g    != NULL);
+	ASSERT(src  != NULL);
+	ASSERT(ids  != NULL);
+	ASSERT(dest != NULL);
+	ASSERT(r < Graph_RelationTypeCount(g));
+
+	if(n == 0) return;
+
+	for(uint64_t i = 0; i < n; i++) {
+		AttributeSet *set = DataBlock_AllocateItem(g->edges, ids + i);
+		*set = NULL;
+	}
+
+	RG_Matrix M   = Graph_GetRelationMatrix(g, r, false);
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+
+	// tuples are added directly to M, flush pending deltas
+	if(!RG_Matrix_Synced(M))   _Graph_WaitMatrix(M, true);
+	if(!RG_Matrix_Synced(adj)) _Graph_WaitMatrix(adj, true);
+
+	_Graph_CountConnections(g, M, adj, src, dest, n);
+
+	// rows represent source nodes, columns represent destination nodes
+	GrB_Info info;
+	UNUSED(info);
+
+	info = RG_Matrix_build(adj, src, dest, NULL, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = RG_Matrix_build(M, src, dest, ids, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// edges of type r have just been created, update statistics
+	GraphStatistics_IncEdgeCount(&g->stats, r, n);
+}
+
 // retrieves all either incoming or outgoing edges
 // to/from given node N, depending on given direction
 void Graph_GetNodeEdges
@@ -931,6 +1285,185 @@ void Graph_GetNodeEdges
 	}
 }
 
+// extract rows I from matrix A, C = A(I, :)
+// pending changes are taken into account: C = (M<!DM> + DP)(I, :)
+static void _Graph_ExtractRows
+(
+	GrB_Matrix *C,       // [output] extracted rows
+	const RG_Matrix A,   // matrix to extract rows from
+	const GrB_Index *I,  // row indices, sorted
+	GrB_Index n          // number of rows
+) {
+	GrB_Type   t;
+	GrB_Info   info;
+	GrB_Index  ncols;
+	GrB_Index  nvals;
+	GrB_Matrix T;
+
+	UNUSED(info);
+
+	GrB_Matrix m  = RG_MATRIX_M(A);
+	GrB_Matrix dp = RG_MATRIX_DELTA_PLUS(A);
+	GrB_Matrix dm = RG_MATRIX_DELTA_MINUS(A);
+
+	GxB_Matrix_type(&t, m);
+	GrB_Matrix_ncols(&ncols, m);
+
+	info = GrB_Matrix_new(C, t, n, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_extract(*C, NULL, NULL, m, I, n, GrB_ALL, ncols, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	// drop entries marked for deletion
+	GrB_Matrix_nvals(&nvals, dm);
+	if(nvals > 0) {
+		info = GrB_Matrix_new(&T, GrB_BOOL, n, ncols);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_extract(T, NULL, NULL, dm, I, n, GrB_ALL, ncols,
+				NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// C<!T> = C
+		info = GrB_Matrix_assign(*C, T, NULL, *C, GrB_ALL, n, GrB_ALL, ncols,
+				GrB_DESC_RSC);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Matrix_free(&T);
+	}
+
+	// introduce pending additions, disjoint from M
+	GrB_Matrix_nvals(&nvals, dp);
+	if(nvals > 0) {
+		info = GrB_Matrix_new(&T, t, n, ncols);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_extract(T, NULL, NULL, dp, I, n, GrB_ALL, ncols,
+				NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_eWiseAdd_BinaryOp(*C, NULL, NULL, GrB_FIRST_UINT64,
+				*C, T, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Matrix_free(&T);
+	}
+}
+
+// returns true if id is one of the sorted IDs
+static inline bool _Graph_ContainsID
+(
+	const GrB_Index *ids,  // sorted IDs
+	GrB_Index n,           // number of IDs
+	GrB_Index id           // ID to look for
+) {
+	GrB_Index lo = 0;
+	GrB_Index hi = n;
+	while(lo < hi) {
+		GrB_Index mid = lo + (hi - lo) / 2;
+		if(ids[mid] == id) return true;
+		if(ids[mid] < id) lo = mid + 1;
+		else hi = mid;
+	}
+	return false;
+}
+
+void Graph_GetNodesEdges
+(
+	const Graph *g,
+	const Node *nodes,
+	uint64_t n,
+	Edge **edges
+) {
+	ASSERT(g     != NULL);
+	ASSERT(nodes != NULL);
+	ASSERT(edges != NULL);
+
+	if(n == 0) return;
+
+	GrB_Info   info;
+	GrB_Index  nvals;
+	GrB_Matrix C;
+
+	UNUSED(info);
+
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * n);
+	for(uint64_t i = 0; i < n; i++) {
+		I[i] = ENTITY_GET_ID(nodes + i);
+		ASSERT(i == 0 || I[i - 1] < I[i]);
+	}
+
+	int relation_count = Graph_RelationTypeCount(g);
+	for(int r = 0; r < relation_count; r++) {
+		RG_Matrix M  = Graph_GetRelationMatrix(g, r, false);
+		RG_Matrix TM = Graph_GetRelationMatrix(g, r, true);
+
+		//----------------------------------------------------------------------
+		// outgoing edges
+		//----------------------------------------------------------------------
+
+		// C[k, dest] = M[I[k], dest]
+		_Graph_ExtractRows(&C, M, I, n);
+
+		GrB_Matrix_nvals(&nvals, C);
+		if(nvals > 0) {
+			GrB_Index *rows = rm_malloc(sizeof(GrB_Index) * nvals);
+			GrB_Index *cols = rm_malloc(sizeof(GrB_Index) * nvals);
+			uint64_t  *vals = rm_malloc(sizeof(uint64_t) * nvals);
+
+			info = GrB_Matrix_extractTuples_UINT64(rows, cols, vals, &nvals, C);
+			ASSERT(info == GrB_SUCCESS);
+
+			for(GrB_Index i = 0; i < nvals; i++) {
+				_CollectEdgesFromEntry(g, I[rows[i]], cols[i], r, vals[i],
+						edges);
+			}
+
+			rm_free(rows);
+			rm_free(cols);
+			rm_free(vals);
+		}
+		GrB_Matrix_free(&C);
+
+		//----------------------------------------------------------------------
+		// incoming edges
+		//----------------------------------------------------------------------
+
+		// C[k, src] = TM[I[k], src]
+		_Graph_ExtractRows(&C, TM, I, n);
+
+		GrB_Matrix_nvals(&nvals, C);
+		if(nvals > 0) {
+			GrB_Index *rows = rm_malloc(sizeof(GrB_Index) * nvals);
+			GrB_Index *cols = rm_malloc(sizeof(GrB_Index) * nvals);
+
+			info = GrB_Matrix_extractTuples_BOOL(rows, cols, NULL, &nvals, C);
+			ASSERT(info == GrB_SUCCESS);
+
+			for(GrB_Index i = 0; i < nvals; i++) {
+				NodeID src  = cols[i];
+				NodeID dest = I[rows[i]];
+
+				// edges leaving a collected node were collected as outgoing
+				if(_Graph_ContainsID(I, n, src)) continue;
+
+				EdgeID id;
+				info = RG_Matrix_extractElement_UINT64(&id, M, src, dest);
+				ASSERT(info == GrB_SUCCESS);
+
+				_CollectEdgesFromEntry(g, src, dest, r, id, edges);
+			}
+
+			rm_free(rows);
+			rm_free(cols);
+		}
+		GrB_Matrix_free(&C);
+	}
+
+	rm_free(I);
+}
+
 // returns node incoming/outgoing degree
 uint64_t Graph_GetNodeDegree
 (
@@ -1075,6 +1608,42 @@ uint Graph_GetNodeLabels
 	return i;
 }
 
+// removes edge `id` of type r connecting src to dest from the matrices
+// the edge's attributes are left intact
+static void _Graph_Disconnect
+(
+	Graph *g,     // graph
+	NodeID src,   // source node
+	NodeID dest,  // destination node
+	EdgeID id,    // edge ID
+	int r         // edge relationship-type
+) {
+	GrB_Info info;
+	bool     entry_deleted;
+	UNUSED(info);
+
+	RG_Matrix R = Graph_GetRelationMatrix(g, r, false);
+
+	// single edge of type R connecting src to dest, delete entry
+	info = RG_Matrix_removeEntry_UINT64(R, src, dest, id, &entry_deleted);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(entry_deleted) {
+		// r no longer connects source to destination
+		// see if source is connected to destination by additional
+		// relationship-types
+		uint64_t connections = ConnectionCounts_Dec(g->connections, src, dest);
+
+		// there are no additional edges connecting source to destination
+		// remove edge from THE adjacency matrix
+		if(connections == 0) {
+			RG_Matrix M = Graph_GetAdjacencyMatrix(g, false);
+			info = RG_Matrix_removeElement_BOOL(M, src, dest);
+			ASSERT(info == GrB_SUCCESS);
+		}
+	}
+}
+
 // removes edges from Graph and updates graph relevant matrices
 void Graph_DeleteEdges
 (
@@ -1086,12 +1655,6 @@ void Graph_DeleteEdges
 	ASSERT(n > 0);
 	ASSERT(edges != NULL);
 
-	uint64_t    x;
-	RG_Matrix   R;
-	RG_Matrix   M;
-	GrB_Info    info;
-	bool        entry_deleted;
-
 	MATRIX_POLICY policy = Graph_GetMatrixPolicy(g);
 	Graph_SetMatrixPolicy(g, SYNC_POLICY_NOP);
 
@@ -1106,43 +1669,263 @@ void Graph_DeleteEdges
 		// an edge of type r has just been deleted, update statistics
 		GraphStatistics_DecEdgeCount(&g->stats, r, 1);
 
-		R = Graph_GetRelationMatrix(g, r, false);
+		_Graph_Disconnect(g, src_id, dest_id, ENTITY_GET_ID(e), r);
 
-		// single edge of type R connecting src to dest, delete entry
-		info = RG_Matrix_removeEntry_UINT64(R, src_id, dest_id, ENTITY_GET_ID(e), &entry_deleted);
-		ASSERT(info == GrB_SUCCESS);
+		// free and remove edges from datablock.
+		DataBlock_DeleteItem(g->edges, ENTITY_GET_ID(e));
+	}
 
-		if(entry_deleted) {
-			// TODO: consider making ADJ UINT64_T where ADJ[i,j] = #connections
-			// drop the entry once it reaches 0
-			//
-			// see if source is connected to destination with additional edges
-			bool connected = false;
-			int relationCount = Graph_RelationTypeCount(g);
-			for(int i = 0; i < relationCount; i++) {
-				if(i == r) continue;
-				M = Graph_GetRelationMatrix(g, i, false);
-				info = RG_Matrix_extractElement_UINT64(&x, M, src_id, dest_id);
-				if(info == GrB_SUCCESS) {
-					connected = true;
-					break;
-				}
+	Graph_SetMatrixPolicy(g, policy);
+}
+
+//------------------------------------------------------------------------------
+// compaction
+//------------------------------------------------------------------------------
+
+uint64_t Graph_PrepareNodeRelocation
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+	return DataBlock_GatherHoles(g->nodes, Graph_NodeCount(g));
+}
+
+uint64_t Graph_PrepareEdgeRelocation
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+	return DataBlock_GatherHoles(g->edges, Graph_EdgeCount(g));
+}
+
+NodeID Graph_RelocateNode
+(
+	Graph *g,
+	NodeID src,
+	uint64_t i,
+	Edge **edges
+) {
+	ASSERT(g     != NULL);
+	ASSERT(edges != NULL);
+	ASSERT(src   >= Graph_NodeCount(g));
+
+	Node n = GE_NEW_NODE();
+	n.id = src;
+
+	// collect node's labels and edges while they're keyed by src
+	uint label_count;
+	NODE_GET_LABELS(g, &n, label_count);
+
+	uint64_t offset = array_len(*edges);
+	Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_BOTH, GRAPH_NO_RELATION, edges);
+	uint64_t edge_count = array_len(*edges);
+
+	// columns are keyed by node ID, discard columns holding node's values
+	bool found = Graph_GetNode(g, src, &n);
+	ASSERT(found == true);
+	UNUSED(found);
+	Graph_InvalidateNodeColumns(g, *n.attributes, NULL);
+
+	NodeID dest = DataBlock_MoveItem(g->nodes, src, i);
+	ASSERT(dest < Graph_NodeCount(g));
+
+	if(label_count > 0) {
+		Graph_LabelNode(g, dest, labels, label_count);
+		Graph_RemoveNodeLabels(g, src, labels, label_count);
+	}
+
+	for(uint64_t j = offset; j < edge_count; j++) {
+		Edge *e = *edges + j;
+		int   r = Edge_GetRelationID(e);
+
+		_Graph_Disconnect(g, e->src_id, e->dest_id, ENTITY_GET_ID(e), r);
+
+		if(e->src_id  == src) e->src_id  = dest;
+		if(e->dest_id == src) e->dest_id = dest;
+
+		Graph_FormConnection(g, e->src_id, e->dest_id, ENTITY_GET_ID(e), r);
+
+		// edge was counted again by Graph_FormConnection
+		GraphStatistics_DecEdgeCount(&g->stats, r, 1);
+	}
+
+	return dest;
+}
+
+EdgeID Graph_RelocateEdge
+(
+	Graph *g,
+	Edge *e,
+	uint64_t i
+) {
+	ASSERT(g != NULL);
+	ASSERT(e != NULL);
+	ASSERT(ENTITY_GET_ID(e) >= Graph_EdgeCount(g));
+
+	int    r    = Edge_GetRelationID(e);
+	EdgeID src  = ENTITY_GET_ID(e);
+	EdgeID dest = DataBlock_MoveItem(g->edges, src, i);
+	ASSERT(dest < Graph_EdgeCount(g));
+
+	_Graph_Disconnect(g, e->src_id, e->dest_id, src, r);
+	Graph_FormConnection(g, e->src_id, e->dest_id, dest, r);
+
+	// edge was counted again by Graph_FormConnection
+	GraphStatistics_DecEdgeCount(&g->stats, r, 1);
+
+	e->id         = dest;
+	e->attributes = DataBlock_GetItem(g->edges, dest);
+
+	return dest;
+}
+
+uint64_t Graph_CollectRelocatableEdges
+(
+	const Graph *g,
+	RelationID r,
+	NodeID *row,
+	uint64_t n,
+	Edge **edges
+) {
+	ASSERT(g     != NULL);
+	ASSERT(row   != NULL);
+	ASSERT(edges != NULL);
+
+	GrB_Index nrows;
+	RG_Matrix M = Graph_GetRelationMatrix(g, r, false);
+	RG_Matrix_nrows(&nrows, M);
+
+	if(*row >= nrows) {
+		*row = nrows;
+		return 0;
+	}
+
+	EdgeID             limit   = Graph_EdgeCount(g);
+	NodeID             src     = INVALID_ENTITY_ID;
+	NodeID             dest    = INVALID_ENTITY_ID;
+	EdgeID             id      = INVALID_ENTITY_ID;
+	NodeID             last    = INVALID_ENTITY_ID;
+	uint64_t           visited = 0;
+	RG_MatrixTupleIter it      = {0};
+
+	RG_MatrixTupleIter_AttachRange(&it, M, *row, nrows - 1);
+
+	// unless stopped early, every row was scanned
+	*row = nrows;
+
+	while(RG_MatrixTupleIter_next_UINT64(&it, &src, &dest, &id) == GrB_SUCCESS) {
+		// stop on a row boundary once enough entries were visited
+		// a row is never left partially scanned
+		if(visited >= n && src != last) {
+			*row = src;
+			break;
+		}
+		last = src;
+
+		Edge e = {0};
+		e.src_id     = src;
+		e.dest_id    = dest;
+		e.relationID = r;
+
+		if(SINGLE_EDGE(id)) {
+			visited++;
+			if(id < limit) continue;
+			e.id         = id;
+			e.attributes = DataBlock_GetItem(g->edges, id);
+			array_append(*edges, e);
+		} else {
+			// multiple edges connecting src to dest
+			EdgeID *ids = (EdgeID *)(CLEAR_MSB(id));
+			uint count = array_len(ids);
+			visited += count;
+			for(uint j = 0; j < count; j++) {
+				if(ids[j] < limit) continue;
+				e.id         = ids[j];
+				e.attributes = DataBlock_GetItem(g->edges, ids[j]);
+				array_append(*edges, e);
 			}
+		}
+	}
 
-			// there are no additional edges connecting source to destination
-			// remove edge from THE adjacency matrix
-			if(!connected) {
-				M = Graph_GetAdjacencyMatrix(g, false);
-				info = RG_Matrix_removeElement_BOOL(M, src_id, dest_id);
-				ASSERT(info == GrB_SUCCESS);
+	RG_MatrixTupleIter_detach(&it);
+
+	return visited;
+}
+
+void Graph_TrimEntities
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+
+	DataBlock_Trim(g->nodes);
+	DataBlock_Trim(g->edges);
+}
+
+void Graph_RebuildConnectionCounts
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Index  nvals;
+	GrB_Matrix C;
+
+	UNUSED(info);
+
+	ConnectionCounts_Clear(g->connections);
+
+	int relation_count = Graph_RelationTypeCount(g);
+	if(relation_count < 2) return;
+
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+	RG_Matrix_nrows(&nrows, adj);
+	RG_Matrix_ncols(&ncols, adj);
+
+	info = GrB_Matrix_new(&C, GrB_UINT64, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	// C[i,j] = number of relation matrices holding entry [i,j]
+	for(int r = 0; r < relation_count; r++) {
+		RG_Matrix R = Graph_GetRelationMatrix(g, r, false);
+		ASSERT(RG_Matrix_Synced(R));
+
+		// C<R> += 1
+		info = GrB_Matrix_assign_UINT64(C, RG_MATRIX_M(R), GrB_PLUS_UINT64,
+				1, GrB_ALL, nrows, GrB_ALL, ncols, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// only pairs connected more than once are tracked
+	info = GrB_Matrix_select_UINT64(C, NULL, NULL, GrB_VALUEGT_UINT64, C, 1,
+			NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix_nvals(&nvals, C);
+	if(nvals > 0) {
+		GrB_Index *I = rm_malloc(sizeof(GrB_Index) * nvals);
+		GrB_Index *J = rm_malloc(sizeof(GrB_Index) * nvals);
+		uint64_t  *X = rm_malloc(sizeof(uint64_t) * nvals);
+
+		info = GrB_Matrix_extractTuples_UINT64(I, J, X, &nvals, C);
+		ASSERT(info == GrB_SUCCESS);
+
+		for(GrB_Index i = 0; i < nvals; i++) {
+			// first connection is implied by the adjacency matrix
+			for(uint64_t k = 1; k < X[i]; k++) {
+				ConnectionCounts_Inc(g->connections, I[i], J[i]);
 			}
 		}
 
-		// free and remove edges from datablock.
-		DataBlock_DeleteItem(g->edges, ENTITY_GET_ID(e));
+		rm_free(I);
+		rm_free(J);
+		rm_free(X);
 	}
 
-	Graph_SetMatrixPolicy(g, policy);
+	GrB_Matrix_free(&C);
 }
 
 inline bool Graph_EntityIsDeleted
@@ -1165,6 +1948,16 @@ DataBlockIterator *Graph_ScanNodes(const Graph *g) {
 	return DataBlock_Scan(g->nodes);
 }
 
+DataBlockIterator *Graph_ScanNodesRange
+(
+	const Graph *g,
+	NodeID start,
+	NodeID end
+) {
+	ASSERT(g);
+	return DataBlock_ScanRange(g->nodes, start, end);
+}
+
 DataBlockIterator *Graph_ScanEdges(const Graph *g) {
 	ASSERT(g);
 	return DataBlock_Scan(g->edges);
@@ -1355,10 +2148,12 @@ static void _Graph_Free
 
 	RG_Matrix_free(&g->_zero_matrix);
 	RG_Matrix_free(&g->adjacency_matrix);
+	ConnectionCounts_Free(g->connections);
 
 	_Graph_FreeRelationMatrices(g);
 	array_free(g->relations);
 	GraphStatistics_FreeInternals(&g->stats);
+	PropertyColumns_Free(g->columns);
 
 	uint32_t labelCount = array_len(g->labels);
 	for(int i = 0; i < labelCount; i++) RG_Matrix_free(&g->labels[i]);
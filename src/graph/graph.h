@@ -13,6 +13,8 @@
 #include "entities/edge.h"
 #include "../redismodule.h"
 #include "graph_statistics.h"
+#include "property_columns.h"
+#include "connection_counts.h"
 #include "rg_matrix/rg_matrix.h"
 #include "../util/datablock/datablock.h"
 #include "../util/datablock/datablock_iterator.h"
@@ -48,6 +50,7 @@ struct Graph {
 	DataBlock *nodes;                   // graph nodes stored in blocks
 	DataBlock *edges;                   // graph edges stored in blocks
 	RG_Matrix adjacency_matrix;         // adjacency matrix, holds all graph connections
+	ConnectionCounts *connections;      // number of relationship-types connecting each pair
 	RG_Matrix *labels;                  // label matrices
 	RG_Matrix node_labels;              // mapping of all node IDs to all labels possessed by each node
 	RG_Matrix *relations;               // relation matrices
@@ -56,6 +59,7 @@ struct Graph {
 	bool _writelocked;                  // true if the read-write lock was acquired by a writer
 	SyncMatrixFunc SynchronizeMatrix;   // function pointer to matrix synchronization routine
 	GraphStatistics stats;              // graph related statistics
+	PropertyColumns *columns;           // columnar read cache of node attributes
 };
 
 // graph synchronization functions
@@ -106,6 +110,61 @@ void Graph_SetMatrixPolicy
 	MATRIX_POLICY policy
 );
 
+// background flush
+// pending matrix changes are merged into new matrices off-lock
+// while readers keep on using the current matrices
+// the merged matrices are swapped in by the writer thread, see Graph_ApplyFlush
+// or the next time the write lock is acquired
+// matrices modified in the meantime discard their merged matrix
+
+// returns true if any of the graph's matrices accumulated enough pending
+// changes to be flushed, caller must hold the write lock
+bool Graph_RequiresFlush
+(
+	const Graph *g
+);
+
+// prepare the background flush of the graph's i'th matrix
+// caller must hold the read lock, holding it for the entire set of matrices
+// would delay writers, hence matrices are prepared one at a time
+// returns false once i exceeds the number of matrices
+bool Graph_PrepareFlush
+(
+	Graph *g,
+	uint i
+);
+
+// apply prepared flushes, acquires the write lock
+// must be called from the writer thread, a write query runs its match phase
+// without holding the graph lock and must not observe matrices being swapped
+void Graph_ApplyFlush
+(
+	Graph *g
+);
+
+// lock each of the graph's matrices, waiting for in-flight synchronizations
+// to complete, caller must hold the graph lock
+// a flush being prepared holds a matrix lock only while snapshotting deltas
+// and publishing its result, never for the duration of the merge
+// while locked no matrix is modified, pending changes are left in place
+void Graph_LockMatrices
+(
+	Graph *g
+);
+
+// unlock each of the graph's matrices
+void Graph_UnlockMatrices
+(
+	Graph *g
+);
+
+// complete pending GraphBLAS work on each of the graph's matrices
+// leaving their pending changes in place, caller must hold the matrix locks
+void Graph_WaitMatrices
+(
+	Graph *g
+);
+
 // checks to see if graph has pending operations
 bool Graph_Pending
 (
@@ -217,6 +276,26 @@ void Graph_CreateEdge
 	Edge *e
 );
 
+// creates n edges of the same relationship-type in bulk
+// the i'th edge connects src[i] to dest[i], its ID is written to ids[i]
+void Graph_CreateEdges
+(
+	Graph *g,            // graph on which to operate
+	RelationID r,        // edges type
+	const NodeID *src,   // source node IDs
+	const NodeID *dest,  // destination node IDs
+	EdgeID *ids,         // [output] created edge IDs
+	uint64_t n           // number of edges to create
+);
+
+// recompute the number of relationship-types connecting each pair of nodes
+// from the relation matrices, expecting all matrices to be synced
+// used once relation matrices are populated directly, e.g. when decoding
+void Graph_RebuildConnectionCounts
+(
+	Graph *g  // graph to update
+);
+
 // deletes nodes from the graph
 void Graph_DeleteNodes
 (
@@ -233,6 +312,65 @@ void Graph_DeleteEdges
 	uint64_t n
 );
 
+// gathers free node positions below the node count
+// returns the number of nodes positioned beyond the node count
+// each to be relocated by Graph_RelocateNode
+uint64_t Graph_PrepareNodeRelocation
+(
+	Graph *g  // graph to compact
+);
+
+// gathers free edge positions below the edge count
+// returns the number of edges positioned beyond the edge count
+// each to be relocated by Graph_RelocateEdge
+uint64_t Graph_PrepareEdgeRelocation
+(
+	Graph *g  // graph to compact
+);
+
+// moves node `src` into the i'th free position gathered by
+// Graph_PrepareNodeRelocation, rewriting its labels and connections
+// the node's edges are appended to `edges` with their updated endpoints
+// returns the node's new ID
+NodeID Graph_RelocateNode
+(
+	Graph *g,      // graph to compact
+	NodeID src,    // node to relocate
+	uint64_t i,    // free position to relocate node into
+	Edge **edges   // [output] node's edges
+);
+
+// moves edge `e` into the i'th free position gathered by
+// Graph_PrepareEdgeRelocation, rewriting its matrix entries
+// `e` is updated with its new ID, which is returned
+EdgeID Graph_RelocateEdge
+(
+	Graph *g,    // graph to compact
+	Edge *e,     // edge to relocate
+	uint64_t i   // free position to relocate edge into
+);
+
+// collects edges of relationship-type r positioned beyond the edge count
+// scanning rows [*row, N), rows are scanned whole, the scan stops at the
+// first row boundary after `n` entries were visited
+// `*row` is set to the row at which the scan should resume, N once done
+// returns the number of visited entries
+uint64_t Graph_CollectRelocatableEdges
+(
+	const Graph *g,  // graph to compact
+	RelationID r,    // relationship-type to scan
+	NodeID *row,     // [input/output] scan position
+	uint64_t n,      // number of entries to visit
+	Edge **edges     // [output] relocatable edges
+);
+
+// drops deleted nodes and edges trailing the last entity, reducing the
+// graph's node capacity and with it its matrices dimensions
+void Graph_TrimEntities
+(
+	Graph *g  // graph to compact
+);
+
 // returns true if the given entity has been deleted
 bool Graph_EntityIsDeleted
 (
@@ -253,6 +391,15 @@ DataBlockIterator *Graph_ScanNodes
 	const Graph *g
 );
 
+// retrieves a node iterator which can be used to access
+// every node with an ID within [start, end)
+DataBlockIterator *Graph_ScanNodesRange
+(
+	const Graph *g,
+	NodeID start,
+	NodeID end
+);
+
 // retrieves an edge iterator which can be used to access
 // every edge in the graph
 DataBlockIterator *Graph_ScanEdges
@@ -334,6 +481,35 @@ bool Graph_GetNode
 	Node *n
 );
 
+// retrieves node's attribute value from the attribute's column
+// returns false if the value isn't laid out in a column
+// in which case the value should be read from the node's attribute-set
+bool Graph_GetNodeColumnarProperty
+(
+	Graph *g,           // graph to read from
+	NodeID id,          // node ID
+	Attribute_ID attr,  // attribute to read
+	SIValue *v          // [output] value
+);
+
+// discard the column of attribute `attr`
+// ATTRIBUTE_ID_ALL discards all columns, caller must hold the write lock
+void Graph_InvalidateNodeColumn
+(
+	Graph *g,          // graph
+	Attribute_ID attr  // modified attribute
+);
+
+// discard the columns of attributes modified by replacing a node's
+// attribute-set `prev` with `set`, a NULL `set` stands for the removal
+// of all of the node's attributes, caller must hold the write lock
+void Graph_InvalidateNodeColumns
+(
+	Graph *g,                 // graph
+	const AttributeSet prev,  // node's attributes prior to modification
+	const AttributeSet set    // node's attributes after modification
+);
+
 // retrieves edge with given id from graph,
 // returns NULL if edge wasn't found
 bool Graph_GetEdge
@@ -373,6 +549,16 @@ void Graph_GetNodeEdges
 	Edge **edges            // array_t incoming/outgoing edges
 );
 
+// collects every edge incoming to or outgoing from any of the given nodes
+// each edge is collected once
+void Graph_GetNodesEdges
+(
+	const Graph *g,     // graph to get edges from
+	const Node *nodes,  // nodes to extract edges from, sorted by ID, distinct
+	uint64_t n,         // number of nodes
+	Edge **edges        // array_t incoming/outgoing edges
+);
+
 // returns node incoming/outgoing degree
 uint64_t Graph_GetNodeDegree
 (
@@ -0,0 +1,199 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../util/arr.h"
+#include "graph_compaction.h"
+
+// number of relation matrix entries scanned for each relocated edge
+// bounds the work of a slice when relocatable edges are sparse
+#define COMPACTION_SCAN_RATIO 16
+
+// replace edge `old` with its relocated version `e` in the indices of
+// its relationship-type
+static void _ReindexEdge
+(
+	GraphContext *gc,  // graph context
+	const Edge *old,   // edge prior to relocation
+	const Edge *e      // relocated edge
+) {
+	Schema *s = GraphContext_GetSchemaByID(gc, Edge_GetRelationID(e),
+			SCHEMA_EDGE);
+	ASSERT(s != NULL);
+
+	if(!Schema_HasIndices(s)) return;
+
+	Schema_RemoveEdgeFromIndices(s, old);
+	Schema_AddEdgeToIndices(s, e);
+}
+
+// replace node `src` with its relocated version `dest` in the indices of
+// its labels, along with each of the node's edges
+static void _ReindexNode
+(
+	GraphContext *gc,   // graph context
+	NodeID src,         // node ID prior to relocation
+	NodeID dest,        // relocated node ID
+	Edge *edges         // relocated node's edges
+) {
+	Graph *g   = gc->g;
+	Node   n   = GE_NEW_NODE();
+	Node   old = GE_NEW_NODE();
+
+	bool found = Graph_GetNode(g, dest, &n);
+	ASSERT(found == true);
+	UNUSED(found);
+
+	// entries are removed by ID
+	old    = n;
+	old.id = src;
+
+	uint label_count;
+	NODE_GET_LABELS(g, &n, label_count);
+
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
+		ASSERT(s != NULL);
+
+		if(!Schema_HasIndices(s)) continue;
+
+		Schema_RemoveNodeFromIndices(s, &old);
+		Schema_AddNodeToIndices(s, &n);
+	}
+
+	uint64_t edge_count = array_len(edges);
+	for(uint64_t i = 0; i < edge_count; i++) {
+		const Edge *e = edges + i;
+
+		// edge endpoints prior to relocation
+		Edge prev = *e;
+		if(prev.src_id  == dest) prev.src_id  = src;
+		if(prev.dest_id == dest) prev.dest_id = src;
+
+		_ReindexEdge(gc, &prev, e);
+	}
+}
+
+// relocate up to `budget` nodes, returns number of relocated nodes
+static uint64_t _CompactNodes
+(
+	GraphContext *gc,  // graph to compact
+	uint64_t budget,   // max number of nodes to relocate
+	Edge **edges       // scratch array of edges
+) {
+	Graph    *g = gc->g;
+	uint64_t  n = MIN(Graph_PrepareNodeRelocation(g), budget);
+
+	// nodes are relocated starting with the last node
+	NodeID src = Graph_UncompactedNodeCount(g);
+
+	for(uint64_t i = 0; i < n; i++) {
+		Node node = GE_NEW_NODE();
+		do {
+			src--;
+		} while(!Graph_GetNode(g, src, &node));
+
+		array_clear(*edges);
+		NodeID dest = Graph_RelocateNode(g, src, i, edges);
+		_ReindexNode(gc, src, dest, *edges);
+	}
+
+	return n;
+}
+
+// relocate up to `budget` edges, returns number of relocated edges
+static uint64_t _CompactEdges
+(
+	GraphContext *gc,          // graph to compact
+	CompactionCursor *cursor,  // relocatable edges scan position
+	uint64_t budget,           // max number of edges to relocate
+	Edge **edges               // scratch array of edges
+) {
+	Graph    *g     = gc->g;
+	uint64_t  n     = MIN(Graph_PrepareEdgeRelocation(g), budget);
+	uint64_t  moved = 0;
+
+	if(n == 0) return 0;
+
+	int      relation_count = Graph_RelationTypeCount(g);
+	int      scanned        = 0;  // number of relation matrices scanned
+	uint64_t scan_budget    = n * COMPACTION_SCAN_RATIO;
+
+	// scan relation matrices for edges positioned beyond the edge count
+	// wrapping around at most once
+	while(moved < n && scan_budget > 0 && scanned <= relation_count) {
+		if(cursor->relation >= relation_count) {
+			cursor->relation = 0;
+			cursor->row      = 0;
+		}
+
+		array_clear(*edges);
+		uint64_t visited = Graph_CollectRelocatableEdges(g, cursor->relation,
+				&cursor->row, MIN(scan_budget, n - moved), edges);
+		scan_budget -= MIN(visited, scan_budget);
+
+		uint64_t edge_count = array_len(*edges);
+		for(uint64_t i = 0; i < edge_count; i++) {
+			Edge *e = *edges + i;
+
+			if(moved == n) {
+				// out of budget, resume scan at the first skipped edge
+				cursor->row = e->src_id;
+				break;
+			}
+
+			Edge old = *e;
+			Graph_RelocateEdge(g, e, moved++);
+			_ReindexEdge(gc, &old, e);
+		}
+
+		// relation matrix scanned, move to the next one
+		GrB_Index nrows;
+		RG_Matrix_nrows(&nrows,
+				Graph_GetRelationMatrix(g, cursor->relation, false));
+		if(cursor->row >= nrows) {
+			cursor->relation++;
+			cursor->row = 0;
+			scanned++;
+		}
+	}
+
+	return moved;
+}
+
+uint64_t GraphCompaction_Holes
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+	return Graph_DeletedNodeCount(g) + Graph_DeletedEdgeCount(g);
+}
+
+uint64_t GraphCompaction_Slice
+(
+	GraphContext *gc,
+	CompactionCursor *cursor,
+	uint64_t budget
+) {
+	ASSERT(gc     != NULL);
+	ASSERT(cursor != NULL);
+
+	Graph *g     = gc->g;
+	Edge  *edges = array_new(Edge, 0);
+
+	// nodes are relocated first, as relocating a node rewrites the entries
+	// of each of its edges
+	budget -= _CompactNodes(gc, budget, &edges);
+	_CompactEdges(gc, cursor, budget, &edges);
+
+	array_free(edges);
+
+	// drop trailing holes, shrinking the graph's storage
+	Graph_TrimEntities(g);
+
+	return GraphCompaction_Holes(g);
+}
+
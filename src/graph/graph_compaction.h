@@ -0,0 +1,49 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "graphcontext.h"
+
+// incremental compaction of a graph's entity storage
+//
+// deleting nodes and edges leaves holes in their datablocks, holes are reused
+// by later creations but the populated part of a datablock, and with it the
+// dimensions of every matrix, never shrinks
+//
+// compaction moves entities positioned beyond the entity count into holes,
+// the relocated entity takes the ID of the hole it fills, every matrix entry
+// and index entry referring to it is rewritten
+// once no entity trails the entity count the datablocks are trimmed
+// reducing the graph's node capacity and matrices dimensions
+//
+// compaction runs in slices, each relocating a bounded number of entities
+// while holding the graph's write lock
+// slices are deterministic given the graph and the slice's arguments
+// such that replaying a slice on a replica relocates the same entities
+
+// position of the relocatable edges scan, carried from one slice to the next
+typedef struct {
+	RelationID relation;  // relation matrix being scanned
+	NodeID row;           // row at which the scan resumes
+} CompactionCursor;
+
+// number of holes in the graph's node and edge storage
+uint64_t GraphCompaction_Holes
+(
+	const Graph *g  // graph to inspect
+);
+
+// run a single compaction slice relocating at most `budget` entities
+// expects the graph's write lock to be held
+// returns the number of holes left once the slice is done
+uint64_t GraphCompaction_Slice
+(
+	GraphContext *gc,          // graph to compact
+	CompactionCursor *cursor,  // [input/output] relocatable edges scan position
+	uint64_t budget            // max number of entities to relocate
+);
+
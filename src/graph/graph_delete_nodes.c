@@ -114,6 +114,10 @@ void Graph_DeleteNodes
 			GraphStatistics_DecNodeCount(&g->stats, j, 1);
 		}
 
+		// node's ID might be reused, discard columns holding its values
+		AttributeSet *set = DataBlock_GetItem(g->nodes, id);
+		Graph_InvalidateNodeColumns(g, *set, NULL);
+
 		// remove node from datablock
 		DataBlock_DeleteItem(g->nodes, id);
 	}
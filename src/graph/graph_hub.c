@@ -89,6 +89,49 @@ static void _AddEdgeToIndices(GraphContext *gc, Edge *e) {
 	Schema_AddEdgeToIndices(s, e);
 }
 
+// introduce node attributes to the statistics of each of its labels
+// or remove them when `add` is false
+static void _UpdateNodeStatistics
+(
+	GraphContext *gc,
+	Node *n,
+	const AttributeSet set,
+	bool add
+) {
+	if(ATTRIBUTE_SET_COUNT(set) == 0) return;
+
+	// retrieve node labels
+	uint label_count;
+	NODE_GET_LABELS(gc->g, n, label_count);
+
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
+		ASSERT(s != NULL);
+
+		if(add) Schema_AddAttributesToStatistics(s, set);
+		else    Schema_RemoveAttributesFromStatistics(s, set);
+	}
+}
+
+// introduce edge attributes to the statistics of its relationship-type
+// or remove them when `add` is false
+static void _UpdateEdgeStatistics
+(
+	GraphContext *gc,
+	Edge *e,
+	const AttributeSet set,
+	bool add
+) {
+	if(ATTRIBUTE_SET_COUNT(set) == 0) return;
+
+	int relation_id = EDGE_GET_RELATION_ID(e, gc->g);
+	Schema *s = GraphContext_GetSchemaByID(gc, relation_id, SCHEMA_EDGE);
+	ASSERT(s != NULL);
+
+	if(add) Schema_AddAttributesToStatistics(s, set);
+	else    Schema_RemoveAttributesFromStatistics(s, set);
+}
+
 void CreateNode
 (
 	GraphContext *gc,
@@ -109,6 +152,7 @@ void CreateNode
 		Schema *s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
 		ASSERT(s);
 		Schema_AddNodeToIndices(s, n);
+		Schema_AddAttributesToStatistics(s, set);
 	}
 
 	// add node creation operation to undo log
@@ -140,6 +184,7 @@ void CreateEdge
 	// all schemas have been created in the edge blueprint loop or earlier
 	ASSERT(s != NULL);
 	Schema_AddEdgeToIndices(s, e);
+	Schema_AddAttributesToStatistics(s, set);
 
 	// add edge creation operation to undo log
 	if(log == true) {
@@ -164,24 +209,24 @@ void DeleteNodes
 	ASSERT(gc != NULL);
 	ASSERT(nodes != NULL);
 
-	UndoLog *undo_log = (log == true) ? QueryCtx_GetUndoLog() : NULL;
-	EffectsBuffer *eb = (log == true) ? QueryCtx_GetEffectsBuffer() : NULL;
 	bool has_indices = GraphContext_HasIndices(gc);
 
-	if(log == true || has_indices) {
-		for(uint i = 0; i < n; i++) {
-			Node *n = nodes + i;
+	if(log == true) {
+		// add nodes deletion operations to undo log
+		UndoLog *undo_log = QueryCtx_GetUndoLog();
+		EffectsBuffer *eb = QueryCtx_GetEffectsBuffer();
+		UndoLog_DeleteNodes(undo_log, nodes, n);
+		EffectsBuffer_AddDeleteNodesEffect(eb, nodes, n);
+	}
 
-			if(log == true) {
-				// add node deletion operation to undo log
-				UndoLog_DeleteNode(undo_log, n);
-				EffectsBuffer_AddDeleteNodeEffect(eb, n);
-			}
+	for(uint i = 0; i < n; i++) {
+		Node *n = nodes + i;
 
-			if(has_indices) {
-				_DeleteNodeFromIndices(gc, n);
-			}
+		if(has_indices) {
+			_DeleteNodeFromIndices(gc, n);
 		}
+
+		_UpdateNodeStatistics(gc, n, *n->attributes, false);
 	}
 
 	Graph_DeleteNodes(gc->g, nodes, n);
@@ -198,23 +243,22 @@ void DeleteEdges
 	ASSERT(n > 0);
 	ASSERT(edges != NULL);
 
-	// add edge deletion operation to undo log
 	bool has_indecise = GraphContext_HasIndices(gc);
 
-	UndoLog *undo_log = (log == true) ? QueryCtx_GetUndoLog() : NULL;
-	EffectsBuffer *eb = (log == true) ? QueryCtx_GetEffectsBuffer() : NULL;
-
-	if(has_indecise == true || log == true) {
-		for (uint i = 0; i < n; i++) {
-			if(log == true) {
-				UndoLog_DeleteEdge(undo_log, edges + i);
-				EffectsBuffer_AddDeleteEdgeEffect(eb, edges + i);
-			}
+	if(log == true) {
+		// add edges deletion operations to undo log
+		UndoLog *undo_log = QueryCtx_GetUndoLog();
+		EffectsBuffer *eb = QueryCtx_GetEffectsBuffer();
+		UndoLog_DeleteEdges(undo_log, edges, n);
+		EffectsBuffer_AddDeleteEdgesEffect(eb, edges, n);
+	}
 
-			if(has_indecise == true) {
-				_DeleteEdgeFromIndices(gc, edges + i);
-			}
+	for (uint i = 0; i < n; i++) {
+		if(has_indecise == true) {
+			_DeleteEdgeFromIndices(gc, edges + i);
 		}
+
+		_UpdateEdgeStatistics(gc, edges + i, *edges[i].attributes, false);
 	}
 
 	Graph_DeleteEdges(gc->g, edges, n);
@@ -243,9 +287,14 @@ void UpdateEntityProperties
 	*ge->attributes = set;
 
 	if(entity_type == GETYPE_NODE) {
+		Graph_InvalidateNodeColumns(gc->g, old_set, set);
 		_AddNodeToIndices(gc, (Node *)ge);
+		_UpdateNodeStatistics(gc, (Node *)ge, old_set, false);
+		_UpdateNodeStatistics(gc, (Node *)ge, set, true);
 	} else {
 		_AddEdgeToIndices(gc, (Edge *)ge);
+		_UpdateEdgeStatistics(gc, (Edge *)ge, old_set, false);
+		_UpdateEdgeStatistics(gc, (Edge *)ge, set, true);
 	}
 }
 
@@ -263,6 +312,32 @@ void UpdateNodeProperty
 	UNUSED(res);
 	ASSERT(res == true);
 
+	// retrieve node labels
+	uint label_count;
+	NODE_GET_LABELS(gc->g, &n, label_count);
+
+	// retract replaced values from statistics
+	Schema *s;
+	for(uint i = 0; i < label_count; i++) {
+		s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
+		ASSERT(s != NULL);
+		if(attr_id == ATTRIBUTE_ID_ALL) {
+			Schema_RemoveAttributesFromStatistics(s, *n.attributes);
+		} else {
+			SIValue *old = GraphEntity_GetProperty((GraphEntity *)&n, attr_id);
+			if(old != ATTRIBUTE_NOTFOUND) {
+				Schema_RemoveFromStatistics(s, attr_id, *old);
+			}
+		}
+	}
+
+	// discard columns holding replaced values
+	if(attr_id == ATTRIBUTE_ID_ALL) {
+		Graph_InvalidateNodeColumns(gc->g, *n.attributes, NULL);
+	} else {
+		Graph_InvalidateNodeColumn(gc->g, attr_id);
+	}
+
 	if(attr_id == ATTRIBUTE_ID_ALL) {
 		AttributeSet_Free(n.attributes);
 	} else if(GraphEntity_GetProperty((GraphEntity *)&n, attr_id) == ATTRIBUTE_NOTFOUND) {
@@ -271,16 +346,12 @@ void UpdateNodeProperty
 		AttributeSet_UpdateNoClone(n.attributes, attr_id, v);
 	}
 
-	// retrieve node labels
-	uint label_count;
-	NODE_GET_LABELS(gc->g, &n, label_count);
-
-	Schema *s;
 	for(uint i = 0; i < label_count; i++) {
 		int label_id = labels[i];
 		s = GraphContext_GetSchemaByID(gc, label_id, SCHEMA_NODE);
 		ASSERT(s != NULL);
 		Schema_AddNodeToIndices(s, &n);
+		if(attr_id != ATTRIBUTE_ID_ALL) Schema_AddToStatistics(s, attr_id, v);
 	}
 }
 
@@ -308,6 +379,19 @@ void UpdateEdgeProperty
 	Edge_SetDestNodeID(&e, dest_id);
 	Edge_SetRelationID(&e, r_id);
 
+	Schema *schema = GraphContext_GetSchemaByID(gc, r_id, SCHEMA_EDGE);
+	ASSERT(schema != NULL);
+
+	// retract replaced values from statistics
+	if(attr_id == ATTRIBUTE_ID_ALL) {
+		Schema_RemoveAttributesFromStatistics(schema, *e.attributes);
+	} else {
+		SIValue *old = GraphEntity_GetProperty((GraphEntity *)&e, attr_id);
+		if(old != ATTRIBUTE_NOTFOUND) {
+			Schema_RemoveFromStatistics(schema, attr_id, *old);
+		}
+	}
+
 	if(attr_id == ATTRIBUTE_ID_ALL) {
 		AttributeSet_Free(e.attributes);
 	} else if(GraphEntity_GetProperty((GraphEntity *)&e, attr_id) == ATTRIBUTE_NOTFOUND) {
@@ -316,9 +400,8 @@ void UpdateEdgeProperty
 		AttributeSet_UpdateNoClone(e.attributes, attr_id, v);
 	}
 
-	Schema *schema = GraphContext_GetSchemaByID(gc, r_id, SCHEMA_EDGE);
-	ASSERT(schema != NULL);
 	Schema_AddEdgeToIndices(schema, &e);
+	if(attr_id != ATTRIBUTE_ID_ALL) Schema_AddToStatistics(schema, attr_id, v);
 }
 
 void UpdateNodeLabels
@@ -382,6 +465,7 @@ void UpdateNodeLabels
 				add_labels_ids[add_labels_index++] = schema_id;
 				// add to index
 				Schema_AddNodeToIndices(s, node);
+				Schema_AddAttributesToStatistics((Schema *)s, *node->attributes);
 			}
 		}
 
@@ -421,6 +505,7 @@ void UpdateNodeLabels
 			remove_labels_ids[remove_labels_index++] = Schema_GetID(s);
 			// remove node from index
 			Schema_RemoveNodeFromIndices(s, node);
+			Schema_RemoveAttributesFromStatistics((Schema *)s, *node->attributes);
 		}
 
 		if(remove_labels_index > 0) {
@@ -14,6 +14,7 @@
 #include "../util/rmalloc.h"
 #include "../util/thpool/pools.h"
 #include "../constraint/constraint.h"
+#include "../ast/query_normalizer.h"
 #include "../serializers/graphcontext_type.h"
 #include "../commands/execution_ctx.h"
 
@@ -96,6 +97,7 @@ GraphContext *GraphContext_New
 	gc->slowlog          = SlowLog_New();
 	gc->queries_log      = QueriesLog_New();
 	gc->ref_count        = 0;  // no refences
+	gc->flush_scheduled  = false;
 	gc->attributes       = raxNew();
 	gc->index_count      = 0;  // no indicies
 	gc->string_mapping   = array_new(char *, 64);
@@ -380,6 +382,102 @@ void GraphContext_DisableConstrains
 	}
 }
 
+void GraphContext_RebuildStatistics
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	Graph *g = gc->g;
+	Node n = GE_NEW_NODE();
+	Edge *edges = array_new(Edge, 0);
+	DataBlockIterator *it = Graph_ScanNodes(g);
+
+	while((n.attributes = DataBlockIterator_Next(it, &n.id)) != NULL) {
+		// introduce node attributes to each of its labels
+		uint label_count;
+		NODE_GET_LABELS(g, &n, label_count);
+		for(uint i = 0; i < label_count; i++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
+			Schema_AddAttributesToStatistics(s, *n.attributes);
+		}
+
+		// introduce node's outgoing edges attributes to their relation-type
+		Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_OUTGOING, GRAPH_NO_RELATION,
+				&edges);
+		uint edge_count = array_len(edges);
+		for(uint i = 0; i < edge_count; i++) {
+			Edge *e = edges + i;
+			Schema *s = GraphContext_GetSchemaByID(gc, e->relationID,
+					SCHEMA_EDGE);
+			Schema_AddAttributesToStatistics(s, *e->attributes);
+		}
+		array_clear(edges);
+	}
+
+	DataBlockIterator_Free(it);
+	array_free(edges);
+}
+
+// swap in prepared flushes
+// executed on the writer thread, no write query is mid-execution
+static void _GraphContext_ApplyFlush
+(
+	void *arg
+) {
+	GraphContext *gc = (GraphContext *)arg;
+
+	Graph_ApplyFlush(gc->g);
+	GraphContext_DecreaseRefCount(gc);
+}
+
+// prepare flushes matrix by matrix, releasing the read lock in between
+// a writer waiting on the lock is delayed by at most a single matrix merge
+static void _GraphContext_Flush
+(
+	void *arg
+) {
+	GraphContext *gc = (GraphContext *)arg;
+	Graph *g = gc->g;
+
+	bool more = true;
+	for(uint i = 0; more; i++) {
+		Graph_AcquireReadLock(g);
+		more = Graph_PrepareFlush(g, i);
+		Graph_ReleaseLock(g);
+	}
+
+	__atomic_store_n(&gc->flush_scheduled, false, __ATOMIC_RELAXED);
+
+	// swapping matrices requires exclusive access to the graph
+	// hand the graph reference over to the writer thread
+	// if its queue is full the next writer to acquire the lock applies flushes
+	if(ThreadPools_AddWorkWriter(_GraphContext_ApplyFlush, gc, false) != 0) {
+		GraphContext_DecreaseRefCount(gc);
+	}
+}
+
+void GraphContext_ScheduleFlush
+(
+	GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+
+	// flush already scheduled
+	if(__atomic_exchange_n(&gc->flush_scheduled, true, __ATOMIC_RELAXED)) {
+		return;
+	}
+
+	// make sure graph isn't freed while flushing
+	GraphContext_IncreaseRefCount(gc);
+
+	if(ThreadPools_AddWorkReader(_GraphContext_Flush, gc, false) != 0) {
+		// queue is full, pending changes are merged by a later flush
+		__atomic_store_n(&gc->flush_scheduled, false, __ATOMIC_RELAXED);
+		GraphContext_DecreaseRefCount(gc);
+	}
+}
+
 Schema *GraphContext_GetSchemaByID(const GraphContext *gc, int id, SchemaType t) {
 	Schema **schemas = (t == SCHEMA_NODE) ? gc->node_schemas : gc->relation_schemas;
 	if(id == GRAPH_NO_LABEL) return NULL;
@@ -543,6 +641,15 @@ void GraphContext_RemoveAttribute
 	rm_free(gc->string_mapping[id]);
 	gc->string_mapping = array_del(gc->string_mapping, id);
 	pthread_rwlock_unlock(&gc->_attribute_rwlock);
+
+	// discard attribute statistics and columns, the attribute ID might be reused
+	Graph_InvalidateNodeColumn(gc->g, id);
+	for(uint i = 0; i < array_len(gc->node_schemas); i++) {
+		Schema_RemoveStatistics(gc->node_schemas[i], id);
+	}
+	for(uint i = 0; i < array_len(gc->relation_schemas); i++) {
+		Schema_RemoveStatistics(gc->relation_schemas[i], id);
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -824,14 +931,31 @@ void GraphContext_LogQuery
 	bool utilized_cache,          // utilized cache
 	bool write,    		          // write query
 	bool timeout,    		      // timeout query
-	const char *query             // query string
+	const char *query,            // query string
+	uint64_t key_hash             // query key hash, 0 if unknown
 ) {
 	ASSERT(gc != NULL);
 	ASSERT(query != NULL);
 
 	QueriesLog_AddQuery(gc->queries_log, received, wait_duration,
 			execution_duration, report_duration, parameterized, utilized_cache,
-			write, timeout, query);
+			write, timeout, query, key_hash);
+}
+
+QueryClass GraphContext_ClassifyQuery
+(
+	const GraphContext *gc,  // graph context
+	const char *query        // query string, including parameters
+) {
+	ASSERT(gc != NULL);
+	ASSERT(query != NULL);
+
+	// executions are logged under the query's plan cache key
+	char *key = QueryNormalizer_CacheKey(query);
+	uint64_t key_hash = QueriesLog_HashQueryKey(key);
+	rm_free(key);
+
+	return QueriesLog_ClassifyQuery(gc->queries_log, key_hash);
 }
 
 //------------------------------------------------------------------------------
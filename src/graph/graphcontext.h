@@ -29,6 +29,7 @@
 typedef struct {
 	Graph *g;                              // container for all matrices and entity properties
 	int ref_count;                         // number of active references
+	bool flush_scheduled;                  // background matrix flush pending
 	rax *attributes;                       // from strings to attribute IDs
 	pthread_rwlock_t _attribute_rwlock;    // read-write lock to protect access to the attribute maps
 	char *graph_name;                      // string associated with graph
@@ -151,6 +152,19 @@ void GraphContext_DisableConstrains
 	GraphContext *gc
 );
 
+// rebuild schemas attribute statistics from the graph's entities
+void GraphContext_RebuildStatistics
+(
+	GraphContext *gc
+);
+
+// schedule a background flush of the graph's pending matrix changes
+// no-op if a flush is already scheduled
+void GraphContext_ScheduleFlush
+(
+	GraphContext *gc
+);
+
 // retrieve the specific schema for the provided ID
 Schema *GraphContext_GetSchemaByID
 (
@@ -367,7 +381,16 @@ void GraphContext_LogQuery
 	bool utilized_cache,          // utilized cache
 	bool write,    		          // write query
 	bool timeout,    		      // timeout query
-	const char *query             // query string
+	const char *query,            // query string
+	uint64_t key_hash             // query key hash, 0 if unknown
+);
+
+// classify query as short or long, based on its logged executions
+// the query is identified by its execution plan cache key
+QueryClass GraphContext_ClassifyQuery
+(
+	const GraphContext *gc,  // graph context
+	const char *query        // query string, including parameters
 );
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,496 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rax.h"
+#include "../util/arr.h"
+#include "property_columns.h"
+#include "../util/rmalloc.h"
+#include "entities/graph_entity.h"
+#include "rg_matrix/rg_matrix_iter.h"
+
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// number of reads of an attribute after which its columns are built
+#define COLUMNS_BUILD_THRESHOLD 10000
+
+// attributes are grouped into chunks, allocated on first access
+#define COLUMNS_CHUNK_BITS 8
+#define COLUMNS_CHUNK_SIZE (1 << COLUMNS_CHUNK_BITS)
+#define COLUMNS_CHUNK_COUNT ((ATTRIBUTE_ID_NONE >> COLUMNS_CHUNK_BITS) + 1)
+
+// bitmap helpers
+#define BITMAP_WORDS(n)     (((n) + 63) / 64)
+#define BITMAP_SET(b, i)    ((b)[(i) >> 6] |= (1ULL << ((i) & 63)))
+#define BITMAP_TEST(b, i)   (((b)[(i) >> 6] >> ((i) & 63)) & 1)
+
+typedef enum {
+	COLUMN_NONE,    // attribute can't be laid out in a column
+	COLUMN_INT64,   // int64 array
+	COLUMN_DOUBLE,  // double array
+	COLUMN_BOOL,    // bitmap
+	COLUMN_STRING,  // dictionary codes
+} ColumnType;
+
+struct _PropertyColumn {
+	ColumnType t;       // column type
+	uint64_t min_id;    // first node ID covered by the column
+	uint64_t len;       // number of node IDs covered by the column
+	uint64_t *present;  // presence bitmap, set if node holds the attribute
+	union {
+		int64_t *longs;    // integer values
+		double *doubles;   // floating point values
+		uint64_t *bools;   // boolean values bitmap
+		uint32_t *codes;   // string dictionary codes
+	};
+	SIValue *dict;      // string dictionary, code -> string
+};
+
+typedef struct {
+	uint64_t _Atomic reads;            // reads since column was discarded
+	bool _Atomic built;                // column was built, possibly to NULL
+	PropertyColumn * _Atomic column;   // attribute column, NULL if not laid out
+} _AttributeColumn;
+
+struct _PropertyColumns {
+	_AttributeColumn * _Atomic chunks[COLUMNS_CHUNK_COUNT];  // attribute chunks
+	pthread_mutex_t lock;  // guards chunk allocation
+};
+
+// min label size for columnar layout, 0 disables columnar layout
+static uint64_t _Atomic min_label_size = ATOMIC_VAR_INIT(0);
+
+void PropertyColumns_SetMinLabelSize
+(
+	uint64_t size
+) {
+	min_label_size = size;
+}
+
+uint64_t PropertyColumns_GetMinLabelSize(void) {
+	return min_label_size;
+}
+
+// map value to its column type
+static ColumnType _ColumnType
+(
+	SIValue v
+) {
+	switch(SI_TYPE(v)) {
+		case T_INT64:
+			return COLUMN_INT64;
+		case T_DOUBLE:
+			return COLUMN_DOUBLE;
+		case T_BOOL:
+			return COLUMN_BOOL;
+		case T_STRING:
+			return COLUMN_STRING;
+		default:
+			return COLUMN_NONE;
+	}
+}
+
+// get node's attribute value
+static inline SIValue *_NodeValue
+(
+	const DataBlock *nodes,
+	uint64_t id,
+	Attribute_ID attr
+) {
+	AttributeSet *set = DataBlock_GetItem((DataBlock *)nodes, id);
+	ASSERT(set != NULL);
+	return AttributeSet_Get(*set, attr);
+}
+
+// scan the nodes of label matrix `L` holding attribute `attr`
+// returns false if the attribute's values don't share a single column type
+static bool _ScanLabel
+(
+	const RG_Matrix L,        // label matrix
+	const DataBlock *nodes,   // node attribute-sets
+	Attribute_ID attr,        // scanned attribute
+	ColumnType *t,            // [input/output] column type
+	uint64_t *present,        // [output] number of nodes holding attribute
+	uint64_t *min_id,         // [output] smallest ID holding attribute
+	uint64_t *max_id          // [output] largest ID holding attribute
+) {
+	GrB_Index id;
+	bool homogeneous = true;
+	RG_MatrixTupleIter it = {0};
+
+	*present = 0;
+	*min_id  = UINT64_MAX;
+	*max_id  = 0;
+
+	RG_MatrixTupleIter_attach(&it, L);
+	while(RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL) == GrB_SUCCESS) {
+		SIValue *v = _NodeValue(nodes, id, attr);
+		if(v == ATTRIBUTE_NOTFOUND) continue;
+
+		// heterogeneous attribute, or a type which isn't laid out in columns
+		ColumnType vt = _ColumnType(*v);
+		if(vt == COLUMN_NONE || (*t != COLUMN_NONE && vt != *t)) {
+			homogeneous = false;
+			break;
+		}
+
+		*t = vt;
+		(*present)++;
+		if(id < *min_id) *min_id = id;
+		if(id > *max_id) *max_id = id;
+	}
+	RG_MatrixTupleIter_detach(&it);
+
+	return homogeneous;
+}
+
+// copy the attribute values of label matrix `L` nodes into column
+// nodes holding multiple covered labels are simply written again
+static void _PopulateColumn
+(
+	PropertyColumn *col,      // column to populate
+	const RG_Matrix L,        // label matrix
+	const DataBlock *nodes,   // node attribute-sets
+	Attribute_ID attr,        // laid out attribute
+	rax *lookup               // string -> dictionary code
+) {
+	GrB_Index id;
+	RG_MatrixTupleIter it = {0};
+
+	uint64_t max_id = col->min_id + col->len - 1;
+	RG_MatrixTupleIter_AttachRange(&it, L, col->min_id, max_id);
+	while(RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL) == GrB_SUCCESS) {
+		SIValue *v = _NodeValue(nodes, id, attr);
+		if(v == ATTRIBUTE_NOTFOUND) continue;
+
+		uint64_t i = id - col->min_id;
+		BITMAP_SET(col->present, i);
+
+		switch(col->t) {
+			case COLUMN_INT64:
+				col->longs[i] = v->longval;
+				break;
+			case COLUMN_DOUBLE:
+				col->doubles[i] = v->doubleval;
+				break;
+			case COLUMN_BOOL:
+				if(v->longval) BITMAP_SET(col->bools, i);
+				break;
+			case COLUMN_STRING: {
+				unsigned char *s = (unsigned char *)v->stringval;
+				size_t l = strlen(v->stringval);
+				void *code = raxFind(lookup, s, l);
+				if(code == raxNotFound) {
+					code = (void *)(uintptr_t)array_len(col->dict);
+					// columns outlive modifications of unrelated attributes
+					// which may replace the attribute-set, own the strings
+					array_append(col->dict, SI_CloneValue(*v));
+					raxInsert(lookup, s, l, code, NULL);
+				}
+				col->codes[i] = (uint32_t)(uintptr_t)code;
+				break;
+			}
+			default:
+				ASSERT(false);
+				break;
+		}
+	}
+	RG_MatrixTupleIter_detach(&it);
+}
+
+PropertyColumn *PropertyColumn_Build
+(
+	const RG_Matrix *labels,
+	uint n,
+	const DataBlock *nodes,
+	Attribute_ID attr
+) {
+	ASSERT(nodes  != NULL);
+	ASSERT(labels != NULL || n == 0);
+
+	if(n == 0) return NULL;
+
+	//--------------------------------------------------------------------------
+	// determine column type, covered labels, ID range and density
+	//--------------------------------------------------------------------------
+
+	bool       covered[n];
+	ColumnType t       =  COLUMN_NONE;
+	uint64_t   present =  0;
+	uint64_t   min_id  =  UINT64_MAX;
+	uint64_t   max_id  =  0;
+
+	for(uint i = 0; i < n; i++) {
+		GrB_Index nvals;
+		GrB_Info info = RG_Matrix_nvals(&nvals, labels[i]);
+		ASSERT(info == GrB_SUCCESS);
+
+		uint64_t l_present;
+		uint64_t l_min_id;
+		uint64_t l_max_id;
+		if(!_ScanLabel(labels[i], nodes, attr, &t, &l_present, &l_min_id,
+					&l_max_id)) {
+			return NULL;
+		}
+
+		// sparse within label, most of the label's nodes don't hold it
+		// the label's nodes are read from their attribute-sets
+		covered[i] = (l_present > 0 && l_present * 2 >= nvals);
+		if(!covered[i]) continue;
+
+		present += l_present;
+		if(l_min_id < min_id) min_id = l_min_id;
+		if(l_max_id > max_id) max_id = l_max_id;
+	}
+
+	if(present == 0) return NULL;
+	ASSERT(t != COLUMN_NONE);
+
+	// scattered node IDs, the column would be mostly empty
+	uint64_t len = max_id - min_id + 1;
+	if(len > present * 4) return NULL;
+
+	//--------------------------------------------------------------------------
+	// populate column
+	//--------------------------------------------------------------------------
+
+	PropertyColumn *col = rm_calloc(1, sizeof(PropertyColumn));
+
+	col->t       = t;
+	col->len     = len;
+	col->min_id  = min_id;
+	col->present = rm_calloc(BITMAP_WORDS(len), sizeof(uint64_t));
+
+	rax *lookup = NULL;  // string -> dictionary code
+	switch(t) {
+		case COLUMN_INT64:
+			col->longs = rm_malloc(len * sizeof(int64_t));
+			break;
+		case COLUMN_DOUBLE:
+			col->doubles = rm_malloc(len * sizeof(double));
+			break;
+		case COLUMN_BOOL:
+			col->bools = rm_calloc(BITMAP_WORDS(len), sizeof(uint64_t));
+			break;
+		case COLUMN_STRING:
+			col->codes = rm_malloc(len * sizeof(uint32_t));
+			col->dict  = array_new(SIValue, 16);
+			lookup     = raxNew();
+			break;
+		default:
+			ASSERT(false);
+			break;
+	}
+
+	for(uint i = 0; i < n; i++) {
+		if(covered[i]) _PopulateColumn(col, labels[i], nodes, attr, lookup);
+	}
+
+	if(lookup != NULL) raxFree(lookup);
+
+	return col;
+}
+
+bool PropertyColumn_Get
+(
+	const PropertyColumn *col,
+	uint64_t id,
+	SIValue *v
+) {
+	ASSERT(v   != NULL);
+	ASSERT(col != NULL);
+
+	if(id < col->min_id) return false;
+
+	uint64_t i = id - col->min_id;
+	if(i >= col->len || !BITMAP_TEST(col->present, i)) return false;
+
+	switch(col->t) {
+		case COLUMN_INT64:
+			*v = SI_LongVal(col->longs[i]);
+			break;
+		case COLUMN_DOUBLE:
+			*v = SI_DoubleVal(col->doubles[i]);
+			break;
+		case COLUMN_BOOL:
+			*v = SI_BoolVal(BITMAP_TEST(col->bools, i));
+			break;
+		case COLUMN_STRING:
+			*v = SI_ConstValue(col->dict + col->codes[i]);
+			break;
+		default:
+			ASSERT(false);
+			return false;
+	}
+
+	return true;
+}
+
+void PropertyColumn_Free
+(
+	PropertyColumn *col
+) {
+	ASSERT(col != NULL);
+
+	switch(col->t) {
+		case COLUMN_INT64:
+			rm_free(col->longs);
+			break;
+		case COLUMN_DOUBLE:
+			rm_free(col->doubles);
+			break;
+		case COLUMN_BOOL:
+			rm_free(col->bools);
+			break;
+		case COLUMN_STRING:
+			rm_free(col->codes);
+			array_free_cb(col->dict, SIValue_Free);
+			break;
+		default:
+			ASSERT(false);
+			break;
+	}
+
+	rm_free(col->present);
+	rm_free(col);
+}
+
+PropertyColumns *PropertyColumns_New(void) {
+	PropertyColumns *pc = rm_calloc(1, sizeof(PropertyColumns));
+	int res = pthread_mutex_init(&pc->lock, NULL);
+	ASSERT(res == 0);
+	return pc;
+}
+
+bool PropertyColumns_Get
+(
+	PropertyColumns *pc,
+	Attribute_ID attr,
+	uint64_t id,
+	SIValue *v,
+	bool *build
+) {
+	ASSERT(v     != NULL);
+	ASSERT(pc    != NULL);
+	ASSERT(build != NULL);
+
+	*build = false;
+
+	// columnar layout is disabled
+	if(min_label_size == 0) return false;
+
+	// get attribute's chunk, allocate on first access
+	_AttributeColumn *chunk = pc->chunks[attr >> COLUMNS_CHUNK_BITS];
+	if(unlikely(chunk == NULL)) {
+		pthread_mutex_lock(&pc->lock);
+		chunk = pc->chunks[attr >> COLUMNS_CHUNK_BITS];
+		if(chunk == NULL) {
+			chunk = rm_calloc(COLUMNS_CHUNK_SIZE, sizeof(_AttributeColumn));
+			pc->chunks[attr >> COLUMNS_CHUNK_BITS] = chunk;
+		}
+		pthread_mutex_unlock(&pc->lock);
+	}
+
+	_AttributeColumn *ac = chunk + (attr & (COLUMNS_CHUNK_SIZE - 1));
+
+	if(!ac->built) {
+		// column has yet to be built, exactly one reader crossing
+		// the threshold is asked to build it
+		*build = (atomic_fetch_add(&ac->reads, 1) + 1 == COLUMNS_BUILD_THRESHOLD);
+		return false;
+	}
+
+	// a single column per attribute, node IDs map directly to its entries
+	PropertyColumn *col = ac->column;
+	return (col != NULL && PropertyColumn_Get(col, id, v));
+}
+
+void PropertyColumns_Publish
+(
+	PropertyColumns *pc,
+	Attribute_ID attr,
+	PropertyColumn *col
+) {
+	ASSERT(pc != NULL);
+
+	_AttributeColumn *chunk = pc->chunks[attr >> COLUMNS_CHUNK_BITS];
+	ASSERT(chunk != NULL);
+
+	_AttributeColumn *ac = chunk + (attr & (COLUMNS_CHUNK_SIZE - 1));
+	ASSERT(!ac->built);
+
+	// set column before marking it built, readers check the mark first
+	ac->column = col;
+	ac->built  = true;
+}
+
+// discard attribute's column and reset its read count
+static void _AttributeColumn_Clear
+(
+	_AttributeColumn *ac
+) {
+	ac->reads = 0;
+	ac->built = false;
+
+	PropertyColumn *col = ac->column;
+	if(col == NULL) return;
+
+	PropertyColumn_Free(col);
+	ac->column = NULL;
+}
+
+void PropertyColumns_Invalidate
+(
+	PropertyColumns *pc,
+	Attribute_ID attr
+) {
+	ASSERT(pc != NULL);
+
+	if(attr == ATTRIBUTE_ID_ALL) {
+		PropertyColumns_Clear(pc);
+		return;
+	}
+
+	// attribute was never read
+	_AttributeColumn *chunk = pc->chunks[attr >> COLUMNS_CHUNK_BITS];
+	if(chunk == NULL) return;
+
+	_AttributeColumn_Clear(chunk + (attr & (COLUMNS_CHUNK_SIZE - 1)));
+}
+
+void PropertyColumns_Clear
+(
+	PropertyColumns *pc
+) {
+	ASSERT(pc != NULL);
+
+	for(int i = 0; i < COLUMNS_CHUNK_COUNT; i++) {
+		_AttributeColumn *chunk = pc->chunks[i];
+		if(chunk == NULL) continue;
+
+		for(int j = 0; j < COLUMNS_CHUNK_SIZE; j++) {
+			_AttributeColumn_Clear(chunk + j);
+		}
+	}
+}
+
+void PropertyColumns_Free
+(
+	PropertyColumns *pc
+) {
+	ASSERT(pc != NULL);
+
+	PropertyColumns_Clear(pc);
+
+	for(int i = 0; i < COLUMNS_CHUNK_COUNT; i++) {
+		if(pc->chunks[i] != NULL) rm_free(pc->chunks[i]);
+	}
+
+	pthread_mutex_destroy(&pc->lock);
+	rm_free(pc);
+}
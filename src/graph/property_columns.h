@@ -0,0 +1,129 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "../value.h"
+#include "rg_matrix/rg_matrix.h"
+#include "entities/attribute_set.h"
+#include "../util/datablock/datablock.h"
+
+// columnar read cache of node attributes
+//
+// a property column holds the values of a single attribute
+// e.g. the `age` attribute, in a dense typed array indexed by node ID:
+//
+// 1. integers and floats are stored as int64 / double arrays
+// 2. booleans are stored as a bitmap
+// 3. strings are dictionary encoded, each node holds a 32 bit code
+//
+// a presence bitmap marks which nodes hold the attribute
+//
+// columns are a cache, each node's attribute-set remains the storage of
+// record for all of its attributes, writes, undo-log, effects and persistence
+// only ever deal with attribute-sets
+// reading a cached value replaces a search of the node's attribute-set
+// with a bitmap test and an array access, and scans visiting nodes in ID
+// order read consecutive column entries
+//
+// an attribute has a single column, covering the nodes of every label
+// holding at least COLUMNAR_MIN_LABEL_SIZE nodes, such that a read is a
+// direct lookup whatever labels the node holds
+// an attribute is only laid out if its values share a single columnar type
+// labels in which the attribute is sparse aren't covered, their nodes
+// are read from the attribute-set
+//
+// a column is built lazily, once its attribute has been read often enough
+// it is discarded once a node's value of the attribute is modified or
+// a node holding it is deleted or relocated
+
+typedef struct _PropertyColumn PropertyColumn;
+typedef struct _PropertyColumns PropertyColumns;
+
+// set min number of nodes a label must hold for its attributes
+// to be laid out in columns, 0 disables columnar layout
+void PropertyColumns_SetMinLabelSize
+(
+	uint64_t min_label_size
+);
+
+// get min number of nodes a label must hold for its attributes
+// to be laid out in columns, 0 if columnar layout is disabled
+uint64_t PropertyColumns_GetMinLabelSize(void);
+
+// build a column of attribute `attr` across the nodes of label matrices
+// returns NULL if the attribute isn't suitable for a columnar layout
+PropertyColumn *PropertyColumn_Build
+(
+	const RG_Matrix *labels,  // label matrices to cover
+	uint n,                   // number of label matrices
+	const DataBlock *nodes,   // node attribute-sets
+	Attribute_ID attr         // attribute to lay out
+);
+
+// retrieves node's value from column
+// returns false if the node isn't covered by the column
+bool PropertyColumn_Get
+(
+	const PropertyColumn *col,  // column to read from
+	uint64_t id,                // node ID
+	SIValue *v                  // [output] value
+);
+
+// free column
+void PropertyColumn_Free
+(
+	PropertyColumn *col  // column to free
+);
+
+// create a new empty columns store
+PropertyColumns *PropertyColumns_New(void);
+
+// retrieves node's value of attribute `attr` from the attribute's column
+// returns false if the node's value isn't held by the column
+//
+// if the attribute was read often enough and has yet to be laid out
+// `build` is set and the caller is expected to build the attribute's column
+// and hand it over to PropertyColumns_Publish
+bool PropertyColumns_Get
+(
+	PropertyColumns *pc,  // columns store
+	Attribute_ID attr,    // attribute to read
+	uint64_t id,          // node ID
+	SIValue *v,           // [output] value
+	bool *build           // [output] attribute column should be built
+);
+
+// publish attribute's column, NULL if the attribute isn't laid out
+// the store takes ownership over the column
+void PropertyColumns_Publish
+(
+	PropertyColumns *pc,  // columns store
+	Attribute_ID attr,    // laid out attribute
+	PropertyColumn *col   // attribute column
+);
+
+// discard attribute's column, ATTRIBUTE_ID_ALL discards all columns
+// must be called while no reader access the store
+void PropertyColumns_Invalidate
+(
+	PropertyColumns *pc,  // columns store
+	Attribute_ID attr     // modified attribute
+);
+
+// discard all columns
+// must be called while no reader access the store
+void PropertyColumns_Clear
+(
+	PropertyColumns *pc  // columns store
+);
+
+// free columns store
+void PropertyColumns_Free
+(
+	PropertyColumns *pc  // columns store to free
+);
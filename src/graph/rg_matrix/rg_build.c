@@ -0,0 +1,236 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rg_matrix.h"
+#include "../../util/arr.h"
+#include "../../util/qsort.h"
+#include "../../util/rmalloc.h"
+
+// merge two entries, each either a single edge ID or a multi-edge array
+// into a single multi-edge array
+// both x's and y's arrays (if any) are consumed
+static uint64_t _merge_edges
+(
+	uint64_t x,
+	uint64_t y
+) {
+	uint64_t *ids;
+
+	if(SINGLE_EDGE(x)) {
+		ids = array_new(uint64_t, 2);
+		array_append(ids, x);
+	} else {
+		ids = (uint64_t *)(CLEAR_MSB(x));
+	}
+
+	if(SINGLE_EDGE(y)) {
+		array_append(ids, y);
+	} else {
+		uint64_t *y_ids = (uint64_t *)(CLEAR_MSB(y));
+		array_ensure_append(ids, y_ids, array_len(y_ids), uint64_t);
+		array_free(y_ids);
+	}
+
+	return (uint64_t)SET_MSB(ids);
+}
+
+typedef struct {
+	const GrB_Index *I;
+	const GrB_Index *J;
+} _Tuples;
+
+// order tuple positions by (row, column)
+// ties are broken by position, keeping edges in the order they were given
+static int _cmp_tuples
+(
+	const void *a,
+	const void *b,
+	void *arg
+) {
+	const _Tuples *t = (const _Tuples *)arg;
+	GrB_Index x = *(const GrB_Index *)a;
+	GrB_Index y = *(const GrB_Index *)b;
+
+	if(t->I[x] != t->I[y]) return (t->I[x] < t->I[y]) ? -1 : 1;
+	if(t->J[x] != t->J[y]) return (t->J[x] < t->J[y]) ? -1 : 1;
+	return (x < y) ? -1 : (x > y);
+}
+
+// collapse tuples sharing a position into a single multi-edge tuple
+// returns the number of unique tuples written to _I, _J and _X
+static GrB_Index _collapse
+(
+	GrB_Index *_I,           // [output] unique row indices
+	GrB_Index *_J,           // [output] unique column indices
+	uint64_t *_X,            // [output] merged values
+	const GrB_Index *I,      // row indices
+	const GrB_Index *J,      // column indices
+	const uint64_t *X,       // values
+	GrB_Index nvals          // number of tuples
+) {
+	GrB_Index *perm = rm_malloc(sizeof(GrB_Index) * nvals);
+	for(GrB_Index k = 0; k < nvals; k++) perm[k] = k;
+
+	_Tuples t = { .I = I, .J = J };
+	sort_r(perm, nvals, sizeof(GrB_Index), _cmp_tuples, &t);
+
+	GrB_Index n = 0;
+	for(GrB_Index k = 0; k < nvals; k++) {
+		GrB_Index p = perm[k];
+		ASSERT(SINGLE_EDGE(X[p]));
+
+		if(n > 0 && _I[n-1] == I[p] && _J[n-1] == J[p]) {
+			_X[n-1] = _merge_edges(_X[n-1], X[p]);
+		} else {
+			_I[n] = I[p];
+			_J[n] = J[p];
+			_X[n] = X[p];
+			n++;
+		}
+	}
+
+	rm_free(perm);
+	return n;
+}
+
+// merge entries of T which collide with existing entries in M
+// into T, such that T's entries can replace M's
+static void _merge_existing
+(
+	GrB_Matrix T,            // new entries
+	GrB_Matrix M             // existing entries
+) {
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Index  nvals;
+	GrB_Matrix E;
+
+	UNUSED(info);
+
+	GrB_Matrix_nrows(&nrows, M);
+	GrB_Matrix_ncols(&ncols, M);
+
+	// E = existing entries at positions shared with T
+	info = GrB_Matrix_new(&E, GrB_UINT64, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_eWiseMult_BinaryOp(E, NULL, NULL, GrB_FIRST_UINT64, M,
+			T, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix_nvals(&nvals, E);
+	if(nvals > 0) {
+		GrB_Index *I = rm_malloc(sizeof(GrB_Index) * nvals);
+		GrB_Index *J = rm_malloc(sizeof(GrB_Index) * nvals);
+		uint64_t  *X = rm_malloc(sizeof(uint64_t)  * nvals);
+
+		info = GrB_Matrix_extractTuples_UINT64(I, J, X, &nvals, E);
+		ASSERT(info == GrB_SUCCESS);
+
+		for(GrB_Index k = 0; k < nvals; k++) {
+			uint64_t y;
+			info = GrB_Matrix_extractElement_UINT64(&y, T, I[k], J[k]);
+			ASSERT(info == GrB_SUCCESS);
+
+			info = GrB_Matrix_setElement_UINT64(T, _merge_edges(X[k], y),
+					I[k], J[k]);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		rm_free(I);
+		rm_free(J);
+		rm_free(X);
+	}
+
+	GrB_Matrix_free(&E);
+}
+
+// add tuples to M, M = M + T where T is built from tuples
+static void _build
+(
+	GrB_Matrix M,            // matrix to update
+	const GrB_Index *I,      // row indices
+	const GrB_Index *J,      // column indices
+	const uint64_t *X,       // values, NULL for a boolean matrix
+	GrB_Index nvals          // number of tuples
+) {
+	GrB_Type   t;
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Matrix T;
+
+	UNUSED(info);
+
+	GxB_Matrix_type(&t, M);
+	GrB_Matrix_nrows(&nrows, M);
+	GrB_Matrix_ncols(&ncols, M);
+
+	info = GrB_Matrix_new(&T, t, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_BinaryOp op;
+	if(X != NULL) {
+		// duplicates are collapsed into multi-edge entries up front
+		// leaving GraphBLAS with unique tuples only
+		GrB_Index *_I = rm_malloc(sizeof(GrB_Index) * nvals);
+		GrB_Index *_J = rm_malloc(sizeof(GrB_Index) * nvals);
+		uint64_t  *_X = rm_malloc(sizeof(uint64_t)  * nvals);
+
+		GrB_Index n = _collapse(_I, _J, _X, I, J, X, nvals);
+		info = GrB_Matrix_build_UINT64(T, _I, _J, _X, n, GrB_FIRST_UINT64);
+
+		rm_free(_I);
+		rm_free(_J);
+		rm_free(_X);
+		ASSERT(info == GrB_SUCCESS);
+
+		// entries colliding with M are merged into T, T replaces them
+		_merge_existing(T, M);
+		op = GrB_SECOND_UINT64;
+	} else {
+		GrB_Scalar s;
+		GrB_Scalar_new(&s, GrB_BOOL);
+		GrB_Scalar_setElement_BOOL(s, true);
+		op = GrB_LOR;
+		info = GxB_Matrix_build_Scalar(T, I, J, s, nvals);
+		GrB_Scalar_free(&s);
+	}
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_eWiseAdd_BinaryOp(M, NULL, NULL, op, M, T, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix_free(&T);
+}
+
+GrB_Info RG_Matrix_build
+(
+	RG_Matrix C,
+	const GrB_Index *I,
+	const GrB_Index *J,
+	const uint64_t *X,
+	GrB_Index nvals
+) {
+	ASSERT(C != NULL);
+	ASSERT(I != NULL);
+	ASSERT(J != NULL);
+	ASSERT(RG_Matrix_Synced(C));
+
+	if(nvals == 0) return GrB_SUCCESS;
+
+	_build(RG_MATRIX_M(C), I, J, X, nvals);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		_build(RG_MATRIX_M(C->transposed), J, I, NULL, nvals);
+	}
+
+	RG_Matrix_setDirty(C);
+
+	return GrB_SUCCESS;
+}
@@ -51,6 +51,8 @@ GrB_Info RG_Matrix_copy
 	_copyMatrix(in_delta_plus, out_delta_plus);
 	_copyMatrix(in_delta_minus, out_delta_minus);
 
+	C->version++;
+
 	return GrB_SUCCESS;
 }
 
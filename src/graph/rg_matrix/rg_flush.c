@@ -0,0 +1,248 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rg_matrix.h"
+#include "configuration/config.h"
+
+// returns true if C (ignoring its transpose) requires a flush
+static bool _RG_Matrix_requiresFlush
+(
+	const RG_Matrix C
+) {
+	GrB_Index dp_nvals;
+	GrB_Index dm_nvals;
+	GrB_Matrix_nvals(&dp_nvals, RG_MATRIX_DELTA_PLUS(C));
+	GrB_Matrix_nvals(&dm_nvals, RG_MATRIX_DELTA_MINUS(C));
+
+	uint64_t delta_max_pending_changes;
+	Config_Option_get(Config_DELTA_MAX_PENDING_CHANGES,
+			&delta_max_pending_changes);
+
+	return (dp_nvals + dm_nvals >= delta_max_pending_changes);
+}
+
+// discard C's prepared matrix
+static void _RG_Matrix_discardFlush
+(
+	RG_Matrix C
+) {
+	if(C->flushed == NULL) return;
+
+	// multi-edge arrays are shared with M and DP, free matrix only
+	GrB_Info info = GrB_Matrix_free(&C->flushed);
+	ASSERT(info == GrB_SUCCESS);
+	UNUSED(info);
+
+	C->flushed = NULL;
+}
+
+// state a flush is prepared from
+typedef struct {
+	GrB_Matrix m;       // C's M, read only
+	GrB_Matrix dp;      // copy of C's delta-plus
+	GrB_Matrix dm;      // copy of C's delta-minus
+	uint64_t version;   // C's version at the time of the snapshot
+} FlushSnapshot;
+
+// snapshot C's deltas, caller holds C's lock
+// returns false if C doesn't require a new flush
+static bool _RG_Matrix_snapshotFlush
+(
+	RG_Matrix C,
+	FlushSnapshot *snapshot
+) {
+	// prepared matrix is up to date
+	if(C->flushed != NULL && C->flushed_version == C->version) return false;
+
+	_RG_Matrix_discardFlush(C);
+
+	if(!_RG_Matrix_requiresFlush(C)) return false;
+
+	// deltas are bounded by the pending changes threshold, copying is cheap
+	// M is referenced, it is only replaced or merged into under the write lock
+	GrB_Info info;
+	UNUSED(info);
+
+	info = GrB_Matrix_dup(&snapshot->dp, RG_MATRIX_DELTA_PLUS(C));
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_dup(&snapshot->dm, RG_MATRIX_DELTA_MINUS(C));
+	ASSERT(info == GrB_SUCCESS);
+
+	snapshot->m       = RG_MATRIX_M(C);
+	snapshot->version = C->version;
+
+	return true;
+}
+
+// build F = M + DP - DM from snapshot, no lock is held
+static GrB_Matrix _RG_Matrix_mergeFlush
+(
+	FlushSnapshot *snapshot
+) {
+	GrB_Info   info;
+	GrB_Matrix f  = NULL;
+	GrB_Matrix m  = snapshot->m;
+	GrB_Matrix dp = snapshot->dp;
+	GrB_Matrix dm = snapshot->dm;
+
+	GrB_Index dp_nvals;
+	GrB_Index dm_nvals;
+	GrB_Matrix_nvals(&dp_nvals, dp);
+	GrB_Matrix_nvals(&dm_nvals, dm);
+
+	// copy M, retaining its format
+	info = GrB_Matrix_dup(&f, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	// perform deletions
+	if(dm_nvals > 0) {
+		info = GrB_transpose(f, dm, GrB_NULL, f, GrB_DESC_RSCT0);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// perform additions
+	if(dp_nvals > 0) {
+		GrB_Type t;
+		GrB_Semiring s;
+		info = GxB_Matrix_type(&t, m);
+		ASSERT(info == GrB_SUCCESS);
+
+		s = (t == GrB_BOOL) ? GxB_ANY_PAIR_BOOL : GxB_ANY_PAIR_UINT64;
+		info = GrB_Matrix_eWiseAdd_Semiring(f, NULL, NULL, s, f, dp, NULL);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// materialize, applying the flush should be O(1)
+	info = GrB_wait(f, GrB_MATERIALIZE);
+	ASSERT(info == GrB_SUCCESS);
+
+	// multi-edge arrays are shared with C's delta-plus, free matrices only
+	GrB_Matrix_free(&snapshot->dp);
+	GrB_Matrix_free(&snapshot->dm);
+
+	return f;
+}
+
+// publish F, caller holds C's lock
+// F is discarded if C was modified since the snapshot was taken
+static void _RG_Matrix_publishFlush
+(
+	RG_Matrix C,
+	FlushSnapshot *snapshot,
+	GrB_Matrix f
+) {
+	if(C->version != snapshot->version || C->flushed != NULL ||
+	   RG_MATRIX_M(C) != snapshot->m) {
+		GrB_Matrix_free(&f);
+		return;
+	}
+
+	C->flushed         = f;
+	C->flushed_version = snapshot->version;
+}
+
+// swap in C's prepared matrix
+static bool _RG_Matrix_applyFlush
+(
+	RG_Matrix C
+) {
+	if(C->flushed == NULL) return false;
+
+	// C was modified since the flush was prepared
+	if(C->flushed_version != C->version) {
+		_RG_Matrix_discardFlush(C);
+		return false;
+	}
+
+	GrB_Info info;
+	UNUSED(info);
+
+	// multi-edge arrays are now owned by the prepared matrix
+	// free the replaced matrix only
+	info = GrB_Matrix_free(&RG_MATRIX_M(C));
+	ASSERT(info == GrB_SUCCESS);
+
+	RG_MATRIX_M(C) = C->flushed;
+	C->flushed     = NULL;
+
+	info = GrB_Matrix_clear(RG_MATRIX_DELTA_PLUS(C));
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_clear(RG_MATRIX_DELTA_MINUS(C));
+	ASSERT(info == GrB_SUCCESS);
+
+	return true;
+}
+
+bool RG_Matrix_requiresFlush
+(
+	const RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
+	if(_RG_Matrix_requiresFlush(C)) return true;
+
+	return (RG_MATRIX_MAINTAIN_TRANSPOSE(C) &&
+			_RG_Matrix_requiresFlush(C->transposed));
+}
+
+GrB_Info RG_Matrix_prepareFlush
+(
+	RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
+	// the lock is held only while snapshotting and publishing
+	// the merge itself doesn't block readers synchronizing C
+	FlushSnapshot snapshots[2];
+	RG_Matrix     matrices[2];
+	uint          n = 0;
+
+	RG_Matrix_Lock(C);
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C) &&
+	   _RG_Matrix_snapshotFlush(C->transposed, snapshots + n)) {
+		matrices[n++] = C->transposed;
+	}
+	if(_RG_Matrix_snapshotFlush(C, snapshots + n)) {
+		matrices[n++] = C;
+	}
+	RG_Matrix_Unlock(C);
+
+	if(n == 0) return GrB_SUCCESS;
+
+	GrB_Matrix flushed[2];
+	for(uint i = 0; i < n; i++) {
+		flushed[i] = _RG_Matrix_mergeFlush(snapshots + i);
+	}
+
+	RG_Matrix_Lock(C);
+	for(uint i = 0; i < n; i++) {
+		_RG_Matrix_publishFlush(matrices[i], snapshots + i, flushed[i]);
+	}
+	RG_Matrix_Unlock(C);
+
+	return GrB_SUCCESS;
+}
+
+bool RG_Matrix_applyFlush
+(
+	RG_Matrix C
+) {
+	ASSERT(C != NULL);
+
+	// the matrix and its transpose are prepared and applied independently
+	// each reflecting its own deltas
+	bool applied = false;
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		applied = _RG_Matrix_applyFlush(C->transposed);
+	}
+
+	applied |= _RG_Matrix_applyFlush(C);
+
+	return applied;
+}
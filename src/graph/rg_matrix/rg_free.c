@@ -71,6 +71,12 @@ void RG_Matrix_free
 	info = GrB_Matrix_free(&M->delta_minus);
 	ASSERT(info == GrB_SUCCESS);
 
+	// prepared flush shares multi-edge arrays with M and delta-plus
+	if(M->flushed != NULL) {
+		info = GrB_Matrix_free(&M->flushed);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
 	pthread_mutex_destroy(&M->mutex);
 
 	rm_free(M);
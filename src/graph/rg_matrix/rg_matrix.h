@@ -24,6 +24,11 @@ typedef _RG_Matrix *RG_Matrix;
 // Checks if X represents edge ID.
 #define SINGLE_EDGE(x) !((x) & MSB_MASK)
 
+// pending changes backlog, in multiples of the max pending changes threshold
+// past which a deferred wait merges the deltas inline
+// rather than leaving them to a background flush
+#define RG_MATRIX_FLUSH_BACKLOG 4
+
 #define RG_MATRIX_M(C) (C)->matrix
 #define RG_MATRIX_DELTA_PLUS(C) (C)->delta_plus
 #define RG_MATRIX_DELTA_MINUS(C) (C)->delta_minus
@@ -124,11 +129,34 @@ typedef _RG_Matrix *RG_Matrix;
 //
 //------------------------------------------------------------------------------
 
+//------------------------------------------------------------------------------
+//
+// background flush
+//
+//------------------------------------------------------------------------------
+//
+// merging the deltas into M in place requires exclusive access to the matrix
+// instead, the merge can be performed copy-on-write:
+//
+// 1. RG_Matrix_prepareFlush builds F = M + DP - DM into a new matrix
+//    M, DP and DM are only read, concurrent readers are unaffected
+//
+// 2. RG_Matrix_applyFlush swaps F in place of M and clears DP and DM
+//    once no reader is active, an O(1) operation
+//
+// every modification bumps the matrix version, a prepared F which
+// doesn't reflect the current version is discarded rather than applied
+//
+//------------------------------------------------------------------------------
+
 struct _RG_Matrix {
 	volatile bool dirty;                // Indicates if matrix requires sync
 	GrB_Matrix matrix;                  // Underlying GrB_Matrix
 	GrB_Matrix delta_plus;              // Pending additions
 	GrB_Matrix delta_minus;             // Pending deletions
+	GrB_Matrix flushed;                 // Prepared M + DP - DM, awaiting apply
+	uint64_t version;                   // Modification counter
+	uint64_t flushed_version;           // Version 'flushed' was prepared from
 	RG_Matrix transposed;               // Transposed matrix
 	pthread_mutex_t mutex;              // Lock
 };
@@ -218,6 +246,19 @@ GrB_Info RG_Matrix_setElement_UINT64      // C (i,j) = x
 	GrB_Index j                         // column index
 );
 
+// add tuples to C in bulk, C must be synced
+// tuples sharing a position with one another or with an existing entry
+// are merged into a multi-edge entry
+// X is NULL for boolean matrices
+GrB_Info RG_Matrix_build
+(
+	RG_Matrix C,                        // matrix to modify
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	const uint64_t *X,                  // values
+	GrB_Index nvals                     // number of tuples
+);
+
 GrB_Info RG_Matrix_extractElement_BOOL     // x = A(i,j)
 (
 	bool *x,                               // extracted scalar
@@ -306,6 +347,47 @@ GrB_Info RG_Matrix_wait
 	bool force_sync
 );
 
+// same as RG_Matrix_wait without forcing a sync
+// pending changes are left to a background flush unless they exceed
+// RG_MATRIX_FLUSH_BACKLOG times the max pending changes threshold
+GrB_Info RG_Matrix_waitDeferred
+(
+	RG_Matrix C
+);
+
+// complete pending GraphBLAS work on C's main and delta matrices
+// without merging C's pending changes
+GrB_Info RG_Matrix_waitNoSync
+(
+	RG_Matrix C
+);
+
+// returns true if either C or its transpose accumulated enough
+// pending changes to be flushed
+bool RG_Matrix_requiresFlush
+(
+	const RG_Matrix C
+);
+
+// merge C's pending changes into a new matrix, leaving C as is
+// C's lock is acquired to snapshot its deltas and to publish the result
+// but isn't held while merging
+// the caller must guarantee C's M isn't replaced for the duration of the call
+// and that C has no pending GraphBLAS work
+GrB_Info RG_Matrix_prepareFlush
+(
+	RG_Matrix C
+);
+
+// swap in the matrix prepared by RG_Matrix_prepareFlush
+// the prepared matrix is discarded if C was modified since it was prepared
+// the caller must have exclusive access to C
+// returns true if a prepared matrix was applied
+bool RG_Matrix_applyFlush
+(
+	RG_Matrix C
+);
+
 // get the type of the M matrix
 GrB_Info RG_Matrix_type
 (
@@ -128,6 +128,8 @@ GrB_Info RG_Matrix_removeEntry_UINT64
 		} else {
 			info = _removeElementMultiVal(m, i, j, v);
 			ASSERT(info == GrB_SUCCESS);
+			// multi-edge array modified in place
+			RG_Matrix_setDirty(C);
 		}
 		return info;
 	}
@@ -149,6 +151,8 @@ GrB_Info RG_Matrix_removeEntry_UINT64
 	} else {
 		info = _removeElementMultiVal(dp, i, j, v);
 		ASSERT(info == GrB_SUCCESS);
+		// multi-edge array modified in place
+		RG_Matrix_setDirty(C);
 	}
 	return info;
 }
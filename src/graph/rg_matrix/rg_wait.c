@@ -103,16 +103,17 @@ static GrB_Info RG_Matrix_sync
 	return info;
 }
 
-GrB_Info RG_Matrix_wait
+static GrB_Info _RG_Matrix_wait
 (
 	RG_Matrix A,
-	bool force_sync
+	bool force_sync,
+	uint64_t max_pending_changes  // sync once pending changes reach this limit
 ) {
 	ASSERT(A != NULL);
 	if(RG_MATRIX_MAINTAIN_TRANSPOSE(A)) {
-		RG_Matrix_wait(A->transposed, force_sync);
+		_RG_Matrix_wait(A->transposed, force_sync, max_pending_changes);
 	}
-	
+
 	GrB_Info   info        = GrB_SUCCESS;
 	GrB_Matrix m           = RG_MATRIX_M(A);
 	GrB_Matrix delta_plus  = RG_MATRIX_DELTA_PLUS(A);
@@ -124,12 +125,8 @@ GrB_Info RG_Matrix_wait
 	GrB_Matrix_nvals(&delta_plus_nvals, delta_plus);
 	GrB_Matrix_nvals(&delta_minus_nvals, delta_minus);
 
-	uint64_t delta_max_pending_changes;
-	Config_Option_get(Config_DELTA_MAX_PENDING_CHANGES,
-			&delta_max_pending_changes);
-
 	if(force_sync ||
-	   delta_plus_nvals + delta_minus_nvals >= delta_max_pending_changes) {
+	   delta_plus_nvals + delta_minus_nvals >= max_pending_changes) {
 		info = RG_Matrix_sync(A);
 	} else {
 		// wait on 'm', in most cases 'm' won't contain any pending work
@@ -149,3 +146,46 @@ GrB_Info RG_Matrix_wait
 	return info;
 }
 
+GrB_Info RG_Matrix_wait
+(
+	RG_Matrix A,
+	bool force_sync
+) {
+	ASSERT(A != NULL);
+
+	uint64_t delta_max_pending_changes;
+	Config_Option_get(Config_DELTA_MAX_PENDING_CHANGES,
+			&delta_max_pending_changes);
+
+	return _RG_Matrix_wait(A, force_sync, delta_max_pending_changes);
+}
+
+GrB_Info RG_Matrix_waitDeferred
+(
+	RG_Matrix A
+) {
+	ASSERT(A != NULL);
+
+	uint64_t delta_max_pending_changes;
+	Config_Option_get(Config_DELTA_MAX_PENDING_CHANGES,
+			&delta_max_pending_changes);
+
+	// merging is left to a background flush, unless changes accumulate
+	// faster than background flushes are applied
+	uint64_t limit = UINT64_MAX;
+	if(delta_max_pending_changes < UINT64_MAX / RG_MATRIX_FLUSH_BACKLOG) {
+		limit = delta_max_pending_changes * RG_MATRIX_FLUSH_BACKLOG;
+	}
+
+	return _RG_Matrix_wait(A, false, limit);
+}
+
+GrB_Info RG_Matrix_waitNoSync
+(
+	RG_Matrix A
+) {
+	ASSERT(A != NULL);
+
+	// no number of pending changes reaches the limit, deltas are never merged
+	return _RG_Matrix_wait(A, false, UINT64_MAX);
+}
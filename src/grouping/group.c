@@ -5,51 +5,54 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "group.h"
+#include "../RG.h"
 #include "../redismodule.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 #include "../execution_plan/ops/op.h"
 
-// creates a new group
-Group *Group_New
+// initialize a group within a buffer of GROUP_SIZE bytes
+Group *Group_Init
 (
-	SIValue *keys,     // group keys
-	uint key_count,    // number of keys
-	AR_ExpNode **agg,  // aggregation functions
-	uint func_count    // number of aggregation functions
+	void *buf,               // buffer to initialize group in
+	const SIValue *keys,     // group keys
+	uint key_count,          // number of keys
+	AR_ExpNode *const *agg,  // aggregation functions
+	uint func_count          // number of aggregation functions
 ) {
-	Group *g = rm_malloc(sizeof(Group));
+	ASSERT(buf != NULL);
+
+	Group *g = (Group *)buf;
 
-	g->keys       = keys;
-	g->agg        = agg;
 	g->key_count  = key_count;
 	g->func_count = func_count;
 
+	// aggregation functions are located right after the keys
+	g->agg = (AR_ExpNode **)(g->keys + key_count);
+
+	if(key_count > 0)  memcpy(g->keys, keys, sizeof(SIValue) * key_count);
+	if(func_count > 0) memcpy(g->agg, agg, sizeof(AR_ExpNode *) * func_count);
+
 	return g;
 }
 
-// free group
-void Group_Free
+// free group's keys and aggregation functions
+void Group_Clear
 (
-	Group *g  // group to free
+	Group *g  // group to clear
 ) {
 	if(g == NULL) {
 		return;
 	}
 
-	if(g->keys != NULL) {
-		for(int i = 0; i < g->key_count; i ++) {
-			SIValue_Free(g->keys[i]);
-		}
-		rm_free(g->keys);
+	for(uint i = 0; i < g->key_count; i ++) {
+		SIValue_Free(g->keys[i]);
 	}
 
 	for(uint i = 0; i < g->func_count; i++) {
 		AR_EXP_Free(g->agg[i]);
 	}
-
-	rm_free(g->agg);
-	rm_free(g);
 }
 
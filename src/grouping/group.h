@@ -9,25 +9,35 @@
 #include "../value.h"
 #include "../arithmetic/arithmetic_expression.h"
 
+// groups are allocated by their owner (see group_table.h)
+// keys and aggregation functions are stored inline, right after the header
 typedef struct {
-	SIValue *keys;     // SIValues that form the key associated with group
 	AR_ExpNode **agg;  // aggregate functions
 	uint key_count;    // number of keys
 	uint func_count;   // number of aggregation functions
+	SIValue keys[];    // SIValues that form the key associated with group
 } Group;
 
-// creates a new group
-Group *Group_New
+// number of bytes required by a group
+#define GROUP_SIZE(key_count, func_count)          \
+	(sizeof(Group) + sizeof(SIValue) * (key_count) + \
+	 sizeof(AR_ExpNode *) * (func_count))
+
+// initialize a group within a buffer of GROUP_SIZE bytes
+// the group takes ownership over both keys and aggregation functions
+Group *Group_Init
 (
-	SIValue *keys,     // group keys
-	uint key_count,    // number of keys
-	AR_ExpNode **agg,  // aggregation functions
-	uint func_count    // number of aggregation functions
+	void *buf,               // buffer to initialize group in
+	const SIValue *keys,     // group keys
+	uint key_count,          // number of keys
+	AR_ExpNode *const *agg,  // aggregation functions
+	uint func_count          // number of aggregation functions
 );
 
-// free group
-void Group_Free
+// free group's keys and aggregation functions
+// the group's buffer is released by its owner
+void Group_Clear
 (
-	Group *g  // group to free
+	Group *g  // group to clear
 );
 
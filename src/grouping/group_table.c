@@ -0,0 +1,223 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "group_table.h"
+#include "../RG.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+// number of groups within a single arena block
+#define GROUP_TABLE_BLOCK_CAP 1024
+
+// minimum number of slots
+#define GROUP_TABLE_MIN_CAP 64
+
+// slots are doubled once the table is half full
+#define GROUP_TABLE_FULL(t) ((t)->count * 2 >= (t)->cap)
+
+// returns true if two group keys are equal
+static bool _GroupTable_KeyEqual
+(
+	SIValue a,
+	SIValue b
+) {
+	int disjointOrNull = 0;
+	int res = SIValue_Compare(a, b, &disjointOrNull);
+
+	// nulls and NaNs can't be compared, values of the same type
+	// sharing a hash are considered equal, e.g. NULL and NULL
+	if(disjointOrNull == COMPARED_NULL || disjointOrNull == COMPARED_NAN) {
+		return SI_TYPE(a) == SI_TYPE(b);
+	}
+
+	if(disjointOrNull == DISJOINT) {
+		return false;
+	}
+
+	return res == 0;
+}
+
+static bool _GroupTable_KeysEqual
+(
+	const GroupTable *t,
+	const Group *g,
+	const SIValue *keys
+) {
+	for(uint i = 0; i < t->key_count; i++) {
+		if(!_GroupTable_KeyEqual(g->keys[i], keys[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// place group in the first free slot along its probe sequence
+static void _GroupTable_Place
+(
+	GroupTableSlot *slots,
+	uint64_t cap,
+	XXH64_hash_t hash,
+	Group *g
+) {
+	uint64_t mask = cap - 1;
+	uint64_t pos  = hash & mask;
+
+	while(slots[pos].group != NULL) {
+		pos = (pos + 1) & mask;
+	}
+
+	slots[pos].hash  = hash;
+	slots[pos].group = g;
+}
+
+// double the number of slots
+static void _GroupTable_Grow
+(
+	GroupTable *t
+) {
+	uint64_t cap = t->cap * 2;
+	GroupTableSlot *slots = rm_calloc(cap, sizeof(GroupTableSlot));
+
+	// rehash, groups aren't relocated
+	for(uint64_t i = 0; i < t->cap; i++) {
+		GroupTableSlot *slot = t->slots + i;
+		if(slot->group != NULL) {
+			_GroupTable_Place(slots, cap, slot->hash, slot->group);
+		}
+	}
+
+	rm_free(t->slots);
+	t->slots = slots;
+	t->cap   = cap;
+}
+
+// allocate memory for a new group from the arena
+static void *_GroupTable_AllocGroup
+(
+	GroupTable *t
+) {
+	uint64_t offset = t->count % GROUP_TABLE_BLOCK_CAP;
+
+	// last block is full, allocate a new one
+	if(offset == 0) {
+		char *block = rm_malloc(t->group_size * GROUP_TABLE_BLOCK_CAP);
+		array_append(t->blocks, block);
+	}
+
+	char *block = t->blocks[array_len(t->blocks) - 1];
+	return block + offset * t->group_size;
+}
+
+GroupTable *GroupTable_New
+(
+	uint key_count,
+	uint func_count,
+	uint64_t n
+) {
+	GroupTable *t = rm_malloc(sizeof(GroupTable));
+
+	// number of slots is a power of 2, at least twice the expected group count
+	uint64_t cap = GROUP_TABLE_MIN_CAP;
+	while(cap < n * 2) cap *= 2;
+
+	t->cap        = cap;
+	t->count      = 0;
+	t->slots      = rm_calloc(cap, sizeof(GroupTableSlot));
+	t->blocks     = array_new(char *, 1);
+	t->key_count  = key_count;
+	t->func_count = func_count;
+	t->group_size = GROUP_SIZE(key_count, func_count);
+
+	return t;
+}
+
+uint64_t GroupTable_Count
+(
+	const GroupTable *t
+) {
+	ASSERT(t != NULL);
+	return t->count;
+}
+
+Group *GroupTable_Lookup
+(
+	const GroupTable *t,
+	XXH64_hash_t hash,
+	const SIValue *keys
+) {
+	ASSERT(t != NULL);
+
+	uint64_t mask = t->cap - 1;
+	uint64_t pos  = hash & mask;
+
+	// probe until an empty slot is reached
+	// table is never full, probing is guaranteed to terminate
+	while(t->slots[pos].group != NULL) {
+		GroupTableSlot *slot = t->slots + pos;
+		if(slot->hash == hash && _GroupTable_KeysEqual(t, slot->group, keys)) {
+			return slot->group;
+		}
+		pos = (pos + 1) & mask;
+	}
+
+	return NULL;
+}
+
+Group *GroupTable_Add
+(
+	GroupTable *t,
+	XXH64_hash_t hash,
+	const SIValue *keys,
+	AR_ExpNode *const *agg
+) {
+	ASSERT(t != NULL);
+
+	if(GROUP_TABLE_FULL(t)) {
+		_GroupTable_Grow(t);
+	}
+
+	void *buf = _GroupTable_AllocGroup(t);
+	Group *g = Group_Init(buf, keys, t->key_count, agg, t->func_count);
+
+	_GroupTable_Place(t->slots, t->cap, hash, g);
+	t->count++;
+
+	return g;
+}
+
+Group *GroupTable_GetGroup
+(
+	const GroupTable *t,
+	uint64_t idx
+) {
+	ASSERT(t != NULL);
+	ASSERT(idx < t->count);
+
+	char *block = t->blocks[idx / GROUP_TABLE_BLOCK_CAP];
+	return (Group *)(block + (idx % GROUP_TABLE_BLOCK_CAP) * t->group_size);
+}
+
+void GroupTable_Free
+(
+	GroupTable *t
+) {
+	ASSERT(t != NULL);
+
+	for(uint64_t i = 0; i < t->count; i++) {
+		Group_Clear(GroupTable_GetGroup(t, i));
+	}
+
+	uint block_count = array_len(t->blocks);
+	for(uint i = 0; i < block_count; i++) {
+		rm_free(t->blocks[i]);
+	}
+	array_free(t->blocks);
+
+	rm_free(t->slots);
+	rm_free(t);
+}
+
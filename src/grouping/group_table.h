@@ -0,0 +1,80 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "group.h"
+#include "xxhash.h"
+
+// GroupTable maps grouping keys to groups
+// the table uses open addressing with linear probing, each slot holds the
+// group's hash alongside a pointer to the group, on a hash match the
+// group keys are compared to resolve collisions
+//
+// groups are allocated from an arena of fixed size blocks and are never
+// relocated, iterating over the table visits groups in insertion order
+
+typedef struct {
+	XXH64_hash_t hash;  // hash of group keys
+	Group *group;       // group, NULL marks an empty slot
+} GroupTableSlot;
+
+typedef struct {
+	GroupTableSlot *slots;  // open addressing slots
+	uint64_t cap;           // number of slots, power of 2
+	uint64_t count;         // number of groups
+	uint key_count;         // number of keys in each group
+	uint func_count;        // number of aggregation functions in each group
+	size_t group_size;      // size of a group in bytes
+	char **blocks;          // arena blocks holding groups
+} GroupTable;
+
+// create a new group table
+GroupTable *GroupTable_New
+(
+	uint key_count,   // number of keys in each group
+	uint func_count,  // number of aggregation functions in each group
+	uint64_t n        // expected number of groups
+);
+
+// returns number of groups in table
+uint64_t GroupTable_Count
+(
+	const GroupTable *t  // group table
+);
+
+// returns the group associated with keys, NULL if group is missing
+Group *GroupTable_Lookup
+(
+	const GroupTable *t,  // group table
+	XXH64_hash_t hash,    // hash of keys
+	const SIValue *keys   // group keys
+);
+
+// adds a new group to the table
+// caller must make sure the group isn't already in the table
+// the group takes ownership over both keys and aggregation functions
+Group *GroupTable_Add
+(
+	GroupTable *t,           // group table
+	XXH64_hash_t hash,       // hash of keys
+	const SIValue *keys,     // group keys
+	AR_ExpNode *const *agg   // group aggregation functions
+);
+
+// returns the idx'th group, in insertion order
+Group *GroupTable_GetGroup
+(
+	const GroupTable *t,  // group table
+	uint64_t idx          // group index
+);
+
+// free group table
+void GroupTable_Free
+(
+	GroupTable *t  // group table to free
+);
+
@@ -10,6 +10,7 @@
 #include "../util/arr.h"
 #include "../query_ctx.h"
 #include "../util/rmalloc.h"
+#include "../util/simple_timer.h"
 #include "../datatypes/point.h"
 #include "../graph/graphcontext.h"
 #include "../graph/entities/node.h"
@@ -26,7 +27,11 @@ struct _Index {
 	GraphEntityType entity_type;   // entity type (node/edge) indexed
 	IndexType type;                // index type exact-match / fulltext
 	RSIndex *rsIdx;                // RediSearch index
+	OrderedIndex *ordered;         // native ordered index, node exact-match
 	uint _Atomic pending_changes;  // number of pending changes
+	uint64_t _Atomic populated;    // number of entities populated
+	uint64_t _Atomic populate_total;  // number of entities to populate
+	double _Atomic populate_start;    // population start time (seconds)
 };
 
 static void _Index_ConstructFullTextStructure
@@ -136,6 +141,20 @@ void Index_ConstructStructure
 	// set RediSearch index
 	ASSERT(idx->rsIdx == NULL);
 	idx->rsIdx = rsIdx;
+
+	// node exact-match indexes are backed by a native ordered index
+	// the RediSearch index is kept empty, serving only the index structure
+	if(idx->type == IDX_EXACT_MATCH && idx->entity_type == GETYPE_NODE) {
+		ASSERT(idx->ordered == NULL);
+
+		uint fields_count = array_len(idx->fields);
+		Attribute_ID attrs[fields_count];
+		for(uint i = 0; i < fields_count; i++) {
+			attrs[i] = idx->fields[i].id;
+		}
+
+		idx->ordered = OrderedIndex_New(attrs, fields_count);
+	}
 }
 
 RSDoc *Index_IndexGraphEntity
@@ -291,12 +310,16 @@ Index Index_New
 	idx->type            = type;
 	idx->label           = rm_strdup(label);
 	idx->rsIdx           = NULL;
+	idx->ordered         = NULL;
 	idx->fields          = array_new(IndexField, 1);
 	idx->label_id        = label_id;
 	idx->language        = NULL;
 	idx->stopwords       = NULL;
 	idx->entity_type     = entity_type;
 	idx->pending_changes = ATOMIC_VAR_INIT(0);
+	idx->populated       = ATOMIC_VAR_INIT(0);
+	idx->populate_total  = ATOMIC_VAR_INIT(0);
+	idx->populate_start  = ATOMIC_VAR_INIT(0);
 
 	return idx;
 }
@@ -317,8 +340,12 @@ Index Index_Clone
 	memcpy(clone, idx, sizeof(_Index));
 
 	clone->rsIdx           = NULL;
+	clone->ordered         = NULL;
 	clone->label           = rm_strdup(idx->label);
 	clone->pending_changes = ATOMIC_VAR_INIT(0);
+	clone->populated       = ATOMIC_VAR_INIT(0);
+	clone->populate_total  = ATOMIC_VAR_INIT(0);
+	clone->populate_start  = ATOMIC_VAR_INIT(0);
 	
 	if(clone->stopwords != NULL) {
 		array_clone_with_cb(clone->stopwords, idx->stopwords, rm_strdup);
@@ -366,6 +393,11 @@ void Index_Disable
 		idx->rsIdx = NULL;
 	}
 
+	if(idx->ordered != NULL) {
+		OrderedIndex_Free(idx->ordered);
+		idx->ordered = NULL;
+	}
+
 	// construct index structure
 	Index_ConstructStructure(idx);
 }
@@ -583,6 +615,71 @@ RSIndex *Index_RSIndex
 	return idx->rsIdx;
 }
 
+// returns native ordered index
+OrderedIndex *Index_OrderedIndex
+(
+	const Index idx
+) {
+	ASSERT(idx != NULL);
+
+	return idx->ordered;
+}
+
+// reset population progress
+void Index_PopulateStart
+(
+	Index idx,
+	uint64_t total
+) {
+	ASSERT(idx != NULL);
+
+	// progress is read concurrently by index listing
+	double tic[2];
+	simple_tic(tic);
+
+	idx->populated      = 0;
+	idx->populate_total = total;
+	idx->populate_start = tic[0] + 1e-9 * tic[1];
+}
+
+// advance population progress
+void Index_PopulateAdvance
+(
+	Index idx,
+	uint64_t n
+) {
+	ASSERT(idx != NULL);
+
+	idx->populated += n;
+}
+
+// returns population progress
+IndexProgress Index_PopulateProgress
+(
+	const Index idx
+) {
+	ASSERT(idx != NULL);
+
+	IndexProgress progress = {
+		.indexed = idx->populated,
+		.total   = idx->populate_total,
+		.eta     = -1
+	};
+
+	// entities created during population may exceed the initial estimate
+	progress.total = MAX(progress.total, progress.indexed);
+
+	if(progress.indexed > 0) {
+		double tic[2];
+		simple_tic(tic);
+		double elapsed = tic[0] + 1e-9 * tic[1] - idx->populate_start;
+		progress.eta = elapsed / progress.indexed *
+			(progress.total - progress.indexed);
+	}
+
+	return progress;
+}
+
 // free index
 void Index_Free
 (
@@ -594,6 +691,10 @@ void Index_Free
 		RediSearch_DropIndex(idx->rsIdx);
 	}
 
+	if(idx->ordered) {
+		OrderedIndex_Free(idx->ordered);
+	}
+
 	if(idx->language) {
 		rm_free(idx->language);
 	}
@@ -10,6 +10,7 @@
 #include "../graph/entities/edge.h"
 #include "../graph/entities/graph_entity.h"
 #include "../graph/graph.h"
+#include "ordered_index.h"
 #include "redisearch_api.h"
 
 #define INDEX_OK 1
@@ -36,6 +37,13 @@ typedef enum {
 	IDX_FULLTEXT     =  2,
 } IndexType;
 
+// index population progress
+typedef struct {
+	uint64_t indexed;  // number of entities indexed
+	uint64_t total;    // estimated number of entities to index
+	double eta;        // estimated seconds to completion, -1 if unknown
+} IndexProgress;
+
 typedef struct {
 	EntityID src_id;
 	EntityID dest_id;
@@ -114,6 +122,13 @@ RSIndex *Index_RSIndex
 	const Index idx  // index to get internal RediSearch index from
 );
 
+// returns native ordered index
+// NULL if index is backed by RediSearch
+OrderedIndex *Index_OrderedIndex
+(
+	const Index idx  // index to get internal ordered index from
+);
+
 // responsible for creating the index structure only!
 // e.g. fields, stopwords, language
 void Index_ConstructStructure
@@ -128,6 +143,26 @@ void Index_Populate
 	Graph *g    // graph holding entities to index
 );
 
+// reset population progress
+void Index_PopulateStart
+(
+	Index idx,      // index being populated
+	uint64_t total  // estimated number of entities to index
+);
+
+// advance population progress
+void Index_PopulateAdvance
+(
+	Index idx,  // index being populated
+	uint64_t n  // number of entities indexed
+);
+
+// returns population progress
+IndexProgress Index_PopulateProgress
+(
+	const Index idx  // index to query
+);
+
 // adds field to index
 void Index_AddField
 (
@@ -6,10 +6,61 @@
 
 #include "RG.h"
 #include "index.h"
+#include "../util/simple_timer.h"
+#include "../util/thpool/pools.h"
 #include "../graph/rg_matrix/rg_matrix_iter.h"
 
 #include <assert.h>
 
+// batch size bounds, a batch is indexed under a single read lock acquisition
+#define POPULATE_MIN_BATCH 1000
+#define POPULATE_MAX_BATCH 100000
+
+// read lock wait time (seconds) considered as contention
+#define POPULATE_LOCK_CONTENTION 0.001
+
+// minimum number of nodes indexed by a single thread
+#define POPULATE_MIN_NODES_PER_THREAD 100000
+
+// max number of entries merged under a single read lock acquisition
+#define POPULATE_MERGE_BATCH 100000
+
+// adapt batch size to lock contention
+// a batch is halved if acquiring the read lock took long
+// indicating writers are waiting, otherwise the batch is doubled
+static uint64_t _AdaptBatchSize
+(
+	uint64_t batch_size,  // current batch size
+	double lock_wait      // time waited on read lock (seconds)
+) {
+	if(lock_wait > POPULATE_LOCK_CONTENTION) {
+		return MAX(batch_size / 2, POPULATE_MIN_BATCH);
+	}
+	return MIN(batch_size * 2, POPULATE_MAX_BATCH);
+}
+
+// acquire graph read lock
+// returns time waited on lock in seconds
+static double _AcquireReadLock
+(
+	Graph *g
+) {
+	double tic[2];
+	simple_tic(tic);
+	Graph_AcquireReadLock(g);
+	return simple_toc(tic);
+}
+
+// range of node IDs populated by a single thread
+typedef struct {
+	Index idx;          // index to populate
+	Graph *g;           // graph holding nodes to index
+	OrderedIndex *sub;  // private sub-index, NULL to populate idx directly
+	NodeID from;        // first node ID
+	NodeID to;          // last node ID (exclusive)
+	bool aborted;       // population aborted
+} _NodeRange;
+
 // index nodes in an asynchronous manner
 // nodes are being indexed in batchs while the graph's read lock is held
 // to avoid interfering with the DB ongoing operation after each batch of nodes
@@ -19,28 +70,31 @@
 // it is safe to run a write query which effects the index by either:
 // adding/removing/updating an entity while the index is being populated
 // in the "worst" case we will index that entity twice which is perfectly OK
-static void _Index_PopulateNodeIndex
+static void _Index_PopulateNodeRange
 (
-	Index idx,
-	Graph *g
+	void *arg,   // node ranges
+	uint64_t i   // range to populate
 ) {
-	ASSERT(g   != NULL);
-	ASSERT(idx != NULL);
+	_NodeRange *range = (_NodeRange *)arg + i;
 
-	GrB_Index          rowIdx     = 0;
-	int                indexed    = 0;      // #entities in current batch
-	int                batch_size = 10000;  // max #entities to index in one go
-	RG_MatrixTupleIter it         = {0};
+	Graph              *g          = range->g;
+	Index              idx         = range->idx;
+	GrB_Index          rowIdx      = range->from;
+	uint64_t           indexed     = 0;      // #entities in current batch
+	uint64_t           batch_size  = 10000;  // max #entities to index in one go
+	RG_MatrixTupleIter it          = {0};
 
-	while(true) {
+	while(rowIdx < range->to) {
 		// lock graph for reading
-		Graph_AcquireReadLock(g);
+		double lock_wait = _AcquireReadLock(g);
 
 		// index state changed, abort indexing
 		// this can happen if for example the following sequance is issued:
 		// 1. CREATE INDEX FOR (n:Person) ON (n.age)
 		// 2. CREATE INDEX FOR (n:Person) ON (n.height)
 		if(Index_PendingChanges(idx) > 1) {
+			range->aborted = true;
+			Graph_ReleaseLock(g);
 			break;
 		}
 
@@ -58,7 +112,7 @@ static void _Index_PopulateNodeIndex
 		GrB_Info info;
 		info = RG_MatrixTupleIter_attach(&it, m);
 		ASSERT(info == GrB_SUCCESS);
-		info = RG_MatrixTupleIter_iterate_range(&it, rowIdx, UINT64_MAX);
+		info = RG_MatrixTupleIter_iterate_range(&it, rowIdx, range->to - 1);
 		ASSERT(info == GrB_SUCCESS);
 
 		//----------------------------------------------------------------------
@@ -71,7 +125,11 @@ static void _Index_PopulateNodeIndex
 		{
 			Node n;
 			Graph_GetNode(g, id, &n);
-			Index_IndexNode(idx, &n);
+			if(range->sub != NULL) {
+				OrderedIndex_IndexEntity(range->sub, id, (GraphEntity *)&n);
+			} else {
+				Index_IndexNode(idx, &n);
+			}
 			indexed++;
 		}
 
@@ -79,25 +137,154 @@ static void _Index_PopulateNodeIndex
 		// done with current batch
 		//----------------------------------------------------------------------
 
-		if(indexed != batch_size) {
-			// iterator depleted, no more nodes to index
-			break;
-		} else {
-			// release read lock
+		// release read lock
+		Graph_ReleaseLock(g);
+		RG_MatrixTupleIter_detach(&it);
+
+		Index_PopulateAdvance(idx, indexed);
+
+		// iterator depleted, no more nodes to index
+		if(indexed != batch_size) break;
+
+		// continue next batch from row id+1
+		// this is true because we're iterating over a diagonal matrix
+		rowIdx = id + 1;
+		batch_size = _AdaptBatchSize(batch_size, lock_wait);
+	}
+}
+
+// merge sub-index into the index's ordered index
+// merging is done in batches under the graph's read lock
+// as the index's ordered index is replaced once the index is disabled
+// returns false if population was aborted
+static bool _Index_MergeSubIndex
+(
+	Index idx,
+	Graph *g,
+	OrderedIndex *sub
+) {
+	uint64_t merged;
+
+	do {
+		Graph_AcquireReadLock(g);
+
+		if(Index_PendingChanges(idx) > 1) {
 			Graph_ReleaseLock(g);
+			return false;
+		}
 
-			// finished current batch
-			RG_MatrixTupleIter_detach(&it);
+		merged = OrderedIndex_Merge(Index_OrderedIndex(idx), sub,
+				POPULATE_MERGE_BATCH);
+
+		Graph_ReleaseLock(g);
+	} while(merged > 0);
+
+	return true;
+}
 
-			// continue next batch from row id+1
-			// this is true because we're iterating over a diagonal matrix
-			rowIdx = id + 1;
+// index nodes
+// natively backed indices are populated on the readers thread-pool
+// the label's ID space is partitioned into ranges
+// each range builds a private sub-index, sub-indices are merged once done
+// RediSearch backed indices do not support concurrent updates
+// and are populated by a single thread
+static void _Index_PopulateNodeIndex
+(
+	Index idx,
+	Graph *g
+) {
+	ASSERT(g   != NULL);
+	ASSERT(idx != NULL);
+
+	//--------------------------------------------------------------------------
+	// estimate work and partition ID space
+	//--------------------------------------------------------------------------
+
+	Graph_AcquireReadLock(g);
+
+	if(Index_PendingChanges(idx) > 1) {
+		Graph_ReleaseLock(g);
+		return;
+	}
+
+	GrB_Index total;
+	const RG_Matrix m = Graph_GetLabelMatrix(g, Index_GetLabelID(idx));
+	RG_Matrix_nvals(&total, m);
+
+	NodeID   cap          = Graph_RequiredMatrixDim(g);
+	uint     thread_count = 1;
+	OrderedIndex *ordered = Index_OrderedIndex(idx);
+
+	if(ordered != NULL) {
+		// readers and the calling thread
+		thread_count = ThreadPools_ReadersCount() + 1;
+		thread_count = MIN(thread_count,
+				MAX(1, total / POPULATE_MIN_NODES_PER_THREAD));
+	}
+
+	uint field_count = Index_FieldsCount(idx);
+	const IndexField *fields = Index_GetFields(idx);
+	Attribute_ID attrs[field_count];
+	for(uint i = 0; i < field_count; i++) attrs[i] = fields[i].id;
+
+	// entities modified while sub-indices are built take precedence
+	// over their sub-indexed state
+	if(thread_count > 1) OrderedIndex_TrackModified(ordered, true);
+
+	Index_PopulateStart(idx, total);
+
+	Graph_ReleaseLock(g);
+
+	//--------------------------------------------------------------------------
+	// populate
+	//--------------------------------------------------------------------------
+
+	_NodeRange ranges[thread_count];
+
+	for(uint i = 0; i < thread_count; i++) {
+		ranges[i] = (_NodeRange) {
+			.idx     = idx,
+			.g       = g,
+			.sub     = NULL,
+			.from    = cap * i / thread_count,
+			.to      = cap * (i + 1) / thread_count,
+			.aborted = false
+		};
+
+		if(thread_count > 1) {
+			ranges[i].sub = OrderedIndex_New(attrs, field_count);
 		}
 	}
 
-	// release read lock
+	// nodes created during population are covered by the last range
+	ranges[thread_count - 1].to = UINT64_MAX;
+
+	// ranges are populated by the readers thread-pool
+	// the calling thread populates ranges as well
+	ThreadPools_ReadersParallelFor(_Index_PopulateNodeRange, ranges,
+			thread_count);
+
+	if(thread_count == 1) return;
+
+	//--------------------------------------------------------------------------
+	// merge sub-indices
+	//--------------------------------------------------------------------------
+
+	bool aborted = false;
+	for(uint i = 0; i < thread_count; i++) {
+		aborted |= ranges[i].aborted;
+	}
+
+	for(uint i = 0; i < thread_count; i++) {
+		if(!aborted) aborted = !_Index_MergeSubIndex(idx, g, ranges[i].sub);
+		OrderedIndex_Free(ranges[i].sub);
+	}
+
+	// stop tracking modifications
+	// an aborted index had its ordered index replaced
+	Graph_AcquireReadLock(g);
+	if(!aborted) OrderedIndex_TrackModified(Index_OrderedIndex(idx), false);
 	Graph_ReleaseLock(g);
-	RG_MatrixTupleIter_detach(&it);
 }
 
 // index edges in an asynchronous manner
@@ -123,13 +310,25 @@ static void _Index_PopulateEdgeIndex
 	EntityID  edge_id      = 0;     // current processed edge id
 	EntityID  prev_src_id  = 0;     // last processed row idx
 	EntityID  prev_dest_id = 0;     // last processed column idx
-	int       indexed      = 0;     // number of entities indexed in current batch
-	int       batch_size   = 1000;  // max number of entities to index in one go
+	uint64_t  indexed      = 0;     // number of entities indexed in current batch
+	uint64_t  batch_size   = 1000;  // max number of entities to index in one go
+	double    lock_wait    = 0;     // time waited on read lock
 	RG_MatrixTupleIter it  = {0};
 
+	//--------------------------------------------------------------------------
+	// estimate work
+	//--------------------------------------------------------------------------
+
+	Graph_AcquireReadLock(g);
+	GrB_Index total;
+	RG_Matrix_nvals(&total, Graph_GetRelationMatrix(g, Index_GetLabelID(idx),
+				false));
+	Index_PopulateStart(idx, total);
+	Graph_ReleaseLock(g);
+
 	while(true) {
 		// lock graph for reading
-		Graph_AcquireReadLock(g);
+		lock_wait = _AcquireReadLock(g);
 
 		// index state changed, abort indexing
 		// this can happen if for example the following sequance is issued:
@@ -201,6 +400,8 @@ static void _Index_PopulateEdgeIndex
 		// done with current batch
 		//----------------------------------------------------------------------
 
+		Index_PopulateAdvance(idx, indexed);
+
 		if(indexed != batch_size) {
 			// iterator depleted, no more edges to index
 			break;
@@ -209,6 +410,7 @@ static void _Index_PopulateEdgeIndex
 			// release read lock
 			Graph_ReleaseLock(g);
 			RG_MatrixTupleIter_detach(&it);
+			batch_size = _AdaptBatchSize(batch_size, lock_wait);
 		}
 	}
 
@@ -22,6 +22,14 @@ void Index_IndexNode
 	ASSERT(n    !=  NULL);
 	ASSERT(idx  !=  NULL);
 
+	// natively indexed, RediSearch document isn't required
+	OrderedIndex *ordered = Index_OrderedIndex(idx);
+	if(ordered != NULL) {
+		OrderedIndex_IndexEntity(ordered, ENTITY_GET_ID(n),
+				(const GraphEntity *)n);
+		return;
+	}
+
 	EntityID key             = ENTITY_GET_ID(n);
 	RSDoc    *doc            = NULL;
 	RSIndex  *rsIdx          = Index_RSIndex(idx);
@@ -55,6 +63,12 @@ void Index_RemoveNode
 	EntityID id     = ENTITY_GET_ID(n);
 	RSIndex  *rsIdx = Index_RSIndex(idx);
 
+	OrderedIndex *ordered = Index_OrderedIndex(idx);
+	if(ordered != NULL) {
+		OrderedIndex_RemoveEntity(ordered, id);
+		return;
+	}
+
 	RediSearch_DeleteDocument(rsIdx, &id, sizeof(EntityID));
 }
 
@@ -0,0 +1,1007 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rax.h"
+#include "ordered_index.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/point.h"
+
+#include <pthread.h>
+
+// value type tags, determine the order between types
+#define OI_TAG_BOOL     0x01
+#define OI_TAG_NUMERIC  0x02
+#define OI_TAG_STRING   0x03
+#define OI_TAG_POINT    0x04
+#define OI_TAG_OTHER    0xFE
+
+#define OI_ID_LEN sizeof(EntityID)
+
+// encoded entry, value followed by entity ID
+typedef struct {
+	uint32_t len;          // entry length
+	unsigned char data[];  // entry
+} OrderedIndexEntry;
+
+// indexed attribute
+typedef struct {
+	Attribute_ID attr;  // indexed attribute
+	rax *entries;       // encoded value followed by entity ID
+	rax *entities;      // entity ID -> entity's entry
+} OrderedIndexField;
+
+struct _OrderedIndex {
+	OrderedIndexField *fields;  // indexed attributes
+	uint64_t entity_count;      // number of indexed entities
+	uint64_t version;           // incremented on every modification
+	rax *modified;              // IDs of modified entities, NULL if untracked
+	pthread_rwlock_t rwlock;    // index population runs under the graph's
+	                            // read lock, concurrently with scans
+};
+
+struct _OrderedIndexIterator {
+	OrderedIndex *idx;          // scanned index
+	OrderedIndexField *field;   // scanned field, single range scan
+	OrderedIndexRange range;    // scanned range, single range scan
+	raxIterator it;             // field iterator, single range scan
+	uint64_t version;           // index version iterator positioned at
+	unsigned char *last;        // last produced entry, single range scan
+	size_t last_len;            // last produced entry length
+	EntityID *ids;              // materialized IDs, multi range scan
+	uint64_t pos;               // next ID to produce, multi range scan
+	bool started;               // iterator positioned
+	bool depleted;              // iterator depleted
+	bool reverse;               // descending value order, single range scan
+};
+
+//------------------------------------------------------------------------------
+// encoding
+//------------------------------------------------------------------------------
+
+// big-endian encoding preserves numeric order under byte comparison
+static inline void _EncodeUInt64
+(
+	uint64_t v,
+	unsigned char *buf
+) {
+	for(int i = 0; i < 8; i++) {
+		buf[i] = (unsigned char)(v >> (56 - 8 * i));
+	}
+}
+
+static inline uint64_t _DecodeUInt64
+(
+	const unsigned char *buf
+) {
+	uint64_t v = 0;
+	for(int i = 0; i < 8; i++) {
+		v = (v << 8) | buf[i];
+	}
+	return v;
+}
+
+// flip sign bit of positive values and all bits of negative values
+// such that doubles order as unsigned integers
+static inline void _EncodeDouble
+(
+	double d,
+	unsigned char *buf
+) {
+	if(d == 0) d = 0;  // normalize -0.0
+
+	uint64_t bits;
+	memcpy(&bits, &d, sizeof(bits));
+	bits = (bits & 0x8000000000000000ULL) ? ~bits
+		: (bits | 0x8000000000000000ULL);
+
+	_EncodeUInt64(bits, buf);
+}
+
+// returns length of `v`'s encoding
+static size_t _EncodedLength
+(
+	SIValue v
+) {
+	switch(SI_TYPE(v)) {
+		case T_BOOL:
+			return 2;
+		case T_INT64:
+		case T_DOUBLE:
+			return 1 + sizeof(double);
+		case T_STRING:
+			return 2 + strlen(v.stringval);
+		case T_POINT:
+			return 1 + 2 * sizeof(double);
+		default:
+			return 1;
+	}
+}
+
+// encode `v` into `buf`, buffer must accommodate _EncodedLength(v) bytes
+static void _EncodeValue
+(
+	SIValue v,
+	unsigned char *buf
+) {
+	switch(SI_TYPE(v)) {
+		case T_BOOL:
+			buf[0] = OI_TAG_BOOL;
+			buf[1] = v.longval ? 1 : 0;
+			break;
+		case T_INT64:
+		case T_DOUBLE:
+			buf[0] = OI_TAG_NUMERIC;
+			_EncodeDouble(SI_GET_NUMERIC(v), buf + 1);
+			break;
+		case T_STRING:
+		{
+			size_t len = strlen(v.stringval);
+			buf[0] = OI_TAG_STRING;
+			memcpy(buf + 1, v.stringval, len);
+			buf[len + 1] = 0;  // strings never contain \0, prefix free
+			break;
+		}
+		case T_POINT:
+			buf[0] = OI_TAG_POINT;
+			_EncodeDouble(Point_lat(v), buf + 1);
+			_EncodeDouble(Point_lon(v), buf + 1 + sizeof(double));
+			break;
+		default:
+			// none indexable type
+			buf[0] = OI_TAG_OTHER;
+			break;
+	}
+}
+
+// encode `v` followed by entity `id` into a newly allocated entry
+static OrderedIndexEntry *_EncodeEntry
+(
+	SIValue v,
+	EntityID id
+) {
+	size_t len = _EncodedLength(v);
+	OrderedIndexEntry *entry = rm_malloc(sizeof(OrderedIndexEntry) + len +
+			OI_ID_LEN);
+
+	_EncodeValue(v, entry->data);
+	_EncodeUInt64(id, entry->data + len);
+	entry->len = len + OI_ID_LEN;
+
+	return entry;
+}
+
+// compare two byte strings, a proper prefix precedes its extensions
+static int _CompareKeys
+(
+	const unsigned char *a,
+	size_t a_len,
+	const unsigned char *b,
+	size_t b_len
+) {
+	int res = memcmp(a, b, MIN(a_len, b_len));
+	if(res != 0) return res;
+	return (a_len > b_len) - (a_len < b_len);
+}
+
+//------------------------------------------------------------------------------
+// ranges
+//------------------------------------------------------------------------------
+
+static unsigned char *_EncodeBound
+(
+	SIValue v,
+	size_t *len
+) {
+	*len = _EncodedLength(v);
+	unsigned char *buf = rm_malloc(*len);
+	_EncodeValue(v, buf);
+	return buf;
+}
+
+static unsigned char *_TagBound
+(
+	unsigned char tag,
+	size_t *len
+) {
+	*len = 1;
+	unsigned char *buf = rm_malloc(1);
+	buf[0] = tag;
+	return buf;
+}
+
+OrderedIndexRange OrderedIndexRange_New
+(
+	Attribute_ID attr,
+	const SIValue *min,
+	bool include_min,
+	const SIValue *max,
+	bool include_max
+) {
+	ASSERT(min != NULL || max != NULL);
+
+	OrderedIndexRange range = {.attr = attr, .include_min = include_min,
+		.include_max = include_max};
+
+	if(min != NULL) {
+		range.min = _EncodeBound(*min, &range.min_len);
+	}
+	if(max != NULL) {
+		range.max = _EncodeBound(*max, &range.max_len);
+	}
+
+	// unbounded ends are limited to the type of the bounded end
+	if(min == NULL) {
+		range.min         = _TagBound(range.max[0], &range.min_len);
+		range.include_min = true;
+	}
+	if(max == NULL) {
+		range.max         = _TagBound(range.min[0] + 1, &range.max_len);
+		range.include_max = false;
+	}
+
+	return range;
+}
+
+OrderedIndexRange OrderedIndexRange_Point
+(
+	Attribute_ID attr,
+	SIValue v
+) {
+	return OrderedIndexRange_New(attr, &v, true, &v, true);
+}
+
+OrderedIndexRange OrderedIndexRange_Latitude
+(
+	Attribute_ID attr,
+	double min_lat,
+	double max_lat
+) {
+	OrderedIndexRange range = {.attr = attr, .include_min = true,
+		.include_max = true};
+
+	// points are encoded latitude first
+	range.min_len = 1 + sizeof(double);
+	range.min     = rm_malloc(range.min_len);
+	range.min[0]  = OI_TAG_POINT;
+	_EncodeDouble(min_lat, range.min + 1);
+
+	// maximal latitude with any longitude
+	range.max_len = 1 + 2 * sizeof(double);
+	range.max     = rm_malloc(range.max_len);
+	range.max[0]  = OI_TAG_POINT;
+	_EncodeDouble(max_lat, range.max + 1);
+	memset(range.max + 1 + sizeof(double), 0xFF, sizeof(double));
+
+	return range;
+}
+
+OrderedIndexRange OrderedIndexRange_NoneIndexable
+(
+	Attribute_ID attr
+) {
+	OrderedIndexRange range = {.attr = attr, .include_min = true,
+		.include_max = false};
+
+	range.min = _TagBound(OI_TAG_OTHER, &range.min_len);
+	range.max = _TagBound(OI_TAG_OTHER + 1, &range.max_len);
+
+	return range;
+}
+
+OrderedIndexRange OrderedIndexRange_All
+(
+	Attribute_ID attr
+) {
+	OrderedIndexRange range = {.attr = attr, .include_min = true,
+		.include_max = true};
+
+	range.min = _TagBound(0x00, &range.min_len);
+	range.max = _TagBound(0xFF, &range.max_len);
+
+	return range;
+}
+
+bool OrderedIndexRange_IsPoint
+(
+	const OrderedIndexRange *range
+) {
+	ASSERT(range != NULL);
+
+	return range->include_min && range->include_max &&
+		_CompareKeys(range->min, range->min_len, range->max,
+				range->max_len) == 0;
+}
+
+bool OrderedIndexRange_IsOpen
+(
+	const OrderedIndexRange *range
+) {
+	ASSERT(range != NULL);
+
+	// unbounded ends are represented by a type tag
+	return range->min_len == 1 || range->max_len == 1;
+}
+
+bool OrderedIndexRange_Ordered
+(
+	const OrderedIndexRange *range
+) {
+	ASSERT(range != NULL);
+
+	unsigned char tag = range->min[0];
+	if(tag != OI_TAG_BOOL && tag != OI_TAG_NUMERIC && tag != OI_TAG_STRING) {
+		return false;
+	}
+
+	// an unbounded upper end is the tag following the lower bound's type
+	if(range->max_len == 1 && range->max[0] == tag + 1) {
+		return !range->include_max;
+	}
+
+	return range->max[0] == tag;
+}
+
+bool OrderedIndexRange_Intersect
+(
+	OrderedIndexRange *a,
+	const OrderedIndexRange *b
+) {
+	ASSERT(a != NULL);
+	ASSERT(b != NULL);
+	ASSERT(a->attr == b->attr);
+
+	// tighten lower bound
+	int cmp = _CompareKeys(a->min, a->min_len, b->min, b->min_len);
+	if(cmp < 0 || (cmp == 0 && !b->include_min)) {
+		rm_free(a->min);
+		a->min         = rm_malloc(b->min_len);
+		a->min_len     = b->min_len;
+		a->include_min = b->include_min;
+		memcpy(a->min, b->min, b->min_len);
+	}
+
+	// tighten upper bound
+	cmp = _CompareKeys(a->max, a->max_len, b->max, b->max_len);
+	if(cmp > 0 || (cmp == 0 && !b->include_max)) {
+		rm_free(a->max);
+		a->max         = rm_malloc(b->max_len);
+		a->max_len     = b->max_len;
+		a->include_max = b->include_max;
+		memcpy(a->max, b->max, b->max_len);
+	}
+
+	cmp = _CompareKeys(a->min, a->min_len, a->max, a->max_len);
+	return (cmp < 0 || (cmp == 0 && a->include_min && a->include_max));
+}
+
+OrderedIndexRange OrderedIndexRange_Clone
+(
+	const OrderedIndexRange *range
+) {
+	ASSERT(range != NULL);
+
+	OrderedIndexRange clone = *range;
+
+	clone.min = rm_malloc(range->min_len);
+	clone.max = rm_malloc(range->max_len);
+	memcpy(clone.min, range->min, range->min_len);
+	memcpy(clone.max, range->max, range->max_len);
+
+	return clone;
+}
+
+void OrderedIndexRange_Free
+(
+	OrderedIndexRange *range
+) {
+	ASSERT(range != NULL);
+
+	rm_free(range->min);
+	rm_free(range->max);
+	range->min = NULL;
+	range->max = NULL;
+}
+
+//------------------------------------------------------------------------------
+// index
+//------------------------------------------------------------------------------
+
+static OrderedIndexField *_GetField
+(
+	const OrderedIndex *idx,
+	Attribute_ID attr
+) {
+	uint n = array_len(idx->fields);
+	for(uint i = 0; i < n; i++) {
+		if(idx->fields[i].attr == attr) return idx->fields + i;
+	}
+	return NULL;
+}
+
+// remove entity from field, returns true if entity was indexed
+static bool _Field_Remove
+(
+	OrderedIndexField *field,
+	const unsigned char *id_key
+) {
+	OrderedIndexEntry *entry = NULL;
+	if(!raxRemove(field->entities, (unsigned char *)id_key, OI_ID_LEN,
+				(void **)&entry)) {
+		return false;
+	}
+
+	raxRemove(field->entries, entry->data, entry->len, NULL);
+	rm_free(entry);
+
+	return true;
+}
+
+OrderedIndex *OrderedIndex_New
+(
+	const Attribute_ID *attrs,
+	uint n
+) {
+	ASSERT(attrs != NULL || n == 0);
+
+	OrderedIndex *idx = rm_calloc(1, sizeof(OrderedIndex));
+
+	idx->fields = array_new(OrderedIndexField, n);
+	for(uint i = 0; i < n; i++) {
+		OrderedIndexField field = {.attr = attrs[i], .entries = raxNew(),
+			.entities = raxNew()};
+		array_append(idx->fields, field);
+	}
+
+	int res = pthread_rwlock_init(&idx->rwlock, NULL);
+	ASSERT(res == 0);
+	UNUSED(res);
+
+	return idx;
+}
+
+uint OrderedIndex_IndexEntity
+(
+	OrderedIndex *idx,
+	EntityID id,
+	const GraphEntity *e
+) {
+	ASSERT(e   != NULL);
+	ASSERT(idx != NULL);
+
+	uint indexed = 0;
+	bool existed = false;
+	unsigned char id_key[OI_ID_LEN];
+	_EncodeUInt64(id, id_key);
+
+	pthread_rwlock_wrlock(&idx->rwlock);
+
+	uint n = array_len(idx->fields);
+	for(uint i = 0; i < n; i++) {
+		OrderedIndexField *field = idx->fields + i;
+
+		// drop previously indexed value
+		existed |= _Field_Remove(field, id_key);
+
+		SIValue *v = GraphEntity_GetProperty(e, field->attr);
+		if(v == ATTRIBUTE_NOTFOUND) continue;
+
+		OrderedIndexEntry *entry = _EncodeEntry(*v, id);
+		raxInsert(field->entries, entry->data, entry->len, NULL, NULL);
+		raxInsert(field->entities, id_key, OI_ID_LEN, entry, NULL);
+		indexed++;
+	}
+
+	if(existed && indexed == 0)  idx->entity_count--;
+	if(!existed && indexed > 0)  idx->entity_count++;
+
+	if(idx->modified != NULL) {
+		raxInsert(idx->modified, id_key, OI_ID_LEN, NULL, NULL);
+	}
+
+	idx->version++;
+
+	pthread_rwlock_unlock(&idx->rwlock);
+
+	return indexed;
+}
+
+void OrderedIndex_RemoveEntity
+(
+	OrderedIndex *idx,
+	EntityID id
+) {
+	ASSERT(idx != NULL);
+
+	bool existed = false;
+	unsigned char id_key[OI_ID_LEN];
+	_EncodeUInt64(id, id_key);
+
+	pthread_rwlock_wrlock(&idx->rwlock);
+
+	uint n = array_len(idx->fields);
+	for(uint i = 0; i < n; i++) {
+		existed |= _Field_Remove(idx->fields + i, id_key);
+	}
+
+	if(existed) {
+		idx->entity_count--;
+		idx->version++;
+	}
+
+	if(idx->modified != NULL) {
+		raxInsert(idx->modified, id_key, OI_ID_LEN, NULL, NULL);
+	}
+
+	pthread_rwlock_unlock(&idx->rwlock);
+}
+
+bool OrderedIndex_Contains
+(
+	OrderedIndex *idx,
+	Attribute_ID attr,
+	SIValue v,
+	EntityID id
+) {
+	ASSERT(idx != NULL);
+
+	bool found = false;
+	OrderedIndexEntry *entry = _EncodeEntry(v, id);
+
+	pthread_rwlock_rdlock(&idx->rwlock);
+
+	OrderedIndexField *field = _GetField(idx, attr);
+	if(field != NULL) {
+		found = raxFind(field->entries, entry->data, entry->len) != raxNotFound;
+	}
+
+	pthread_rwlock_unlock(&idx->rwlock);
+
+	rm_free(entry);
+	return found;
+}
+
+uint64_t OrderedIndex_EntityCount
+(
+	OrderedIndex *idx
+) {
+	ASSERT(idx != NULL);
+
+	pthread_rwlock_rdlock(&idx->rwlock);
+	uint64_t count = idx->entity_count;
+	pthread_rwlock_unlock(&idx->rwlock);
+
+	return count;
+}
+
+void OrderedIndex_TrackModified
+(
+	OrderedIndex *idx,
+	bool track
+) {
+	ASSERT(idx != NULL);
+
+	pthread_rwlock_wrlock(&idx->rwlock);
+
+	if(track && idx->modified == NULL) {
+		idx->modified = raxNew();
+	} else if(!track && idx->modified != NULL) {
+		raxFree(idx->modified);
+		idx->modified = NULL;
+	}
+
+	pthread_rwlock_unlock(&idx->rwlock);
+}
+
+// returns true if entity is indexed under any of the index's fields
+static bool _Contains
+(
+	const OrderedIndex *idx,
+	const unsigned char *id_key
+) {
+	uint n = array_len(idx->fields);
+	for(uint i = 0; i < n; i++) {
+		if(raxFind(idx->fields[i].entities, (unsigned char *)id_key,
+					OI_ID_LEN) != raxNotFound) {
+			return true;
+		}
+	}
+	return false;
+}
+
+uint64_t OrderedIndex_Merge
+(
+	OrderedIndex *dest,
+	OrderedIndex *src,
+	uint64_t n
+) {
+	ASSERT(src  != NULL);
+	ASSERT(dest != NULL);
+	ASSERT(array_len(src->fields) == array_len(dest->fields));
+
+	uint64_t moved = 0;
+	raxIterator it;
+
+	pthread_rwlock_wrlock(&dest->rwlock);
+
+	uint field_count = array_len(src->fields);
+	for(uint i = 0; i < field_count && moved < n; i++) {
+		OrderedIndexField *from = src->fields + i;
+		OrderedIndexField *to   = _GetField(dest, from->attr);
+		ASSERT(to != NULL);
+
+		raxStart(&it, from->entities);
+
+		// entries are removed from src as they're moved
+		// iterator is re-positioned after each removal
+		while(moved < n && raxSeek(&it, "^", NULL, 0) && raxNext(&it)) {
+			unsigned char id_key[OI_ID_LEN];
+			memcpy(id_key, it.key, OI_ID_LEN);
+			OrderedIndexEntry *entry = it.data;
+
+			raxRemove(from->entities, id_key, OI_ID_LEN, NULL);
+			raxRemove(from->entries, entry->data, entry->len, NULL);
+			if(!_Contains(src, id_key)) src->entity_count--;
+			moved++;
+
+			// dest is authoritative for entities modified since tracking began
+			bool modified = dest->modified != NULL &&
+				raxFind(dest->modified, id_key, OI_ID_LEN) != raxNotFound;
+			if(modified || raxFind(to->entities, id_key, OI_ID_LEN) !=
+					raxNotFound) {
+				rm_free(entry);
+				continue;
+			}
+
+			if(!_Contains(dest, id_key)) dest->entity_count++;
+
+			raxInsert(to->entries, entry->data, entry->len, NULL, NULL);
+			raxInsert(to->entities, id_key, OI_ID_LEN, entry, NULL);
+		}
+
+		raxStop(&it);
+	}
+
+	if(moved > 0) {
+		src->version++;
+		dest->version++;
+	}
+
+	pthread_rwlock_unlock(&dest->rwlock);
+
+	return moved;
+}
+
+void OrderedIndex_Free
+(
+	OrderedIndex *idx
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->modified != NULL) raxFree(idx->modified);
+
+	uint n = array_len(idx->fields);
+	for(uint i = 0; i < n; i++) {
+		OrderedIndexField *field = idx->fields + i;
+		raxFree(field->entries);
+		raxFreeWithCallback(field->entities, rm_free);
+	}
+	array_free(idx->fields);
+
+	pthread_rwlock_destroy(&idx->rwlock);
+	rm_free(idx);
+}
+
+//------------------------------------------------------------------------------
+// iterator
+//------------------------------------------------------------------------------
+
+// position reverse field iterator at range's last entry
+// or before the last produced entry when resuming
+static void _Iterator_SeekReverse
+(
+	OrderedIndexIterator *it
+) {
+	if(it->started) {
+		raxSeek(&it->it, "<", it->last, it->last_len);
+		return;
+	}
+
+	const OrderedIndexRange *range = &it->range;
+	if(range->include_max) {
+		// include all entries holding the upper bound value
+		unsigned char key[range->max_len + OI_ID_LEN];
+		memcpy(key, range->max, range->max_len);
+		memset(key + range->max_len, 0xFF, OI_ID_LEN);
+		raxSeek(&it->it, "<=", key, sizeof(key));
+	} else {
+		raxSeek(&it->it, "<", range->max, range->max_len);
+	}
+}
+
+// position field iterator at range's first entry, or past the last produced
+// entry when resuming after the index was modified
+static void _Iterator_Seek
+(
+	OrderedIndexIterator *it
+) {
+	if(it->reverse) {
+		_Iterator_SeekReverse(it);
+		return;
+	}
+
+	if(it->started) {
+		raxSeek(&it->it, ">", it->last, it->last_len);
+		return;
+	}
+
+	const OrderedIndexRange *range = &it->range;
+	if(range->include_min) {
+		raxSeek(&it->it, ">=", range->min, range->min_len);
+	} else {
+		// skip all entries holding the lower bound value
+		unsigned char key[range->min_len + OI_ID_LEN];
+		memcpy(key, range->min, range->min_len);
+		memset(key + range->min_len, 0xFF, OI_ID_LEN);
+		raxSeek(&it->it, ">", key, sizeof(key));
+	}
+}
+
+// returns true if entry lies beyond range's upper bound
+static bool _Iterator_PastMax
+(
+	const OrderedIndexRange *range,
+	const unsigned char *key,
+	size_t key_len
+) {
+	// entries are composed of a value followed by an ID
+	// compare value part only
+	int cmp = _CompareKeys(key, key_len - OI_ID_LEN, range->max, range->max_len);
+	return range->include_max ? cmp > 0 : cmp >= 0;
+}
+
+// returns true if entry lies below range's lower bound
+static bool _Iterator_PastMin
+(
+	const OrderedIndexRange *range,
+	const unsigned char *key,
+	size_t key_len
+) {
+	int cmp = _CompareKeys(key, key_len - OI_ID_LEN, range->min, range->min_len);
+	return range->include_min ? cmp < 0 : cmp <= 0;
+}
+
+// advance field iterator, returns false once past the range
+static bool _Iterator_Step
+(
+	OrderedIndexIterator *it
+) {
+	if(it->reverse) {
+		return raxPrev(&it->it) &&
+			!_Iterator_PastMin(&it->range, it->it.key, it->it.key_len);
+	}
+
+	return raxNext(&it->it) &&
+		!_Iterator_PastMax(&it->range, it->it.key, it->it.key_len);
+}
+
+static int _CompareIDs
+(
+	const void *a,
+	const void *b
+) {
+	EntityID x = *(const EntityID *)a;
+	EntityID y = *(const EntityID *)b;
+	return (x > y) - (x < y);
+}
+
+// collect IDs of all entities within range
+static void _CollectRange
+(
+	OrderedIndexField *field,
+	const OrderedIndexRange *range,
+	EntityID **ids
+) {
+	OrderedIndexIterator it = {.range = *range};
+	raxStart(&it.it, field->entries);
+
+	_Iterator_Seek(&it);
+	while(raxNext(&it.it)) {
+		if(_Iterator_PastMax(range, it.it.key, it.it.key_len)) break;
+		EntityID id = _DecodeUInt64(it.it.key + it.it.key_len - OI_ID_LEN);
+		array_append(*ids, id);
+	}
+
+	raxStop(&it.it);
+}
+
+OrderedIndexIterator *OrderedIndex_Scan
+(
+	OrderedIndex *idx,
+	const OrderedIndexRange *ranges,
+	uint n
+) {
+	ASSERT(idx != NULL);
+	ASSERT(ranges != NULL || n == 0);
+
+	OrderedIndexIterator *it = rm_calloc(1, sizeof(OrderedIndexIterator));
+	it->idx = idx;
+
+	//--------------------------------------------------------------------------
+	// single range, stream entries in value order
+	//--------------------------------------------------------------------------
+
+	if(n == 1) {
+		it->field = _GetField(idx, ranges[0].attr);
+		it->range = OrderedIndexRange_Clone(ranges);
+		it->depleted = (it->field == NULL);
+		if(it->field != NULL) raxStart(&it->it, it->field->entries);
+		return it;
+	}
+
+	//--------------------------------------------------------------------------
+	// multiple ranges, materialize and deduplicate
+	//--------------------------------------------------------------------------
+
+	it->ids = array_new(EntityID, 0);
+
+	pthread_rwlock_rdlock(&idx->rwlock);
+
+	for(uint i = 0; i < n; i++) {
+		OrderedIndexField *field = _GetField(idx, ranges[i].attr);
+		if(field != NULL) _CollectRange(field, ranges + i, &it->ids);
+	}
+
+	pthread_rwlock_unlock(&idx->rwlock);
+
+	// an entity might fall within multiple ranges
+	uint count = array_len(it->ids);
+	if(count > 1) {
+		qsort(it->ids, count, sizeof(EntityID), _CompareIDs);
+		uint j = 0;
+		for(uint i = 1; i < count; i++) {
+			if(it->ids[i] != it->ids[j]) it->ids[++j] = it->ids[i];
+		}
+		it->ids = array_trimm_len(it->ids, j + 1);
+	}
+
+	return it;
+}
+
+OrderedIndexIterator *OrderedIndex_ScanReverse
+(
+	OrderedIndex *idx,
+	const OrderedIndexRange *range
+) {
+	ASSERT(idx   != NULL);
+	ASSERT(range != NULL);
+
+	OrderedIndexIterator *it = OrderedIndex_Scan(idx, range, 1);
+	it->reverse = true;
+
+	return it;
+}
+
+// orders probed ranges by attribute and lower bound
+static int _CompareRanges
+(
+	const void *a,
+	const void *b
+) {
+	const OrderedIndexRange *x = *(const OrderedIndexRange **)a;
+	const OrderedIndexRange *y = *(const OrderedIndexRange **)b;
+
+	if(x->attr != y->attr) return (x->attr > y->attr) - (x->attr < y->attr);
+	return _CompareKeys(x->min, x->min_len, y->min, y->min_len);
+}
+
+void OrderedIndex_Probe
+(
+	OrderedIndex *idx,
+	const OrderedIndexRange *ranges,
+	uint n,
+	EntityID **matches
+) {
+	ASSERT(idx     != NULL);
+	ASSERT(matches != NULL);
+	ASSERT(ranges  != NULL || n == 0);
+
+	if(n == 0) return;
+
+	// visit ranges in key order, consecutive seeks touch nearby nodes
+	const OrderedIndexRange **order = rm_malloc(sizeof(OrderedIndexRange *) * n);
+	for(uint i = 0; i < n; i++) order[i] = ranges + i;
+	qsort(order, n, sizeof(OrderedIndexRange *), _CompareRanges);
+
+	pthread_rwlock_rdlock(&idx->rwlock);
+
+	OrderedIndexField *field = NULL;
+	for(uint i = 0; i < n; i++) {
+		const OrderedIndexRange *range = order[i];
+		uint j = range - ranges;
+
+		matches[j] = array_new(EntityID, 1);
+
+		if(field == NULL || field->attr != range->attr) {
+			field = _GetField(idx, range->attr);
+			if(field == NULL) continue;
+		}
+
+		_CollectRange(field, range, matches + j);
+	}
+
+	pthread_rwlock_unlock(&idx->rwlock);
+
+	rm_free(order);
+}
+
+bool OrderedIndexIterator_Next
+(
+	OrderedIndexIterator *it,
+	EntityID *id
+) {
+	ASSERT(it != NULL);
+	ASSERT(id != NULL);
+
+	if(it->depleted) return false;
+
+	// materialized scan
+	if(it->ids != NULL) {
+		if(it->pos == array_len(it->ids)) {
+			it->depleted = true;
+			return false;
+		}
+		*id = it->ids[it->pos++];
+		return true;
+	}
+
+	OrderedIndex *idx = it->idx;
+	pthread_rwlock_rdlock(&idx->rwlock);
+
+	// (re)position iterator, modifications invalidate the field iterator
+	if(!it->started || it->version != idx->version) {
+		_Iterator_Seek(it);
+		it->version = idx->version;
+		it->started = true;
+	}
+
+	if(!_Iterator_Step(it)) {
+		it->depleted = true;
+		pthread_rwlock_unlock(&idx->rwlock);
+		return false;
+	}
+
+	// remember entry, resuming point in case the index is modified
+	if(it->last_len < it->it.key_len) {
+		it->last = rm_realloc(it->last, it->it.key_len);
+	}
+	it->last_len = it->it.key_len;
+	memcpy(it->last, it->it.key, it->last_len);
+
+	pthread_rwlock_unlock(&idx->rwlock);
+
+	*id = _DecodeUInt64(it->last + it->last_len - OI_ID_LEN);
+	return true;
+}
+
+void OrderedIndexIterator_Free
+(
+	OrderedIndexIterator *it
+) {
+	ASSERT(it != NULL);
+
+	if(it->ids != NULL) {
+		array_free(it->ids);
+	} else {
+		if(it->field != NULL) raxStop(&it->it);
+		OrderedIndexRange_Free(&it->range);
+	}
+
+	if(it->last != NULL) rm_free(it->last);
+	rm_free(it);
+}
+
@@ -0,0 +1,238 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+#include "../graph/entities/graph_entity.h"
+
+// native in-memory ordered index
+//
+// maps attribute values directly to entity IDs
+// each indexed attribute is backed by a radix tree keyed by the attribute's
+// order preserving encoded value followed by the entity ID
+// supporting point lookups, range scans and ordered iteration
+//
+// value encoding, types are ordered: boolean < numeric < string < point
+// numerics are encoded as doubles, e.g. 1 and 1.0 share the same key
+// values of none indexable types e.g. arrays are grouped under a single key
+// such that entities holding them can be located
+//
+// scans may return a superset of the entities matching a filter
+// e.g. integers exceeding 2^53 or points within a latitude band
+// callers are expected to re-evaluate their filter
+
+// forward declarations
+typedef struct _OrderedIndex OrderedIndex;
+typedef struct _OrderedIndexIterator OrderedIndexIterator;
+
+// range of encoded values within a single attribute
+typedef struct {
+	Attribute_ID attr;   // scanned attribute
+	unsigned char *min;  // encoded lower bound
+	size_t min_len;      // lower bound length
+	unsigned char *max;  // encoded upper bound
+	size_t max_len;      // upper bound length
+	bool include_min;    // lower bound inclusive
+	bool include_max;    // upper bound inclusive
+} OrderedIndexRange;
+
+//------------------------------------------------------------------------------
+// ranges
+//------------------------------------------------------------------------------
+
+// create a range over values of a single type
+// a NULL bound is unbounded within the type of the other bound
+// at least one bound must be specified
+OrderedIndexRange OrderedIndexRange_New
+(
+	Attribute_ID attr,   // attribute
+	const SIValue *min,  // [optional] lower bound
+	bool include_min,    // lower bound inclusive
+	const SIValue *max,  // [optional] upper bound
+	bool include_max     // upper bound inclusive
+);
+
+// create a range matching a single value
+OrderedIndexRange OrderedIndexRange_Point
+(
+	Attribute_ID attr,  // attribute
+	SIValue v           // value
+);
+
+// create a range matching all points within a latitude band
+OrderedIndexRange OrderedIndexRange_Latitude
+(
+	Attribute_ID attr,  // attribute
+	double min_lat,     // minimum latitude
+	double max_lat      // maximum latitude
+);
+
+// create a range matching all values of none indexable types
+OrderedIndexRange OrderedIndexRange_NoneIndexable
+(
+	Attribute_ID attr  // attribute
+);
+
+// create a range matching all values
+OrderedIndexRange OrderedIndexRange_All
+(
+	Attribute_ID attr  // attribute
+);
+
+// returns true if range matches a single value
+bool OrderedIndexRange_IsPoint
+(
+	const OrderedIndexRange *range  // range to inspect
+);
+
+// returns true if range is unbounded on either end
+bool OrderedIndexRange_IsOpen
+(
+	const OrderedIndexRange *range  // range to inspect
+);
+
+// returns true if range spans booleans, numerics or strings only
+// in which case scan order agrees with value comparison
+bool OrderedIndexRange_Ordered
+(
+	const OrderedIndexRange *range  // range to inspect
+);
+
+// intersect range `a` with range `b`
+// both ranges must cover the same attribute
+// returns false if the intersection is empty
+bool OrderedIndexRange_Intersect
+(
+	OrderedIndexRange *a,       // [input/output] range to tighten
+	const OrderedIndexRange *b  // range to intersect with
+);
+
+// clone range
+OrderedIndexRange OrderedIndexRange_Clone
+(
+	const OrderedIndexRange *range  // range to clone
+);
+
+// free range
+void OrderedIndexRange_Free
+(
+	OrderedIndexRange *range  // range to free
+);
+
+//------------------------------------------------------------------------------
+// index
+//------------------------------------------------------------------------------
+
+// create a new ordered index over the specified attributes
+OrderedIndex *OrderedIndex_New
+(
+	const Attribute_ID *attrs,  // indexed attributes
+	uint n                      // number of attributes
+);
+
+// index entity, replacing any previously indexed values
+// returns number of indexed attributes the entity possess
+uint OrderedIndex_IndexEntity
+(
+	OrderedIndex *idx,    // index to update
+	EntityID id,          // entity ID
+	const GraphEntity *e  // entity to index
+);
+
+// remove entity from index
+void OrderedIndex_RemoveEntity
+(
+	OrderedIndex *idx,  // index to update
+	EntityID id         // entity to remove
+);
+
+// returns true if entity `id` is indexed under `attr` with value `v`
+bool OrderedIndex_Contains
+(
+	OrderedIndex *idx,  // index to query
+	Attribute_ID attr,  // attribute
+	SIValue v,          // value
+	EntityID id         // entity ID
+);
+
+// returns number of indexed entities
+uint64_t OrderedIndex_EntityCount
+(
+	OrderedIndex *idx  // index to query
+);
+
+// scan index
+// entities are produced in value order when a single range is scanned
+// otherwise in ascending ID order, each entity is produced once
+OrderedIndexIterator *OrderedIndex_Scan
+(
+	OrderedIndex *idx,               // index to scan
+	const OrderedIndexRange *ranges, // ranges to scan
+	uint n                           // number of ranges
+);
+
+// scan a single range in descending value order
+OrderedIndexIterator *OrderedIndex_ScanReverse
+(
+	OrderedIndex *idx,               // index to scan
+	const OrderedIndexRange *range   // range to scan
+);
+
+// probe index with multiple ranges under a single lock acquisition
+// ranges are visited in key order
+// `matches[i]` is set to an array holding the IDs within `ranges[i]`
+// caller is responsible for freeing each array
+void OrderedIndex_Probe
+(
+	OrderedIndex *idx,                // index to probe
+	const OrderedIndexRange *ranges,  // ranges to probe
+	uint n,                           // number of ranges
+	EntityID **matches                // [output] IDs per range
+);
+
+// start or stop tracking modified entities
+// while tracked, merged entities never override modified ones
+void OrderedIndex_TrackModified
+(
+	OrderedIndex *idx,  // index to update
+	bool track          // track modifications
+);
+
+// move up to `n` entities from `src` into `dest`
+// entities already indexed or modified in `dest` are discarded
+// returns number of entries consumed from `src`, 0 once `src` is empty
+uint64_t OrderedIndex_Merge
+(
+	OrderedIndex *dest,  // index to merge into
+	OrderedIndex *src,   // index to merge from, over the same attributes
+	uint64_t n           // max number of entries to consume
+);
+
+// free index
+void OrderedIndex_Free
+(
+	OrderedIndex *idx  // index to free
+);
+
+//------------------------------------------------------------------------------
+// iterator
+//------------------------------------------------------------------------------
+
+// advance iterator
+// returns false once depleted
+bool OrderedIndexIterator_Next
+(
+	OrderedIndexIterator *it,  // iterator
+	EntityID *id               // [output] entity ID
+);
+
+// free iterator
+void OrderedIndexIterator_Free
+(
+	OrderedIndexIterator *it  // iterator to free
+);
+
@@ -425,8 +425,16 @@ static void RG_ForkPrepare() {
 	// modified, otherwise the child process might inherit a malformed matrix
 	//
 	// on BGSAVE: acquire read lock
-	// flush all matrices such that child won't inherit locked matrix
-	// release read lock immediately once forked
+	// lock all matrices, waiting for readers synchronizing a matrix
+	// a background flush merging a matrix doesn't hold its lock
+	// and only reads the matrix, the fork doesn't wait on it
+	// release locks immediately once forked
+	//
+	// pending matrix changes are not flushed, doing so stalls Redis main thread
+	// the child iterates over matrices merging their deltas on the fly
+	// and the decoder rebuilds fully synced matrices
+	// pending GraphBLAS work is completed here, such that the child
+	// never assembles a matrix, which might spawn OpenMP threads
 	//
 	// in the case of RediSearch GC fork, quickly return
 
@@ -447,9 +455,11 @@ static void RG_ForkPrepare() {
 		// set matrix synchronization policy to default
 		Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
 
-		// synchronize all matrices, make sure they're in a consistent state
-		// do not force-flush as this can take awhile
-		Graph_ApplyAllPending(g, false);
+		// make sure no matrix is mid-synchronization when forking
+		Graph_LockMatrices(g);
+
+		// finish pending GraphBLAS work without merging deltas
+		Graph_WaitMatrices(g);
 
 		GraphContext_DecreaseRefCount(gc);
 	}
@@ -469,6 +479,7 @@ static void RG_AfterForkParent() {
 	Globals_ScanGraphs(&it);
 
 	while((gc = GraphIterator_Next(&it)) != NULL) {
+		Graph_UnlockMatrices(gc->g);
 		Graph_ReleaseLock(gc->g);
 		GraphContext_DecreaseRefCount(gc);
 	}
@@ -490,7 +501,9 @@ static void RG_AfterForkChild() {
 	uint32_t n = array_len(graphs);
 	for(uint32_t i = 0; i < n; i++) {
 		Graph *g = graphs[i]->g;
-		// all matrices should be synced, set synchronization policy to NOP
+		// matrices may hold pending changes, which are merged on the fly
+		// while iterating, matrix locks inherited from the parent are never
+		// acquired under the NOP synchronization policy
 		Graph_SetMatrixPolicy(g, SYNC_POLICY_NOP);
 	}
 }
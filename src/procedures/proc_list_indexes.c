@@ -258,7 +258,7 @@ static bool _EmitIndex
 		RSIndex *rsIdx = Index_RSIndex(idx);
 
 		RediSearch_IndexInfo(rsIdx, &info);
-		SIValue map = SI_Map(23);
+		SIValue map = SI_Map(26);
 
 		Map_Add(&map, SI_ConstStringVal("gcPolicy"), SI_LongVal(info.gcPolicy));
 		Map_Add(&map, SI_ConstStringVal("score"),    SI_DoubleVal(info.score));
@@ -280,7 +280,12 @@ static bool _EmitIndex
 		Map_Add(&map, SI_ConstStringVal("fields"), fields);
 		SIValue_Free(fields);
 
-		Map_Add(&map, SI_ConstStringVal("numDocuments"),     SI_LongVal(info.numDocuments));
+		// natively indexed entities are not stored as RediSearch documents
+		OrderedIndex *ordered = Index_OrderedIndex(idx);
+		uint64_t num_docs = (ordered != NULL) ?
+			OrderedIndex_EntityCount(ordered) : info.numDocuments;
+
+		Map_Add(&map, SI_ConstStringVal("numDocuments"),     SI_LongVal(num_docs));
 		Map_Add(&map, SI_ConstStringVal("maxDocId"),         SI_LongVal(info.maxDocId));
 		Map_Add(&map, SI_ConstStringVal("docTableSize"),     SI_LongVal(info.docTableSize));
 		Map_Add(&map, SI_ConstStringVal("sortablesSize"),    SI_LongVal(info.sortablesSize));
@@ -300,6 +305,12 @@ static bool _EmitIndex
 		Map_Add(&map, SI_ConstStringVal("totalMSRun"),       SI_LongVal(info.totalMSRun));
 		Map_Add(&map, SI_ConstStringVal("lastRunTimeMs"),    SI_LongVal(info.lastRunTimeMs));
 
+		// population progress, an operational index reports its last population
+		IndexProgress progress = Index_PopulateProgress(idx);
+		Map_Add(&map, SI_ConstStringVal("indexedEntities"), SI_LongVal(progress.indexed));
+		Map_Add(&map, SI_ConstStringVal("totalEntities"),   SI_LongVal(progress.total));
+		Map_Add(&map, SI_ConstStringVal("etaSeconds"),      SI_DoubleVal(progress.eta));
+
 		RediSearch_IndexInfoFree(&info);
 		*ctx->yield_info = map;
 	}
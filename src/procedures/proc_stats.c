@@ -0,0 +1,294 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_stats.h"
+#include "RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../schema/schema.h"
+#include "../datatypes/map.h"
+#include "../datatypes/array.h"
+
+// CALL db.stats()
+
+typedef struct {
+	SIValue *out;                 // outputs
+	GraphContext *gc;             // graph context
+	SchemaType schema_type;       // type of schemas being scanned
+	uint schema_id;               // current schema ID
+	Attribute_ID attr;            // next attribute to inspect
+	SIValue *yield_label;         // yield label / relationship-type
+	SIValue *yield_entity_type;   // yield entity type
+	SIValue *yield_property;      // yield property name
+	SIValue *yield_count;         // yield number of entities with property
+	SIValue *yield_distinct;      // yield estimated number of distinct values
+	SIValue *yield_mcv;           // yield most common values
+	SIValue *yield_histogram;     // yield histogram boundaries
+} StatsContext;
+
+static void _process_yield
+(
+	StatsContext *ctx,
+	const char **yield
+) {
+	ctx->yield_mcv         = NULL;
+	ctx->yield_label       = NULL;
+	ctx->yield_count       = NULL;
+	ctx->yield_property    = NULL;
+	ctx->yield_distinct    = NULL;
+	ctx->yield_histogram   = NULL;
+	ctx->yield_entity_type = NULL;
+
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("label", yield[i]) == 0) {
+			ctx->yield_label = ctx->out + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("entitytype", yield[i]) == 0) {
+			ctx->yield_entity_type = ctx->out + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("property", yield[i]) == 0) {
+			ctx->yield_property = ctx->out + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("count", yield[i]) == 0) {
+			ctx->yield_count = ctx->out + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("distinct", yield[i]) == 0) {
+			ctx->yield_distinct = ctx->out + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("mostCommonValues", yield[i]) == 0) {
+			ctx->yield_mcv = ctx->out + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("histogram", yield[i]) == 0) {
+			ctx->yield_histogram = ctx->out + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+ProcedureResult Proc_StatsInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	ASSERT(ctx   != NULL);
+	ASSERT(args  != NULL);
+	ASSERT(yield != NULL);
+
+	// expecting no arguments
+	if(array_len((SIValue *)args) != 0) return PROCEDURE_ERR;
+
+	StatsContext *pdata = rm_malloc(sizeof(StatsContext));
+
+	pdata->gc          = QueryCtx_GetGraphCtx();
+	pdata->out         = array_new(SIValue, 7);
+	pdata->schema_type = SCHEMA_NODE;
+	pdata->schema_id   = 0;
+	pdata->attr        = 0;
+
+	_process_yield(pdata, yield);
+
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+// advance to the next non empty attribute statistics
+// returns NULL once all schemas been scanned
+static const AttributeStatistics *_NextStatistics
+(
+	StatsContext *ctx,
+	Schema **schema,
+	Attribute_ID *attr
+) {
+	while(true) {
+		if(ctx->schema_id >= GraphContext_SchemaCount(ctx->gc, ctx->schema_type)) {
+			// done with node schemas, move on to relationship-types
+			if(ctx->schema_type == SCHEMA_EDGE) return NULL;
+			ctx->schema_type = SCHEMA_EDGE;
+			ctx->schema_id   = 0;
+			ctx->attr        = 0;
+			continue;
+		}
+
+		Schema *s = GraphContext_GetSchemaByID(ctx->gc, ctx->schema_id,
+				ctx->schema_type);
+
+		while(ctx->attr < array_len(s->stats)) {
+			Attribute_ID a = ctx->attr++;
+			const AttributeStatistics *stats = Schema_GetStatistics(s, a);
+			if(stats != NULL && AttributeStatistics_Count(stats) > 0) {
+				*schema = s;
+				*attr   = a;
+				return stats;
+			}
+		}
+
+		// schema depleted
+		ctx->schema_id++;
+		ctx->attr = 0;
+	}
+}
+
+SIValue *Proc_StatsStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData != NULL);
+
+	StatsContext *pdata = ctx->privateData;
+
+	Schema *s;
+	Attribute_ID attr;
+	const AttributeStatistics *stats = _NextStatistics(pdata, &s, &attr);
+
+	// depleted
+	if(stats == NULL) return NULL;
+
+	if(pdata->yield_label != NULL) {
+		*pdata->yield_label = SI_ConstStringVal((char *)Schema_GetName(s));
+	}
+
+	if(pdata->yield_entity_type != NULL) {
+		*pdata->yield_entity_type = (Schema_GetType(s) == SCHEMA_NODE)
+			? SI_ConstStringVal("NODE")
+			: SI_ConstStringVal("RELATIONSHIP");
+	}
+
+	if(pdata->yield_property != NULL) {
+		*pdata->yield_property = SI_ConstStringVal(
+				(char *)GraphContext_GetAttributeString(pdata->gc, attr));
+	}
+
+	if(pdata->yield_count != NULL) {
+		*pdata->yield_count = SI_LongVal(AttributeStatistics_Count(stats));
+	}
+
+	if(pdata->yield_distinct != NULL) {
+		*pdata->yield_distinct =
+			SI_LongVal(AttributeStatistics_DistinctCount(stats));
+	}
+
+	if(pdata->yield_mcv != NULL) {
+		SIValue   values[ATTR_STATS_MCV_CAPACITY];
+		uint64_t  counts[ATTR_STATS_MCV_CAPACITY];
+		uint n = AttributeStatistics_MostCommonValues(stats, values, counts);
+
+		*pdata->yield_mcv = SI_Array(n);
+		for(uint i = 0; i < n; i++) {
+			SIValue mcv = SI_Map(2);
+			Map_Add(&mcv, SI_ConstStringVal("value"), values[i]);
+			Map_Add(&mcv, SI_ConstStringVal("count"), SI_LongVal(counts[i]));
+			SIArray_Append(pdata->yield_mcv, mcv);
+			SIValue_Free(mcv);
+		}
+	}
+
+	if(pdata->yield_histogram != NULL) {
+		const double *bounds;
+		uint n = AttributeStatistics_Histogram(stats, &bounds);
+
+		*pdata->yield_histogram = SI_Array(n);
+		for(uint i = 0; i < n; i++) {
+			SIArray_Append(pdata->yield_histogram, SI_DoubleVal(bounds[i]));
+		}
+	}
+
+	return pdata->out;
+}
+
+ProcedureResult Proc_StatsFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(ctx->privateData) {
+		StatsContext *pdata = ctx->privateData;
+		array_free(pdata->out);
+		rm_free(pdata);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_StatsCtx(void) {
+	void *privateData = NULL;
+	ProcedureOutput output;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 7);
+
+	// label / relationship-type
+	output = (ProcedureOutput) {
+		.name = "label", .type = T_STRING
+	};
+	array_append(outputs, output);
+
+	// entity type (node / relationship)
+	output = (ProcedureOutput) {
+		.name = "entitytype", .type = T_STRING
+	};
+	array_append(outputs, output);
+
+	// property name
+	output = (ProcedureOutput) {
+		.name = "property", .type = T_STRING
+	};
+	array_append(outputs, output);
+
+	// number of entities holding the property
+	output = (ProcedureOutput) {
+		.name = "count", .type = T_INT64
+	};
+	array_append(outputs, output);
+
+	// estimated number of distinct values
+	output = (ProcedureOutput) {
+		.name = "distinct", .type = T_INT64
+	};
+	array_append(outputs, output);
+
+	// most common values and their frequencies
+	output = (ProcedureOutput) {
+		.name = "mostCommonValues", .type = T_ARRAY
+	};
+	array_append(outputs, output);
+
+	// equi-depth histogram bucket boundaries
+	output = (ProcedureOutput) {
+		.name = "histogram", .type = T_ARRAY
+	};
+	array_append(outputs, output);
+
+	ProcedureCtx *ctx = ProcCtxNew("db.stats",
+								   0,
+								   outputs,
+								   Proc_StatsStep,
+								   Proc_StatsInvoke,
+								   Proc_StatsFree,
+								   privateData,
+								   true);
+	return ctx;
+}
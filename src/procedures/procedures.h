@@ -12,6 +12,7 @@
 #include "proc_sp_paths.h"
 #include "proc_ss_paths.h"
 #include "proc_relations.h"
+#include "proc_stats.h"
 #include "proc_procedures.h"
 #include "proc_list_indexes.h"
 #include "proc_list_constraints.h"
@@ -5,10 +5,12 @@
  */
 
 #include "RG.h"
+#include "xxhash.h"
 #include "queries_log.h"
 #include "util/rmalloc.h"
 #include "configuration/config.h"
 
+#include <string.h>
 #include <pthread.h>
 #include <stdatomic.h>
 
@@ -22,15 +24,58 @@ typedef struct QueriesCounters {
     _Atomic uint64_t write_timedout_n;   // # write queries timed out
 } QueriesCounters;
 
+// number of queries tracked by the execution history table
+// must be a power of 2
+#define QUERY_HISTORY_SIZE 256
+
+// execution history of a query
+// slots are addressed by the query key's hash, a query evicts a colliding query
+// an entry packs the upper half of the hash, identifying the query
+// with its moving average execution time (μs) in the lower half
+// such that an entry is read and updated as a single atomic word
+typedef _Atomic uint64_t QueryHistory;
+
+#define HISTORY_TAG(hash)          ((hash) >> 32)
+#define HISTORY_DURATION_MAX       UINT32_MAX
+#define HISTORY_ENTRY(tag, us)     (((uint64_t)(tag) << 32) | (us))
+#define HISTORY_ENTRY_TAG(e)       ((e) >> 32)
+#define HISTORY_ENTRY_DURATION(e)  ((e) & HISTORY_DURATION_MAX)
+
 // QueriesLog
 // maintains a log of queries
 typedef struct _QueriesLog {
-	CircularBuffer queries;    // buffer
-	CircularBuffer swap;       // swap buffer
-	QueriesCounters counters;  // counters with states
-	pthread_rwlock_t rwlock;   // RWLock
+	CircularBuffer queries;                     // buffer
+	CircularBuffer swap;                        // swap buffer
+	QueriesCounters counters;                   // counters with states
+	pthread_rwlock_t rwlock;                    // RWLock
+	QueryHistory history[QUERY_HISTORY_SIZE];   // queries execution history
 } _QueriesLog;
 
+// update query's execution history
+static void _QueriesLog_UpdateHistory
+(
+	QueriesLog log,     // queries log
+	uint64_t key_hash,  // query key hash
+	double duration     // execution time (ms)
+) {
+	uint64_t tag = HISTORY_TAG(key_hash);
+	double   us  = duration * 1000;
+	us = (us < HISTORY_DURATION_MAX) ? us : HISTORY_DURATION_MAX;
+
+	QueryHistory *h = log->history + (key_hash & (QUERY_HISTORY_SIZE - 1));
+
+	uint64_t entry = atomic_load(h);
+	uint64_t updated;
+	do {
+		uint64_t avg = (uint64_t)us;
+		if(HISTORY_ENTRY_TAG(entry) == tag) {
+			// favor recent executions
+			avg = (HISTORY_ENTRY_DURATION(entry) * 3 + avg) / 4;
+		}
+		updated = HISTORY_ENTRY(tag, avg);
+	} while(!atomic_compare_exchange_weak(h, &entry, updated));
+}
+
 // create a new queries log structure
 QueriesLog QueriesLog_New(void) {
 	QueriesLog log = rm_calloc(1, sizeof(struct _QueriesLog));
@@ -64,7 +109,8 @@ void QueriesLog_AddQuery
 	bool utilized_cache,          // utilized cache
 	bool write,    	   	          // write query
 	bool timeout,    		      // timeout query
-	const char *query             // query string
+	const char *query,            // query string
+	uint64_t key_hash             // query key hash, 0 if unknown
 ) {
 	// add query stats to buffer
 	// acquire READ lock, multiple threads can be populating the circular buffer
@@ -95,6 +141,40 @@ void QueriesLog_AddQuery
 
 	res = pthread_rwlock_unlock(&log->rwlock);
 	ASSERT(res == 0);
+
+	if(key_hash != 0) {
+		_QueriesLog_UpdateHistory(log, key_hash, execution_duration);
+	}
+}
+
+uint64_t QueriesLog_HashQueryKey
+(
+	const char *key  // query key
+) {
+	ASSERT(key != NULL);
+
+	return XXH64(key, strlen(key), 0);
+}
+
+// classify query by the execution time of its previous runs
+QueryClass QueriesLog_ClassifyQuery
+(
+	QueriesLog log,    // queries log
+	uint64_t key_hash  // query key hash
+) {
+	ASSERT(log != NULL);
+
+	QueryHistory *h = log->history + (key_hash & (QUERY_HISTORY_SIZE - 1));
+	uint64_t entry = atomic_load(h);
+
+	// queries without history are considered short
+	if(HISTORY_ENTRY_TAG(entry) != HISTORY_TAG(key_hash)) {
+		return QUERY_CLASS_SHORT;
+	}
+
+	return (HISTORY_ENTRY_DURATION(entry) >= LONG_QUERY_THRESHOLD * 1000)
+		? QUERY_CLASS_LONG
+		: QUERY_CLASS_SHORT;
 }
 
 // returns number of queries in log
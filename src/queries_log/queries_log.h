@@ -21,6 +21,16 @@ typedef struct QueryStats {
 	char *query;                // query string
 } LoggedQuery;
 
+// queries averaging at least this many milliseconds of execution
+// are classified as long
+#define LONG_QUERY_THRESHOLD 50
+
+// query classes, derived from previous executions of a query
+typedef enum {
+	QUERY_CLASS_SHORT,  // short or unseen query
+	QUERY_CLASS_LONG,   // long running query
+} QueryClass;
+
 // forward declaration of opaque QueriesLog structure
 typedef struct _QueriesLog *QueriesLog;
 
@@ -39,7 +49,22 @@ void QueriesLog_AddQuery
 	bool utilized_cache,        // utilized cache
 	bool write,    		        // write query
 	bool timeout,    		    // timeout query
-	const char *query           // query string
+	const char *query,          // query string
+	uint64_t key_hash           // query key hash, 0 if unknown
+);
+
+// hash a query key, queries sharing a key share their execution history
+// a query's key is its execution plan cache key
+uint64_t QueriesLog_HashQueryKey
+(
+	const char *key  // query key
+);
+
+// classify query by the execution time of its previous runs
+QueryClass QueriesLog_ClassifyQuery
+(
+	QueriesLog log,    // queries log
+	uint64_t key_hash  // query key hash
 );
 
 // returns number of queries in log
@@ -126,7 +126,8 @@ void QueryCtx_AdvanceStage
 				ctx->stats.utilized_cache,
 				ctx->flags & QueryExecutionTypeFlag_WRITE,
 				ctx->status == QueryExecutionStatus_TIMEDOUT,
-				ctx->query_data.query);
+				ctx->query_data.query,
+				ctx->query_data.key_hash);
 	}
 
 	// advance to next stage
@@ -375,10 +376,16 @@ static void _QueryCtx_UnlockCommit
 ) {
 	GraphContext *gc = ctx->gc;
 
+	// check while still holding the write lock
+	// if committed changes should be flushed in the background
+	bool flush = Graph_RequiresFlush(gc->g);
+
 	ctx->internal_exec_ctx.locked_for_commit = false;
 	// release graph R/W lock
 	Graph_ReleaseLock(gc->g);
 
+	if(flush) GraphContext_ScheduleFlush(gc);
+
 	// close Key
 	RedisModule_CloseKey(ctx->internal_exec_ctx.key);
 
@@ -442,6 +449,11 @@ void QueryCtx_Free(void) {
 		ctx->query_data.params = NULL;
 	}
 
+	if(ctx->query_data.query_normalized != NULL) {
+		rm_free(ctx->query_data.query_normalized);
+		ctx->query_data.query_normalized = NULL;
+	}
+
 	rm_free(ctx);
 
 	// NULL-set the context for reuse the next time this thread receives a query
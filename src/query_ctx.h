@@ -52,6 +52,8 @@ typedef struct {
 	rax *params;                  // query parameters
 	const char *query;            // query string
 	const char *query_no_params;  // query string without parameters part
+	char *query_normalized;       // normalized query string, owned by ctx
+	uint64_t key_hash;            // hash of the execution plan cache key
 } QueryCtx_QueryData;
 
 typedef struct {
@@ -298,6 +298,7 @@ Schema *Schema_New
 	s->type        = type;
 	s->name        = rm_strdup(name);
 	s->constraints = array_new(Constraint, 0);
+	s->stats       = array_new(AttributeStatistics *, 0);
 
 	return s;
 }
@@ -765,6 +766,121 @@ bool Schema_EnforceConstraints
 	return true;
 }
 
+//------------------------------------------------------------------------------
+// statistics API
+//------------------------------------------------------------------------------
+
+// get attribute's value statistics
+// returns NULL if attribute was never introduced to the schema's statistics
+AttributeStatistics *Schema_GetStatistics
+(
+	const Schema *s,    // schema
+	Attribute_ID attr   // attribute
+) {
+	ASSERT(s != NULL);
+
+	if(attr >= array_len(s->stats)) return NULL;
+	return s->stats[attr];
+}
+
+// get attribute's value statistics, creating them if missing
+AttributeStatistics *Schema_GetOrCreateStatistics
+(
+	Schema *s,          // schema
+	Attribute_ID attr   // attribute
+) {
+	ASSERT(s != NULL);
+
+	AttributeStatistics *stats = Schema_GetStatistics(s, attr);
+	if(stats == NULL) {
+		stats = AttributeStatistics_New();
+		Schema_SetStatistics(s, attr, stats);
+	}
+
+	return stats;
+}
+
+// set attribute's value statistics, replacing existing statistics
+void Schema_SetStatistics
+(
+	Schema *s,                  // schema
+	Attribute_ID attr,          // attribute
+	AttributeStatistics *stats  // statistics
+) {
+	ASSERT(s     != NULL);
+	ASSERT(stats != NULL);
+
+	// grow statistics array to accommodate attribute
+	while(attr >= array_len(s->stats)) {
+		array_append(s->stats, NULL);
+	}
+
+	if(s->stats[attr] != NULL) AttributeStatistics_Free(s->stats[attr]);
+	s->stats[attr] = stats;
+}
+
+// discard attribute's value statistics
+void Schema_RemoveStatistics
+(
+	Schema *s,          // schema
+	Attribute_ID attr   // attribute
+) {
+	AttributeStatistics *stats = Schema_GetStatistics(s, attr);
+	if(stats == NULL) return;
+
+	AttributeStatistics_Free(stats);
+	s->stats[attr] = NULL;
+}
+
+// introduce attribute value to schema's statistics
+void Schema_AddToStatistics
+(
+	Schema *s,          // schema
+	Attribute_ID attr,  // attribute
+	SIValue v           // added value
+) {
+	AttributeStatistics_Add(Schema_GetOrCreateStatistics(s, attr), v);
+}
+
+// remove attribute value from schema's statistics
+void Schema_RemoveFromStatistics
+(
+	Schema *s,          // schema
+	Attribute_ID attr,  // attribute
+	SIValue v           // removed value
+) {
+	AttributeStatistics *stats = Schema_GetStatistics(s, attr);
+	if(stats != NULL) AttributeStatistics_Remove(stats, v);
+}
+
+// introduce all of the attributes in `set` to schema's statistics
+void Schema_AddAttributesToStatistics
+(
+	Schema *s,              // schema
+	const AttributeSet set  // added attributes
+) {
+	uint16_t n = ATTRIBUTE_SET_COUNT(set);
+	for(uint16_t i = 0; i < n; i++) {
+		Attribute_ID attr;
+		SIValue v = AttributeSet_GetIdx(set, i, &attr);
+		Schema_AddToStatistics(s, attr, v);
+	}
+}
+
+// remove all of the attributes in `set` from schema's statistics
+void Schema_RemoveAttributesFromStatistics
+(
+	Schema *s,              // schema
+	const AttributeSet set  // removed attributes
+) {
+	uint16_t n = ATTRIBUTE_SET_COUNT(set);
+	for(uint16_t i = 0; i < n; i++) {
+		Attribute_ID attr;
+		SIValue v = AttributeSet_GetIdx(set, i, &attr);
+		Schema_RemoveFromStatistics(s, attr, v);
+	}
+}
+
 void Schema_Free
 (
 	Schema *s
@@ -801,6 +917,15 @@ void Schema_Free
 		Index_Free(ACTIVE_EXACTMATCH_IDX(s));
 	}
 
+	// free statistics
+	if(s->stats != NULL) {
+		uint n = array_len(s->stats);
+		for(uint i = 0; i < n; i++) {
+			if(s->stats[i] != NULL) AttributeStatistics_Free(s->stats[i]);
+		}
+		array_free(s->stats);
+	}
+
 	rm_free(s);
 }
 
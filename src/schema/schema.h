@@ -10,6 +10,7 @@
 #include "../index/index.h"
 #include "redisearch_api.h"
 #include "../constraint/constraint.h"
+#include "../graph/attribute_statistics.h"
 #include "../graph/entities/graph_entity.h"
 
 #define ACTIVE_FULLTEXT_IDX(s)    s->fulltextIdx[0]
@@ -32,6 +33,7 @@ typedef struct {
 	Index fulltextIdx[2];       // full-text index
 	Index exactmatchIdx[2];     // active/pending exact-match index
 	Constraint *constraints;    // constraints array
+	AttributeStatistics **stats;  // value statistics indexed by attribute ID
 } Schema;
 
 // creates a new schema
@@ -155,6 +157,73 @@ void Schema_RemoveEdgeFromIndices
 	const Edge *e
 );
 
+//------------------------------------------------------------------------------
+// statistics API
+//------------------------------------------------------------------------------
+
+// statistics are modified while holding the graph's write lock
+// readers, the planner included, must hold the graph's read lock
+
+// get attribute's value statistics
+// returns NULL if attribute was never introduced to the schema's statistics
+AttributeStatistics *Schema_GetStatistics
+(
+	const Schema *s,    // schema
+	Attribute_ID attr   // attribute
+);
+
+// get attribute's value statistics, creating them if missing
+AttributeStatistics *Schema_GetOrCreateStatistics
+(
+	Schema *s,          // schema
+	Attribute_ID attr   // attribute
+);
+
+// set attribute's value statistics, replacing existing statistics
+void Schema_SetStatistics
+(
+	Schema *s,                  // schema
+	Attribute_ID attr,          // attribute
+	AttributeStatistics *stats  // statistics
+);
+
+// discard attribute's value statistics
+void Schema_RemoveStatistics
+(
+	Schema *s,          // schema
+	Attribute_ID attr   // attribute
+);
+
+// introduce attribute value to schema's statistics
+void Schema_AddToStatistics
+(
+	Schema *s,          // schema
+	Attribute_ID attr,  // attribute
+	SIValue v           // added value
+);
+
+// remove attribute value from schema's statistics
+void Schema_RemoveFromStatistics
+(
+	Schema *s,          // schema
+	Attribute_ID attr,  // attribute
+	SIValue v           // removed value
+);
+
+// introduce all of the attributes in `set` to schema's statistics
+void Schema_AddAttributesToStatistics
+(
+	Schema *s,              // schema
+	const AttributeSet set  // added attributes
+);
+
+// remove all of the attributes in `set` from schema's statistics
+void Schema_RemoveAttributesFromStatistics
+(
+	Schema *s,              // schema
+	const AttributeSet set  // removed attributes
+);
+
 // Free schema
 void Schema_Free
 (
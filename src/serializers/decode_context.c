@@ -8,6 +8,7 @@
 #include "../RG.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
+#include "../util/string_pool.h"
 #include "../util/rax_extensions.h"
 
 GraphDecodeContext *GraphDecodeContext_New() {
@@ -16,6 +17,9 @@ GraphDecodeContext *GraphDecodeContext_New() {
 	ctx->graph_keys_count = 1;
 	ctx->meta_keys = raxNew();
 	ctx->multi_edge = NULL;
+	ctx->pending_labels = NULL;
+	ctx->pending_edges = NULL;
+	ctx->strings = array_new(SIValue, 0);
 	return ctx;
 }
 
@@ -29,6 +33,9 @@ void GraphDecodeContext_Reset(GraphDecodeContext *ctx) {
 		array_free(ctx->multi_edge);
 		ctx->multi_edge = NULL;
 	}
+
+	GraphDecodeContext_ClearPending(ctx);
+	GraphDecodeContext_ClearStrings(ctx);
 }
 
 void GraphDecodeContext_SetKeyCount(GraphDecodeContext *ctx, uint64_t key_count) {
@@ -57,6 +64,70 @@ void GraphDecodeContext_ClearMetaKeys(GraphDecodeContext *ctx) {
 	ctx->meta_keys = raxNew();
 }
 
+void GraphDecodeContext_InitPending(GraphDecodeContext *ctx, uint64_t label_count,
+		uint64_t relation_count) {
+	ASSERT(ctx);
+	ASSERT(ctx->pending_labels == NULL);
+	ASSERT(ctx->pending_edges == NULL);
+
+	ctx->pending_labels = array_new(uint64_t *, label_count);
+	for(uint64_t i = 0; i < label_count; i++) {
+		array_append(ctx->pending_labels, array_new(uint64_t, 0));
+	}
+
+	ctx->pending_edges = array_new(PendingEdges, relation_count);
+	for(uint64_t i = 0; i < relation_count; i++) {
+		PendingEdges edges = {
+			.src  = array_new(uint64_t, 0),
+			.dest = array_new(uint64_t, 0),
+			.ids  = array_new(uint64_t, 0)
+		};
+		array_append(ctx->pending_edges, edges);
+	}
+}
+
+void GraphDecodeContext_AddLabeledNode(GraphDecodeContext *ctx, uint64_t label,
+		uint64_t node_id) {
+	ASSERT(ctx);
+	ASSERT(label < array_len(ctx->pending_labels));
+
+	array_append(ctx->pending_labels[label], node_id);
+}
+
+void GraphDecodeContext_AddEdge(GraphDecodeContext *ctx, uint64_t relation,
+		uint64_t src, uint64_t dest, uint64_t edge_id) {
+	ASSERT(ctx);
+	ASSERT(relation < array_len(ctx->pending_edges));
+
+	PendingEdges *edges = ctx->pending_edges + relation;
+	array_append(edges->src, src);
+	array_append(edges->dest, dest);
+	array_append(edges->ids, edge_id);
+}
+
+void GraphDecodeContext_ClearPending(GraphDecodeContext *ctx) {
+	ASSERT(ctx);
+
+	if(ctx->pending_labels) {
+		uint n = array_len(ctx->pending_labels);
+		for(uint i = 0; i < n; i++) array_free(ctx->pending_labels[i]);
+		array_free(ctx->pending_labels);
+		ctx->pending_labels = NULL;
+	}
+
+	if(ctx->pending_edges) {
+		uint n = array_len(ctx->pending_edges);
+		for(uint i = 0; i < n; i++) {
+			PendingEdges *edges = ctx->pending_edges + i;
+			array_free(edges->src);
+			array_free(edges->dest);
+			array_free(edges->ids);
+		}
+		array_free(ctx->pending_edges);
+		ctx->pending_edges = NULL;
+	}
+}
+
 // Returns if the the number of processed keys is equal to the total number of graph keys.
 bool GraphDecodeContext_Finished(const GraphDecodeContext *ctx) {
 	ASSERT(ctx);
@@ -73,6 +144,36 @@ bool GraphDecodeContext_GetProcessedKeyCount(const GraphDecodeContext *ctx) {
 	return ctx->keys_processed;
 }
 
+uint64_t GraphDecodeContext_StringCount(const GraphDecodeContext *ctx) {
+	ASSERT(ctx);
+	return array_len(ctx->strings);
+}
+
+SIValue GraphDecodeContext_AddString(GraphDecodeContext *ctx, SIValue str) {
+	ASSERT(ctx);
+	ASSERT(SI_TYPE(str) == T_STRING);
+
+	// mirror the encoder, strings too long to be interned aren't introduced
+	if(strlen(str.stringval) > STRING_POOL_MAX_LEN) return str;
+
+	str = SI_InternValue(str);
+	array_append(ctx->strings, SI_CloneValue(str));
+	return str;
+}
+
+SIValue GraphDecodeContext_GetString(const GraphDecodeContext *ctx, uint64_t id) {
+	ASSERT(ctx);
+	ASSERT(id < array_len(ctx->strings));
+	return SI_CloneValue(ctx->strings[id]);
+}
+
+void GraphDecodeContext_ClearStrings(GraphDecodeContext *ctx) {
+	ASSERT(ctx);
+	uint count = array_len(ctx->strings);
+	for(uint i = 0; i < count; i++) SIValue_Free(ctx->strings[i]);
+	array_clear(ctx->strings);
+}
+
 void GraphDecodeContext_Free(GraphDecodeContext *ctx) {
 	if(ctx) {
 		raxFree(ctx->meta_keys);
@@ -82,6 +183,10 @@ void GraphDecodeContext_Free(GraphDecodeContext *ctx) {
 			ctx->multi_edge = NULL;
 		}
 
+		GraphDecodeContext_ClearPending(ctx);
+		GraphDecodeContext_ClearStrings(ctx);
+		array_free(ctx->strings);
+
 		rm_free(ctx);
 	}
 }
@@ -10,13 +10,24 @@
 #include "stdbool.h"
 #include "stdint.h"
 #include "rax.h"
+#include "../value.h"
+
+// Edges of a single relationship-type awaiting bulk matrix construction.
+typedef struct {
+	uint64_t *src;   // Source node IDs.
+	uint64_t *dest;  // Destination node IDs.
+	uint64_t *ids;   // Edge IDs.
+} PendingEdges;
 
 // A struct that maintains the state of a graph decoding from RDB.
 typedef struct {
-	uint64_t keys_processed;    // Count the number of procssed graph keys.
-	uint64_t graph_keys_count;  // The number of keys representing the graph.
-	rax *meta_keys;             // The meta keys encountered so far in the decode process.
-	uint64_t *multi_edge;       // Is relation contains multi edge values.
+	uint64_t keys_processed;        // Count the number of procssed graph keys.
+	uint64_t graph_keys_count;      // The number of keys representing the graph.
+	rax *meta_keys;                 // The meta keys encountered so far in the decode process.
+	uint64_t *multi_edge;           // Is relation contains multi edge values.
+	uint64_t **pending_labels;      // Per label, node IDs awaiting bulk matrix construction.
+	PendingEdges *pending_edges;    // Per relation, edges awaiting bulk matrix construction.
+	SIValue *strings;               // String dictionary of the key being decoded.
 } GraphDecodeContext;
 
 // Creates a new graph decoding context.
@@ -40,6 +51,35 @@ unsigned char **GraphDecodeContext_GetMetaKeys(const GraphDecodeContext *ctx);
 // Removes the stored meta key names from the context.
 void GraphDecodeContext_ClearMetaKeys(GraphDecodeContext *ctx);
 
+// Allocate buffers for entities awaiting bulk matrix construction.
+void GraphDecodeContext_InitPending(GraphDecodeContext *ctx, uint64_t label_count,
+		uint64_t relation_count);
+
+// Buffer a labeled node, introduced to the label matrix in bulk.
+void GraphDecodeContext_AddLabeledNode(GraphDecodeContext *ctx, uint64_t label,
+		uint64_t node_id);
+
+// Buffer an edge, introduced to the relation matrices in bulk.
+void GraphDecodeContext_AddEdge(GraphDecodeContext *ctx, uint64_t relation,
+		uint64_t src, uint64_t dest, uint64_t edge_id);
+
+// Free buffered entities.
+void GraphDecodeContext_ClearPending(GraphDecodeContext *ctx);
+
+// Returns the number of strings in the current key's string dictionary.
+uint64_t GraphDecodeContext_StringCount(const GraphDecodeContext *ctx);
+
+// Introduce a string to the current key's string dictionary under the next ID.
+// Returns an interned copy of the string, ownership of `str` is taken.
+// Strings too long to be interned are returned as is and not introduced.
+SIValue GraphDecodeContext_AddString(GraphDecodeContext *ctx, SIValue str);
+
+// Returns a shared copy of the string introduced under `id`.
+SIValue GraphDecodeContext_GetString(const GraphDecodeContext *ctx, uint64_t id);
+
+// Empties the string dictionary, called once a key is decoded.
+void GraphDecodeContext_ClearStrings(GraphDecodeContext *ctx);
+
 // Returns if the number of processed keys is equal to the total number of graph keys.
 bool GraphDecodeContext_Finished(const GraphDecodeContext *ctx);
 
@@ -0,0 +1,342 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "decode_v14.h"
+#include "../../../../util/thpool/pools.h"
+
+// number of attribute sets constructed by a single task
+#define ATTRIBUTE_SET_CHUNK 1024
+
+// forward declarations
+static SIValue _RdbLoadPoint(RedisModuleIO *rdb);
+static SIValue _RdbLoadSIArray(RedisModuleIO *rdb, GraphDecodeContext *ctx);
+
+static SIValue _RdbLoadString
+(
+	RedisModuleIO *rdb,
+	GraphDecodeContext *ctx
+) {
+	// strings are dictionary encoded, a dictionary is kept per key
+	// Format:
+	// string ID
+	// string (only if first encountered in key)
+	uint64_t id = RedisModule_LoadUnsigned(rdb);
+	if(id < GraphDecodeContext_StringCount(ctx)) {
+		return GraphDecodeContext_GetString(ctx, id);
+	}
+
+	// transfer ownership of the heap-allocated string to the
+	// newly-created SIValue
+	SIValue s = SI_TransferStringVal(RedisModule_LoadStringBuffer(rdb, NULL));
+	return GraphDecodeContext_AddString(ctx, s);
+}
+
+static SIValue _RdbLoadSIValue
+(
+	RedisModuleIO *rdb,
+	GraphDecodeContext *ctx
+) {
+	// Format:
+	// SIType
+	// Value
+	SIType t = RedisModule_LoadUnsigned(rdb);
+	switch(t) {
+	case T_INT64:
+		return SI_LongVal(RedisModule_LoadSigned(rdb));
+	case T_DOUBLE:
+		return SI_DoubleVal(RedisModule_LoadDouble(rdb));
+	case T_STRING:
+		return _RdbLoadString(rdb, ctx);
+	case T_BOOL:
+		return SI_BoolVal(RedisModule_LoadSigned(rdb));
+	case T_ARRAY:
+		return _RdbLoadSIArray(rdb, ctx);
+	case T_POINT:
+		return _RdbLoadPoint(rdb);
+	case T_NULL:
+	default: // currently impossible
+		return SI_NullVal();
+	}
+}
+
+static SIValue _RdbLoadPoint
+(
+	RedisModuleIO *rdb
+) {
+	double lat = RedisModule_LoadDouble(rdb);
+	double lon = RedisModule_LoadDouble(rdb);
+	return SI_Point(lat, lon);
+}
+
+static SIValue _RdbLoadSIArray
+(
+	RedisModuleIO *rdb,
+	GraphDecodeContext *ctx
+) {
+	/* loads array as
+	   unsinged : array legnth
+	   array[0]
+	   .
+	   .
+	   .
+	   array[array length -1]
+	 */
+	uint arrayLen = RedisModule_LoadUnsigned(rdb);
+	SIValue list = SI_Array(arrayLen);
+	for(uint i = 0; i < arrayLen; i++) {
+		SIValue elem = _RdbLoadSIValue(rdb, ctx);
+		SIArray_Append(&list, elem);
+		SIValue_Free(elem);
+	}
+	return list;
+}
+
+// attributes of a payload's entities
+// attribute values are read sequentially off the RDB stream
+// attribute sets are constructed in parallel once the payload is read
+typedef struct {
+	AttributeSet **sets;    // attribute set of each entity
+	uint64_t *offsets;      // offset of each entity's first attribute
+	Attribute_ID *ids;      // attribute IDs
+	SIValue *vals;          // attribute values
+} _AttributeBatch;
+
+static void _AttributeBatch_Init
+(
+	_AttributeBatch *batch,
+	uint64_t n  // number of entities
+) {
+	batch->sets    = array_new(AttributeSet *, n);
+	batch->offsets = array_new(uint64_t, n + 1);
+	batch->ids     = array_new(Attribute_ID, n);
+	batch->vals    = array_new(SIValue, n);
+}
+
+// construct the attribute sets of the i'th chunk of entities
+static void _AttributeBatch_BuildChunk
+(
+	void *arg,
+	uint64_t chunk
+) {
+	_AttributeBatch *batch = (_AttributeBatch *)arg;
+
+	uint64_t n    = array_len(batch->sets);
+	uint64_t from = chunk * ATTRIBUTE_SET_CHUNK;
+	uint64_t to   = MIN(n, from + ATTRIBUTE_SET_CHUNK);
+
+	for(uint64_t i = from; i < to; i++) {
+		uint64_t offset = batch->offsets[i];
+		uint64_t count  = batch->offsets[i + 1] - offset;
+		if(count == 0) continue;
+
+		AttributeSet_AddNoClone(batch->sets[i], batch->ids + offset,
+				batch->vals + offset, count, false);
+	}
+}
+
+// construct attribute sets on the readers thread-pool and free the batch
+static void _AttributeBatch_Build
+(
+	_AttributeBatch *batch
+) {
+	uint64_t n = array_len(batch->sets);
+	array_append(batch->offsets, array_len(batch->ids));
+
+	uint64_t chunks = (n + ATTRIBUTE_SET_CHUNK - 1) / ATTRIBUTE_SET_CHUNK;
+	ThreadPools_ReadersParallelFor(_AttributeBatch_BuildChunk, batch, chunks);
+
+	array_free(batch->sets);
+	array_free(batch->offsets);
+	array_free(batch->ids);
+	array_free(batch->vals);
+}
+
+static void _RdbLoadEntity
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	GraphEntity *e,
+	_AttributeBatch *batch
+) {
+	// Format:
+	// #properties N
+	// (name, value type, value) X N
+
+	uint64_t n = RedisModule_LoadUnsigned(rdb);
+
+	array_append(batch->sets, e->attributes);
+	array_append(batch->offsets, array_len(batch->ids));
+
+	for(int i = 0; i < n; i++) {
+		array_append(batch->ids, RedisModule_LoadUnsigned(rdb));
+		array_append(batch->vals, _RdbLoadSIValue(rdb, gc->decoding_context));
+	}
+}
+
+void RdbLoadNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t node_count
+) {
+	// Node Format:
+	//      ID
+	//      #labels M
+	//      (labels) X M
+	//      #properties N
+	//      (name, value type, value) X N
+
+	_AttributeBatch batch;
+	_AttributeBatch_Init(&batch, node_count);
+
+	// nodes to introduce to indices once their attributes are set
+	Node    *indexed_nodes  = array_new(Node, 0);
+	LabelID *indexed_labels = array_new(LabelID, 0);
+
+	for(uint64_t i = 0; i < node_count; i++) {
+		Node n;
+		NodeID id = RedisModule_LoadUnsigned(rdb);
+
+		// #labels M
+		uint64_t nodeLabelCount = RedisModule_LoadUnsigned(rdb);
+
+		// * (labels) x M
+		LabelID labels[nodeLabelCount];
+		for(uint64_t i = 0; i < nodeLabelCount; i ++){
+			labels[i] = RedisModule_LoadUnsigned(rdb);
+		}
+
+		// label matrices are constructed in bulk once all keys are decoded
+		Serializer_Graph_SetNode(gc->g, id, NULL, 0, &n);
+		for(uint64_t i = 0; i < nodeLabelCount; i++) {
+			GraphDecodeContext_AddLabeledNode(gc->decoding_context, labels[i],
+					id);
+		}
+
+		_RdbLoadEntity(rdb, gc, (GraphEntity *)&n, &batch);
+
+		// natively backed indices are populated once all keys are decoded
+		for(uint64_t i = 0; i < nodeLabelCount; i++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
+			ASSERT(s != NULL);
+
+			Index idx = PENDING_EXACTMATCH_IDX(s);
+			if(PENDING_FULLTEXT_IDX(s) ||
+			   (idx && Index_OrderedIndex(idx) == NULL)) {
+				array_append(indexed_nodes, n);
+				array_append(indexed_labels, labels[i]);
+			}
+		}
+	}
+
+	_AttributeBatch_Build(&batch);
+
+	// introduce nodes to each relevant index
+	uint64_t indexed_count = array_len(indexed_nodes);
+	for(uint64_t i = 0; i < indexed_count; i++) {
+		Node *n = indexed_nodes + i;
+		Schema *s = GraphContext_GetSchemaByID(gc, indexed_labels[i],
+				SCHEMA_NODE);
+
+		Index idx = PENDING_FULLTEXT_IDX(s);
+		if(idx) Index_IndexNode(idx, n);
+
+		idx = PENDING_EXACTMATCH_IDX(s);
+		if(idx && Index_OrderedIndex(idx) == NULL) Index_IndexNode(idx, n);
+	}
+
+	array_free(indexed_nodes);
+	array_free(indexed_labels);
+}
+
+void RdbLoadDeletedNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_node_count
+) {
+	// Format:
+	// node id X N
+	for(uint64_t i = 0; i < deleted_node_count; i++) {
+		NodeID id = RedisModule_LoadUnsigned(rdb);
+		Serializer_Graph_MarkNodeDeleted(gc->g, id);
+	}
+}
+
+void RdbLoadEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t edge_count
+) {
+	// Format:
+	// {
+	//  edge ID
+	//  source node ID
+	//  destination node ID
+	//  relation type
+	// } X N
+	// edge properties X N
+
+	_AttributeBatch batch;
+	_AttributeBatch_Init(&batch, edge_count);
+
+	// edges to introduce to indices once their attributes are set
+	Edge *indexed_edges = array_new(Edge, 0);
+
+	// construct connections
+	for(uint64_t i = 0; i < edge_count; i++) {
+		Edge e;
+		EdgeID    edgeId   = RedisModule_LoadUnsigned(rdb);
+		NodeID    srcId    = RedisModule_LoadUnsigned(rdb);
+		NodeID    destId   = RedisModule_LoadUnsigned(rdb);
+		uint64_t  relation = RedisModule_LoadUnsigned(rdb);
+
+		if(gc->decoding_context->multi_edge[relation]) {
+			Serializer_Graph_SetEdge(gc->g, true, edgeId, srcId, destId,
+					relation, &e);
+		} else {
+			// connection is formed in bulk once all keys are decoded
+			Serializer_Graph_AllocateEdge(gc->g, edgeId, srcId, destId,
+					relation, &e);
+			GraphDecodeContext_AddEdge(gc->decoding_context, relation, srcId,
+					destId, edgeId);
+		}
+		_RdbLoadEntity(rdb, gc, (GraphEntity *)&e, &batch);
+
+		Schema *s = GraphContext_GetSchemaByID(gc, relation, SCHEMA_EDGE);
+		ASSERT(s != NULL);
+
+		if(PENDING_EXACTMATCH_IDX(s)) array_append(indexed_edges, e);
+	}
+
+	_AttributeBatch_Build(&batch);
+
+	// index edges
+	uint64_t indexed_count = array_len(indexed_edges);
+	for(uint64_t i = 0; i < indexed_count; i++) {
+		Edge *e = indexed_edges + i;
+		Schema *s = GraphContext_GetSchemaByID(gc, Edge_GetRelationID(e),
+				SCHEMA_EDGE);
+		Index_IndexEdge(PENDING_EXACTMATCH_IDX(s), e);
+	}
+
+	array_free(indexed_edges);
+}
+
+void RdbLoadDeletedEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_edge_count
+) {
+	// Format:
+	// edge id X N
+	for(uint64_t i = 0; i < deleted_edge_count; i++) {
+		EdgeID id = RedisModule_LoadUnsigned(rdb);
+		Serializer_Graph_MarkEdgeDeleted(gc->g, id);
+	}
+}
@@ -19,6 +19,8 @@ GraphContext *Decode_Previous(RedisModuleIO *rdb, int encver) {
 		return RdbLoadGraphContext_v11(rdb);
 	case 12:
 		return RdbLoadGraphContext_v12(rdb);
+	case 13:
+		return RdbLoadGraphContext_v13(rdb);
 	default:
 		ASSERT(false && "attempted to read unsupported RedisGraph version from RDB file.");
 		return NULL;
@@ -193,6 +193,9 @@ GraphContext *RdbLoadGraphContext_v10(RedisModuleIO *rdb) {
 
 		Graph_ApplyAllPending(g, true);
 
+		// count relationship-types connecting each pair of nodes
+		Graph_RebuildConnectionCounts(g);
+
 		// revert to default synchronization behavior
 		Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
 
@@ -232,6 +235,9 @@ GraphContext *RdbLoadGraphContext_v10(RedisModuleIO *rdb) {
 			}
 		}
 
+		// statistics are not encoded prior to v14, rebuild them
+		GraphContext_RebuildStatistics(gc);
+
 		// make sure graph doesn't contains may pending changes
 		ASSERT(Graph_Pending(g) == false);
 
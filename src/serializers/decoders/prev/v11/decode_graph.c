@@ -200,6 +200,9 @@ GraphContext *RdbLoadGraphContext_v11
 
 		Graph_ApplyAllPending(g, true);
 
+		// count relationship-types connecting each pair of nodes
+		Graph_RebuildConnectionCounts(g);
+
 		// revert to default synchronization behavior
 		Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
 
@@ -239,6 +242,9 @@ GraphContext *RdbLoadGraphContext_v11
 			}
 		}
 
+		// statistics are not encoded prior to v14, rebuild them
+		GraphContext_RebuildStatistics(gc);
+
 		// make sure graph doesn't contains may pending changes
 		ASSERT(Graph_Pending(g) == false);
 
@@ -172,6 +172,9 @@ GraphContext *RdbLoadGraphContext_v8(RedisModuleIO *rdb) {
 
 		Graph_ApplyAllPending(g, true);
 
+		// count relationship-types connecting each pair of nodes
+		Graph_RebuildConnectionCounts(g);
+
 		// revert to default synchronization behavior
 		Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
 
@@ -213,6 +216,9 @@ GraphContext *RdbLoadGraphContext_v8(RedisModuleIO *rdb) {
 			}
 		}
 
+		// statistics are not encoded prior to v14, rebuild them
+		GraphContext_RebuildStatistics(gc);
+
 		// make sure graph doesn't contains may pending changes
 		ASSERT(Graph_Pending(g) == false);
 
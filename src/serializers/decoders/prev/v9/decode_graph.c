@@ -185,6 +185,9 @@ GraphContext *RdbLoadGraphContext_v9(RedisModuleIO *rdb) {
 
 		Graph_ApplyAllPending(g, true);
 
+		// count relationship-types connecting each pair of nodes
+		Graph_RebuildConnectionCounts(g);
+
 		// revert to default synchronization behavior
 		Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
 
@@ -236,6 +239,9 @@ GraphContext *RdbLoadGraphContext_v9(RedisModuleIO *rdb) {
 			}
 		}
 
+		// statistics are not encoded prior to v14, rebuild them
+		GraphContext_RebuildStatistics(gc);
+
 		// make sure graph doesn't contains may pending changes
 		ASSERT(Graph_Pending(g) == false);
 
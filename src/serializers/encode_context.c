@@ -8,11 +8,13 @@
 #include "../RG.h"
 #include "../util/rmalloc.h"
 #include "../util/rax_extensions.h"
+#include "../util/string_pool.h"
 #include "../configuration/config.h"
 
 GraphEncodeContext *GraphEncodeContext_New() {
 	GraphEncodeContext *ctx = rm_calloc(1, sizeof(GraphEncodeContext));
 	ctx->meta_keys = raxNew();
+	ctx->strings = raxNew();
 	GraphEncodeContext_Reset(ctx);
 	return ctx;
 }
@@ -59,6 +61,8 @@ void GraphEncodeContext_Reset(GraphEncodeContext *ctx) {
 
 	// Avoid leaks in case or reset during encodeing.
 	RG_MatrixTupleIter_detach(&ctx->matrix_tuple_iterator);
+
+	GraphEncodeContext_ClearStrings(ctx);
 }
 
 void GraphEncodeContext_InitHeader
@@ -210,6 +214,36 @@ void GraphEncodeContext_IncreaseProcessedKeyCount(GraphEncodeContext *ctx) {
 	ctx->keys_processed++;
 }
 
+bool GraphEncodeContext_GetStringID(GraphEncodeContext *ctx, const char *str,
+		uint64_t *id) {
+	ASSERT(ctx);
+	ASSERT(id);
+	ASSERT(str);
+
+	// the next string introduced is assigned the dictionary's size as its ID
+	*id = raxSize(ctx->strings);
+
+	// long strings rarely repeat, don't pay for holding them
+	size_t len = strlen(str);
+	if(len > STRING_POOL_MAX_LEN) return true;
+
+	void *existing = raxFind(ctx->strings, (unsigned char *)str, len);
+	if(existing != raxNotFound) {
+		*id = (uint64_t)existing;
+		return false;
+	}
+
+	raxInsert(ctx->strings, (unsigned char *)str, len, (void *)*id, NULL);
+	return true;
+}
+
+void GraphEncodeContext_ClearStrings(GraphEncodeContext *ctx) {
+	ASSERT(ctx);
+	if(raxSize(ctx->strings) == 0) return;
+	raxFree(ctx->strings);
+	ctx->strings = raxNew();
+}
+
 static void GraphEncodeContext_FreeHeader(GraphEncodeContext *ctx) {
 	if(ctx->header.multi_edge != NULL) rm_free(ctx->header.multi_edge);
 }
@@ -218,6 +252,7 @@ void GraphEncodeContext_Free(GraphEncodeContext *ctx) {
 	if(ctx) {
 		GraphEncodeContext_FreeHeader(ctx);
 		raxFree(ctx->meta_keys);
+		raxFree(ctx->strings);
 		rm_free(ctx);
 	}
 }
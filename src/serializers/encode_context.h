@@ -54,6 +54,7 @@ typedef struct {
 	uint multiple_edges_current_index;          // The current index of the encoded edges array.
 	DataBlockIterator *datablock_iterator;      // Datablock iterator to be saved in the context.
 	RG_MatrixTupleIter matrix_tuple_iterator;   // Matrix tuple iterator to be saved in the context.
+	rax *strings;                               // Strings encoded in the current key, mapped to their dictionary ID.
 } GraphEncodeContext;
 
 // Creates a new graph encoding context.
@@ -124,6 +125,15 @@ NodeID GraphEncodeContext_GetMultipleEdgesSourceNode(const GraphEncodeContext *c
 // Retrive the multiple edges array destination node.
 NodeID GraphEncodeContext_GetMultipleEdgesDestinationNode(const GraphEncodeContext *ctx);
 
+// Retrieve a string's ID in the current key's string dictionary.
+// Returns true if the string is not in the dictionary and must be encoded in full,
+// in which case `id` is set to the ID the string is introduced under.
+// Strings too long to be interned are never added to the dictionary.
+bool GraphEncodeContext_GetStringID(GraphEncodeContext *ctx, const char *str, uint64_t *id);
+
+// Empties the string dictionary, called once a key is encoded.
+void GraphEncodeContext_ClearStrings(GraphEncodeContext *ctx);
+
 // Returns if the the number of processed keys is equal to the total number of graph keys.
 bool GraphEncodeContext_Finished(const GraphEncodeContext *ctx);
 
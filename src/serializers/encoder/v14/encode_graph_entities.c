@@ -4,19 +4,21 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
-#include "encode_v13.h"
+#include "encode_v14.h"
 #include "../../../datatypes/datatypes.h"
 
 // forword decleration
 static void _RdbSaveSIValue
 (
 	RedisModuleIO *rdb,
+	GraphEncodeContext *ctx,
 	const SIValue *v
 );
 
 static void _RdbSaveSIArray
 (
 	RedisModuleIO *rdb,
+	GraphEncodeContext *ctx,
 	const SIValue list
 ) {
 	/* saves array as
@@ -31,13 +33,30 @@ static void _RdbSaveSIArray
 	RedisModule_SaveUnsigned(rdb, arrayLen);
 	for(uint i = 0; i < arrayLen; i ++) {
 		SIValue value = SIArray_Get(list, i);
-		_RdbSaveSIValue(rdb, &value);
+		_RdbSaveSIValue(rdb, ctx, &value);
 	}
 }
 
+static void _RdbSaveString
+(
+	RedisModuleIO *rdb,
+	GraphEncodeContext *ctx,
+	const char *s
+) {
+	// strings are dictionary encoded, a dictionary is kept per key
+	// Format:
+	// string ID
+	// string (only if first encountered in key)
+	uint64_t id;
+	bool introduce = GraphEncodeContext_GetStringID(ctx, s, &id);
+	RedisModule_SaveUnsigned(rdb, id);
+	if(introduce) RedisModule_SaveStringBuffer(rdb, s, strlen(s) + 1);
+}
+
 static void _RdbSaveSIValue
 (
 	RedisModuleIO *rdb,
+	GraphEncodeContext *ctx,
 	const SIValue *v
 ) {
 	// Format:
@@ -53,10 +72,10 @@ static void _RdbSaveSIValue
 			RedisModule_SaveDouble(rdb, v->doubleval);
 			return;
 		case T_STRING:
-			RedisModule_SaveStringBuffer(rdb, v->stringval, strlen(v->stringval) + 1);
+			_RdbSaveString(rdb, ctx, v->stringval);
 			return;
 		case T_ARRAY:
-			_RdbSaveSIArray(rdb, *v);
+			_RdbSaveSIArray(rdb, ctx, *v);
 			return;
 		case T_POINT:
 			RedisModule_SaveDouble(rdb, Point_lat(*v));
@@ -71,6 +90,7 @@ static void _RdbSaveSIValue
 static void _RdbSaveEntity
 (
 	RedisModuleIO *rdb,
+	GraphEncodeContext *ctx,
 	const GraphEntity *e
 ) {
 	// Format:
@@ -85,14 +105,14 @@ static void _RdbSaveEntity
 		Attribute_ID attr_id;
 		SIValue value = AttributeSet_GetIdx(set, i, &attr_id);
 		RedisModule_SaveUnsigned(rdb, attr_id);
-		_RdbSaveSIValue(rdb, &value);
+		_RdbSaveSIValue(rdb, ctx, &value);
 	}
 }
 
 static void _RdbSaveEdge
 (
 	RedisModuleIO *rdb,
-	const Graph *g,
+	GraphEncodeContext *ctx,
 	const Edge *e,
 	int r
 ) {
@@ -116,10 +136,10 @@ static void _RdbSaveEdge
 	RedisModule_SaveUnsigned(rdb, r);
 
 	// edge properties
-	_RdbSaveEntity(rdb, (GraphEntity *)e);
+	_RdbSaveEntity(rdb, ctx, (GraphEntity *)e);
 }
 
-static void _RdbSaveNode_v13
+static void _RdbSaveNode_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -146,10 +166,10 @@ static void _RdbSaveNode_v13
 
 	// properties N
 	// (name, value type, value) X N
-	_RdbSaveEntity(rdb, (GraphEntity *)n);
+	_RdbSaveEntity(rdb, gc->encoding_context, (GraphEntity *)n);
 }
 
-static void _RdbSaveDeletedEntities_v13
+static void _RdbSaveDeletedEntities_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -165,7 +185,7 @@ static void _RdbSaveDeletedEntities_v13
 	}
 }
 
-void RdbSaveDeletedNodes_v13
+void RdbSaveDeletedNodes_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -177,10 +197,10 @@ void RdbSaveDeletedNodes_v13
 	if(deleted_nodes_to_encode == 0) return;
 	// get deleted nodes list
 	uint64_t *deleted_nodes_list = Serializer_Graph_GetDeletedNodesList(gc->g);
-	_RdbSaveDeletedEntities_v13(rdb, gc, deleted_nodes_to_encode, deleted_nodes_list);
+	_RdbSaveDeletedEntities_v14(rdb, gc, deleted_nodes_to_encode, deleted_nodes_list);
 }
 
-void RdbSaveDeletedEdges_v13
+void RdbSaveDeletedEdges_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -193,10 +213,10 @@ void RdbSaveDeletedEdges_v13
 
 	// get deleted edges list
 	uint64_t *deleted_edges_list = Serializer_Graph_GetDeletedEdgesList(gc->g);
-	_RdbSaveDeletedEntities_v13(rdb, gc, deleted_edges_to_encode, deleted_edges_list);
+	_RdbSaveDeletedEntities_v14(rdb, gc, deleted_edges_to_encode, deleted_edges_list);
 }
 
-void RdbSaveNodes_v13
+void RdbSaveNodes_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -227,7 +247,7 @@ void RdbSaveNodes_v13
 	for(uint64_t i = 0; i < nodes_to_encode; i++) {
 		GraphEntity e;
 		e.attributes = (AttributeSet *)DataBlockIterator_Next(iter, &e.id);
-		_RdbSaveNode_v13(rdb, gc, &e);
+		_RdbSaveNode_v14(rdb, gc, &e);
 	}
 
 	// check if done encodeing nodes
@@ -267,7 +287,7 @@ static void _RdbSaveMultipleEdges
 		e.src_id  = src;
 		e.dest_id = dest;
 		Graph_GetEdge(gc->g, edgeID, &e);
-		_RdbSaveEdge(rdb, gc->g, &e, r);
+		_RdbSaveEdge(rdb, gc->encoding_context, &e, r);
 		encoded_edges_count++;
 	}
 
@@ -276,7 +296,7 @@ static void _RdbSaveMultipleEdges
 	*multiple_edges_current_index = i;
 }
 
-void RdbSaveEdges_v13
+void RdbSaveEdges_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -370,7 +390,7 @@ void RdbSaveEdges_v13
 		e.dest_id = dest;
 		if(SINGLE_EDGE(edgeID)) {
 			Graph_GetEdge(gc->g, edgeID, &e);
-			_RdbSaveEdge(rdb, gc->g, &e, r);
+			_RdbSaveEdge(rdb, gc->encoding_context, &e, r);
 			encoded_edges++;
 		} else {
 			multiple_edges_array = (EdgeID *)(CLEAR_MSB(edgeID));
@@ -4,7 +4,7 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
-#include "encode_v13.h"
+#include "encode_v14.h"
 #include "../../../util/arr.h"
 
 static void _RdbSaveAttributeKeys
@@ -183,6 +183,98 @@ static void _RdbSaveConstraintsData
 	array_free(active_constraints);
 }
 
+static void _RdbSaveStatisticsValue
+(
+	RedisModuleIO *rdb,
+	SIValue v
+) {
+	/* Format:
+	 * value type
+	 * value */
+
+	RedisModule_SaveUnsigned(rdb, SI_TYPE(v));
+	switch(SI_TYPE(v)) {
+		case T_STRING:
+			RedisModule_SaveStringBuffer(rdb, v.stringval,
+					strlen(v.stringval) + 1);
+			break;
+		case T_INT64:
+		case T_BOOL:
+			RedisModule_SaveSigned(rdb, v.longval);
+			break;
+		case T_DOUBLE:
+			RedisModule_SaveDouble(rdb, v.doubleval);
+			break;
+		default:
+			ASSERT(false && "unexpected most common value type");
+			break;
+	}
+}
+
+static void _RdbSaveAttributeStatistics
+(
+	RedisModuleIO *rdb,
+	Attribute_ID attr,
+	const AttributeStatistics *stats
+) {
+	/* Format:
+	 * attribute id
+	 * count
+	 * numeric count
+	 * numeric seen
+	 * random state
+	 * HLL registers
+	 * #most common values
+	 * (value, count, error) X N
+	 * #sampled values
+	 * sampled value X M
+	 */
+
+	RedisModule_SaveUnsigned(rdb, attr);
+	RedisModule_SaveUnsigned(rdb, stats->count);
+	RedisModule_SaveUnsigned(rdb, stats->numeric_count);
+	RedisModule_SaveUnsigned(rdb, stats->numeric_seen);
+	RedisModule_SaveUnsigned(rdb, stats->rng);
+	RedisModule_SaveStringBuffer(rdb, (const char *)stats->hll,
+			ATTR_STATS_HLL_REGISTERS);
+
+	uint n = array_len(stats->mcv);
+	RedisModule_SaveUnsigned(rdb, n);
+	for(uint i = 0; i < n; i++) {
+		_RdbSaveStatisticsValue(rdb, stats->mcv[i].value);
+		RedisModule_SaveUnsigned(rdb, stats->mcv[i].count);
+		RedisModule_SaveUnsigned(rdb, stats->mcv[i].error);
+	}
+
+	n = array_len(stats->sample);
+	RedisModule_SaveUnsigned(rdb, n);
+	for(uint i = 0; i < n; i++) {
+		RedisModule_SaveDouble(rdb, stats->sample[i]);
+	}
+}
+
+static void _RdbSaveStatistics
+(
+	RedisModuleIO *rdb,
+	Schema *s
+) {
+	// count attributes with statistics
+	uint n = array_len(s->stats);
+	uint stats_count = 0;
+	for(uint i = 0; i < n; i++) {
+		if(s->stats[i] != NULL) stats_count++;
+	}
+
+	// encode number of attribute statistics
+	RedisModule_SaveUnsigned(rdb, stats_count);
+
+	// encode statistics
+	for(uint i = 0; i < n; i++) {
+		if(s->stats[i] == NULL) continue;
+		_RdbSaveAttributeStatistics(rdb, i, s->stats[i]);
+	}
+}
+
 static void _RdbSaveSchema(RedisModuleIO *rdb, Schema *s) {
 	/* Format:
 	 * id
@@ -191,6 +283,8 @@ static void _RdbSaveSchema(RedisModuleIO *rdb, Schema *s) {
 	 * (index type, indexed property) X M 
 	 * #constraints 
 	 * (constraint type, constraint fields) X N
+	 * #attribute statistics
+	 * attribute statistics X K
 	 */
 
 	// Schema ID.
@@ -217,9 +311,12 @@ static void _RdbSaveSchema(RedisModuleIO *rdb, Schema *s) {
 
 	// Constraints.
 	_RdbSaveConstraintsData(rdb, s->constraints);
+
+	// Attribute statistics.
+	_RdbSaveStatistics(rdb, s);
 }
 
-void RdbSaveGraphSchema_v13(RedisModuleIO *rdb, GraphContext *gc) {
+void RdbSaveGraphSchema_v14(RedisModuleIO *rdb, GraphContext *gc) {
 	/* Format:
 	 * attribute keys (unified schema)
 	 * #node schemas
@@ -180,19 +180,16 @@ static void _OptimizedSingleEdgeFormConnection
 	GraphStatistics_IncEdgeCount(&g->stats, r, 1);
 }
 
-// set a given edge in the graph - Used for deserialization of graph
-void Serializer_Graph_SetEdge
+// allocate edge without forming its connection
+void Serializer_Graph_AllocateEdge
 (
 	Graph *g,
-	bool multi_edge,
 	EdgeID edge_id,
 	NodeID src,
 	NodeID dest,
 	int r,
 	Edge *e
 ) {
-	GrB_Info info;
-
 	AttributeSet *set = DataBlock_AllocateItemOutOfOrder(g->edges, edge_id);
 	*set = NULL;
 
@@ -201,6 +198,132 @@ void Serializer_Graph_SetEdge
 	e->dest_id    =  dest;
 	e->attributes =  set;
 	e->relationID =  r;
+}
+
+// make sure matrices can accommodate node IDs
+static void _EnsureMatrixDim
+(
+	Graph *g,
+	GrB_Matrix m,
+	const NodeID *ids,
+	uint64_t n
+) {
+	GrB_Index nrows;
+	GrB_Matrix_nrows(&nrows, m);
+
+	NodeID max_id = 0;
+	for(uint64_t i = 0; i < n; i++) max_id = MAX(max_id, ids[i]);
+
+	if(max_id >= nrows) {
+		RedisModule_Log(NULL, "notice", "RESIZE MATRIX BULK");
+		Graph_EnsureNodeCap(g, max_id);
+	}
+}
+
+// add tuples to matrix `m`
+// tuples are assembled into a temporary matrix which is then merged into `m`
+// `vals` is optional, when NULL all entries are set to true
+static void _BulkAdd
+(
+	GrB_Matrix m,
+	const GrB_Index *rows,
+	const GrB_Index *cols,
+	const uint64_t *vals,
+	uint64_t n
+) {
+	GrB_Info   info;
+	GrB_Type   t;
+	GrB_Matrix tmp;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+
+	UNUSED(info);
+
+	GxB_Matrix_type(&t, m);
+	GrB_Matrix_nrows(&nrows, m);
+	GrB_Matrix_ncols(&ncols, m);
+
+	info = GrB_Matrix_new(&tmp, t, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(vals != NULL) {
+		info = GrB_Matrix_build_UINT64(tmp, rows, cols, vals, n,
+				GrB_FIRST_UINT64);
+	} else {
+		GrB_Scalar s;
+		GrB_Scalar_new(&s, GrB_BOOL);
+		GrB_Scalar_setElement_BOOL(s, true);
+		info = GxB_Matrix_build_Scalar(tmp, rows, cols, s, n);
+		GrB_Scalar_free(&s);
+	}
+	ASSERT(info == GrB_SUCCESS);
+
+	// merge, existing entries are kept
+	GrB_BinaryOp op = (vals != NULL) ? GrB_FIRST_UINT64 : GrB_LOR;
+	info = GrB_Matrix_eWiseAdd_BinaryOp(m, NULL, NULL, op, m, tmp, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix_free(&tmp);
+}
+
+// introduce label to nodes in bulk
+void Serializer_Graph_BulkSetLabel
+(
+	Graph *g,
+	LabelID l,
+	const NodeID *ids,
+	uint64_t n
+) {
+	ASSERT(g != NULL);
+	if(n == 0) return;
+
+	RG_Matrix  L = Graph_GetLabelMatrix(g, l);
+	_EnsureMatrixDim(g, RG_MATRIX_M(L), ids, n);
+
+	// label matrices are diagonal
+	_BulkAdd(RG_MATRIX_M(L), ids, ids, NULL, n);
+}
+
+// form connections of single edge relationship-type in bulk
+void Serializer_Graph_BulkFormConnections
+(
+	Graph *g,
+	int r,
+	const NodeID *src,
+	const NodeID *dest,
+	const EdgeID *ids,
+	uint64_t n
+) {
+	ASSERT(g != NULL);
+	if(n == 0) return;
+
+	RG_Matrix M   = Graph_GetRelationMatrix(g, r, false);
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+
+	_EnsureMatrixDim(g, RG_MATRIX_M(adj), src, n);
+	_EnsureMatrixDim(g, RG_MATRIX_M(adj), dest, n);
+
+	// rows represent source nodes, columns represent destination nodes
+	_BulkAdd(RG_MATRIX_M(adj),  src,  dest, NULL, n);
+	_BulkAdd(RG_MATRIX_TM(adj), dest, src,  NULL, n);
+	_BulkAdd(RG_MATRIX_M(M),    src,  dest, ids,  n);
+	_BulkAdd(RG_MATRIX_TM(M),   dest, src,  NULL, n);
+
+	GraphStatistics_IncEdgeCount(&g->stats, r, n);
+}
+
+// set a given edge in the graph - Used for deserialization of graph
+void Serializer_Graph_SetEdge
+(
+	Graph *g,
+	bool multi_edge,
+	EdgeID edge_id,
+	NodeID src,
+	NodeID dest,
+	int r,
+	Edge *e
+) {
+	Serializer_Graph_AllocateEdge(g, edge_id, src, dest, r, e);
 
 	if(multi_edge) {
 		if(!Graph_FormConnection(g, src, dest, edge_id, r)) {
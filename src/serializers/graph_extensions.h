@@ -36,6 +36,37 @@ void Serializer_Graph_SetEdge
 	Edge *e                 // pointer to edge
 );
 
+// allocate edge without forming its connection
+void Serializer_Graph_AllocateEdge
+(
+	Graph *g,               // graph to add edge to
+	EdgeID edge_id,         // edge ID
+	NodeID src,             // edge source
+	NodeID dest,            // edge destination
+	int r,                  // edge relationship-type
+	Edge *e                 // pointer to edge
+);
+
+// introduce label to nodes in bulk
+void Serializer_Graph_BulkSetLabel
+(
+	Graph *g,               // graph to update
+	LabelID l,              // label
+	const NodeID *ids,      // labeled nodes
+	uint64_t n              // number of nodes
+);
+
+// form connections of a relationship-type without multi-edge in bulk
+void Serializer_Graph_BulkFormConnections
+(
+	Graph *g,               // graph to update
+	int r,                  // relationship-type
+	const NodeID *src,      // edges source
+	const NodeID *dest,     // edges destination
+	const EdgeID *ids,      // edge IDs
+	uint64_t n              // number of edges
+);
+
 // marks a node ID as deleted
 void Serializer_Graph_MarkNodeDeleted
 (
@@ -98,6 +98,42 @@ static void _index_delete_edge
 	Schema_RemoveEdgeFromIndices(s, e);
 }
 
+// introduce node attributes to the statistics of each of its labels
+// or remove them when `add` is false
+static void _statistics_node
+(
+	QueryCtx *ctx,
+	Node *n,
+	const AttributeSet set,
+	bool add
+) {
+	uint label_count;
+	NODE_GET_LABELS(ctx->gc->g, n, label_count);
+	for(uint j = 0; j < label_count; j++) {
+		Schema *s = GraphContext_GetSchemaByID(ctx->gc, labels[j], SCHEMA_NODE);
+		ASSERT(s);
+
+		if(add) Schema_AddAttributesToStatistics(s, set);
+		else    Schema_RemoveAttributesFromStatistics(s, set);
+	}
+}
+
+// introduce edge attributes to the statistics of its relationship-type
+// or remove them when `add` is false
+static void _statistics_edge
+(
+	QueryCtx *ctx,
+	Edge *e,
+	const AttributeSet set,
+	bool add
+) {
+	Schema *s = GraphContext_GetSchemaByID(ctx->gc, e->relationID, SCHEMA_EDGE);
+	ASSERT(s);
+
+	if(add) Schema_AddAttributesToStatistics(s, set);
+	else    Schema_RemoveAttributesFromStatistics(s, set);
+}
+
 static void _UndoLog_Restore_Entity_Property
 (
 	GraphEntity *ge,
@@ -132,15 +168,23 @@ static void _UndoLog_Rollback_Update_Entity
 
 		// update indices
 		if(update_op->entity_type == GETYPE_NODE) {
+			_statistics_node(ctx, &update_op->n, *update_op->n.attributes,
+					false);
+			Graph_InvalidateNodeColumns(ctx->gc->g, *update_op->n.attributes,
+					update_op->set);
 			// free current entity attribute-set
 			AttributeSet_Free(update_op->n.attributes);
 			// restore entity original attribute-set
 			*update_op->n.attributes = update_op->set;
 			_index_node(ctx, &update_op->n);
+			_statistics_node(ctx, &update_op->n, update_op->set, true);
 		} else {
+			_statistics_edge(ctx, &update_op->e, *update_op->e.attributes,
+					false);
 			AttributeSet_Free(update_op->e.attributes);
 			*update_op->e.attributes = update_op->set;
 			_index_edge(ctx, &update_op->e);
+			_statistics_edge(ctx, &update_op->e, update_op->set, true);
 		}
 	}
 }
@@ -164,6 +208,13 @@ static void _UndoLog_Rollback_Set_Labels
 		_index_delete_node_with_labels(ctx, &(update_labels_op->node),
 				update_labels_op->label_ids, labels_count);
 
+		for(uint j = 0; j < labels_count; j++) {
+			Schema *s = GraphContext_GetSchemaByID(ctx->gc,
+					update_labels_op->label_ids[j], SCHEMA_NODE);
+			Schema_RemoveAttributesFromStatistics(s,
+					*update_labels_op->node.attributes);
+		}
+
 		array_free(update_labels_op->label_ids);
 	}
 }
@@ -187,6 +238,13 @@ static void _UndoLog_Rollback_Remove_Labels
 		_index_node_with_labels(ctx, &(update_labels_op->node),
 				update_labels_op->label_ids, labels_count);
 
+		for(uint j = 0; j < labels_count; j++) {
+			Schema *s = GraphContext_GetSchemaByID(ctx->gc,
+					update_labels_op->label_ids[j], SCHEMA_NODE);
+			Schema_AddAttributesToStatistics(s,
+					*update_labels_op->node.attributes);
+		}
+
 		array_free(update_labels_op->label_ids);
 	}
 }
@@ -209,6 +267,7 @@ static void _UndoLog_Rollback_Create_Node
 		Node *n = &undo_list[seq_start - i].create_op.n;
 		nodes[i] = *n;
 		_index_delete_node(ctx, n);
+		_statistics_node(ctx, n, *n->attributes, false);
 	}
 
 	Graph_DeleteNodes(ctx->gc->g, nodes, node_count);
@@ -233,6 +292,7 @@ static void _UndoLog_Rollback_Create_Edge
 		Edge *e = &undo_list[seq_start - i].create_op.e;
 		edges[i] = *e;
 		_index_delete_edge(ctx, e);
+		_statistics_edge(ctx, e, *e->attributes, false);
 	}
 
 	Graph_DeleteEdges(ctx->gc->g, edges, edge_count);
@@ -258,6 +318,7 @@ static void _UndoLog_Rollback_Delete_Node
 
 		// re-introduce node to indices
 		_index_node(ctx, &n);
+		_statistics_node(ctx, &n, delete_op->set, true);
 
 		// cleanup after undo rollback, as the op D'tor is not called
 		rm_free(delete_op->labels);
@@ -282,6 +343,7 @@ static void _UndoLog_Rollback_Delete_Edge
 		*e.attributes = delete_op.set;
 
 		_index_edge(ctx, &e);
+		_statistics_edge(ctx, &e, delete_op.set, true);
 	}
 }
 
@@ -438,6 +500,42 @@ void UndoLog_DeleteEdge
 	_UndoLog_AddOperation(log, &op);
 }
 
+// undo nodes deletion
+void UndoLog_DeleteNodes
+(
+	UndoLog *log,  // undo log
+	Node *nodes,   // nodes deleted
+	uint64_t n     // number of nodes
+) {
+	ASSERT(log != NULL && *log != NULL);
+	ASSERT(nodes != NULL || n == 0);
+
+	// make room for all operations at once
+	*log = array_ensure_cap(*log, array_len(*log) + n);
+
+	for(uint64_t i = 0; i < n; i++) {
+		UndoLog_DeleteNode(log, nodes + i);
+	}
+}
+
+// undo edges deletion
+void UndoLog_DeleteEdges
+(
+	UndoLog *log,  // undo log
+	Edge *edges,   // edges deleted
+	uint64_t n     // number of edges
+) {
+	ASSERT(log != NULL && *log != NULL);
+	ASSERT(edges != NULL || n == 0);
+
+	// make room for all operations at once
+	*log = array_ensure_cap(*log, array_len(*log) + n);
+
+	for(uint64_t i = 0; i < n; i++) {
+		UndoLog_DeleteEdge(log, edges + i);
+	}
+}
+
 // undo entity update
 void UndoLog_UpdateEntity
 (
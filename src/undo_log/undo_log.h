@@ -152,6 +152,22 @@ void UndoLog_DeleteEdge
 	Edge *edge     // edge deleted
 );
 
+// undo nodes deletion
+void UndoLog_DeleteNodes
+(
+	UndoLog *log,   // undo log
+	Node *nodes,    // nodes deleted
+	uint64_t n      // number of nodes
+);
+
+// undo edges deletion
+void UndoLog_DeleteEdges
+(
+	UndoLog *log,   // undo log
+	Edge *edges,    // edges deleted
+	uint64_t n      // number of edges
+);
+
 // undo entity update
 void UndoLog_UpdateEntity
 (
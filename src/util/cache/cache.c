@@ -16,6 +16,7 @@ static CacheEntry *_CacheEvictLRU(Cache *cache) {
 	raxRemove(cache->lookup, (unsigned  char *)entry->key,
 	  strlen(entry->key), NULL);
 	CacheArray_CleanEntry(entry, cache->free_item);
+	cache->evictions++;
 
 	return entry;
 }
@@ -66,6 +67,9 @@ Cache *Cache_New(uint cap, CacheEntryFreeFunc freeFunc, CacheEntryCopyFunc copyF
 	cache->copy_item = copyFunc;
 	cache->free_item = freeFunc;
 	cache->arr = rm_calloc(cap, sizeof(CacheEntry)); // Array of cached values.
+	cache->hits      = 0;
+	cache->misses    = 0;
+	cache->evictions = 0;
 
 	// Initialize the read-write lock to protect access to the cache.
 	int res = pthread_rwlock_init(&cache->_cache_rwlock, NULL);
@@ -87,7 +91,13 @@ void *Cache_GetValue(Cache *cache, const char *key) {
 	size_t key_len = strlen(key);
 	CacheEntry *entry = raxFind(cache->lookup, (unsigned char *)key, key_len);
 
-	if(entry == raxNotFound) goto cleanup;
+	// lookups are performed under a READ lock, count atomically
+	if(entry == raxNotFound) {
+		atomic_fetch_add(&cache->misses, 1);
+		goto cleanup;
+	}
+
+	atomic_fetch_add(&cache->hits, 1);
 
 	// element is now the most recently used; update its LRU
 	// note that multiple threads can be here simultaneously
@@ -145,6 +155,26 @@ void *Cache_SetGetValue(Cache *cache, const char *key, void *value) {
 	return value_to_return;
 }
 
+CacheStats Cache_GetStats(Cache *cache) {
+	ASSERT(cache != NULL);
+
+	CacheStats stats;
+	stats.hits   = cache->hits;
+	stats.misses = cache->misses;
+
+	// evictions are counted under the WRITE lock
+	int res = pthread_rwlock_rdlock(&cache->_cache_rwlock);
+	UNUSED(res);
+	ASSERT(res == 0);
+
+	stats.evictions = cache->evictions;
+
+	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
+	ASSERT(res == 0);
+
+	return stats;
+}
+
 void Cache_Free(Cache *cache) {
 	ASSERT(cache != NULL);
 
@@ -8,6 +8,8 @@
 
 #include "cache_array.h"
 #include "rax.h"
+#include <stdint.h>
+#include <stdatomic.h>
 
 /**
  * @brief Key-value cache, uses LRU policy for eviction.
@@ -22,8 +24,20 @@ typedef struct Cache {
 	CacheEntryFreeFunc free_item;      // Callback function that free cached value.
 	CacheEntryCopyFunc copy_item;      // Callback function that copies cached value.
 	pthread_rwlock_t _cache_rwlock;    // Read-write lock to protect access to the cache.
+	_Atomic uint64_t hits;             // Number of lookups served by the cache.
+	_Atomic uint64_t misses;           // Number of lookups missing the cache.
+	uint64_t evictions;                // Number of evicted entries.
 } Cache;
 
+/**
+ * @brief Cache usage statistics.
+ */
+typedef struct CacheStats {
+	uint64_t hits;       // Number of lookups served by the cache.
+	uint64_t misses;     // Number of lookups missing the cache.
+	uint64_t evictions;  // Number of evicted entries.
+} CacheStats;
+
 /**
  * @brief  Initialize a cache.
  * @param  size: Number of entries.
@@ -60,6 +74,13 @@ void Cache_SetValue(Cache *cache, const char *key, void *item);
  */
 void *Cache_SetGetValue(Cache *cache, const char *key, void *value);
 
+/**
+ * @brief  Returns cache usage statistics.
+ * @param  *cache: cache pointer.
+ * @retval Number of cache hits, misses and evictions since cache creation.
+ */
+CacheStats Cache_GetStats(Cache *cache);
+
 /**
  * @brief  Destroys the cache and free all stored items.
  * @param  *cache: cache pointer
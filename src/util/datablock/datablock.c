@@ -10,6 +10,7 @@
 #include "../arr.h"
 #include "../rmalloc.h"
 #include <math.h>
+#include <string.h>
 #include <stdbool.h>
 
 // computes the number of blocks required to accommodate n items.
@@ -115,6 +116,29 @@ DataBlockIterator *DataBlock_Scan(const DataBlock *dataBlock) {
 	return DataBlockIterator_New(startBlock, dataBlock->blockCap, endPos);
 }
 
+DataBlockIterator *DataBlock_ScanRange
+(
+	const DataBlock *dataBlock,
+	uint64_t start,
+	uint64_t end
+) {
+	ASSERT(dataBlock != NULL);
+
+	// clamp range to the populated part of the datablock
+	uint64_t scan_end = dataBlock->itemCount + array_len(dataBlock->deletedIdx);
+	end   = MIN(end, scan_end);
+	start = MIN(start, end);
+
+	// an empty range never touches its start block
+	Block *startBlock = (start < end) ? GET_ITEM_BLOCK(dataBlock, start) :
+		dataBlock->blocks[0];
+
+	DataBlockIterator *iter = DataBlockIterator_New(startBlock,
+			dataBlock->blockCap, end);
+	DataBlockIterator_SetRange(iter, startBlock, start, end);
+	return iter;
+}
+
 DataBlockIterator *DataBlock_FullScan(const DataBlock *dataBlock) {
 	ASSERT(dataBlock != NULL);
 	Block *startBlock = dataBlock->blocks[0];
@@ -229,6 +253,102 @@ inline bool DataBlock_ItemIsDeleted(void *item) {
 	return IS_ITEM_DELETED(header);
 }
 
+uint64_t DataBlock_GatherHoles
+(
+	DataBlock *dataBlock,
+	uint64_t limit
+) {
+	ASSERT(dataBlock != NULL);
+
+	uint64_t *idx = dataBlock->deletedIdx;
+	uint64_t n    = array_len(idx);
+	uint64_t end  = n;
+
+	// partition free list, positions below limit are moved to its end
+	// [end, n) holds positions below limit
+	for(uint64_t k = n; k > 0; k--) {
+		if(idx[k - 1] < limit) {
+			end--;
+			uint64_t tmp = idx[k - 1];
+			idx[k - 1] = idx[end];
+			idx[end] = tmp;
+		}
+	}
+
+	return n - end;
+}
+
+uint64_t DataBlock_MoveItem
+(
+	DataBlock *dataBlock,
+	uint64_t src,
+	uint64_t i
+) {
+	ASSERT(dataBlock != NULL);
+	ASSERT(i < array_len(dataBlock->deletedIdx));
+	ASSERT(!_DataBlock_IndexOutOfBounds(dataBlock, src));
+
+	uint64_t k    = array_len(dataBlock->deletedIdx) - 1 - i;
+	uint64_t dest = dataBlock->deletedIdx[k];
+
+	DataBlockItemHeader *src_header  = DataBlock_GetItemHeader(dataBlock, src);
+	DataBlockItemHeader *dest_header = DataBlock_GetItemHeader(dataBlock, dest);
+
+	ASSERT(!IS_ITEM_DELETED(src_header));
+	ASSERT(IS_ITEM_DELETED(dest_header));
+
+	memcpy(ITEM_DATA(dest_header), ITEM_DATA(src_header),
+			dataBlock->itemSize - ITEM_HEADER_SIZE);
+
+	MARK_HEADER_AS_NOT_DELETED(dest_header);
+	MARK_HEADER_AS_DELETED(src_header);
+
+	// number of items is unchanged, src replaces dest as a free position
+	dataBlock->deletedIdx[k] = src;
+
+	return dest;
+}
+
+void DataBlock_Trim
+(
+	DataBlock *dataBlock
+) {
+	ASSERT(dataBlock != NULL);
+
+	// find the end of the populated part of the datablock
+	uint64_t len = dataBlock->itemCount + array_len(dataBlock->deletedIdx);
+	while(len > 0 &&
+		  IS_ITEM_DELETED(DataBlock_GetItemHeader(dataBlock, len - 1))) {
+		len--;
+	}
+
+	// drop trailing positions from the free list, keeping its order
+	uint64_t *idx = dataBlock->deletedIdx;
+	uint64_t n    = array_len(idx);
+	uint64_t j    = 0;
+	for(uint64_t k = 0; k < n; k++) {
+		if(idx[k] < len) idx[j++] = idx[k];
+	}
+	dataBlock->deletedIdx = array_trimm_len(dataBlock->deletedIdx, j);
+
+	ASSERT(dataBlock->itemCount + array_len(dataBlock->deletedIdx) == len);
+
+	// free blocks beyond the populated part, keep at least one block
+	uint blockCount = MAX(1, ITEM_COUNT_TO_BLOCK_COUNT(len, dataBlock->blockCap));
+	if(blockCount >= dataBlock->blockCount) return;
+
+	for(uint i = blockCount; i < dataBlock->blockCount; i++) {
+		Block_Free(dataBlock->blocks[i]);
+	}
+
+	dataBlock->blockCount = blockCount;
+	dataBlock->blocks = rm_realloc(dataBlock->blocks,
+			sizeof(Block *) * dataBlock->blockCount);
+	dataBlock->blocks[blockCount - 1]->next = NULL;
+
+	dataBlock->itemCap = dataBlock->blockCount * dataBlock->blockCap;
+}
+
 //------------------------------------------------------------------------------
 // Out of order functionality
 //------------------------------------------------------------------------------
@@ -77,6 +77,14 @@ void DataBlock_Ensure(DataBlock *dataBlock, uint64_t idx);
 // Returns an iterator which scans entire datablock.
 DataBlockIterator *DataBlock_Scan(const DataBlock *dataBlock);
 
+// Returns an iterator which scans items within positions [start, end).
+DataBlockIterator *DataBlock_ScanRange
+(
+	const DataBlock *dataBlock,
+	uint64_t start,
+	uint64_t end
+);
+
 // Returns an iterator which scans entire out of order datablock.
 DataBlockIterator *DataBlock_FullScan(const DataBlock *dataBlock);
 
@@ -100,6 +108,32 @@ uint DataBlock_DeletedItemsCount(const DataBlock *dataBlock);
 // Returns true if the given item has been deleted.
 bool DataBlock_ItemIsDeleted(void *item);
 
+// gathers free positions below 'limit' at the end of the free list
+// returns the number of free positions below 'limit'
+uint64_t DataBlock_GatherHoles
+(
+	DataBlock *dataBlock,  // datablock
+	uint64_t limit         // gather free positions below limit
+);
+
+// moves item at position 'src' into the i'th gathered free position
+// counting from the end of the free list, 'src' takes the free position's
+// place in the free list, the item's destructor is not called
+// returns the item's new position
+uint64_t DataBlock_MoveItem
+(
+	DataBlock *dataBlock,  // datablock
+	uint64_t src,          // position of item to move
+	uint64_t i             // gathered free position to move item into
+);
+
+// drops deleted items trailing the last item
+// and frees blocks which no longer hold any item
+void DataBlock_Trim
+(
+	DataBlock *dataBlock  // datablock to trim
+);
+
 // Free block.
 void DataBlock_Free(DataBlock *block);
 
@@ -25,11 +25,30 @@ DataBlockIterator *DataBlockIterator_New
 	iter->_current_block  =  block;
 	iter->_block_pos      =  0;
 	iter->_block_cap      =  block_cap;
+	iter->_start_pos      =  0;
 	iter->_current_pos    =  0;
 	iter->_end_pos        =  end_pos;
 	return iter;
 }
 
+void DataBlockIterator_SetRange
+(
+	DataBlockIterator *iter,
+	Block *block,
+	uint64_t start_pos,
+	uint64_t end_pos
+) {
+	ASSERT(iter != NULL);
+	ASSERT(block != NULL);
+	ASSERT(start_pos <= end_pos);
+
+	iter->_start_block  =  block;
+	iter->_start_pos    =  start_pos;
+	iter->_end_pos      =  end_pos;
+
+	DataBlockIterator_Reset(iter);
+}
+
 void *DataBlockIterator_Next
 (
 	DataBlockIterator *iter,
@@ -72,8 +91,8 @@ void DataBlockIterator_Reset
 	DataBlockIterator *iter
 ) {
 	ASSERT(iter != NULL);
-	iter->_block_pos      =  0;
-	iter->_current_pos    =  0;
+	iter->_block_pos      =  iter->_start_pos % iter->_block_cap;
+	iter->_current_pos    =  iter->_start_pos;
 	iter->_current_block  =  iter->_start_block;
 }
 
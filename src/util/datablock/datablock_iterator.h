@@ -16,6 +16,7 @@ typedef struct {
 	Block *_current_block;			// current block
 	uint64_t _block_pos;			// position within a block
 	uint64_t _block_cap;            // max number of items in block
+	uint64_t _start_pos;			// position at which iteration begins
 	uint64_t _current_pos;			// iterator current position
 	uint64_t _end_pos;				// iterator won't pass end position
 } DataBlockIterator;
@@ -28,6 +29,16 @@ DataBlockIterator *DataBlockIterator_New
 	uint64_t end_pos	 // iteration stops here
 );
 
+// restrict iterator to positions [start_pos, end_pos)
+// `block` must be the block containing `start_pos`
+void DataBlockIterator_SetRange
+(
+	DataBlockIterator *iter,  // iterator
+	Block *block,             // block containing start_pos
+	uint64_t start_pos,       // iteration begins here
+	uint64_t end_pos          // iteration stops here
+);
+
 #define DataBlockIterator_Position(iter) (iter)->_current_pos
 
 // Returns the next item, unless we've reached the end
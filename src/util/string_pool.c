@@ -0,0 +1,188 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "dict.h"
+#include "xxhash.h"
+#include "rmalloc.h"
+#include "string_pool.h"
+
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// interned string header, the string itself follows the header
+typedef struct {
+	uint64_t hash;               // precomputed string hash
+	uint64_t _Atomic refcount;   // number of references to the string
+	char str[];                  // null terminated string
+} _StringPoolEntry;
+
+#define ENTRY(s) ((_StringPoolEntry *)((s) - offsetof(_StringPoolEntry, str)))
+
+// the pool is split into shards by string hash, each guarded by its own lock
+// such that threads interning different strings rarely contend
+#define SHARD_BITS 6
+#define SHARD_COUNT (1 << SHARD_BITS)
+
+// shard is picked by the hash's high bits
+// dict buckets are picked by its low bits, keeping shards evenly spread
+#define SHARD(hash) (shards + ((hash) >> (64 - SHARD_BITS)))
+
+typedef struct {
+	// guards the shard
+	// held while adding strings and while releasing a string's last reference
+	pthread_mutex_t lock;
+	dict *strings;  // interned strings
+} _StringPoolShard;
+
+static _StringPoolShard shards[SHARD_COUNT];
+
+// shards are initialized on first use
+static pthread_once_t shards_once = PTHREAD_ONCE_INIT;
+
+static uint64_t _hash
+(
+	const void *key
+) {
+	const char *s = key;
+	return StringPool_HashString(s, strlen(s));
+}
+
+static int _compare
+(
+	dict *d,
+	const void *a,
+	const void *b
+) {
+	return strcmp(a, b) == 0;
+}
+
+static dictType _pool_dt = {_hash, NULL, NULL, _compare, NULL, NULL, NULL,
+	NULL, NULL, NULL};
+
+static void _init_shards(void) {
+	for(int i = 0; i < SHARD_COUNT; i++) {
+		int res = pthread_mutex_init(&shards[i].lock, NULL);
+		ASSERT(res == 0);
+		UNUSED(res);
+		shards[i].strings = HashTableCreate(&_pool_dt);
+	}
+}
+
+uint64_t StringPool_HashString
+(
+	const char *s,
+	size_t len
+) {
+	ASSERT(s != NULL);
+	return XXH64(s, len, 0);
+}
+
+char *StringPool_Intern
+(
+	const char *s
+) {
+	ASSERT(s != NULL);
+
+	size_t len = strlen(s);
+	if(len > STRING_POOL_MAX_LEN) return NULL;
+
+	pthread_once(&shards_once, _init_shards);
+
+	uint64_t hash = StringPool_HashString(s, len);
+	_StringPoolShard *shard = SHARD(hash);
+
+	pthread_mutex_lock(&shard->lock);
+
+	_StringPoolEntry *e;
+	dictEntry *de = HashTableFind(shard->strings, s);
+	if(de != NULL) {
+		// string already interned
+		e = ENTRY((char *)HashTableGetKey(de));
+		e->refcount++;
+	} else {
+		// introduce string
+		e = rm_malloc(sizeof(_StringPoolEntry) + len + 1);
+		e->hash     = hash;
+		e->refcount = 1;
+		memcpy(e->str, s, len + 1);
+
+		int res = HashTableAdd(shard->strings, e->str, NULL);
+		ASSERT(res == DICT_OK);
+	}
+
+	pthread_mutex_unlock(&shard->lock);
+
+	return e->str;
+}
+
+char *StringPool_Retain
+(
+	char *s
+) {
+	ASSERT(s != NULL);
+
+	// caller holds a reference, the string can't be removed concurrently
+	_StringPoolEntry *e = ENTRY(s);
+	ASSERT(e->refcount > 0);
+	e->refcount++;
+
+	return s;
+}
+
+void StringPool_Release
+(
+	char *s
+) {
+	ASSERT(s != NULL);
+
+	_StringPoolEntry *e = ENTRY(s);
+
+	// release without locking as long as this isn't the last reference
+	uint64_t refcount = e->refcount;
+	while(refcount > 1) {
+		if(atomic_compare_exchange_weak(&e->refcount, &refcount,
+					refcount - 1)) {
+			return;
+		}
+	}
+
+	// possibly the last reference, synchronize with interning threads
+	// which might revive the string
+	_StringPoolShard *shard = SHARD(e->hash);
+	pthread_mutex_lock(&shard->lock);
+
+	if(atomic_fetch_sub(&e->refcount, 1) == 1) {
+		int res = HashTableDelete(shard->strings, e->str);
+		ASSERT(res == DICT_OK);
+		rm_free(e);
+	}
+
+	pthread_mutex_unlock(&shard->lock);
+}
+
+uint64_t StringPool_Hash
+(
+	const char *s
+) {
+	ASSERT(s != NULL);
+	return ENTRY(s)->hash;
+}
+
+uint64_t StringPool_Size(void) {
+	pthread_once(&shards_once, _init_shards);
+
+	uint64_t n = 0;
+	for(int i = 0; i < SHARD_COUNT; i++) {
+		_StringPoolShard *shard = shards + i;
+		pthread_mutex_lock(&shard->lock);
+		n += HashTableElemCount(shard->strings);
+		pthread_mutex_unlock(&shard->lock);
+	}
+
+	return n;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// string pool
+//
+// reference counted dictionary of interned strings
+// interning a string returns a shared copy of it, every distinct string is
+// held once no matter how many values refer to it
+//
+// an interned string is a regular null terminated string prefixed by a
+// header holding its reference count and precomputed hash
+// as such two interned strings are equal if and only if they share an address
+//
+// the pool is shared by all graphs and is safe to access from multiple threads
+// it is sharded by string hash, threads interning different strings rarely
+// contend on the same lock
+
+// strings longer than this aren't interned
+// long strings rarely repeat and the pool's per string overhead
+// isn't worth paying for them
+#define STRING_POOL_MAX_LEN 128
+
+// intern string
+// returns a shared copy of `s`, NULL if `s` is too long to be interned
+// the returned string must be released via StringPool_Release
+char *StringPool_Intern
+(
+	const char *s  // string to intern
+);
+
+// acquire an additional reference to an interned string
+char *StringPool_Retain
+(
+	char *s  // interned string
+);
+
+// release a reference to an interned string
+// the string is removed from the pool once its last reference is released
+void StringPool_Release
+(
+	char *s  // interned string
+);
+
+// returns interned string's precomputed hash
+uint64_t StringPool_Hash
+(
+	const char *s  // interned string
+);
+
+// hash a string, interned strings precompute their hash using this function
+uint64_t StringPool_HashString
+(
+	const char *s,  // string to hash
+	size_t len      // string length
+);
+
+// returns number of distinct strings in the pool
+uint64_t StringPool_Size(void);
@@ -5,8 +5,11 @@
  */
 
 #include <pthread.h>
+#include <stdatomic.h>
+#include <sys/param.h>
 #include "RG.h"
 #include "pools.h"
+#include "../rmalloc.h"
 #include "../../configuration/config.h"
 
 //------------------------------------------------------------------------------
@@ -141,13 +144,117 @@ int ThreadPools_AddWorkReader
 	void (*function_p)(void *),  // function to run
 	void *arg_p,                 // function arguments
 	int force                    // true will add task even if internal queue is full
+) {
+	return ThreadPools_AddWorkReaderPriority(function_p, arg_p,
+			THPOOL_PRIORITY_HIGH, force);
+}
+
+// adds a read task to one of the readers priority lanes
+int ThreadPools_AddWorkReaderPriority
+(
+	void (*function_p)(void *),  // function to run
+	void *arg_p,                 // function arguments
+	thpool_priority priority,    // priority lane
+	int force                    // true will add task even if internal queue is full
 ) {
 	ASSERT(_readers_thpool != NULL);
 
 	// make sure there's enough room in thread pool queue
 	if(!force && thpool_queue_full(_readers_thpool)) return THPOOL_QUEUE_FULL;
 
-	return thpool_add_work(_readers_thpool, function_p, arg_p);
+	return thpool_add_work_priority(_readers_thpool, function_p, arg_p,
+			priority);
+}
+
+// work items shared by a calling thread and reader threads
+typedef struct {
+	void (*fn)(void *, uint64_t);  // processes a single item
+	void *arg;                     // fn argument
+	uint64_t n;                    // number of items
+	uint64_t _Atomic next;         // next unclaimed item
+	uint _Atomic refs;             // calling thread and queued tasks
+	uint64_t done;                 // number of processed items
+	pthread_mutex_t mutex;         // guards done
+	pthread_cond_t cond;           // signaled once all items are processed
+} _ParallelFor;
+
+static void _ParallelFor_Release
+(
+	_ParallelFor *pf
+) {
+	if(atomic_fetch_sub(&pf->refs, 1) != 1) return;
+
+	pthread_cond_destroy(&pf->cond);
+	pthread_mutex_destroy(&pf->mutex);
+	rm_free(pf);
+}
+
+// process items until none is left unclaimed
+static void _ParallelFor_Run
+(
+	_ParallelFor *pf
+) {
+	uint64_t i;
+	while((i = atomic_fetch_add(&pf->next, 1)) < pf->n) {
+		pf->fn(pf->arg, i);
+
+		pthread_mutex_lock(&pf->mutex);
+		if(++pf->done == pf->n) pthread_cond_signal(&pf->cond);
+		pthread_mutex_unlock(&pf->mutex);
+	}
+}
+
+static void _ParallelFor_Task
+(
+	void *arg
+) {
+	_ParallelFor *pf = (_ParallelFor *)arg;
+	_ParallelFor_Run(pf);
+	_ParallelFor_Release(pf);
+}
+
+void ThreadPools_ReadersParallelFor
+(
+	void (*fn)(void *arg, uint64_t i),
+	void *arg,
+	uint64_t n
+) {
+	ASSERT(fn != NULL);
+	ASSERT(_readers_thpool != NULL);
+
+	if(n == 0) return;
+	if(n == 1) {
+		fn(arg, 0);
+		return;
+	}
+
+	_ParallelFor *pf = rm_calloc(1, sizeof(_ParallelFor));
+	pf->fn   = fn;
+	pf->arg  = arg;
+	pf->n    = n;
+	pf->refs = 1;
+	pthread_mutex_init(&pf->mutex, NULL);
+	pthread_cond_init(&pf->cond, NULL);
+
+	// the calling thread processes an item as well
+	// items not picked up by tasks are processed by the calling thread
+	uint64_t tasks = MIN(n - 1, thpool_num_threads(_readers_thpool));
+	for(uint64_t i = 0; i < tasks; i++) {
+		atomic_fetch_add(&pf->refs, 1);
+		if(ThreadPools_AddWorkReader(_ParallelFor_Task, pf, false) != 0) {
+			atomic_fetch_sub(&pf->refs, 1);
+			break;
+		}
+	}
+
+	_ParallelFor_Run(pf);
+
+	// wait for items claimed by reader threads
+	pthread_mutex_lock(&pf->mutex);
+	while(pf->done < pf->n) pthread_cond_wait(&pf->cond, &pf->mutex);
+	pthread_mutex_unlock(&pf->mutex);
+
+	_ParallelFor_Release(pf);
 }
 
 // add task for writer thread
@@ -206,6 +313,17 @@ void **ThreadPools_GetTasksByHandler
 	return tasks;
 }
 
+// collects the queueing statistics of a readers priority lane
+void ThreadPools_ReadersWaitStats
+(
+	thpool_priority priority,  // priority lane
+	uint64_t *jobs,            // number of tasks dequeued
+	double *wait_ms            // accumulated queueing time in milliseconds
+) {
+	ASSERT(_readers_thpool != NULL);
+	thpool_get_wait_stats(_readers_thpool, priority, jobs, wait_ms);
+}
+
 void ThreadPools_Destroy
 (
 	void
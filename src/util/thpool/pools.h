@@ -7,6 +7,7 @@
 #pragma once
 
 #include "thpool.h"
+#include <stdint.h>
 #include <sys/types.h>
 
 #define THPOOL_QUEUE_FULL -2
@@ -51,6 +52,27 @@ int ThreadPools_AddWorkReader
 	int force                    // true will add task even if internal queue is full
 );
 
+// adds a read task to one of the readers priority lanes
+int ThreadPools_AddWorkReaderPriority
+(
+	void (*function_p)(void *),  // function to run
+	void *arg_p,                 // function arguments
+	thpool_priority priority,    // priority lane
+	int force                    // true will add task even if internal queue is full
+);
+
+// process `n` work items on the readers thread-pool
+// `fn` is invoked once for each item index in [0, n)
+// the calling thread processes items as well and only waits for items
+// reader threads already started processing, as such it is safe to call
+// from a reader thread or while all reader threads are occupied
+void ThreadPools_ReadersParallelFor
+(
+	void (*fn)(void *arg, uint64_t i),  // processes item i
+	void *arg,                          // fn argument
+	uint64_t n                          // number of items
+);
+
 // add a write task
 int ThreadPools_AddWorkWriter
 (
@@ -74,6 +96,14 @@ void **ThreadPools_GetTasksByHandler
 	uint32_t *n               // number of tasks returned
 );
 
+// collects the queueing statistics of a readers priority lane
+void ThreadPools_ReadersWaitStats
+(
+	thpool_priority priority,  // priority lane
+	uint64_t *jobs,            // number of tasks dequeued
+	double *wait_ms            // accumulated queueing time in milliseconds
+);
+
 // destroies all threadpools, allows threads to exit gracefully
 void ThreadPools_Destroy
 (
@@ -39,6 +39,10 @@
 #define err(str)
 #endif
 
+/* A thread consults the low priority lane first after running this many
+ * consecutive high priority jobs */
+#define THPOOL_LOW_PRIORITY_INTERVAL 8
+
 static atomic_uint_fast32_t threads_keepalive;
 static atomic_uint_fast32_t threads_on_hold;
 
@@ -56,6 +60,8 @@ typedef struct job {
 	struct job *prev;            /* pointer to previous job   */
 	void (*function)(void *arg); /* function pointer          */
 	void *arg;                   /* function's argument       */
+	thpool_priority priority;    /* priority lane             */
+	struct timespec queued;      /* time job was queued       */
 } job;
 
 /* Job queue */
@@ -63,27 +69,39 @@ typedef struct jobqueue {
 	pthread_mutex_t rwmutex; 		/* used for queue r/w access */
 	job *front;              		/* pointer to front of queue */
 	job *rear;               		/* pointer to rear  of queue */
-	bsem *has_jobs;          		/* flag as binary semaphore  */
-	int len;                 		/* number of jobs in queue   */
-	uint64_t cap;                   /* capacity of the queue     */
+	atomic_int len;          		/* number of jobs in queue   */
 } jobqueue;
 
+/* Priority lane statistics */
+typedef struct lanestats {
+	atomic_uint_fast64_t jobs;     /* number of jobs dequeued        */
+	atomic_uint_fast64_t wait_us;  /* accumulated queueing time (us) */
+} lanestats;
+
 /* Thread */
 typedef struct thread {
 	int id;                   /* friendly id               */
 	pthread_t pthread;        /* pointer to actual thread  */
 	struct thpool_ *thpool_p; /* access to thpool          */
+	uint64_t streak;          /* consecutive high priority jobs */
+	jobqueue queues[THPOOL_PRIORITY_COUNT]; /* thread's queue per lane */
 } thread;
 
 /* Threadpool */
 typedef struct thpool_ {
 	thread **threads;                         /* pointer to threads              */
+	int num_threads;                          /* number of threads in pool       */
 	const char *name;                         /* name associated with pool       */
 	atomic_uint_fast32_t num_threads_alive;   /* threads currently alive         */
 	atomic_uint_fast32_t num_threads_working; /* threads currently working       */
+	atomic_uint_fast32_t num_low_working;     /* threads running low priority    */
+	atomic_uint_fast32_t next_queue;          /* round robin queue selector      */
+	atomic_uint_fast64_t len;                 /* number of queued jobs           */
+	uint64_t cap;                             /* max number of queued jobs       */
+	bsem *has_jobs;                           /* flag as binary semaphore        */
 	pthread_mutex_t thcount_lock;             /* used for the condition variable */
 	pthread_cond_t threads_all_idle;          /* signal to thpool_wait           */
-	jobqueue jobqueue;                        /* job queue                       */
+	lanestats stats[THPOOL_PRIORITY_COUNT];   /* per lane statistics             */
 } thpool_;
 
 /* ========================== PROTOTYPES ============================ */
@@ -91,16 +109,16 @@ typedef struct thpool_ {
 static int thread_init(thpool_* thpool_p, struct thread **thread_p, int id);
 static void *thread_do(struct thread *thread_p);
 static void thread_hold(int sig_id);
+static struct job *thread_take(struct thread *thread_p);
 static void thread_destroy(struct thread *thread_p);
 
-static int jobqueue_init(jobqueue *jobqueue_p);
+static void jobqueue_init(jobqueue *jobqueue_p);
 static void jobqueue_clear(jobqueue *jobqueue_p);
 static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob_p);
 static struct job *jobqueue_pull(jobqueue *jobqueue_p);
 static void jobqueue_destroy(jobqueue *jobqueue_p);
 
 static void bsem_init(struct bsem *bsem_p, int value);
-static void bsem_reset(struct bsem *bsem_p);
 static void bsem_post(struct bsem *bsem_p);
 static void bsem_post_all(struct bsem *bsem_p);
 static void bsem_wait(struct bsem *bsem_p);
@@ -130,21 +148,24 @@ struct thpool_ *thpool_init(int num_threads, const char *name) {
 	}
 
 	thpool_p->name = name;
+	thpool_p->num_threads = num_threads;
 	thpool_p->num_threads_alive = 0;
 	thpool_p->num_threads_working = 0;
+	thpool_p->cap = UINT64_MAX; // unlimited queue size
 
-	/* Initialise the job queue */
-	if(jobqueue_init(&thpool_p->jobqueue) == -1) {
+	thpool_p->has_jobs = (struct bsem *)rm_calloc(1, sizeof(struct bsem));
+	if(thpool_p->has_jobs == NULL) {
 		err("thpool_init(): Could not allocate memory for job queue\n");
 		rm_free(thpool_p);
 		return NULL;
 	}
+	bsem_init(thpool_p->has_jobs, 0);
 
 	/* Make threads in pool */
 	thpool_p->threads = (struct thread **)rm_calloc(num_threads, sizeof(struct thread *));
 	if(thpool_p->threads == NULL) {
 		err("thpool_init(): Could not allocate memory for threads\n");
-		jobqueue_destroy(&thpool_p->jobqueue);
+		rm_free(thpool_p->has_jobs);
 		rm_free(thpool_p);
 		return NULL;
 	}
@@ -170,6 +191,20 @@ struct thpool_ *thpool_init(int num_threads, const char *name) {
 
 /* Add work to the thread pool */
 int thpool_add_work(thpool_* thpool_p, void (*function_p)(void *), void *arg_p) {
+	return thpool_add_work_priority(thpool_p, function_p, arg_p,
+			THPOOL_PRIORITY_HIGH);
+}
+
+/* Add work to one of the thread pool's priority lanes */
+int thpool_add_work_priority(thpool_* thpool_p, void (*function_p)(void *),
+		void *arg_p, thpool_priority priority) {
+	ASSERT(priority < THPOOL_PRIORITY_COUNT);
+
+	if(thpool_p->num_threads == 0) {
+		err("thpool_add_work(): Thread pool has no threads\n");
+		return -1;
+	}
+
 	job *newjob;
 
 	newjob = (struct job *)rm_calloc(1, sizeof(struct job));
@@ -181,9 +216,15 @@ int thpool_add_work(thpool_* thpool_p, void (*function_p)(void *), void *arg_p)
 	/* add function and argument */
 	newjob->function = function_p;
 	newjob->arg = arg_p;
+	newjob->priority = priority;
+	clock_gettime(CLOCK_MONOTONIC, &newjob->queued);
 
-	/* add job to queue */
-	jobqueue_push(&thpool_p->jobqueue, newjob);
+	/* spread jobs across threads' queues, idle threads steal the rest */
+	uint32_t n = thpool_p->next_queue++ % thpool_p->num_threads;
+	jobqueue_push(&thpool_p->threads[n]->queues[priority], newjob);
+
+	thpool_p->len++;
+	bsem_post(thpool_p->has_jobs);
 
 	return 0;
 }
@@ -191,7 +232,7 @@ int thpool_add_work(thpool_* thpool_p, void (*function_p)(void *), void *arg_p)
 /* Wait until all jobs have finished */
 void thpool_wait(thpool_* thpool_p) {
 	pthread_mutex_lock(&thpool_p->thcount_lock);
-	while(thpool_p->jobqueue.len || thpool_p->num_threads_working) {
+	while(thpool_p->len || thpool_p->num_threads_working) {
 		pthread_cond_wait(&thpool_p->threads_all_idle, &thpool_p->thcount_lock);
 	}
 	pthread_mutex_unlock(&thpool_p->thcount_lock);
@@ -212,19 +253,19 @@ void thpool_destroy(thpool_* thpool_p) {
 	// Wake up the threads so that they exit and will become ready to be
 	// destroyed.
 	while(thpool_p->num_threads_alive) {
-		bsem_post_all(thpool_p->jobqueue.has_jobs);
+		bsem_post_all(thpool_p->has_jobs);
 	}
 
-	// Destroy the threads.
+	// Destroy the threads along with their job queues.
 	for (size_t i = 0; i < threads_total; ++i) {
-		ASSERT(pthread_join(thpool_p->threads[i]->pthread, NULL) == 0);
+		int res = pthread_join(thpool_p->threads[i]->pthread, NULL);
+		ASSERT(res == 0);
+		UNUSED(res);
 		thread_destroy(thpool_p->threads[i]);
 	}
 	rm_free(thpool_p->threads);
 
-	/* Job queue cleanup */
-	jobqueue_destroy(&thpool_p->jobqueue);
-
+	rm_free(thpool_p->has_jobs);
 	rm_free(thpool_p);
 }
 
@@ -274,7 +315,7 @@ bool thpool_queue_full(thpool_* thpool_p) {
 	ASSERT(thpool_p != NULL);
 
 	// test if there's enough room in thread pool queue
-	return (thpool_p->jobqueue.len >= thpool_p->jobqueue.cap);
+	return (thpool_p->len >= thpool_p->cap);
 }
 
 void thpool_set_jobqueue_cap
@@ -283,7 +324,7 @@ void thpool_set_jobqueue_cap
 	uint64_t val
 ) {
 	ASSERT(thpool_p);
-	thpool_p->jobqueue.cap = val;
+	thpool_p->cap = val;
 }
 
 uint64_t thpool_get_jobqueue_cap
@@ -291,7 +332,7 @@ uint64_t thpool_get_jobqueue_cap
 	thpool_* thpool_p
 ) {
 	ASSERT(thpool_p);
-	return thpool_p->jobqueue.cap;
+	return thpool_p->cap;
 }
 
 uint64_t thpool_get_jobqueue_len
@@ -299,7 +340,7 @@ uint64_t thpool_get_jobqueue_len
 	thpool_* thpool_p
 ) {
 	ASSERT(thpool_p);
-	return thpool_p->jobqueue.len;
+	return thpool_p->len;
 }
 
 // collects tasks matching given handler
@@ -317,37 +358,55 @@ void thpool_get_tasks
 	ASSERT(thpool_p  != NULL);
 	ASSERT(num_tasks != NULL);
 
-	jobqueue *jobqueue_p = &thpool_p->jobqueue;
+	uint32_t i = 0;
 
-	// lock job queue
-	pthread_mutex_lock(&jobqueue_p->rwmutex);
+	// iterate through each thread's job queues
+	for(int t = 0; t < thpool_p->num_threads && i < *num_tasks; t++) {
+		for(int p = 0; p < THPOOL_PRIORITY_COUNT && i < *num_tasks; p++) {
+			jobqueue *jobqueue_p = &thpool_p->threads[t]->queues[p];
 
-	job *job = jobqueue_p->front;
+			// lock job queue
+			pthread_mutex_lock(&jobqueue_p->rwmutex);
 
-	// iterate through job queue
-	uint32_t i = 0;
-	for(; i < jobqueue_p->len && i < *num_tasks; i++) {
-		// check if job matches given handler
-		if(job->function == handler) {
-			tasks[i] = job->arg;
-
-			// execute match function if given
-			if(match != NULL) {
-				match(job->arg);
+			job *job = jobqueue_p->front;
+			for(; job != NULL && i < *num_tasks; job = job->prev) {
+				// check if job matches given handler
+				if(job->function != handler) continue;
+
+				tasks[i++] = job->arg;
+
+				// execute match function if given
+				if(match != NULL) {
+					match(job->arg);
+				}
 			}
-		}
 
-		// advance to next job
-		job = job->prev;
+			// release lock
+			pthread_mutex_unlock(&jobqueue_p->rwmutex);
+		}
 	}
 
-	// release lock
-	pthread_mutex_unlock(&jobqueue_p->rwmutex);
-
 	// set number of tasks collected
 	*num_tasks = i;
 }
 
+// collects the queueing statistics of a priority lane
+void thpool_get_wait_stats
+(
+	threadpool thpool_p,       // thread pool
+	thpool_priority priority,  // priority lane
+	uint64_t *jobs,            // number of jobs dequeued
+	double *wait_ms            // accumulated queueing time in milliseconds
+) {
+	ASSERT(jobs     != NULL);
+	ASSERT(wait_ms  != NULL);
+	ASSERT(thpool_p != NULL);
+	ASSERT(priority < THPOOL_PRIORITY_COUNT);
+
+	*jobs    = thpool_p->stats[priority].jobs;
+	*wait_ms = thpool_p->stats[priority].wait_us / 1000.0;
+}
+
 /* ============================ THREAD ============================== */
 
 /* Initialize a thread in the thread pool
@@ -367,6 +426,10 @@ static int thread_init(thpool_* thpool_p, struct thread **thread_p, int id) {
 	(*thread_p)->thpool_p = thpool_p;
 	(*thread_p)->id = id;
 
+	for(int p = 0; p < THPOOL_PRIORITY_COUNT; p++) {
+		jobqueue_init(&(*thread_p)->queues[p]);
+	}
+
 	pthread_create(&(*thread_p)->pthread, NULL, (void *)thread_do, (*thread_p));
 	return 0;
 }
@@ -380,6 +443,89 @@ static void thread_hold(int sig_id) {
 	}
 }
 
+/* Reserve a thread for running a low priority job
+ *
+ * Low priority jobs may occupy all threads but one, such that a high
+ * priority job is never queued behind long running jobs only.
+ *
+ * @return true if a reservation was made
+ */
+static bool thread_reserve_low(thpool_* thpool_p) {
+	uint32_t max = (thpool_p->num_threads > 1) ? thpool_p->num_threads - 1 : 1;
+	uint_fast32_t n = thpool_p->num_low_working;
+
+	while(n < max) {
+		if(atomic_compare_exchange_weak(&thpool_p->num_low_working, &n, n + 1)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Take a job from a priority lane
+ *
+ * The thread's own queue is consulted first, when empty a job is stolen
+ * from the queue of another thread.
+ */
+static struct job *thread_take_lane(struct thread *thread_p,
+		thpool_priority priority) {
+	thpool_* thpool_p = thread_p->thpool_p;
+	int n = thpool_p->num_threads;
+
+	for(int i = 0; i < n; i++) {
+		thread *victim = thpool_p->threads[(thread_p->id + i) % n];
+		job *job_p = jobqueue_pull(&victim->queues[priority]);
+		if(job_p != NULL) return job_p;
+	}
+
+	return NULL;
+}
+
+/* Take the next job to run, NULL if no job can be taken
+ *
+ * High priority jobs are preferred, to avoid starving the low priority
+ * lane it is consulted first once every THPOOL_LOW_PRIORITY_INTERVAL jobs.
+ */
+static struct job *thread_take(struct thread *thread_p) {
+	thpool_* thpool_p = thread_p->thpool_p;
+	thpool_priority lanes[THPOOL_PRIORITY_COUNT] = {THPOOL_PRIORITY_HIGH,
+		THPOOL_PRIORITY_LOW};
+
+	if(thread_p->streak >= THPOOL_LOW_PRIORITY_INTERVAL) {
+		lanes[0] = THPOOL_PRIORITY_LOW;
+		lanes[1] = THPOOL_PRIORITY_HIGH;
+	}
+
+	for(int i = 0; i < THPOOL_PRIORITY_COUNT; i++) {
+		thpool_priority priority = lanes[i];
+		bool low = (priority == THPOOL_PRIORITY_LOW);
+
+		if(low && !thread_reserve_low(thpool_p)) continue;
+
+		job *job_p = thread_take_lane(thread_p, priority);
+		if(job_p == NULL) {
+			if(low) --thpool_p->num_low_working;
+			continue;
+		}
+
+		thread_p->streak = low ? 0 : thread_p->streak + 1;
+		thpool_p->len--;
+
+		/* account for the time job spent in queue */
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		int64_t wait_us = (now.tv_sec - job_p->queued.tv_sec) * 1000000 +
+			(now.tv_nsec - job_p->queued.tv_nsec) / 1000;
+		thpool_p->stats[priority].jobs++;
+		thpool_p->stats[priority].wait_us += (wait_us > 0) ? wait_us : 0;
+
+		return job_p;
+	}
+
+	return NULL;
+}
+
 /* What each thread is doing
 *
 * In principle this is an endless loop. The only time this loop gets interuppted is once
@@ -420,29 +566,34 @@ static void *thread_do(struct thread *thread_p) {
 
 	while(threads_keepalive) {
 
-		bsem_wait(thpool_p->jobqueue.has_jobs);
+		bsem_wait(thpool_p->has_jobs);
+
+		if(!threads_keepalive) break;
 
-		if(threads_keepalive) {
-			++thpool_p->num_threads_working;
+		++thpool_p->num_threads_working;
 
-			/* Read job from queue and execute it */
-			void (*func_buff)(void *);
-			void *arg_buff;
-			job *job_p = jobqueue_pull(&thpool_p->jobqueue);
-			if(job_p) {
-				func_buff = job_p->function;
-				arg_buff = job_p->arg;
-				func_buff(arg_buff);
-				rm_free(job_p);
+		/* Run jobs for as long as there are jobs this thread can take */
+		job *job_p;
+		while(threads_keepalive && (job_p = thread_take(thread_p)) != NULL) {
+			/* more jobs pending -> wake another thread */
+			if(thpool_p->len) {
+				bsem_post(thpool_p->has_jobs);
 			}
 
-			--thpool_p->num_threads_working;
-			pthread_mutex_lock(&thpool_p->thcount_lock);
-			if (!thpool_p->num_threads_working) {
-				pthread_cond_signal(&thpool_p->threads_all_idle);
+			job_p->function(job_p->arg);
+
+			if(job_p->priority == THPOOL_PRIORITY_LOW) {
+				--thpool_p->num_low_working;
 			}
-			pthread_mutex_unlock(&thpool_p->thcount_lock);
+			rm_free(job_p);
+		}
+
+		--thpool_p->num_threads_working;
+		pthread_mutex_lock(&thpool_p->thcount_lock);
+		if (!thpool_p->num_threads_working) {
+			pthread_cond_signal(&thpool_p->threads_all_idle);
 		}
+		pthread_mutex_unlock(&thpool_p->thcount_lock);
 	}
 
 	--thpool_p->num_threads_alive;
@@ -450,30 +601,23 @@ static void *thread_do(struct thread *thread_p) {
 	return NULL;
 }
 
-/* Frees a thread  */
+/* Frees a thread and its job queues */
 static void thread_destroy(thread *thread_p) {
+	for(int p = 0; p < THPOOL_PRIORITY_COUNT; p++) {
+		jobqueue_destroy(&thread_p->queues[p]);
+	}
 	rm_free(thread_p);
 }
 
 /* ============================ JOB QUEUE =========================== */
 
 /* Initialize queue */
-static int jobqueue_init(jobqueue *jobqueue_p) {
+static void jobqueue_init(jobqueue *jobqueue_p) {
 	jobqueue_p->len         =  0;
 	jobqueue_p->front       =  NULL;
 	jobqueue_p->rear        =  NULL;
 
-	jobqueue_p->has_jobs = (struct bsem *)rm_calloc(1, sizeof(struct bsem));
-	if(jobqueue_p->has_jobs == NULL) {
-		return -1;
-	}
-
 	pthread_mutex_init(&(jobqueue_p->rwmutex), NULL);
-	bsem_init(jobqueue_p->has_jobs, 0);
-
-	jobqueue_p->cap = UINT64_MAX; // unlimited queue size
-
-	return 0;
 }
 
 /* Clear the queue */
@@ -485,7 +629,6 @@ static void jobqueue_clear(jobqueue *jobqueue_p) {
 
 	jobqueue_p->front = NULL;
 	jobqueue_p->rear = NULL;
-	bsem_reset(jobqueue_p->has_jobs);
 	jobqueue_p->len = 0;
 }
 
@@ -506,17 +649,20 @@ static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob) {
 	}
 
 	jobqueue_p->len++;
-	bsem_post(jobqueue_p->has_jobs);
 
 	pthread_mutex_unlock(&jobqueue_p->rwmutex);
 }
 
 /* Get first job from queue(removes it from queue)
- *
- * Notice: Caller MUST hold a mutex
+ * returns NULL if queue is empty
  */
 static struct job *jobqueue_pull(jobqueue *jobqueue_p) {
 
+	/* peek without locking, skipping empty queues while stealing */
+	if(jobqueue_p->len == 0) {
+		return NULL;
+	}
+
 	pthread_mutex_lock(&jobqueue_p->rwmutex);
 	job *job_p = jobqueue_p->front;
 
@@ -534,8 +680,6 @@ static struct job *jobqueue_pull(jobqueue *jobqueue_p) {
 	default: /* if >1 jobs in queue */
 		jobqueue_p->front = job_p->prev;
 		jobqueue_p->len--;
-		/* more than one job in queue -> post it */
-		bsem_post(jobqueue_p->has_jobs);
 	}
 
 	pthread_mutex_unlock(&jobqueue_p->rwmutex);
@@ -545,7 +689,7 @@ static struct job *jobqueue_pull(jobqueue *jobqueue_p) {
 /* Free all queue resources back to the system */
 static void jobqueue_destroy(jobqueue *jobqueue_p) {
 	jobqueue_clear(jobqueue_p);
-	rm_free(jobqueue_p->has_jobs);
+	pthread_mutex_destroy(&jobqueue_p->rwmutex);
 }
 
 /* ======================== SYNCHRONISATION ========================= */
@@ -561,11 +705,6 @@ static void bsem_init(bsem *bsem_p, int value) {
 	bsem_p->v = value;
 }
 
-/* Reset semaphore to 0 */
-static void bsem_reset(bsem *bsem_p) {
-	bsem_init(bsem_p, 0);
-}
-
 /* Post to at least one thread */
 static void bsem_post(bsem *bsem_p) {
 	pthread_mutex_lock(&bsem_p->mutex);
@@ -19,6 +19,18 @@ extern "C" {
 
 typedef struct thpool_* threadpool;
 
+/* Job priority lanes
+ *
+ * Each thread holds a queue per lane, idle threads steal jobs from the
+ * queues of busy threads. High priority jobs are served first and low
+ * priority jobs never occupy all of the pool's threads.
+ */
+typedef enum {
+	THPOOL_PRIORITY_HIGH = 0,  /* latency sensitive jobs */
+	THPOOL_PRIORITY_LOW,       /* long running jobs      */
+	THPOOL_PRIORITY_COUNT
+} thpool_priority;
+
 
 /**
  * @brief  Initialize threadpool
@@ -71,6 +83,21 @@ threadpool thpool_init(int num_threads, const char *name);
 int thpool_add_work(threadpool, void (*function_p)(void*), void* arg_p);
 
 
+/**
+ * @brief Add work to one of the priority lanes
+ *
+ * Same as thpool_add_work, jobs added by thpool_add_work are high priority.
+ *
+ * @param  threadpool    threadpool to which the work will be added
+ * @param  function_p    pointer to function to add as work
+ * @param  arg_p         pointer to an argument
+ * @param  priority      priority lane of the job
+ * @return 0 on successs -1 otherwise
+ */
+int thpool_add_work_priority(threadpool, void (*function_p)(void*),
+		void* arg_p, thpool_priority priority);
+
+
 /**
  * @brief Wait for all queued jobs to finish
  *
@@ -254,6 +281,15 @@ void thpool_get_tasks
 	void (*match)(void*)      // [optional] executed on every match task
 );
 
+// collects the queueing statistics of a priority lane
+void thpool_get_wait_stats
+(
+	threadpool thpool_p,       // thread pool
+	thpool_priority priority,  // priority lane
+	uint64_t *jobs,            // number of jobs dequeued
+	double *wait_ms            // accumulated queueing time in milliseconds
+);
+
 #ifdef __cplusplus
 }
 #endif
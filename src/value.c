@@ -15,6 +15,7 @@
 #include <ctype.h>
 #include <sys/param.h>
 #include "util/rmalloc.h"
+#include "util/string_pool.h"
 #include "datatypes/map.h"
 #include "datatypes/array.h"
 #include "datatypes/point.h"
@@ -111,6 +112,33 @@ SIValue SI_TransferStringVal(char *s) {
 	};
 }
 
+SIValue SI_InternStringVal(const char *s) {
+	char *interned = StringPool_Intern(s);
+	if(interned == NULL) return SI_DuplicateStringVal(s);
+
+	return (SIValue) {
+		.stringval = interned, .type = T_STRING, .allocation = M_INTERN
+	};
+}
+
+SIValue SI_InternValue(SIValue v) {
+	if(v.type != T_STRING || v.allocation == M_INTERN) return v;
+
+	// share an additional reference to an already interned string
+	if(v.allocation & M_INTERN) return SI_CloneValue(v);
+
+	char *interned = StringPool_Intern(v.stringval);
+	if(interned == NULL) {
+		// string is too long to be interned, make sure it is owned
+		return (v.allocation == M_SELF) ? v : SI_CloneValue(v);
+	}
+
+	SIValue_Free(v);
+	return (SIValue) {
+		.stringval = interned, .type = T_STRING, .allocation = M_INTERN
+	};
+}
+
 SIValue SI_Point(float latitude, float longitude) {
 	return (SIValue) {
 		.type = T_POINT, .allocation = M_NONE,
@@ -125,6 +153,7 @@ SIValue SI_ShareValue(const SIValue v) {
 	SIValue dup = v;
 	// If the original value owns an allocation, mark that the duplicate shares it.
 	if(v.allocation == M_SELF) dup.allocation = M_VOLATILE;
+	else if(v.allocation == M_INTERN) dup.allocation = M_VOLATILE | M_INTERN;
 	return dup;
 }
 
@@ -135,6 +164,13 @@ SIValue SI_CloneValue(const SIValue v) {
 	if(v.allocation == M_NONE) return v; // Stack value; no allocation necessary.
 
 	if(v.type == T_STRING) {
+		// Interned strings are shared rather than copied.
+		if(v.allocation & M_INTERN) {
+			return (SIValue) {
+				.stringval = StringPool_Retain(v.stringval), .type = T_STRING,
+				.allocation = M_INTERN
+			};
+		}
 		// Allocate a new copy of the input's string value.
 		return SI_DuplicateStringVal(v.stringval);
 	}
@@ -172,7 +208,7 @@ SIValue SI_CloneValue(const SIValue v) {
 }
 
 SIValue SI_ShallowCloneValue(const SIValue v) {
-	if(v.allocation == M_CONST || v.allocation == M_NONE) return v;
+	if((v.allocation & M_CONST) || v.allocation == M_NONE) return v;
 	return SI_CloneValue(v);
 }
 
@@ -180,7 +216,8 @@ SIValue SI_ShallowCloneValue(const SIValue v) {
  *  to remain in scope. This is most frequently the case for GraphEntity properties. */
 SIValue SI_ConstValue(const SIValue *v) {
 	SIValue dup = *v;
-	if(v->allocation != M_NONE) dup.allocation = M_CONST;
+	// interned strings keep their mark, allowing their hash to be reused
+	if(v->allocation != M_NONE) dup.allocation = M_CONST | (v->allocation & M_INTERN);
 	return dup;
 }
 
@@ -188,6 +225,7 @@ SIValue SI_ConstValue(const SIValue *v) {
 SIValue SI_TransferOwnership(SIValue *v) {
 	SIValue dup = *v;
 	if(v->allocation == M_SELF) v->allocation = M_VOLATILE;
+	else if(v->allocation == M_INTERN) v->allocation = M_VOLATILE | M_INTERN;
 	return dup;
 }
 
@@ -196,6 +234,7 @@ SIValue SI_TransferOwnership(SIValue *v) {
  * This is used in cases like performing shallow copies of scalars in Record entries. */
 void SIValue_MakeVolatile(SIValue *v) {
 	if(v->allocation == M_SELF) v->allocation = M_VOLATILE;
+	else if(v->allocation == M_INTERN) v->allocation = M_VOLATILE | M_INTERN;
 }
 
 /* Ensure that any allocation held by the given SIValue is guaranteed to not go out
@@ -205,7 +244,7 @@ void SIValue_MakeVolatile(SIValue *v) {
 void SIValue_Persist(SIValue *v) {
 	// do nothing for non-volatile values
 	// for volatile values, persisting uses the same logic as cloning
-	if(v->allocation == M_VOLATILE) *v = SI_CloneValue(*v);
+	if(v->allocation & M_VOLATILE) *v = SI_CloneValue(*v);
 }
 
 /* Update an SIValue's allocation type to the provided value. */
@@ -597,6 +636,8 @@ int SIValue_Compare(const SIValue a, const SIValue b, int *disjointOrNull) {
 
 			return SAFE_COMPARISON_RESULT(a.doubleval - b.doubleval);
 		case T_STRING:
+			// shared strings, e.g. interned strings, are equal
+			if(a.stringval == b.stringval) return 0;
 			return strcmp(a.stringval, b.stringval);
 		case T_NODE:
 		case T_EDGE:
@@ -698,7 +739,11 @@ void SIValue_HashUpdate(SIValue v, XXH64_state_t *state) {
 			return;
 		case T_STRING:
 			XXH64_update(state, &t, sizeof(t));
-			XXH64_update(state, v.stringval, strlen(v.stringval));
+			// interned strings hold their precomputed hash
+			inner_hash = (v.allocation & M_INTERN) ?
+				StringPool_Hash(v.stringval) :
+				StringPool_HashString(v.stringval, strlen(v.stringval));
+			XXH64_update(state, &inner_hash, sizeof(inner_hash));
 			return;
 		case T_INT64:
 			// change type to numeric
@@ -826,6 +871,12 @@ SIValue SIValue_FromBinary
 }
 			
 void SIValue_Free(SIValue v) {
+	// Release a reference to an interned string.
+	if(v.allocation == M_INTERN) {
+		StringPool_Release(v.stringval);
+		return;
+	}
+
 	// The free routine only performs work if it owns a heap allocation.
 	if(v.allocation != M_SELF) return;
 
@@ -44,7 +44,8 @@ typedef enum {
 	M_NONE = 0,             // SIValue is not heap-allocated
 	M_SELF = (1 << 0),      // SIValue is responsible for freeing its reference
 	M_VOLATILE = (1 << 1),  // SIValue does not own its reference and may go out of scope
-	M_CONST = (1 << 2)      // SIValue does not own its allocation, but its access is safe
+	M_CONST = (1 << 2),     // SIValue does not own its allocation, but its access is safe
+	M_INTERN = (1 << 3)     // SIValue refers to an interned string, see string_pool.h
 } SIAllocation;
 
 #define SI_TYPE(value) (value).type
@@ -125,6 +126,14 @@ SIValue SI_ConstStringVal(const char *s);
 // Don't duplicate input string, but assume ownership.
 SIValue SI_TransferStringVal(char *s);
 
+// Share an interned copy of the input string, strings too long to be interned
+// are duplicated.
+SIValue SI_InternStringVal(const char *s);
+
+// Returns an interned equivalent of the input value, taking ownership of it.
+// Non-string values are returned as is.
+SIValue SI_InternValue(SIValue v);
+
 /* Functions for copying and guaranteeing memory safety for SIValues. */
 // SI_ShareValue creates an SIValue that shares all of the original's allocations.
 SIValue SI_ShareValue(const SIValue v);
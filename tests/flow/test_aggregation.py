@@ -133,4 +133,18 @@ class testAggregations():
 
         query = 'MATCH (n:L) WHERE (null <> false) XOR true RETURN COUNT(n)'
         expected = [[0]]
-        self.get_res_and_assertAlmostEquals(query, expected)
\ No newline at end of file
+        self.get_res_and_assertAlmostEquals(query, expected)
+
+    def test10_AggregateManyGroups(self):
+        # grow group table well beyond its initial capacity
+        query = """UNWIND range(0, 99999) AS x
+                   WITH x % 30000 AS k, count(x) AS c
+                   RETURN count(k), sum(c), min(c), max(c)"""
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [[30000, 100000, 3, 4]])
+
+        # numeric keys of different types share a group, nulls share a group
+        query = """UNWIND [1, 1.0, 2, null, null] AS x
+                   RETURN x, count(1) AS c ORDER BY c DESC, x"""
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [[1, 2], [None, 2], [2, 1]])
@@ -0,0 +1,115 @@
+from common import *
+
+GRAPH_ID = "attribute_stats"
+NODE_COUNT = 2000
+
+STATS_QUERY = """CALL db.stats() YIELD label, entitytype, property, count, distinct, mostCommonValues, histogram
+                 WHERE label = $label AND property = $property
+                 RETURN entitytype, count, distinct, mostCommonValues, histogram"""
+
+class testAttributeStats(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True, enableDebugCommand=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # skewed status distribution: 90% done, 9% open, 1% failed
+        q = """UNWIND range(0, $n - 1) AS x
+               CREATE (:Order {id: x,
+                               status: CASE WHEN x % 100 = 0 THEN 'failed'
+                                            WHEN x % 10 = 0 THEN 'open'
+                                            ELSE 'done' END})-[:SHIPPED {days: x % 5}]->(:Carrier)"""
+        self.graph.query(q, {'n': NODE_COUNT})
+
+    def stats(self, label, prop):
+        res = self.graph.query(STATS_QUERY, {'label': label, 'property': prop}).result_set
+        self.env.assertEquals(len(res), 1)
+        return res[0]
+
+    def test01_node_statistics(self):
+        entitytype, count, distinct, mcv, histogram = self.stats('Order', 'status')
+        self.env.assertEquals(entitytype, 'NODE')
+        self.env.assertEquals(count, NODE_COUNT)
+        self.env.assertEquals(distinct, 3)
+
+        # most common values ordered by descending frequency
+        self.env.assertEquals(mcv, [{'value': 'done', 'count': 1800},
+                                    {'value': 'open', 'count': 180},
+                                    {'value': 'failed', 'count': 20}])
+
+        # non numeric attribute, no histogram
+        self.env.assertEquals(histogram, [])
+
+        # numeric attribute, histogram spans the attribute's values
+        _, count, distinct, _, histogram = self.stats('Order', 'id')
+        self.env.assertEquals(count, NODE_COUNT)
+        self.env.assertGreater(distinct, NODE_COUNT * 0.9)
+        self.env.assertLess(distinct, NODE_COUNT * 1.1)
+        self.env.assertEquals(len(histogram), 17)
+        self.env.assertEquals(histogram, sorted(histogram))
+        self.env.assertGreaterEqual(histogram[0], 0)
+        self.env.assertLessEqual(histogram[-1], NODE_COUNT - 1)
+
+    def test02_edge_statistics(self):
+        entitytype, count, distinct, mcv, histogram = self.stats('SHIPPED', 'days')
+        self.env.assertEquals(entitytype, 'RELATIONSHIP')
+        self.env.assertEquals(count, NODE_COUNT)
+        self.env.assertEquals(distinct, 5)
+        self.env.assertEquals(len(mcv), 5)
+        for entry in mcv:
+            self.env.assertEquals(entry['count'], NODE_COUNT / 5)
+        self.env.assertEquals(histogram[0], 0)
+        self.env.assertEquals(histogram[-1], 4)
+
+    def test03_statistics_follow_updates(self):
+        # move open orders to done
+        self.graph.query("MATCH (o:Order {status: 'open'}) SET o.status = 'done'")
+        _, count, distinct, mcv, _ = self.stats('Order', 'status')
+        self.env.assertEquals(count, NODE_COUNT)
+        self.env.assertEquals(mcv, [{'value': 'done', 'count': 1980},
+                                    {'value': 'failed', 'count': 20}])
+
+        # delete failed orders
+        self.graph.query("MATCH (o:Order {status: 'failed'}) DETACH DELETE o")
+        _, count, _, mcv, _ = self.stats('Order', 'status')
+        self.env.assertEquals(count, NODE_COUNT - 20)
+        self.env.assertEquals(mcv, [{'value': 'done', 'count': 1980}])
+
+        # deleted edges are retracted from relationship statistics
+        _, count, _, _, _ = self.stats('SHIPPED', 'days')
+        self.env.assertEquals(count, NODE_COUNT - 20)
+
+        # removed attribute
+        self.graph.query("MATCH (o:Order) WHERE o.id < 10 SET o.status = NULL")
+        _, count, _, mcv, _ = self.stats('Order', 'status')
+        self.env.assertEquals(count, NODE_COUNT - 29)
+
+    def test04_statistics_persisted(self):
+        before = self.graph.query(STATS_QUERY, {'label': 'Order', 'property': 'id'}).result_set
+        self.conn.execute_command("DEBUG", "RELOAD")
+        after = self.graph.query(STATS_QUERY, {'label': 'Order', 'property': 'id'}).result_set
+        self.env.assertEquals(before, after)
+
+    def test05_index_choice(self):
+        g = Graph(self.conn, "attribute_stats_index")
+        q = """UNWIND range(0, $n - 1) AS x
+               CREATE (:Order {status: CASE WHEN x % 100 = 0 THEN 'failed' ELSE 'done' END})"""
+        g.query(q, {'n': NODE_COUNT})
+        g.query("CREATE INDEX FOR (o:Order) ON (o.status)")
+
+        # selective predicate, utilize index
+        plan = g.execution_plan("MATCH (o:Order) WHERE o.status = 'failed' RETURN count(o)")
+        self.env.assertIn("Node By Index Scan", plan)
+
+        # predicate matching most of the label, scanning is cheaper
+        plan = g.execution_plan("MATCH (o:Order) WHERE o.status = 'done' RETURN count(o)")
+        self.env.assertNotIn("Node By Index Scan", plan)
+        self.env.assertIn("Node By Label Scan", plan)
+
+        # both plans produce the same results
+        res = g.query("MATCH (o:Order) WHERE o.status = 'done' RETURN count(o)").result_set
+        self.env.assertEquals(res[0][0], NODE_COUNT - 20)
+        res = g.query("MATCH (o:Order) WHERE o.status = 'failed' RETURN count(o)").result_set
+        self.env.assertEquals(res[0][0], 20)
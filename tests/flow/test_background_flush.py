@@ -0,0 +1,60 @@
+from common import *
+from pathos.pools import ProcessPool as Pool
+
+GRAPH_ID = "background_flush"
+MAX_PENDING_CHANGES = 100
+
+def reader(args):
+    env = Env(decodeResponses=True)
+    conn = env.getConnection()
+    g = Graph(conn, GRAPH_ID)
+
+    # edge and node counts must agree at all times
+    for _ in range(50):
+        res = g.query("MATCH (a:A)-[:R]->(b:B) RETURN count(a), count(DISTINCT b)").result_set
+        if res[0][0] != res[0][1]:
+            return False
+    return True
+
+class testBackgroundFlush(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True,
+                       moduleArgs=f'DELTA_MAX_PENDING_CHANGES {MAX_PENDING_CHANGES}')
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+
+    def count(self):
+        q = "MATCH (a:A)-[:R]->(b:B) RETURN count(a)"
+        return self.graph.query(q).result_set[0][0]
+
+    def test01_flush_preserves_content(self):
+        # every batch exceeds the pending changes threshold
+        expected = 0
+        for i in range(10):
+            q = "UNWIND range(1, $n) AS x CREATE (:A {v: x})-[:R]->(:B {v: x})"
+            self.graph.query(q, {'n': MAX_PENDING_CHANGES * 3})
+            expected += MAX_PENDING_CHANGES * 3
+            self.env.assertEquals(self.count(), expected)
+
+        # deletions are flushed as well
+        q = "MATCH (a:A)-[e:R]->() WHERE a.v % 2 = 0 DELETE e"
+        deleted = self.graph.query(q).relationships_deleted
+        expected -= deleted
+        self.env.assertEquals(self.count(), expected)
+
+        # restore deleted edges
+        q = """MATCH (a:A), (b:B) WHERE a.v % 2 = 0 AND a.v = b.v AND
+               NOT (a)-[:R]->() CREATE (a)-[:R]->(b)"""
+        self.graph.query(q)
+
+    def test02_concurrent_readers(self):
+        pool = Pool(nodes=4)
+        res = pool.amap(reader, range(4))
+
+        # keep on modifying the graph while readers are active
+        for i in range(10):
+            q = "UNWIND range(1, $n) AS x CREATE (:A {v: x})-[:R]->(:B {v: x})"
+            self.graph.query(q, {'n': MAX_PENDING_CHANGES * 2})
+
+        self.env.assertTrue(all(res.get()))
+        pool.clear()
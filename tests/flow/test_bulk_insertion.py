@@ -715,3 +715,107 @@ class testGraphBulkInsertFlow(FlowTestsBase):
             query_result = graph.query(q)
             self.env.assertEquals(query_result.result_set, expected_result)
 
+
+    # Verify that multiple edges connecting the same pair of nodes are kept
+    def test12_multi_edges(self):
+        graphname = "tmpgraph7"
+        # Write temporary files
+        with open('/tmp/nodes.tmp', mode='w') as csv_file:
+            out = csv.writer(csv_file)
+            out.writerow(["id"])
+            for i in range(3):
+                out.writerow([i])
+        with open('/tmp/relations.tmp', mode='w') as csv_file:
+            out = csv.writer(csv_file)
+            out.writerow(["src", "dest", "v"])
+            out.writerow([0, 1, 1])
+            out.writerow([0, 1, 2])
+            out.writerow([1, 2, 3])
+            out.writerow([0, 1, 4])
+            out.writerow([1, 2, 5])
+
+        runner = CliRunner()
+        res = runner.invoke(bulk_insert, ['--redis-url', f"redis://localhost:{port}",
+                                          '--nodes', '/tmp/nodes.tmp',
+                                          '--relations', '/tmp/relations.tmp',
+                                          graphname])
+
+        self.env.assertEquals(res.exit_code, 0)
+        self.env.assertIn('5 relations created', res.output)
+
+        graph = Graph(redis_con, graphname)
+        query_result = graph.query('MATCH (a)-[e]->(b) RETURN a.id, b.id, e.v ORDER BY e.v')
+        expected_result = [[0, 1, 1],
+                           [0, 1, 2],
+                           [1, 2, 3],
+                           [0, 1, 4],
+                           [1, 2, 5]]
+        self.env.assertEquals(query_result.result_set, expected_result)
+
+        # edges are reachable from both endpoints
+        query_result = graph.query('MATCH (a)<-[e]-(b) RETURN count(e)')
+        self.env.assertEquals(query_result.result_set, [[5]])
+
+        # deleting a single edge keeps the remaining edges
+        graph.query('MATCH ()-[e {v: 2}]->() DELETE e')
+        query_result = graph.query('MATCH ({id: 0})-[e]->({id: 1}) RETURN e.v ORDER BY e.v')
+        self.env.assertEquals(query_result.result_set, [[1], [4]])
+
+    # Verify that edges loaded by a later query merge with existing edges
+    # connecting the same pair of nodes
+    def test13_multi_edges_across_batches(self):
+        graphname = "tmpgraph8"
+        # Write temporary files
+        with open('/tmp/nodes.tmp', mode='w') as csv_file:
+            out = csv.writer(csv_file)
+            out.writerow(["id"])
+            for i in range(3):
+                out.writerow([i])
+        with open('/tmp/relations_a.tmp', mode='w') as csv_file:
+            out = csv.writer(csv_file)
+            out.writerow(["src", "dest", "v"])
+            out.writerow([0, 1, 1])
+            out.writerow([0, 1, 2])
+            out.writerow([1, 2, 3])
+        with open('/tmp/relations_b.tmp', mode='w') as csv_file:
+            out = csv.writer(csv_file)
+            out.writerow(["src", "dest", "v"])
+            out.writerow([0, 1, 4]) # existing multi-edge
+            out.writerow([1, 2, 5]) # existing single edge
+            out.writerow([1, 2, 6])
+            out.writerow([2, 0, 7]) # new edge
+
+        # one query per input file
+        runner = CliRunner()
+        res = runner.invoke(bulk_insert, ['--redis-url', f"redis://localhost:{port}",
+                                          '--nodes', '/tmp/nodes.tmp',
+                                          '--relations-with-type', 'R', '/tmp/relations_a.tmp',
+                                          '--relations-with-type', 'R', '/tmp/relations_b.tmp',
+                                          '--max-token-count', 1,
+                                          graphname])
+
+        self.env.assertEquals(res.exit_code, 0)
+
+        graph = Graph(redis_con, graphname)
+        query_result = graph.query('MATCH (a)-[e:R]->(b) RETURN a.id, b.id, e.v ORDER BY e.v')
+        expected_result = [[0, 1, 1],
+                           [0, 1, 2],
+                           [1, 2, 3],
+                           [0, 1, 4],
+                           [1, 2, 5],
+                           [1, 2, 6],
+                           [2, 0, 7]]
+        self.env.assertEquals(query_result.result_set, expected_result)
+
+        query_result = graph.query('MATCH (a)<-[e:R]-(b) RETURN count(e)')
+        self.env.assertEquals(query_result.result_set, [[7]])
+
+        # deleting a merged edge keeps the remaining edges
+        graph.query('MATCH ()-[e {v: 5}]->() DELETE e')
+        query_result = graph.query('MATCH ({id: 1})-[e]->({id: 2}) RETURN e.v ORDER BY e.v')
+        self.env.assertEquals(query_result.result_set, [[3], [6]])
+
+        # Delete temporary files
+        os.remove('/tmp/nodes.tmp')
+        os.remove('/tmp/relations_a.tmp')
+        os.remove('/tmp/relations_b.tmp')
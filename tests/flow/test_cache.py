@@ -24,16 +24,18 @@ class testCache():
         plan_graph.delete()
 
     def test_01_sanity_check(self):
+        # queries differing only by their literals share a cache entry
+        # vary the queried attribute to produce distinct entries
         graph = Graph(redis_con, 'Cache_Sanity_Check')
         for i in range(CACHE_SIZE + 1):
-            result = graph.query("MATCH (n) WHERE n.value = {val} RETURN n".format(val=i))
+            result = graph.query("MATCH (n) WHERE n.value_{val} = 1 RETURN n".format(val=i))
             self.env.assertFalse(result.cached_execution)
         
         for i in range(1, CACHE_SIZE + 1):
-            result = graph.query("MATCH (n) WHERE n.value = {val} RETURN n".format(val=i))
+            result = graph.query("MATCH (n) WHERE n.value_{val} = 1 RETURN n".format(val=i))
             self.env.assertTrue(result.cached_execution)
         
-        result = graph.query("MATCH (n) WHERE n.value = 0 RETURN n")
+        result = graph.query("MATCH (n) WHERE n.value_0 = 1 RETURN n")
         self.env.assertFalse(result.cached_execution)
 
         graph.delete()
@@ -287,3 +289,87 @@ class testCache():
 
         loop.run_until_complete(asyncio.wait(tasks))
 
+    def plan_cache_stats(self, con):
+        res = con.execute_command("GRAPH.INFO", "PlanCache")
+        self.env.assertEqual(res[0], "# Plan cache")
+        stats = res[1]
+        self.env.assertEqual(stats[0::2], ["Hits", "Misses", "Evictions"])
+        return dict(zip(stats[0::2], stats[1::2]))
+
+    def test_15_literals_normalization(self):
+        # queries differing only by their literals, whitespace or keywords case
+        # share a single cached execution plan
+        con = self.env.getConnection()
+        graph = Graph(con, 'Cache_Test_Normalization')
+        graph.query("UNWIND range(1, 5) AS x CREATE (:N {v: x, s: 'str_' + toString(x)})-[:R]->(:M {v: x})")
+
+        query = "MATCH (n:N) WHERE n.v > 2 AND n.s <> 'str_4' RETURN n.v ORDER BY n.v"
+        uncached_result = graph.query(query)
+        self.env.assertFalse(uncached_result.cached_execution)
+        self.env.assertEqual([[3], [5]], uncached_result.result_set)
+
+        query = "match (n:N)   where n.v > 0 and n.s <> 'str_1'  RETURN n.v ORDER BY n.v"
+        cached_result = graph.query(query)
+        self.env.assertTrue(cached_result.cached_execution)
+        self.env.assertEqual([[2], [3], [4], [5]], cached_result.result_set)
+
+        # list literals are lifted as a whole
+        query = "MATCH (n:N) WHERE n.v IN [1, 2] RETURN count(n)"
+        self.env.assertEqual([[2]], graph.query(query).result_set)
+        query = "MATCH (n:N) WHERE n.v IN [1, 2, 3, 4] RETURN count(n)"
+        cached_result = graph.query(query)
+        self.env.assertTrue(cached_result.cached_execution)
+        self.env.assertEqual([[4]], cached_result.result_set)
+
+        # RETURN clauses are kept as is, column names are preserved
+        result = graph.query("MATCH (n:N) WHERE n.v = 1 RETURN n.v + 10, 'x' AS y")
+        self.env.assertEqual(["n.v + 10", "y"], [h[1] for h in result.header])
+        self.env.assertEqual([[11, 'x']], result.result_set)
+
+        # variable length traversals, SKIP and LIMIT aren't parameterized
+        result = graph.query("MATCH (n:N {v: 1})-[*1..1]->(m) RETURN count(m)")
+        self.env.assertEqual([[1]], result.result_set)
+        result = graph.query("MATCH (n:N {v: 1})-[*2..3]->(m) RETURN count(m)")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual([[0]], result.result_set)
+
+        result = graph.query("MATCH (n:N) WITH n ORDER BY n.v SKIP 1 LIMIT 2 RETURN n.v")
+        self.env.assertEqual([[2], [3]], result.result_set)
+        result = graph.query("MATCH (n:N) WITH n ORDER BY n.v SKIP 3 LIMIT 1 RETURN n.v")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual([[4]], result.result_set)
+
+        # user specified parameters named as synthetic parameters
+        result = graph.query("MATCH (n:N) WHERE n.v = $lit_0 AND n.s = 'str_2' RETURN n.v", {'lit_0': 2})
+        self.env.assertEqual([[2]], result.result_set)
+
+        # errors are reported against the original query
+        try:
+            graph.query("MATCH (n:N) WHERE n.v = 1 RETURN m")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("'m' not defined", str(e))
+
+        graph.delete()
+
+    def test_16_plan_cache_info(self):
+        con = self.env.getConnection()
+        graph = Graph(con, 'Cache_Test_Info')
+
+        before = self.plan_cache_stats(con)
+
+        graph.query("MATCH (n) WHERE n.v = 1 RETURN n")  # miss
+        graph.query("MATCH (n) WHERE n.v = 2 RETURN n")  # hit
+
+        stats = self.plan_cache_stats(con)
+        self.env.assertEqual(stats["Hits"], before["Hits"] + 1)
+        self.env.assertEqual(stats["Misses"], before["Misses"] + 1)
+
+        # overflow the cache, causing evictions
+        for i in range(CACHE_SIZE + 1):
+            graph.query(f"MATCH (n) WHERE n.v_{i} = 1 RETURN n")
+
+        stats = self.plan_cache_stats(con)
+        self.env.assertGreater(stats["Evictions"], before["Evictions"])
+
+        graph.delete()
@@ -0,0 +1,138 @@
+from common import *
+
+GRAPH_ID = "columnar_properties"
+NODE_COUNT = 20000 # enough reads to have attributes laid out in columns
+
+class testColumnarProperties(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs='COLUMNAR_MIN_LABEL_SIZE 1000')
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # dense attributes of every columnar type
+        # a heterogeneous attribute and a sparse attribute
+        q = """UNWIND range(0, $n - 1) AS x
+               CREATE (:Person {
+                   age: x,
+                   score: x / 2.0,
+                   active: x % 2 = 0,
+                   city: 'city_' + toString(x % 7),
+                   mixed: CASE WHEN x % 2 = 0 THEN x ELSE toString(x) END,
+                   sparse: CASE WHEN x % 10 = 0 THEN x ELSE NULL END})"""
+        self.graph.query(q, {'n': NODE_COUNT})
+
+        # small label, below COLUMNAR_MIN_LABEL_SIZE
+        self.graph.query("UNWIND range(0, 9) AS x CREATE (:Pet {age: x})")
+
+        # node with multiple labels
+        self.graph.query("CREATE (:Person:Pet {age: -1, city: 'nowhere'})")
+
+    def set_min_label_size(self, n):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "COLUMNAR_MIN_LABEL_SIZE", n)
+
+    def compare(self, queries):
+        for q in queries:
+            # run twice, first run lays attributes out in columns
+            self.set_min_label_size(1000)
+            self.graph.query(q)
+            columnar = self.graph.query(q).result_set
+
+            self.set_min_label_size(0)
+            expected = self.graph.query(q).result_set
+
+            self.env.assertEquals(columnar, expected)
+
+    def test01_filters_and_projections(self):
+        queries = [
+            "MATCH (p:Person) RETURN count(p), sum(p.age), min(p.score), max(p.score)",
+            "MATCH (p:Person) WHERE p.age > 19990 RETURN p.age, p.score, p.active, p.city ORDER BY p.age",
+            "MATCH (p:Person) WHERE p.active RETURN count(p)",
+            "MATCH (p:Person) WHERE p.city = 'city_3' RETURN count(p), min(p.age)",
+            "MATCH (p:Person) RETURN p.city, count(p) ORDER BY p.city",
+            "MATCH (p:Person) WHERE p.age < 10 RETURN p.mixed, p.sparse ORDER BY p.age",
+            "MATCH (p:Person) RETURN count(p.sparse), sum(p.sparse)",
+            "MATCH (p:Person) RETURN count(p.missing)",
+            "MATCH (n) WHERE n.age < 5 RETURN labels(n), n.age, n.city ORDER BY n.age",
+        ]
+        self.compare(queries)
+
+    def test02_modifications(self):
+        q = "MATCH (p:Person) WHERE p.age % 1000 = 0 RETURN p.age, p.city ORDER BY p.age"
+
+        # lay attributes out in columns
+        self.set_min_label_size(1000)
+        self.graph.query(q)
+        self.graph.query(q)
+
+        # update, remove and delete
+        self.graph.query("MATCH (p:Person) WHERE p.age = 0 SET p.city = 'updated'")
+        self.graph.query("MATCH (p:Person) WHERE p.age = 1000 SET p.city = NULL")
+        self.graph.query("MATCH (p:Person) WHERE p.age = 2000 DELETE p")
+        self.graph.query("CREATE (:Person {age: 2000, city: 'created'})")
+
+        self.graph.query(q)
+        actual = self.graph.query(q).result_set
+        self.env.assertEquals(actual[0], [0, 'updated'])
+        self.env.assertEquals(actual[1], [1000, None])
+        self.env.assertEquals(actual[2], [2000, 'created'])
+
+        # columns are rebuilt with the attribute's new type
+        self.graph.query("MATCH (p:Person) SET p.age = toFloat(p.age)")
+        self.compare(["MATCH (p:Person) WHERE p.age > 19990.0 RETURN p.age ORDER BY p.age"])
+
+    def test03_config(self):
+        # invalid values are rejected
+        try:
+            self.set_min_label_size(-1)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError:
+            pass
+
+        res = self.conn.execute_command("GRAPH.CONFIG", "GET", "COLUMNAR_MIN_LABEL_SIZE")
+        self.env.assertEquals(res, ["COLUMNAR_MIN_LABEL_SIZE", 0])
+
+    def test04_unrelated_modifications(self):
+        # columns of attributes a write doesn't touch are retained
+        # while the nodes' attribute-sets are replaced
+        q = "MATCH (p:Person) WHERE p.city = 'city_3' RETURN count(p), min(p.age)"
+
+        self.set_min_label_size(1000)
+        self.graph.query(q)
+        expected = self.graph.query(q).result_set
+
+        self.graph.query("MATCH (p:Person) SET p.score = p.score + 1")
+        self.graph.query("MATCH (p:Person) WHERE p.age < 100 SET p.tag = 'x'")
+        self.env.assertEquals(self.graph.query(q).result_set, expected)
+
+        self.compare([q, "MATCH (p:Person) RETURN p.city, count(p) ORDER BY p.city"])
+
+    def test05_multiple_labels(self):
+        # a single column covers every large label
+        # nodes may hold several covered labels
+        self.graph.query("""UNWIND range(0, 1999) AS x
+                            CREATE (:Employee {rank: x, dept: 'dept_' + toString(x % 3)})""")
+        self.graph.query("""MATCH (e:Employee) WHERE e.rank % 2 = 0
+                            SET e:Manager""")
+        self.graph.query("""UNWIND range(0, 1999) AS x
+                            CREATE (:Manager {rank: x + 2000, dept: 'board'})""")
+
+        # attribute of a different type in each label isn't laid out
+        self.graph.query("""UNWIND range(0, 1999) AS x
+                            CREATE (:Contractor {dept: x})""")
+
+        # read `rank` often enough for it to be laid out
+        self.set_min_label_size(1000)
+        for _ in range(3):
+            self.graph.query("MATCH (n:Manager) RETURN sum(n.rank)")
+
+        queries = [
+            "MATCH (e:Employee) RETURN count(e), sum(e.rank), min(e.dept), max(e.dept)",
+            "MATCH (m:Manager) RETURN count(m), sum(m.rank), min(m.dept), max(m.dept)",
+            "MATCH (e:Employee:Manager) WHERE e.rank < 10 RETURN e.rank, e.dept ORDER BY e.rank",
+            "MATCH (n) WHERE n.rank > 3990 RETURN labels(n), n.rank, n.dept ORDER BY n.rank",
+            "MATCH (c:Contractor) RETURN count(c), sum(c.dept)",
+            "MATCH (n) WHERE n:Contractor OR n:Manager RETURN n.dept, count(n) ORDER BY n.dept LIMIT 5",
+        ]
+        self.compare(queries)
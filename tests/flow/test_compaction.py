@@ -0,0 +1,144 @@
+import threading
+from common import *
+from index_utils import *
+
+GRAPH_ID = "compaction"
+
+# queries whose results must survive compaction
+QUERIES = [
+    "MATCH (a:A)-[r:R]->(b:A) RETURN count(r), sum(r.w), sum(a.v), sum(b.v)",
+    "MATCH (a:A)-[:S]->(a) RETURN count(a), sum(a.v)",
+    "MATCH (a:A {v: 17000})-[r:R]->(b) RETURN a.v, r.w, b.v ORDER BY r.w",
+    "MATCH (a:A)<-[r:R]-(b) WHERE a.v = 18001 RETURN b.v, r.w ORDER BY r.w",
+    "MATCH (a)-[r:R {w: 18000}]->(b) RETURN a.v, b.v",
+    "MATCH (a:A) WHERE a.v > 19990 RETURN a.v ORDER BY a.v",
+]
+
+class testCompaction(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+
+    def fragmentation(self):
+        res = self.conn.execute_command("GRAPH.DEBUG", "FRAGMENTATION", GRAPH_ID)
+        return dict(zip(res[::2], res[1::2]))
+
+    def compact(self, budget, graph_id=GRAPH_ID):
+        relation = 0
+        row = 0
+        for _ in range(1000):
+            holes, relation, row = self.conn.execute_command("GRAPH.DEBUG",
+                    "COMPACT", graph_id, budget, relation, row)
+            if holes == 0:
+                return True
+        return False
+
+    def test01_compact(self):
+        create_node_exact_match_index(self.graph, 'A', 'v', sync=True)
+        self.graph.query("CREATE INDEX FOR ()-[r:R]-() ON (r.w)")
+
+        # node IDs match v
+        self.graph.query("UNWIND range(0, 19999) AS x CREATE (:A {v: x})")
+
+        # chain nodes, every 10th pair is connected twice
+        self.graph.query("""MATCH (a:A) MATCH (b:A {v: a.v + 1})
+                            CREATE (a)-[:R {w: a.v}]->(b)""")
+        self.graph.query("""MATCH (a:A) WHERE a.v % 10 = 0
+                            MATCH (b:A {v: a.v + 1})
+                            CREATE (a)-[:R {w: -a.v}]->(b)""")
+        self.graph.query("MATCH (a:A) WHERE a.v % 7 = 0 CREATE (a)-[:S]->(a)")
+
+        # drop the first 15000 nodes, leaving holes at the beginning
+        self.graph.query("MATCH (a:A) WHERE a.v < 15000 DELETE a")
+
+        expected = [self.graph.query(q).result_set for q in QUERIES]
+
+        before = self.fragmentation()
+        self.env.assertEquals(before['Nodes'], 5000)
+        self.env.assertEquals(before['Deleted nodes'], 15000)
+        self.env.assertGreater(before['Deleted edges'], 0)
+
+        # compact in small slices
+        self.env.assertTrue(self.compact(500))
+
+        after = self.fragmentation()
+        self.env.assertEquals(after['Nodes'], 5000)
+        self.env.assertEquals(after['Deleted nodes'], 0)
+        self.env.assertEquals(after['Edges'], before['Edges'])
+        self.env.assertEquals(after['Deleted edges'], 0)
+        self.env.assertLess(after['Matrix dimension'],
+                            before['Matrix dimension'])
+
+        # entities were relocated into the holes
+        res = self.graph.query("MATCH (a) RETURN max(ID(a))").result_set
+        self.env.assertEquals(res[0][0], after['Nodes'] - 1)
+        res = self.graph.query("MATCH ()-[r]->() RETURN max(ID(r))").result_set
+        self.env.assertEquals(res[0][0], after['Edges'] - 1)
+
+        # content, indices and multi-edges are intact
+        for q, e in zip(QUERIES, expected):
+            self.env.assertEquals(self.graph.query(q).result_set, e)
+
+        # new entities are created past the compacted range
+        res = self.graph.query("CREATE (a:A {v: -1}) RETURN ID(a)").result_set
+        self.env.assertEquals(res[0][0], after['Nodes'])
+
+    def test02_compacted_graph(self):
+        # compacting a compacted graph is a no-op
+        self.graph.query("MATCH (a:A {v: -1}) DELETE a")
+        self.env.assertTrue(self.compact(500))
+
+        before = self.fragmentation()
+        self.env.assertTrue(self.compact(500))
+        self.env.assertEquals(self.fragmentation(), before)
+
+    def test03_invalid_arguments(self):
+        for args in [["COMPACT", GRAPH_ID], ["COMPACT", GRAPH_ID, 0],
+                     ["COMPACT", GRAPH_ID, 10, -1, 0]]:
+            try:
+                self.conn.execute_command("GRAPH.DEBUG", *args)
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError:
+                pass
+
+    def test04_concurrent_writes(self):
+        # compaction slices are serialized with write queries
+        # which run their match phase without holding the graph lock
+        graph_id = "compaction_concurrent"
+        g = Graph(self.conn, graph_id)
+
+        g.query("UNWIND range(0, 9999) AS x CREATE (:A {v: x})")
+        g.query("""MATCH (a:A) MATCH (b:A {v: a.v + 1})
+                   CREATE (a)-[:R {w: a.v}]->(b)""")
+        g.query("MATCH (a:A) WHERE a.v < 6000 DELETE a")
+
+        iterations = 20
+
+        def write(conn):
+            w = Graph(conn, graph_id)
+            for i in range(iterations):
+                w.query("MATCH (a:A) WHERE a.v % 2 = 0 SET a.c = coalesce(a.c, 0) + 1")
+                w.query(f"MATCH (a:A) WHERE a.v % {iterations} = {i} AND a.v % 2 = 1 DELETE a")
+
+        t = threading.Thread(target=write, args=(self.env.getConnection(),))
+        t.start()
+
+        relation = 0
+        row = 0
+        while t.is_alive():
+            _, relation, row = self.conn.execute_command("GRAPH.DEBUG",
+                    "COMPACT", graph_id, 100, relation, row)
+        t.join()
+
+        self.env.assertTrue(self.compact(100, graph_id))
+
+        # odd nodes were deleted, even nodes were updated on every iteration
+        res = g.query("MATCH (a:A) RETURN count(a), min(a.c), max(a.c), sum(a.v % 2)").result_set
+        self.env.assertEquals(res[0], [2000, iterations, iterations, 0])
+
+        # no edge is left dangling
+        res = g.query("MATCH (a:A)-[r:R]->(b:A) RETURN count(r)").result_set
+        self.env.assertEquals(res[0][0], 0)
+        res = g.query("MATCH ()-[r]->() RETURN count(r)").result_set
+        self.env.assertEquals(res[0][0], 0)
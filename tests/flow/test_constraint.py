@@ -74,14 +74,14 @@ class testConstraintNodes():
             self.env.assertContains("mandatory constraint violation: node with label Person missing property height", str(e))
 
         #-----------------------------------------------------------------------
-        # create a node that violates the unique constraint on point data ignored
+        # create a node that violates the unique constraint on point data
         #-----------------------------------------------------------------------
 
         try:
-            g.query("MATCH (p:Person) CREATE (n:Person{height:p.height + 1, loc: p.loc}) DELETE n")
-            self.env.assertTrue(True)
-        except ResponseError as e:
+            g.query("MATCH (p:Person) CREATE (:Person{height:p.height + 1000, loc: p.loc})")
             self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("unique constraint violation on node of type Person", str(e))
 
         #-----------------------------------------------------------------------
         # create a node that violates the unique constraint
@@ -550,6 +550,30 @@ class testConstraintNodes():
         drop_exact_match_index(self.g, "Author", "nickname")
         drop_exact_match_index(self.g, "Author", "birthdate")
 
+    def test09_constraint_none_indexable_values(self):
+        # unique constraint over array values
+        create_unique_node_constraint(self.g, "Playlist", "tracks", sync=True)
+        self.g.query("CREATE (:Playlist {tracks: [1, 2, 3]})")
+
+        # same elements in a different order are a different value
+        self.g.query("CREATE (:Playlist {tracks: [3, 2, 1]})")
+
+        try:
+            self.g.query("CREATE (:Playlist {tracks: [1, 2, 3]})")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("unique constraint violation on node of type Playlist", str(e))
+
+        # integers beyond 2^53 are told apart
+        create_unique_node_constraint(self.g, "Serial", "n", sync=True)
+        self.g.query("CREATE (:Serial {n: 9007199254740992}), (:Serial {n: 9007199254740993})")
+
+        try:
+            self.g.query("CREATE (:Serial {n: 9007199254740993})")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("unique constraint violation on node of type Serial", str(e))
+
 class testConstraintEdges():
     def __init__(self):
         self.env = Env(decodeResponses=True)
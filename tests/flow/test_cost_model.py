@@ -0,0 +1,97 @@
+from common import *
+from execution_plan_util import locate_operation
+
+GRAPH_ID = "cost_model"
+
+class testCostModel(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # skewed labels, 2000 Big nodes and 10 Small nodes
+        self.graph.query("UNWIND range(0, 1999) AS x CREATE (:Big {v: x})")
+        self.graph.query("""UNWIND range(0, 9) AS x
+                            MATCH (b:Big {v: x})
+                            CREATE (b)-[:R]->(:Small {v: x})""")
+
+    def first_op(self, q):
+        plan = self.graph.execution_plan(q)
+        ops = plan.split(os.linesep)
+        ops.reverse()
+        return ops[0]
+
+    def test01_start_from_smaller_label(self):
+        q = "MATCH (a:Big)-[:R]->(b:Small) RETURN count(a)"
+        self.env.assertIn("Node By Label Scan | (b:Small)", self.first_op(q))
+
+        q = "MATCH (b:Small)<-[:R]-(a:Big) RETURN count(a)"
+        self.env.assertIn("Node By Label Scan | (b:Small)", self.first_op(q))
+
+        # results are unaffected by traversal direction
+        res = self.graph.query("MATCH (a:Big)-[:R]->(b:Small) RETURN count(a)")
+        self.env.assertEquals(res.result_set[0][0], 10)
+
+    def test02_filter_on_large_label(self):
+        # filtering Big by equality is still estimated to produce
+        # more records than scanning Small
+        q = "MATCH (a:Big)-[:R]->(b:Small) WHERE a.v = 3 RETURN b.v"
+        self.env.assertIn("Node By Label Scan | (b:Small)", self.first_op(q))
+
+        res = self.graph.query(q)
+        self.env.assertEquals(res.result_set, [[3]])
+
+        # ID filters are highly selective
+        q = "MATCH (a:Big)-[:R]->(b:Small) WHERE ID(a) = 3 RETURN b.v"
+        self.env.assertIn("(a", self.first_op(q))
+
+        res = self.graph.query(q)
+        self.env.assertEquals(res.result_set, [[3]])
+
+    def test03_hash_join_caches_smaller_stream(self):
+        for q in ["MATCH (a:Big), (b:Small) WHERE a.v = b.v RETURN count(a)",
+                  "MATCH (b:Small), (a:Big) WHERE a.v = b.v RETURN count(a)"]:
+            plan = self.graph.explain(q)
+            join = locate_operation(plan.structured_plan, "Value Hash Join")
+            self.env.assertTrue(join is not None)
+            self.env.assertIn("(b:Small)", join.children[0].args)
+
+            res = self.graph.query(q)
+            self.env.assertEquals(res.result_set[0][0], 10)
+
+    def test04_cartesian_product_order(self):
+        # smallest stream is evaluated once, as the last stream
+        q = "MATCH (b:Small), (a:Big) RETURN count(a)"
+        plan = self.graph.explain(q)
+        cp = locate_operation(plan.structured_plan, "Cartesian Product")
+        self.env.assertTrue(cp is not None)
+        self.env.assertIn("(a:Big)", cp.children[0].args)
+        self.env.assertIn("(b:Small)", cp.children[1].args)
+
+        res = self.graph.query(q)
+        self.env.assertEquals(res.result_set[0][0], 20000)
+
+    def test05_join_order(self):
+        # the join between b and c is estimated to produce the fewest records
+        # and is evaluated first, a is joined with its result
+        q = """MATCH (a:Big), (b:Big), (c:Small)
+               WHERE a.v = b.v AND b.v = c.v
+               RETURN count(a)"""
+        plan = self.graph.explain(q)
+        outer = locate_operation(plan.structured_plan, "Value Hash Join")
+        self.env.assertTrue(outer is not None)
+
+        inner = None
+        for child in outer.children:
+            inner = inner or locate_operation(child, "Value Hash Join")
+        self.env.assertTrue(inner is not None)
+
+        args = " ".join(child.args for child in inner.children)
+        self.env.assertIn("(b:Big)", args)
+        self.env.assertIn("(c:Small)", args)
+        self.env.assertNotIn("(a:Big)", args)
+
+        res = self.graph.query(q)
+        self.env.assertEquals(res.result_set[0][0], 10)
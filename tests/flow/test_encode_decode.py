@@ -343,3 +343,28 @@ class test_encode_decode(FlowTestsBase):
 
         compare_nodes_result_set(self.env, nodes_before.result_set, nodes_after.result_set)
         self.env.assertEquals(edges_before.result_set, edges_after.result_set)
+
+    def test13_repeated_strings_over_multiple_keys(self):
+        # strings are dictionary encoded, a dictionary per key
+        # make sure repeated, long and nested strings survive a reload
+        graph_name = "repeated_strings_over_multiple_keys"
+        redis_graph = Graph(redis_con, graph_name)
+
+        long_str = "x" * 1000
+        redis_graph.query("""UNWIND range(0, 99) AS i
+                             CREATE (:Node {val: i, s: 'str_' + toString(i % 7),
+                                     l: $long + toString(i % 3),
+                                     arr: ['str_' + toString(i % 5), 'str_0', i]})""",
+                          {'long': long_str})
+        redis_graph.query("""MATCH (a:Node), (b:Node) WHERE b.val = a.val + 1
+                             CREATE (a)-[:R {s: a.s, t: 'str_' + toString(b.val % 11)}]->(b)""")
+
+        queries = ["MATCH (n:Node) RETURN n ORDER BY n.val",
+                   "MATCH ()-[e:R]->() RETURN e ORDER BY e.s, e.t"]
+        expected = [redis_graph.query(q).result_set for q in queries]
+
+        # Save RDB & Load from RDB
+        redis_con.execute_command("DEBUG", "RELOAD")
+
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(redis_graph.query(q).result_set, e)
@@ -2739,3 +2739,40 @@ class testFunctionCallsFlow(FlowTestsBase):
         }
         for query, expected_result in query_to_expected_result.items():
             self.get_res_and_assertEquals(query, expected_result)
+
+    def test94_constant_arguments(self):
+        # regex patterns given as literals or parameters are compiled once
+        query = """UNWIND ['a1', 'b2', 'a3'] AS s
+                   RETURN string.matchRegEx(s, 'a(\\d)'), string.replaceRegEx(s, $p, 'x')"""
+        actual_result = graph.query(query, {'p': '\\d'})
+        expected_result = [[[['a1', '1']], 'ax'], [[], 'bx'], [[['a3', '3']], 'ax']]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # patterns varying per row are compiled per row
+        query = """UNWIND [['a1', 'a'], ['b2', 'b(\\d)']] AS p
+                   RETURN string.matchRegEx(p[0], p[1])"""
+        actual_result = graph.query(query)
+        expected_result = [[[['a']]], [[['b2', '2']]]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # invalid constant pattern is reported on evaluation
+        try:
+            graph.query("UNWIND ['a'] AS s RETURN string.matchRegEx(s, '?')")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Invalid regex", str(e))
+
+        # long constant lists are hashed
+        query = """UNWIND [1, 2.0, 20, 30.5, 'a', 'z', true, null] AS x
+                   RETURN x IN $list"""
+        lst = list(range(1, 20)) + [30.5, 'a', 'b']
+        actual_result = graph.query(query, {'list': lst})
+        expected_result = [[True], [True], [False], [True], [True], [False], [False], [None]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # a null within the list turns misses into null
+        query = """UNWIND [1, 100] AS x
+                   RETURN x IN [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, null]"""
+        actual_result = graph.query(query)
+        expected_result = [[True], [None]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
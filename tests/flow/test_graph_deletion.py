@@ -448,4 +448,38 @@ class testGraphDeletionFlow(FlowTestsBase):
 
         res = redis_graph.query("MATCH (n:Bar) RETURN count(n)")
         self.env.assertEquals(res.result_set[0][0], 0)
-        
\ No newline at end of file
+        
+    def test21_bulk_detach_delete(self):
+        # deleting many nodes collects their edges in bulk
+        self.env.flush()
+        redis_graph = Graph(self.env.getConnection(), GRAPH_ID)
+
+        # each B node is connected to itself, connected twice to K
+        # and connected from K
+        redis_graph.query("""CREATE (k:K)-[:R]->(:X)
+                             WITH k
+                             UNWIND range(0, 499) AS i
+                             CREATE (b:B {v: i}), (b)-[:S]->(b), (b)-[:R]->(k),
+                             (b)-[:R]->(k), (k)-[:T]->(b)""")
+
+        # chain B nodes
+        redis_graph.query("""MATCH (a:B), (b:B) WHERE b.v = a.v + 1
+                             CREATE (a)-[:R]->(b)""")
+
+        # delete B nodes along with an explicit reference to their self edges
+        res = redis_graph.query("MATCH (b:B)-[e:S]->(b) DELETE b, e")
+        self.env.assertEquals(res.nodes_deleted, 500)
+        self.env.assertEquals(res.relationships_deleted, 500 * 4 + 499)
+
+        res = redis_graph.query("MATCH (n) RETURN count(n)")
+        self.env.assertEquals(res.result_set[0][0], 2)
+
+        res = redis_graph.query("MATCH ()-[e]->() RETURN count(e)")
+        self.env.assertEquals(res.result_set[0][0], 1)
+
+        # K remains connected to X only
+        res = redis_graph.query("MATCH (k:K)-->(x) RETURN labels(x)")
+        self.env.assertEquals(res.result_set, [[['X']]])
+
+        res = redis_graph.query("MATCH (k:K)<--(x) RETURN count(x)")
+        self.env.assertEquals(res.result_set[0][0], 0)
@@ -433,3 +433,44 @@ class testGraphInfo(FlowTestsBase):
         # wait for all threads to complete
         for t in threads:
             t.join()
+
+    def test08_scheduler(self):
+        """queries are scheduled by their execution history"""
+
+        def scheduler_stats():
+            res = self.conn.execute_command("GRAPH.INFO", "Scheduler")
+            self.env.assertEquals(res[0], "# Scheduler")
+            stats = res[1]
+            self.env.assertEquals(stats[0::2], ["Short queries",
+                "Short queries avg wait duration", "Long queries",
+                "Long queries avg wait duration"])
+            return dict(zip(stats[0::2], stats[1::2]))
+
+        g = Graph(self.conn, GRAPH_ID)
+        before = scheduler_stats()
+
+        # unseen queries are considered short
+        g.query("RETURN 1")
+        stats = scheduler_stats()
+        self.env.assertGreater(stats["Short queries"], before["Short queries"])
+
+        # once a query is known to run long, it is queued as a long query
+        long_query = "UNWIND range(0, 5000000) AS x RETURN count(x)"
+        for _ in range(3):
+            g.query(long_query)
+
+        stats = scheduler_stats()
+        self.env.assertGreater(stats["Long queries"], before["Long queries"])
+        self.env.assertGreaterEqual(float(stats["Long queries avg wait duration"]), 0)
+
+        # queries are identified by their plan cache key
+        # runs differing only by their parameters or literals share history
+        before = stats
+        g.query("UNWIND range(0, 5000001) AS x RETURN count(x)")
+
+        # first run is unseen, second run is known to run long
+        for n in [5000002, 5000003]:
+            g.query("UNWIND range(0, $n) AS x RETURN count(x)", {'n': n})
+
+        stats = scheduler_stats()
+        self.env.assertEquals(stats["Long queries"], before["Long queries"] + 2)
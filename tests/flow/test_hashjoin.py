@@ -35,3 +35,64 @@ class testHashJoin(FlowTestsBase):
 
         self.env.assertEquals(actual_result.result_set, expected_result)
 
+    def test_hashjoin_large_build_side(self):
+        # large enough for the build side to be partitioned
+        graph = Graph(self.env.getConnection(), "hashjoin_large")
+        graph.query("UNWIND range(0, 99999) AS x CREATE (:A {v: x % 50000}), (:B {v: toFloat(x % 70000)})")
+
+        q = "MATCH (a:A), (b:B) WHERE a.v = b.v RETURN count(1)"
+        plan = graph.execution_plan(q)
+        self.env.assertIn("Value Hash Join", plan)
+
+        # each value in [0, 50000) appears twice on both sides
+        # int and float values holding the same number are joined
+        res = graph.query(q).result_set
+        self.env.assertEquals(res[0][0], 50000 * 4 - 20000 * 2)
+
+    def test_hashjoin_duplicates_and_nulls(self):
+        graph = Graph(self.env.getConnection(), "hashjoin_dups")
+        graph.query("UNWIND range(1, 6) AS x CREATE (:A {v: x % 3, i: x}), (:B {v: x % 2, i: x})")
+        graph.query("CREATE (:A), (:B)")
+
+        # null values never join, duplicates produce every combination
+        q = """MATCH (a:A), (b:B) WHERE a.v = b.v
+               RETURN a.i, b.i ORDER BY a.i, b.i"""
+        plan = graph.execution_plan(q)
+        self.env.assertIn("Value Hash Join", plan)
+
+        expected = [[a, b] for a in range(1, 7) for b in range(1, 7) if a % 3 == b % 2]
+        res = graph.query(q).result_set
+        self.env.assertEquals(res, expected)
+
+    def test_hashjoin_spill(self):
+        con = self.env.getConnection()
+        graph = Graph(con, "hashjoin_spill")
+        graph.query("""UNWIND range(1, 2000) AS x
+                       CREATE (:A {v: x % 300, s: 'a' + toString(x)})-[:R {w: x}]->(:C),
+                              (:B {v: x % 400, s: 'b' + toString(x)})""")
+
+        queries = [
+            # scalar joined values and string projections
+            """MATCH (a:A), (b:B) WHERE a.v = b.v
+               RETURN a.s, b.s ORDER BY a.s, b.s""",
+            # nodes and edges carried by spilled records
+            """MATCH p = (a:A)-[r:R]->(c), (b:B) WHERE a.v = b.v
+               RETURN a.s, b.s, r.w, length(p), ID(c) - ID(a)
+               ORDER BY a.s, b.s""",
+            # aggregation over the joined stream
+            """MATCH (a:A), (b:B) WHERE a.v = b.v
+               RETURN a.v, count(b) ORDER BY a.v""",
+        ]
+
+        for q in queries:
+            self.env.assertIn("Value Hash Join", graph.execution_plan(q))
+
+        expected = [graph.query(q).result_set for q in queries]
+
+        # spill once the build side exceeds 100 records
+        con.execute_command("GRAPH.CONFIG", "SET", "HASH_JOIN_SPILL_THRESHOLD", 100)
+        try:
+            for q, e in zip(queries, expected):
+                self.env.assertEquals(graph.query(q).result_set, e)
+        finally:
+            con.execute_command("GRAPH.CONFIG", "SET", "HASH_JOIN_SPILL_THRESHOLD", 0)
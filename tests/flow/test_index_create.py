@@ -201,6 +201,51 @@ class testIndexCreationFlow():
 
             loop.run_until_complete(asyncio.wait(tasks))
 
+    def test06_parallel_index_population(self):
+        # large enough for the label to be partitioned between threads
+        g = Graph(con, "parallel_population")
+        node_count = 500000
+        g.query(f"UNWIND range(0, {node_count - 1}) AS x CREATE (:L {{v: x}})")
+
+        res = create_node_exact_match_index(g, 'L', 'v', sync=False)
+        self.env.assertEquals(res.indices_created, 1)
+
+        # modify nodes while the index is being populated
+        g.query("MATCH (n:L) WHERE n.v < 10 SET n.v = -n.v - 1")
+        g.query("MATCH (n:L) WHERE n.v >= 10 AND n.v < 20 DELETE n")
+
+        # population progress is reported whether or not population is done
+        q = """CALL db.indexes() YIELD label, info
+               WHERE label = 'L'
+               RETURN info.indexedEntities, info.totalEntities, info.etaSeconds"""
+        res = g.query(q, read_only=True).result_set
+        self.env.assertEquals(len(res), 1)
+        indexed, total, eta = res[0]
+        self.env.assertGreaterEqual(indexed, 0)
+        self.env.assertLessEqual(indexed, total)
+        self.env.assertLessEqual(total, node_count)
+
+        wait_for_indices_to_sync(g)
+
+        # once populated every remaining node is accounted for
+        indexed, total, eta = g.query(q, read_only=True).result_set[0]
+        self.env.assertGreaterEqual(indexed, node_count - 20)
+        self.env.assertLessEqual(indexed, total)
+        self.env.assertLessEqual(total, node_count)
+        self.env.assertGreaterEqual(eta, 0)
+
+        q = "MATCH (n:L) WHERE n.v < 20 RETURN n.v ORDER BY n.v"
+        plan = str(g.explain(q))
+        self.env.assertIn("Node By Index Scan", plan)
+
+        # updated nodes are indexed by their new value, deleted nodes are gone
+        res = g.query(q).result_set
+        self.env.assertEquals(res, [[-v] for v in range(10, 0, -1)])
+
+        q = "MATCH (n:L) WHERE n.v >= 0 RETURN count(n)"
+        res = g.query(q).result_set
+        self.env.assertEquals(res[0][0], node_count - 20)
+
     # def test06_syntax_error_index_creation(self):
     #     # create index on invalid property name
     #     try:
@@ -710,3 +710,142 @@ class testIndexScanFlow():
 
         # expecting an no index scan operation
         self.env.assertNotIn('Node By Index Scan', plan)
+
+    def test_24_index_scan_mixed_types(self):
+        g = Graph(self.env.getConnection(), 'mixed_types')
+
+        create_node_exact_match_index(g, 'N', 'v', 'w', sync=True)
+        g.query("""UNWIND range(0, 9) AS i
+                   CREATE (:N {v: i, w: toString(i)})""")
+        g.query("CREATE (:N {v: 2.5}), (:N {v: 'a'}), (:N {v: true}), (:N {v: [1, 2]})")
+
+        # integers and floats are compared by value
+        query = "MATCH (n:N) WHERE n.v = 3.0 RETURN n.v"
+        plan = g.execution_plan(query)
+        self.env.assertIn('Node By Index Scan', plan)
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [[3]])
+
+        # range limited to numerics
+        query = "MATCH (n:N) WHERE n.v > 2 AND n.v <= 4 RETURN n.v ORDER BY n.v"
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [[2.5], [3], [4]])
+
+        # string range
+        query = "MATCH (n:N) WHERE n.w >= '7' RETURN n.w ORDER BY n.w"
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [['7'], ['8'], ['9']])
+
+        # union of ranges over different attributes
+        query = "MATCH (n:N) WHERE n.v IN [1, 'a', true] OR n.w = '5' RETURN n.v ORDER BY n.v"
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [['a'], [True], [1], [5]])
+
+        # none indexable values are located
+        query = "MATCH (n:N) WHERE n.v = [1, 2] RETURN n.v"
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [[[1, 2]]])
+
+        # updates are reflected
+        g.query("MATCH (n:N {v: 3}) SET n.v = 30")
+        result = g.query("MATCH (n:N) WHERE n.v = 3 RETURN count(n)")
+        self.env.assertEquals(result.result_set, [[0]])
+        result = g.query("MATCH (n:N) WHERE n.v = 30 RETURN n.w")
+        self.env.assertEquals(result.result_set, [['3']])
+
+        # index reports the number of indexed nodes
+        result = g.query("CALL db.indexes() YIELD info RETURN info.numDocuments")
+        self.env.assertEquals(result.result_set, [[14]])
+
+    def test_25_batched_index_lookups(self):
+        g = Graph(self.env.getConnection(), 'batched_lookups')
+
+        create_node_exact_match_index(g, 'N', 'id', sync=True)
+        g.query("UNWIND range(0, 4999) AS i CREATE (:N {id: i, v: i % 7})")
+
+        # lookups spanning multiple batches, routed back to their records
+        query = """UNWIND range(0, 9999) AS x
+                   MATCH (n:N {id: x})
+                   RETURN count(n), sum(n.id - x)"""
+        plan = g.execution_plan(query)
+        self.env.assertIn('Node By Index Scan', plan)
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [[5000, 0]])
+
+        # duplicate and null keys
+        query = """UNWIND [3, 3, null, 4, 99999] AS x
+                   MATCH (n:N {id: x})
+                   RETURN x, n.id"""
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [[3, 3], [3, 3], [4, 4]])
+
+        # multiple ranges per record
+        query = """UNWIND [[1, 2], [2, 3], []] AS xs
+                   MATCH (n:N) WHERE n.id IN xs OR n.id = xs[0] + 100
+                   RETURN xs, n.id ORDER BY xs, n.id"""
+        result = g.query(query)
+        self.env.assertEquals(result.result_set,
+                [[[1, 2], 1], [[1, 2], 2], [[1, 2], 101],
+                 [[2, 3], 2], [[2, 3], 3], [[2, 3], 102]])
+
+        # filter independent of child records
+        query = """UNWIND range(1, 3) AS x
+                   MATCH (n:N) WHERE n.id < 2
+                   RETURN x, n.id ORDER BY x, n.id"""
+        result = g.query(query)
+        self.env.assertEquals(result.result_set,
+                [[1, 0], [1, 1], [2, 0], [2, 1], [3, 0], [3, 1]])
+
+    def test_26_ordered_index_scan(self):
+        g = Graph(self.env.getConnection(), 'ordered_scan')
+
+        create_node_exact_match_index(g, 'Event', 'ts', sync=True)
+        g.query("UNWIND range(0, 999) AS i CREATE (:Event {ts: i, v: i % 3})")
+        g.query("CREATE (:Event {ts: 'str'}), (:Event {ts: [1]}), (:Event)")
+
+        # sort is replaced by a descending index scan
+        query = """MATCH (n:Event) WHERE n.ts > $t
+                   RETURN n.ts ORDER BY n.ts DESC LIMIT 3"""
+        plan = g.execution_plan(query, {'t': 10})
+        self.env.assertIn('Node By Index Scan', plan)
+        self.env.assertNotIn('Sort', plan)
+        result = g.query(query, {'t': 10})
+        self.env.assertEquals(result.result_set, [[999], [998], [997]])
+
+        # ascending, with skip and a residual filter
+        query = """MATCH (n:Event) WHERE n.ts >= 10 AND n.ts < 500 AND n.v = 0
+                   RETURN n ORDER BY n.ts SKIP 1 LIMIT 3"""
+        plan = g.execution_plan(query)
+        self.env.assertNotIn('Sort', plan)
+        result = g.query(query)
+        self.env.assertEquals([r[0].properties['ts'] for r in result.result_set],
+                [15, 18, 21])
+
+        # string ranges are ordered as well
+        query = """MATCH (n:Event) WHERE n.ts > 'a'
+                   RETURN n.ts ORDER BY n.ts LIMIT 5"""
+        plan = g.execution_plan(query)
+        self.env.assertNotIn('Sort', plan)
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [['str']])
+
+        # sort is kept when the index doesn't determine the order
+        queries = [
+            # unlimited sort
+            "MATCH (n:Event) WHERE n.ts > 10 RETURN n.ts ORDER BY n.ts",
+            # multiple sort keys
+            "MATCH (n:Event) WHERE n.ts > 10 RETURN n.ts ORDER BY n.ts, n.v LIMIT 3",
+            # sort key isn't the scanned range
+            "MATCH (n:Event) WHERE n.ts > 10 RETURN n.v ORDER BY n.v LIMIT 3",
+            # multiple ranges
+            "MATCH (n:Event) WHERE n.ts IN [1, 5, 3] RETURN n.ts ORDER BY n.ts LIMIT 3",
+            # write query
+            "MATCH (n:Event) WHERE n.ts > 10 SET n.x = 1 RETURN n.ts ORDER BY n.ts LIMIT 3",
+        ]
+        for q in queries:
+            plan = g.execution_plan(q)
+            self.env.assertIn('Sort', plan)
+
+        query = "MATCH (n:Event) WHERE n.ts IN [1, 5, 3] RETURN n.ts ORDER BY n.ts DESC LIMIT 2"
+        result = g.query(query)
+        self.env.assertEquals(result.result_set, [[5], [3]])
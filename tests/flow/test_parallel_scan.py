@@ -0,0 +1,78 @@
+from common import *
+
+GRAPH_ID = "parallel_scan"
+NODE_COUNT = 20000 # spans multiple scan morsels
+
+class testParallelScan(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs='PARALLEL_SCAN_WORKERS 4')
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        q = """UNWIND range(0, $n - 1) AS x
+               CREATE (a:A {v: x})-[:R]->(:B {v: x % 10})"""
+        self.graph.query(q, {'n': NODE_COUNT})
+
+    def set_workers(self, n):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "PARALLEL_SCAN_WORKERS", n)
+
+    def test01_exchange_placement(self):
+        # aggregation over a scan stream is parallelized
+        plan = self.graph.execution_plan("MATCH (a:A)-[:R]->(b) WHERE b.v > 2 RETURN count(a)")
+        self.env.assertIn("Exchange", plan)
+
+        # write queries are never parallelized
+        plan = self.graph.execution_plan("MATCH (a:A) SET a.w = 1 RETURN count(a)")
+        self.env.assertNotIn("Exchange", plan)
+
+        # index and id scans are not split
+        plan = self.graph.execution_plan("MATCH (a:A) WHERE ID(a) > 10 RETURN count(a)")
+        self.env.assertNotIn("Exchange", plan)
+
+    def test02_parallel_aggregation(self):
+        queries = [
+            "MATCH (a:A) RETURN count(a), sum(a.v), min(a.v), max(a.v)",
+            "MATCH (n) RETURN count(n), sum(n.v)",
+            "MATCH (a:A)-[:R]->(b) WHERE b.v > 2 RETURN b.v, count(a) ORDER BY b.v",
+            "MATCH (a:A) WHERE a.v % 7 = 0 RETURN a.v ORDER BY a.v DESC LIMIT 5",
+            "MATCH (a:A)-[:R]->(b:B) RETURN a.v + b.v AS s ORDER BY s LIMIT 10",
+        ]
+
+        for q in queries:
+            self.set_workers(4)
+            parallel = self.graph.query(q).result_set
+
+            self.set_workers(0)
+            serial = self.graph.query(q).result_set
+
+            self.env.assertEquals(parallel, serial)
+
+    def test03_parallel_projection(self):
+        # final projection fed by a parallel scan
+        # records are returned in the same order as a serial scan
+        queries = [
+            "MATCH (a:A) WHERE a.v % 3 = 0 RETURN a.v",
+            "MATCH (n) WHERE n.v < 5 RETURN ID(n), n.v",
+            "MATCH (a:A)-[:R]->(b:B) WHERE a.v % 11 = 0 RETURN a.v, b.v",
+        ]
+
+        for q in queries:
+            self.set_workers(4)
+            self.env.assertIn("Exchange", self.graph.execution_plan(q))
+            parallel = self.graph.query(q).result_set
+
+            self.set_workers(0)
+            serial = self.graph.query(q).result_set
+
+            self.env.assertEquals(parallel, serial)
+
+    def test04_parallel_runtime_error(self):
+        # errors raised by workers are reported back to the client
+        self.set_workers(4)
+        try:
+            self.graph.query("MATCH (a:A) WHERE a.v / (a.v - 12345) > 0 RETURN count(a)")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Division by zero", str(e))
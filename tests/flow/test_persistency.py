@@ -1,4 +1,5 @@
 from common import *
+import time
 import random
 from index_utils import *
 from click.testing import CliRunner
@@ -417,3 +418,119 @@ class testGraphPersistency():
         for q in queries:
             actual_result = g.query(q)
             self.env.assertEquals(actual_result.result_set[0], [1])
+
+    # Verify that a graph with pending matrix changes is saved by BGSAVE
+    # the forked child encodes matrices without them being flushed
+    def test08_bgsave_pending_changes(self):
+        graph_id = "pending_changes"
+        g = Graph(redis_con, graph_id)
+
+        # keep changes pending within the delta matrices
+        redis_con.execute_command("GRAPH.CONFIG", "SET",
+                                  "DELTA_MAX_PENDING_CHANGES", 100000)
+
+        g.query("UNWIND range(0, 999) AS x CREATE (:A {v: x})")
+        g.query("""MATCH (a:A), (b:A) WHERE b.v = a.v + 1
+                   CREATE (a)-[:R {v: a.v}]->(b)""")
+
+        # introduce both additions and deletions
+        g.query("MATCH (a:A) WHERE a.v % 10 = 0 DELETE a")
+        g.query("MATCH (:A)-[r:R]->() WHERE r.v % 7 = 0 DELETE r")
+        g.query("MATCH (a:A) WHERE a.v % 3 = 0 SET a:B")
+        g.query("MATCH (a:A) WHERE a.v % 11 = 0 CREATE (a)-[:S]->(a)")
+
+        queries = ["MATCH (a:A) RETURN count(a), sum(a.v)",
+                   "MATCH (b:B) RETURN count(b), sum(b.v)",
+                   "MATCH ()-[r:R]->() RETURN count(r), sum(r.v)",
+                   "MATCH (a)-[:S]->(a) RETURN count(a), sum(a.v)"]
+        expected = [g.query(q).result_set for q in queries]
+
+        redis_con.execute_command("BGSAVE")
+        while True:
+            info = redis_con.execute_command("INFO", "persistence")
+            if info['rdb_bgsave_in_progress'] == 0:
+                break
+            time.sleep(0.1)
+        self.env.assertEquals(info['rdb_last_bgsave_status'], "ok")
+
+        # load the RDB produced by BGSAVE
+        redis_con.execute_command("DEBUG", "RELOAD", "NOSAVE")
+
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(g.query(q).result_set, e)
+
+        # restore default
+        redis_con.execute_command("GRAPH.CONFIG", "SET",
+                                  "DELTA_MAX_PENDING_CHANGES", 10000)
+
+    # Verify matrices built in bulk and native indices populated in parallel
+    # on load reflect multi-edges, deleted entities and multiple labels
+    def test09_bulk_load(self):
+        graph_id = "bulk_load"
+        g = Graph(redis_con, graph_id)
+
+        # a native index per label, populated once all keys are loaded
+        for label in ["A", "B", "C"]:
+            create_node_exact_match_index(g, label, 'v', sync=True)
+
+        # indices updated as entities are loaded
+        create_fulltext_index(g, 'A', 'name', sync=True)
+        create_edge_exact_match_index(g, 'R', 'v', sync=True)
+
+        g.query("UNWIND range(0, 2999) AS x CREATE (:A {v: x})")
+        g.query("MATCH (a:A) WHERE a.v % 2 = 0 SET a:B")
+        g.query("MATCH (a:A) WHERE a.v % 3 = 0 SET a:C")
+        g.query("MATCH (a:A) WHERE a.v < 100 SET a.name = 'node' + toString(a.v)")
+
+        # single edges
+        g.query("""MATCH (a:A), (b:A) WHERE b.v = a.v + 1
+                   CREATE (a)-[:R {v: a.v}]->(b)""")
+        # multi-edges, connecting the same pair of nodes three times
+        g.query("""MATCH (a:A), (b:A) WHERE a.v % 5 = 0 AND b.v = a.v + 2
+                   UNWIND range(0, 2) AS i
+                   CREATE (a)-[:M {v: a.v * 10 + i}]->(b)""")
+        # self loops
+        g.query("MATCH (a:A) WHERE a.v % 11 = 0 CREATE (a)-[:S]->(a)")
+
+        # deleted entities leave holes in the entity storage
+        g.query("MATCH (a:A) WHERE a.v % 13 = 0 DELETE a")
+        g.query("MATCH ()-[r:R]->() WHERE r.v % 7 = 0 DELETE r")
+        g.query("MATCH ()-[m:M]->() WHERE m.v % 10 = 1 DELETE m")
+
+        queries = ["MATCH (a:A) RETURN count(a), sum(a.v)",
+                   "MATCH (b:B) RETURN count(b), sum(b.v)",
+                   "MATCH (c:C) RETURN count(c), sum(c.v)",
+                   "MATCH (b:B:C) RETURN count(b), sum(b.v)",
+                   "MATCH ()-[r:R]->() RETURN count(r), sum(r.v)",
+                   "MATCH (a)-[m:M]->(b) RETURN a.v, b.v, collect(m.v) ORDER BY a.v",
+                   "MATCH (a)-[:S]->(a) RETURN count(a), sum(a.v)",
+                   "MATCH (a)<-[:R]-(b) WHERE a.v < 100 RETURN a.v, b.v ORDER BY a.v",
+                   "MATCH (a:A {v: 1000})-[r]->(b) RETURN type(r), b.v ORDER BY type(r), b.v",
+                   "MATCH (b:B {v: 2000}) RETURN b.v",
+                   "MATCH (c:C) WHERE c.v > 2950 RETURN c.v ORDER BY c.v",
+                   "MATCH (a:A {v: 13}) RETURN a",
+                   "CALL db.idx.fulltext.queryNodes('A', 'node42') YIELD node RETURN node.v",
+                   "MATCH ()-[r:R {v: 1002}]->(b) RETURN b.v"]
+        expected = [g.query(q).result_set for q in queries]
+        self.env.assertEquals(expected[-2], [[42]])
+        self.env.assertEquals(expected[-1], [[1003]])
+
+        self.env.dumpAndReload()
+
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(g.query(q).result_set, e)
+
+        # indices are populated and utilized
+        for label in ["A", "B", "C"]:
+            q = f"MATCH (n:{label}) WHERE n.v = 6 RETURN n.v"
+            plan = g.execution_plan(q)
+            self.env.assertIn("Node By Index Scan", plan)
+            self.env.assertEquals(g.query(q).result_set, [[6]])
+
+        plan = g.execution_plan("MATCH ()-[r:R {v: 1002}]->(b) RETURN b.v")
+        self.env.assertIn("Edge By Index Scan", plan)
+
+        # deleted IDs are reused and reachable through the index
+        g.query("CREATE (:A:B:C {v: -1})")
+        res = g.query("MATCH (n:C) WHERE n.v = -1 RETURN n.v").result_set
+        self.env.assertEquals(res, [[-1]])
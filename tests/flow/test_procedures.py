@@ -373,5 +373,6 @@ class testProcedures(FlowTestsBase):
                            ["READ", "db.labels"],
                            ["READ", "db.propertyKeys"],
                            ["READ", "db.relationshipTypes"],
+                           ["READ", "db.stats"],
                            ["READ", "dbms.procedures"]]
         self.env.assertEquals(actual_resultset, expected_result)
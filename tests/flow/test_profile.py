@@ -39,3 +39,23 @@ class testProfile(FlowTestsBase):
         self.env.assertIn("Update | Records produced: 0", profile)
         self.env.assertIn("Conditional Variable Length Traverse | (a)-[@anon_1*1..INF]->(@anon_0) | Records produced: 0", profile)
         self.env.assertIn("Node By Label Scan | (a:L) | Records produced: 0", profile)
+
+    def test03_profile_traverse_batch_size(self):
+        # validate that conditional traverse reports its batch sizes
+        redis_graph.query("UNWIND range(1, 1000) AS x CREATE (:A)-[:R]->(:B)")
+
+        q = "MATCH (a:A)-[:R]->(b:B) RETURN count(b)"
+        profile = redis_con.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        traverse = [x for x in profile if "Conditional Traverse" in x][0]
+        self.env.assertIn("Records produced: 1000", traverse)
+        self.env.assertIn("Batches:", traverse)
+
+        # batch size grows beyond its initial size of 16
+        max_batch = int(traverse.split("Max batch size: ")[1])
+        self.env.assertGreater(max_batch, 16)
+
+        # batch size is bounded by a downstream limit
+        q = "MATCH (a:A)-[:R]->(b:B) RETURN b LIMIT 4"
+        profile = redis_con.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        traverse = [x for x in profile if "Conditional Traverse" in x][0]
+        self.env.assertIn("Max batch size: 4", traverse)
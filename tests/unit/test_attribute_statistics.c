@@ -0,0 +1,117 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/rmalloc.h"
+#include "src/graph/attribute_statistics.h"
+
+#include <math.h>
+
+void setup() {
+	Alloc_Reset();
+}
+#define TEST_INIT setup();
+#include "acutest.h"
+
+void test_distinctCount() {
+	AttributeStatistics *stats = AttributeStatistics_New();
+	TEST_ASSERT(AttributeStatistics_DistinctCount(stats) == 0);
+
+	uint n = 100000;
+	for(uint i = 0; i < n; i++) {
+		AttributeStatistics_Add(stats, SI_LongVal(i));
+	}
+	TEST_ASSERT(AttributeStatistics_Count(stats) == n);
+
+	// estimate within 10% of the actual number of distinct values
+	uint64_t distinct = AttributeStatistics_DistinctCount(stats);
+	TEST_ASSERT(distinct > n * 0.9 && distinct < n * 1.1);
+
+	// estimate is bounded by the number of values
+	for(uint i = 0; i < n - 10; i++) {
+		AttributeStatistics_Remove(stats, SI_LongVal(i));
+	}
+	TEST_ASSERT(AttributeStatistics_DistinctCount(stats) <= 10);
+
+	AttributeStatistics_Free(stats);
+}
+
+void test_mostCommonValues() {
+	AttributeStatistics *stats = AttributeStatistics_New();
+
+	// a handful of frequent values mixed with a long tail of unique values
+	for(uint i = 0; i < 10000; i++) {
+		SIValue v = (i % 2 == 0) ? SI_ConstStringVal("a") :
+			(i % 4 == 1) ? SI_ConstStringVal("b") : SI_LongVal(i);
+		AttributeStatistics_Add(stats, v);
+	}
+
+	SIValue  values[ATTR_STATS_MCV_CAPACITY];
+	uint64_t counts[ATTR_STATS_MCV_CAPACITY];
+	uint n = AttributeStatistics_MostCommonValues(stats, values, counts);
+	TEST_ASSERT(n == ATTR_STATS_MCV_CAPACITY);
+
+	// frequent values survive the tail and are reported first
+	TEST_ASSERT(strcmp(values[0].stringval, "a") == 0);
+	TEST_ASSERT(strcmp(values[1].stringval, "b") == 0);
+	TEST_ASSERT(counts[0] <= 5000 && counts[0] > 4500);
+	TEST_ASSERT(counts[1] <= 2500 && counts[1] > 2000);
+	for(uint i = 1; i < n; i++) TEST_ASSERT(counts[i - 1] >= counts[i]);
+
+	SIValue a = SI_ConstStringVal("a");
+	double s = AttributeStatistics_EqualitySelectivity(stats, &a);
+	TEST_ASSERT(s > 0.45 && s <= 0.5);
+
+	// untracked value
+	SIValue z = SI_ConstStringVal("z");
+	s = AttributeStatistics_EqualitySelectivity(stats, &z);
+	TEST_ASSERT(s < 0.01);
+
+	AttributeStatistics_Free(stats);
+}
+
+void test_histogram() {
+	AttributeStatistics *stats = AttributeStatistics_New();
+
+	const double *bounds;
+	TEST_ASSERT(AttributeStatistics_Histogram(stats, &bounds) == 0);
+
+	// uniformly distributed values
+	uint n = 100000;
+	for(uint i = 0; i < n; i++) {
+		AttributeStatistics_Add(stats, SI_DoubleVal(i));
+	}
+
+	uint len = AttributeStatistics_Histogram(stats, &bounds);
+	TEST_ASSERT(len == ATTR_STATS_HISTOGRAM_BUCKETS + 1);
+	for(uint i = 1; i < len; i++) TEST_ASSERT(bounds[i - 1] <= bounds[i]);
+
+	// range selectivity roughly matches the actual fraction
+	double s = AttributeStatistics_RangeSelectivity(stats, n / 4, true);
+	TEST_ASSERT(fabs(s - 0.25) < 0.1);
+	s = AttributeStatistics_RangeSelectivity(stats, n / 4, false);
+	TEST_ASSERT(fabs(s - 0.75) < 0.1);
+
+	// out of range boundaries
+	TEST_ASSERT(AttributeStatistics_RangeSelectivity(stats, -1, true) == 0);
+	TEST_ASSERT(AttributeStatistics_RangeSelectivity(stats, n, true) == 1);
+
+	// non numeric values dilute numeric selectivity
+	for(uint i = 0; i < n; i++) {
+		AttributeStatistics_Add(stats, SI_ConstStringVal("x"));
+	}
+	s = AttributeStatistics_RangeSelectivity(stats, n, true);
+	TEST_ASSERT(s == 0.5);
+
+	AttributeStatistics_Free(stats);
+}
+
+TEST_LIST = {
+	{"distinctCount", test_distinctCount},
+	{"mostCommonValues", test_mostCommonValues},
+	{"histogram", test_histogram},
+	{NULL, NULL}
+};
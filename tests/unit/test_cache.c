@@ -99,8 +99,38 @@ void test_executionPlanCache() {
 	TEST_ASSERT(free_count == 9);
 }
 
+void test_cacheStats() {
+	Cache *cache = Cache_New(1, (CacheEntryFreeFunc)CacheObj_Free,
+			(CacheEntryCopyFunc)CacheObj_Dup);
+
+	const char *key1 = "MATCH (a) RETURN a";
+	const char *key2 = "MATCH (b) RETURN b";
+
+	// miss
+	TEST_ASSERT(Cache_GetValue(cache, key1) == NULL);
+	Cache_SetValue(cache, key1, CacheObj_New("1"));
+
+	// hit
+	CacheObj *from_cache = (CacheObj*)Cache_GetValue(cache, key1);
+	TEST_ASSERT(from_cache != NULL);
+	CacheObj_Free(from_cache);
+
+	// miss followed by an eviction of key1
+	TEST_ASSERT(Cache_GetValue(cache, key2) == NULL);
+	Cache_SetValue(cache, key2, CacheObj_New("2"));
+	TEST_ASSERT(Cache_GetValue(cache, key1) == NULL);
+
+	CacheStats stats = Cache_GetStats(cache);
+	TEST_ASSERT(stats.hits      == 1);
+	TEST_ASSERT(stats.misses    == 3);
+	TEST_ASSERT(stats.evictions == 1);
+
+	Cache_Free(cache);
+}
+
 TEST_LIST = {
 	{"executionPlanCache", test_executionPlanCache},
+	{"cacheStats", test_cacheStats},
 	{NULL, NULL}
 };
 
@@ -128,6 +128,54 @@ void test_dataBlockScan() {
 	DataBlockIterator_Free(it);
 }
 
+void test_dataBlockScanRange() {
+	// small blocks, ranges span multiple blocks
+	DataBlock *dataBlock = DataBlock_New(16, 16, sizeof(int), NULL);
+	size_t itemCount = 100;
+	DataBlock_Accommodate(dataBlock, itemCount);
+
+	for(int i = 0 ; i < itemCount; i++) {
+		int *item = (int *)DataBlock_AllocateItem(dataBlock, NULL);
+		*item = i;
+	}
+
+	// scan [10, 50)
+	int count = 10;
+	int *item = NULL;
+	uint64_t idx = 0;
+
+	DataBlockIterator *it = DataBlock_ScanRange(dataBlock, 10, 50);
+	while((item = (int *)DataBlockIterator_Next(it, &idx))) {
+		TEST_ASSERT(count == idx);
+		TEST_ASSERT(*item == count);
+		count++;
+	}
+	TEST_ASSERT(count == 50);
+
+	// reset returns to the beginning of the range
+	DataBlockIterator_Reset(it);
+	item = (int *)DataBlockIterator_Next(it, &idx);
+	TEST_ASSERT(*item == 10 && idx == 10);
+	DataBlockIterator_Free(it);
+
+	// range exceeding the datablock is clamped
+	count = 90;
+	it = DataBlock_ScanRange(dataBlock, 90, 200);
+	while((item = (int *)DataBlockIterator_Next(it, &idx))) {
+		TEST_ASSERT(*item == count);
+		count++;
+	}
+	TEST_ASSERT(count == itemCount);
+	DataBlockIterator_Free(it);
+
+	// range past the last item is empty
+	it = DataBlock_ScanRange(dataBlock, 200, 300);
+	TEST_ASSERT(DataBlockIterator_Next(it, NULL) == NULL);
+	DataBlockIterator_Free(it);
+
+	DataBlock_Free(dataBlock);
+}
+
 void test_dataBlockRemoveItem() {
 	DataBlock *dataBlock = DataBlock_New(DATABLOCK_BLOCK_CAP, 1024, sizeof(int), NULL);
 	uint itemCount = 32;
@@ -230,12 +278,68 @@ void test_dataBlockOutOfOrderBuilding() {
 	DataBlockIterator_Free(it);
 }
 
+void test_dataBlockCompaction() {
+	// small blocks, such that trimming frees blocks
+	DataBlock *dataBlock = DataBlock_New(4, 16, sizeof(int), NULL);
+
+	for(int i = 0; i < 16; i++) {
+		int *item = (int *)DataBlock_AllocateItem(dataBlock, NULL);
+		*item = i;
+	}
+	TEST_ASSERT(dataBlock->blockCount == 4);
+
+	// delete items 1, 3, 5 and 7
+	for(int i = 1; i < 8; i += 2) DataBlock_DeleteItem(dataBlock, i);
+
+	// free positions below the item count
+	uint64_t limit = DataBlock_ItemCount(dataBlock);
+	TEST_ASSERT(limit == 12);
+	uint64_t holes = DataBlock_GatherHoles(dataBlock, limit);
+	TEST_ASSERT(holes == 4);
+
+	// move the last 4 items into the holes
+	for(uint64_t i = 0; i < holes; i++) {
+		uint64_t src  = 15 - i;
+		uint64_t dest = DataBlock_MoveItem(dataBlock, src, i);
+		TEST_ASSERT(dest < limit);
+		TEST_ASSERT(DataBlock_GetItem(dataBlock, src) == NULL);
+		TEST_ASSERT(*(int *)DataBlock_GetItem(dataBlock, dest) == src);
+	}
+
+	TEST_ASSERT(DataBlock_ItemCount(dataBlock) == 12);
+	TEST_ASSERT(DataBlock_DeletedItemsCount(dataBlock) == 4);
+
+	// trailing deleted items are dropped along with the last block
+	DataBlock_Trim(dataBlock);
+	TEST_ASSERT(DataBlock_ItemCount(dataBlock) == 12);
+	TEST_ASSERT(DataBlock_DeletedItemsCount(dataBlock) == 0);
+	TEST_ASSERT(dataBlock->blockCount == 3);
+	TEST_ASSERT(dataBlock->itemCap == 12);
+
+	// every item is reachable
+	int seen[16] = {0};
+	int *item;
+	DataBlockIterator *it = DataBlock_Scan(dataBlock);
+	while((item = (int *)DataBlockIterator_Next(it, NULL))) seen[*item]++;
+	DataBlockIterator_Free(it);
+	for(int i = 0; i < 16; i++) TEST_ASSERT(seen[i] == (i < 8 ? (i % 2 == 0) : 1));
+
+	// new items are appended past the trimmed range
+	uint64_t idx;
+	DataBlock_AllocateItem(dataBlock, &idx);
+	TEST_ASSERT(idx == 12);
+
+	DataBlock_Free(dataBlock);
+}
+
 TEST_LIST = {
 	{"dataBlockNew", test_dataBlockNew},
 	{"dataBlockAddItem", test_dataBlockAddItem },
 	{"dataBlockScan", test_dataBlockScan},
+	{"dataBlockScanRange", test_dataBlockScanRange},
 	{"dataBlockRemoveItem", test_dataBlockRemoveItem},
 	{"dataBlockOutOfOrderBuilding", test_dataBlockOutOfOrderBuilding},
+	{"dataBlockCompaction", test_dataBlockCompaction},
 	{NULL, NULL}
 };
 
@@ -463,11 +463,89 @@ void test_getEdge() {
 	Graph_Free(g);
 }
 
+void test_connectionCounts() {
+	Edge e;
+	Node n;
+	bool x;
+	GrB_Info info;
+	Graph *g = Graph_New(4, 4);
+	Graph_AcquireWriteLock(g);
+
+	for(int i = 0; i < 3; i++) {
+		n = GE_NEW_NODE();
+		Graph_CreateNode(g, &n, NULL, 0);
+	}
+	int r0 = Graph_AddRelationType(g);
+	int r1 = Graph_AddRelationType(g);
+
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+
+	/* Connections:
+	 * 0 connected to 1 by two edges of type r0 and a single edge of type r1
+	 * 1 connected to 2 by a single edge of type r0 */
+
+	Graph_CreateEdge(g, 0, 1, r0, &e);
+	Graph_CreateEdge(g, 0, 1, r0, &e);
+	Graph_CreateEdge(g, 0, 1, r1, &e);
+	Graph_CreateEdge(g, 1, 2, r0, &e);
+
+	// multi-edges of the same type are counted once
+	TEST_ASSERT(ConnectionCounts_Get(g->connections, 0, 1) == 2);
+	TEST_ASSERT(ConnectionCounts_Get(g->connections, 1, 2) == 1);
+	TEST_ASSERT(ConnectionCounts_Size(g->connections) == 1);
+
+	// connect 1 to 2 by r1 in bulk, duplicates are counted once
+	NodeID  src[2]  = {1, 1};
+	NodeID  dest[2] = {2, 2};
+	EdgeID  ids[2];
+	Graph_CreateEdges(g, r1, src, dest, ids, 2);
+	TEST_ASSERT(ConnectionCounts_Get(g->connections, 1, 2) == 2);
+
+	// counts computed from relation matrices agree
+	Graph_ApplyAllPending(g, true);
+	Graph_RebuildConnectionCounts(g);
+	TEST_ASSERT(ConnectionCounts_Get(g->connections, 0, 1) == 2);
+	TEST_ASSERT(ConnectionCounts_Get(g->connections, 1, 2) == 2);
+	TEST_ASSERT(ConnectionCounts_Size(g->connections) == 2);
+
+	// delete edges connecting 0 to 1 one by one
+	Edge *edges = array_new(Edge, 3);
+	Graph_GetEdgesConnectingNodes(g, 0, 1, GRAPH_NO_RELATION, &edges);
+	TEST_ASSERT(array_len(edges) == 3);
+
+	for(uint i = 0; i < 3; i++) {
+		// pair remains connected until its last edge is deleted
+		info = RG_Matrix_extractElement_BOOL(&x, adj, 0, 1);
+		TEST_ASSERT(info == GrB_SUCCESS);
+
+		Graph_DeleteEdges(g, edges + i, 1);
+	}
+
+	info = RG_Matrix_extractElement_BOOL(&x, adj, 0, 1);
+	TEST_ASSERT(info == GrB_NO_VALUE);
+	TEST_ASSERT(ConnectionCounts_Size(g->connections) == 1);
+
+	// 1 remains connected to 2 as long as either type connects the pair
+	array_clear(edges);
+	Graph_GetEdgesConnectingNodes(g, 1, 2, r0, &edges);
+	TEST_ASSERT(array_len(edges) == 1);
+	Graph_DeleteEdges(g, edges, 1);
+
+	info = RG_Matrix_extractElement_BOOL(&x, adj, 1, 2);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	TEST_ASSERT(ConnectionCounts_Size(g->connections) == 0);
+
+	array_free(edges);
+	Graph_ReleaseLock(g);
+	Graph_Free(g);
+}
+
 TEST_LIST = {
 	{"newGraph", test_newGraph},
 	{"graphConstruction", test_graphConstruction},
 	{"removeNodes", test_removeNodes},
 	{"getNode", test_getNode},
 	{"getEdge", test_getEdge},
+	{"connectionCounts", test_connectionCounts},
 	{NULL, NULL}
 };
@@ -0,0 +1,94 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/rmalloc.h"
+#include "src/grouping/group_table.h"
+
+void setup() {
+	Alloc_Reset();
+}
+#define TEST_INIT setup();
+#include "acutest.h"
+
+void test_groupTableAddLookup() {
+	GroupTable *t = GroupTable_New(1, 0, 0);
+	TEST_ASSERT(GroupTable_Count(t) == 0);
+
+	uint n = 10000;
+	for(uint i = 0; i < n; i++) {
+		SIValue key = SI_LongVal(i);
+		TEST_ASSERT(GroupTable_Lookup(t, i, &key) == NULL);
+		GroupTable_Add(t, i, &key, NULL);
+	}
+	TEST_ASSERT(GroupTable_Count(t) == n);
+
+	// groups are located after the table grew
+	for(uint i = 0; i < n; i++) {
+		SIValue key = SI_LongVal(i);
+		Group *g = GroupTable_Lookup(t, i, &key);
+		TEST_ASSERT(g != NULL);
+		TEST_ASSERT(g->keys[0].longval == i);
+	}
+
+	// groups are iterated in insertion order
+	for(uint i = 0; i < n; i++) {
+		Group *g = GroupTable_GetGroup(t, i);
+		TEST_ASSERT(g->keys[0].longval == i);
+	}
+
+	GroupTable_Free(t);
+}
+
+void test_groupTableHashCollision() {
+	GroupTable *t = GroupTable_New(2, 0, 0);
+
+	// different keys sharing the same hash
+	XXH64_hash_t hash = 7;
+	SIValue a[2] = {SI_LongVal(1), SI_ConstStringVal("a")};
+	SIValue b[2] = {SI_LongVal(1), SI_ConstStringVal("b")};
+	SIValue c[2] = {SI_LongVal(2), SI_ConstStringVal("a")};
+
+	Group *ga = GroupTable_Add(t, hash, a, NULL);
+	TEST_ASSERT(GroupTable_Lookup(t, hash, b) == NULL);
+	Group *gb = GroupTable_Add(t, hash, b, NULL);
+	TEST_ASSERT(GroupTable_Lookup(t, hash, c) == NULL);
+
+	TEST_ASSERT(ga != gb);
+	TEST_ASSERT(GroupTable_Count(t) == 2);
+	TEST_ASSERT(GroupTable_Lookup(t, hash, a) == ga);
+	TEST_ASSERT(GroupTable_Lookup(t, hash, b) == gb);
+
+	GroupTable_Free(t);
+}
+
+void test_groupTableKeyEquality() {
+	GroupTable *t = GroupTable_New(1, 0, 0);
+
+	// null keys group together
+	SIValue null = SI_NullVal();
+	Group *g = GroupTable_Add(t, 1, &null, NULL);
+	TEST_ASSERT(GroupTable_Lookup(t, 1, &null) == g);
+
+	// numerics of different types group together
+	SIValue i = SI_LongVal(1);
+	SIValue d = SI_DoubleVal(1.0);
+	g = GroupTable_Add(t, 2, &i, NULL);
+	TEST_ASSERT(GroupTable_Lookup(t, 2, &d) == g);
+
+	// disjoint types never match
+	SIValue s = SI_ConstStringVal("1");
+	TEST_ASSERT(GroupTable_Lookup(t, 2, &s) == NULL);
+
+	GroupTable_Free(t);
+}
+
+TEST_LIST = {
+	{"groupTableAddLookup", test_groupTableAddLookup},
+	{"groupTableHashCollision", test_groupTableHashCollision},
+	{"groupTableKeyEquality", test_groupTableKeyEquality},
+	{NULL, NULL}
+};
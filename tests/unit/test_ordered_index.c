@@ -0,0 +1,334 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/arr.h"
+#include "src/util/rmalloc.h"
+#include "src/index/ordered_index.h"
+#include "src/graph/entities/attribute_set.h"
+
+void setup() {
+	Alloc_Reset();
+}
+#define TEST_INIT setup();
+#include "acutest.h"
+
+#define ATTR_V 0
+#define ATTR_W 1
+
+// index entity holding a single attribute
+static void _IndexValue
+(
+	OrderedIndex *idx,
+	EntityID id,
+	Attribute_ID attr,
+	SIValue v
+) {
+	AttributeSet set = NULL;
+	AttributeSet_Add(&set, attr, v);
+
+	GraphEntity e = {.attributes = &set, .id = id};
+	OrderedIndex_IndexEntity(idx, id, &e);
+
+	AttributeSet_Free(&set);
+}
+
+// collect all IDs produced by scanning `n` ranges
+static EntityID *_Scan
+(
+	OrderedIndex *idx,
+	OrderedIndexRange *ranges,
+	uint n
+) {
+	EntityID id;
+	EntityID *ids = array_new(EntityID, 0);
+	OrderedIndexIterator *it = OrderedIndex_Scan(idx, ranges, n);
+
+	while(OrderedIndexIterator_Next(it, &id)) array_append(ids, id);
+
+	OrderedIndexIterator_Free(it);
+	for(uint i = 0; i < n; i++) OrderedIndexRange_Free(ranges + i);
+
+	return ids;
+}
+
+void test_valueOrder() {
+	Attribute_ID attrs[1] = {ATTR_V};
+	OrderedIndex *idx = OrderedIndex_New(attrs, 1);
+
+	// mixed types and signs, indexed out of order
+	_IndexValue(idx, 0, ATTR_V, SI_ConstStringVal("b"));
+	_IndexValue(idx, 1, ATTR_V, SI_DoubleVal(2.5));
+	_IndexValue(idx, 2, ATTR_V, SI_LongVal(-3));
+	_IndexValue(idx, 3, ATTR_V, SI_BoolVal(true));
+	_IndexValue(idx, 4, ATTR_V, SI_ConstStringVal("a"));
+	_IndexValue(idx, 5, ATTR_V, SI_DoubleVal(-0.5));
+	_IndexValue(idx, 6, ATTR_V, SI_LongVal(100));
+	_IndexValue(idx, 7, ATTR_V, SI_BoolVal(false));
+
+	TEST_ASSERT(OrderedIndex_EntityCount(idx) == 8);
+
+	// booleans < numerics < strings
+	EntityID expected[8] = {7, 3, 2, 5, 1, 6, 4, 0};
+	OrderedIndexRange all = OrderedIndexRange_All(ATTR_V);
+	EntityID *ids = _Scan(idx, &all, 1);
+
+	TEST_ASSERT(array_len(ids) == 8);
+	for(uint i = 0; i < 8; i++) TEST_ASSERT(ids[i] == expected[i]);
+
+	array_free(ids);
+	OrderedIndex_Free(idx);
+}
+
+void test_rangeScan() {
+	Attribute_ID attrs[1] = {ATTR_V};
+	OrderedIndex *idx = OrderedIndex_New(attrs, 1);
+
+	for(EntityID i = 0; i < 10; i++) {
+		_IndexValue(idx, i, ATTR_V, SI_LongVal(i));
+	}
+	_IndexValue(idx, 10, ATTR_V, SI_ConstStringVal("5"));
+
+	// integers and doubles share the same encoding
+	OrderedIndexRange point = OrderedIndexRange_Point(ATTR_V, SI_DoubleVal(3));
+	EntityID *ids = _Scan(idx, &point, 1);
+	TEST_ASSERT(array_len(ids) == 1 && ids[0] == 3);
+	array_free(ids);
+
+	// 2 < v <= 5
+	SIValue min = SI_LongVal(2);
+	SIValue max = SI_LongVal(5);
+	OrderedIndexRange range = OrderedIndexRange_New(ATTR_V, &min, false, &max,
+			true);
+	ids = _Scan(idx, &range, 1);
+	TEST_ASSERT(array_len(ids) == 3);
+	TEST_ASSERT(ids[0] == 3 && ids[1] == 4 && ids[2] == 5);
+	array_free(ids);
+
+	// v >= 7, limited to numerics
+	min = SI_LongVal(7);
+	range = OrderedIndexRange_New(ATTR_V, &min, true, NULL, false);
+	ids = _Scan(idx, &range, 1);
+	TEST_ASSERT(array_len(ids) == 3);
+	TEST_ASSERT(ids[0] == 7 && ids[1] == 8 && ids[2] == 9);
+	array_free(ids);
+
+	// v < 1.5
+	max = SI_DoubleVal(1.5);
+	range = OrderedIndexRange_New(ATTR_V, NULL, false, &max, false);
+	ids = _Scan(idx, &range, 1);
+	TEST_ASSERT(array_len(ids) == 2);
+	TEST_ASSERT(ids[0] == 0 && ids[1] == 1);
+	array_free(ids);
+
+	// intersection of disjoint ranges is empty
+	min = SI_LongVal(8);
+	max = SI_LongVal(2);
+	OrderedIndexRange a = OrderedIndexRange_New(ATTR_V, &min, true, NULL, false);
+	OrderedIndexRange b = OrderedIndexRange_New(ATTR_V, NULL, false, &max, true);
+	TEST_ASSERT(!OrderedIndexRange_Intersect(&a, &b));
+	OrderedIndexRange_Free(&a);
+	OrderedIndexRange_Free(&b);
+
+	OrderedIndex_Free(idx);
+}
+
+void test_multiRangeScan() {
+	Attribute_ID attrs[2] = {ATTR_V, ATTR_W};
+	OrderedIndex *idx = OrderedIndex_New(attrs, 2);
+
+	for(EntityID i = 0; i < 10; i++) {
+		AttributeSet set = NULL;
+		AttributeSet_Add(&set, ATTR_V, SI_LongVal(i % 3));
+		AttributeSet_Add(&set, ATTR_W, SI_LongVal(i));
+
+		GraphEntity e = {.attributes = &set, .id = i};
+		TEST_ASSERT(OrderedIndex_IndexEntity(idx, i, &e) == 2);
+		AttributeSet_Free(&set);
+	}
+
+	// v = 0 OR w = 3 OR w = 9
+	// entities 3 and 9 match multiple ranges yet are produced once
+	OrderedIndexRange ranges[3] = {
+		OrderedIndexRange_Point(ATTR_V, SI_LongVal(0)),
+		OrderedIndexRange_Point(ATTR_W, SI_LongVal(3)),
+		OrderedIndexRange_Point(ATTR_W, SI_LongVal(9))
+	};
+	EntityID *ids = _Scan(idx, ranges, 3);
+
+	TEST_ASSERT(array_len(ids) == 4);
+	TEST_ASSERT(ids[0] == 0 && ids[1] == 3 && ids[2] == 6 && ids[3] == 9);
+	array_free(ids);
+
+	TEST_ASSERT(OrderedIndex_Contains(idx, ATTR_W, SI_DoubleVal(4), 4));
+	TEST_ASSERT(!OrderedIndex_Contains(idx, ATTR_W, SI_LongVal(4), 5));
+
+	OrderedIndex_Free(idx);
+}
+
+void test_reindexAndRemove() {
+	Attribute_ID attrs[1] = {ATTR_V};
+	OrderedIndex *idx = OrderedIndex_New(attrs, 1);
+
+	_IndexValue(idx, 1, ATTR_V, SI_LongVal(1));
+	_IndexValue(idx, 2, ATTR_V, SI_LongVal(1));
+
+	// update entity 1, previous value is dropped
+	_IndexValue(idx, 1, ATTR_V, SI_LongVal(2));
+	TEST_ASSERT(OrderedIndex_EntityCount(idx) == 2);
+
+	OrderedIndexRange point = OrderedIndexRange_Point(ATTR_V, SI_LongVal(1));
+	EntityID *ids = _Scan(idx, &point, 1);
+	TEST_ASSERT(array_len(ids) == 1 && ids[0] == 2);
+	array_free(ids);
+
+	// entity lacking indexed attributes is removed
+	_IndexValue(idx, 2, ATTR_W, SI_LongVal(1));
+	TEST_ASSERT(OrderedIndex_EntityCount(idx) == 1);
+
+	OrderedIndex_RemoveEntity(idx, 1);
+	TEST_ASSERT(OrderedIndex_EntityCount(idx) == 0);
+
+	OrderedIndexRange all = OrderedIndexRange_All(ATTR_V);
+	ids = _Scan(idx, &all, 1);
+	TEST_ASSERT(array_len(ids) == 0);
+	array_free(ids);
+
+	OrderedIndex_Free(idx);
+}
+
+void test_modifyDuringScan() {
+	Attribute_ID attrs[1] = {ATTR_V};
+	OrderedIndex *idx = OrderedIndex_New(attrs, 1);
+
+	for(EntityID i = 0; i < 100; i++) {
+		_IndexValue(idx, i, ATTR_V, SI_LongVal(i));
+	}
+
+	EntityID id;
+	uint count = 0;
+	OrderedIndexRange all = OrderedIndexRange_All(ATTR_V);
+	OrderedIndexIterator *it = OrderedIndex_Scan(idx, &all, 1);
+
+	// remove each produced entity as well as its successor
+	while(OrderedIndexIterator_Next(it, &id)) {
+		TEST_ASSERT(id == count * 2);
+		OrderedIndex_RemoveEntity(idx, id);
+		OrderedIndex_RemoveEntity(idx, id + 1);
+		count++;
+	}
+
+	TEST_ASSERT(count == 50);
+	TEST_ASSERT(OrderedIndex_EntityCount(idx) == 0);
+
+	OrderedIndexIterator_Free(it);
+	OrderedIndexRange_Free(&all);
+	OrderedIndex_Free(idx);
+}
+
+void test_merge() {
+	Attribute_ID attrs[1] = {ATTR_V};
+	OrderedIndex *idx = OrderedIndex_New(attrs, 1);
+	OrderedIndex *sub = OrderedIndex_New(attrs, 1);
+
+	OrderedIndex_TrackModified(idx, true);
+
+	for(EntityID i = 0; i < 10; i++) {
+		_IndexValue(sub, i, ATTR_V, SI_LongVal(i));
+	}
+
+	// modified after sub-index was built
+	_IndexValue(idx, 2, ATTR_V, SI_LongVal(20));
+	OrderedIndex_RemoveEntity(idx, 3);
+
+	// merge in batches
+	uint64_t consumed = 0;
+	uint64_t n;
+	while((n = OrderedIndex_Merge(idx, sub, 4)) > 0) {
+		TEST_ASSERT(n <= 4);
+		consumed += n;
+	}
+	TEST_ASSERT(consumed == 10);
+	TEST_ASSERT(OrderedIndex_EntityCount(sub) == 0);
+
+	OrderedIndex_TrackModified(idx, false);
+
+	// entity 2 keeps its modified value, entity 3 remains removed
+	TEST_ASSERT(OrderedIndex_EntityCount(idx) == 9);
+	TEST_ASSERT(OrderedIndex_Contains(idx, ATTR_V, SI_LongVal(20), 2));
+	TEST_ASSERT(!OrderedIndex_Contains(idx, ATTR_V, SI_LongVal(2), 2));
+	TEST_ASSERT(!OrderedIndex_Contains(idx, ATTR_V, SI_LongVal(3), 3));
+	TEST_ASSERT(OrderedIndex_Contains(idx, ATTR_V, SI_LongVal(9), 9));
+
+	OrderedIndex_Free(sub);
+	OrderedIndex_Free(idx);
+}
+
+void test_reverseScan() {
+	Attribute_ID attrs[1] = {ATTR_V};
+	OrderedIndex *idx = OrderedIndex_New(attrs, 1);
+
+	// entities 0..9 hold values 0..9, entity 10 holds a string
+	for(uint i = 0; i < 10; i++) {
+		_IndexValue(idx, i, ATTR_V, SI_LongVal(i));
+	}
+	_IndexValue(idx, 10, ATTR_V, SI_ConstStringVal("a"));
+	_IndexValue(idx, 11, ATTR_V, SI_LongVal(9));
+
+	EntityID id;
+	SIValue min = SI_LongVal(3);
+	SIValue max = SI_LongVal(9);
+
+	// 3 < v <= 9, descending, equal values in descending ID order
+	OrderedIndexRange range = OrderedIndexRange_New(ATTR_V, &min, false, &max,
+			true);
+	TEST_ASSERT(OrderedIndexRange_Ordered(&range));
+
+	EntityID expected[7] = {11, 9, 8, 7, 6, 5, 4};
+	OrderedIndexIterator *it = OrderedIndex_ScanReverse(idx, &range);
+	for(uint i = 0; i < 7; i++) {
+		TEST_ASSERT(OrderedIndexIterator_Next(it, &id));
+		TEST_ASSERT(id == expected[i]);
+
+		// entries moved behind the iterator are not revisited
+		if(i == 2) _IndexValue(idx, 1, ATTR_V, SI_LongVal(9));
+	}
+	TEST_ASSERT(!OrderedIndexIterator_Next(it, &id));
+	OrderedIndexIterator_Free(it);
+	OrderedIndexRange_Free(&range);
+
+	// v >= 3, unbounded upper end is limited to numerics
+	range = OrderedIndexRange_New(ATTR_V, &min, true, NULL, false);
+	TEST_ASSERT(OrderedIndexRange_Ordered(&range));
+
+	it = OrderedIndex_ScanReverse(idx, &range);
+	TEST_ASSERT(OrderedIndexIterator_Next(it, &id));
+	TEST_ASSERT(id == 11);
+	uint count = 1;
+	while(OrderedIndexIterator_Next(it, &id)) count++;
+	TEST_ASSERT(count == 9);  // 3..9, entities 11 and 1 hold 9 as well
+	OrderedIndexIterator_Free(it);
+	OrderedIndexRange_Free(&range);
+
+	// ranges spanning multiple types aren't ordered by value
+	range = OrderedIndexRange_All(ATTR_V);
+	TEST_ASSERT(!OrderedIndexRange_Ordered(&range));
+	OrderedIndexRange_Free(&range);
+
+	OrderedIndex_Free(idx);
+}
+
+TEST_LIST = {
+	{"valueOrder", test_valueOrder},
+	{"rangeScan", test_rangeScan},
+	{"multiRangeScan", test_multiRangeScan},
+	{"reindexAndRemove", test_reindexAndRemove},
+	{"modifyDuringScan", test_modifyDuringScan},
+	{"merge", test_merge},
+	{"reverseScan", test_reverseScan},
+	{NULL, NULL}
+};
+
@@ -0,0 +1,151 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/ast/query_normalizer.h"
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+// normalize query and validate both normalized query and lifted literals
+static void _validate
+(
+	const char *query,
+	const char *expected_query,   // NULL if query shouldn't be normalized
+	const char *expected_params   // NULL if no literals should be lifted
+) {
+	char *params;
+	char *normalized = QueryNormalizer_Normalize(query, &params);
+
+	if(expected_query == NULL) {
+		TEST_ASSERT(normalized == NULL);
+	} else {
+		TEST_ASSERT(normalized != NULL);
+		TEST_CHECK(strcmp(normalized, expected_query) == 0);
+		TEST_MSG("expected: %s, got: %s", expected_query, normalized);
+	}
+
+	if(expected_params == NULL) {
+		TEST_ASSERT(params == NULL);
+	} else {
+		TEST_ASSERT(params != NULL);
+		TEST_CHECK(strcmp(params, expected_params) == 0);
+		TEST_MSG("expected: %s, got: %s", expected_params, params);
+	}
+
+	if(normalized != NULL) rm_free(normalized);
+	if(params != NULL) rm_free(params);
+}
+
+void test_liftLiterals() {
+	_validate("MATCH (n {id: 42}) RETURN n",
+			"MATCH (n {id: $lit_0}) RETURN n",
+			"CYPHER lit_0=42");
+
+	_validate("MATCH (n) WHERE n.name = 'a\\'b' AND n.v > -1.5e3 RETURN n",
+			"MATCH (n) WHERE n.name = $lit_0 AND n.v > $lit_1 RETURN n",
+			"CYPHER lit_0='a\\'b' lit_1=-1.5e3");
+
+	// list literals are lifted as a whole
+	_validate("MATCH (n) WHERE n.v IN [1, 'a', -2] SET n.x = xs[3] RETURN n",
+			"MATCH (n) WHERE n.v IN $lit_0 SET n.x = xs[$lit_1] RETURN n",
+			"CYPHER lit_0=[1, 'a', -2] lit_1=3");
+
+	// binary minus
+	_validate("MATCH (n) WHERE n.v = n.w-1 RETURN n",
+			"MATCH (n) WHERE n.v = n.w-$lit_0 RETURN n",
+			"CYPHER lit_0=1");
+
+	// parameters are kept
+	_validate("MATCH (n {id: $id}) RETURN n", NULL, NULL);
+}
+
+void test_keepLiterals() {
+	// RETURN clauses, SKIP, LIMIT and variable length traversals
+	_validate("MATCH (a)-[*1..3]->(b) RETURN a.v + 1 ORDER BY a.v SKIP 2 LIMIT 5",
+			NULL, NULL);
+
+	_validate("MATCH (a)-[:R*2]->(b) WITH a SKIP 1 LIMIT 2 RETURN a", NULL,
+			NULL);
+
+	_validate("UNWIND [1, 2, 3][0..2] AS x RETURN x",
+			"UNWIND $lit_0[0..2] AS x RETURN x",
+			"CYPHER lit_0=[1, 2, 3]");
+
+	// hexadecimal integer
+	_validate("MATCH (n) WHERE n.v = 0x1F RETURN n", NULL, NULL);
+
+	// index management
+	_validate("CREATE INDEX FOR (n:L) ON (n.v)", NULL, NULL);
+
+	// unterminated string
+	_validate("MATCH (n {v: 'a}) RETURN n", NULL, NULL);
+}
+
+void test_canonicalize() {
+	// whitespace, comments and keywords case
+	_validate("match (n:L)   where  n.v=1 // comment\n return n",
+			"MATCH (n:L) WHERE n.v=$lit_0 RETURN n",
+			"CYPHER lit_0=1");
+
+	_validate("MATCH ( n {a:1,b:2} ) /* c */ RETURN n",
+			"MATCH (n {a:$lit_0, b:$lit_1}) RETURN n",
+			"CYPHER lit_0=1 lit_1=2");
+
+	// attributes, labels and map keys named as keywords are kept
+	_validate("match (n:match {limit: 1}) where n.in = true return n.return",
+			"MATCH (n:match {limit: $lit_0}) WHERE n.in = TRUE RETURN n.return",
+			"CYPHER lit_0=1");
+
+	// RETURN clauses end at UNION or at the end of a subquery
+	_validate("call { match (n) where n.v = 1 return n } return n "
+			"union match (n {v: 'x'}) return n",
+			"CALL {MATCH (n) WHERE n.v = $lit_0 RETURN n} RETURN n "
+			"UNION MATCH (n {v: $lit_1}) RETURN n",
+			"CYPHER lit_0=1 lit_1='x'");
+}
+
+static void _validate_key
+(
+	const char *query,
+	const char *expected_key
+) {
+	char *key = QueryNormalizer_CacheKey(query);
+	TEST_CHECK(strcmp(key, expected_key) == 0);
+	TEST_MSG("expected: %s, got: %s", expected_key, key);
+	rm_free(key);
+}
+
+void test_cacheKey() {
+	// queries differing only by their parameters share a key
+	_validate_key("MATCH (n {id: $id}) RETURN n",
+			"MATCH (n {id: $id}) RETURN n");
+	_validate_key("CYPHER id=1 MATCH (n {id: $id}) RETURN n",
+			"MATCH (n {id: $id}) RETURN n");
+	_validate_key("cypher  id = 'a b'  xs=[1, 2] m={a: 'x y', b: [3]} "
+			"MATCH (n {id: $id}) RETURN n",
+			"MATCH (n {id: $id}) RETURN n");
+
+	// key is normalized
+	_validate_key("CYPHER x=1 match (n:L {v: 2}) where n.w = $x return n",
+			"MATCH (n:L {v: $lit_0}) WHERE n.w = $x RETURN n");
+
+	// malformed parameters, the query is used as is
+	_validate_key("CYPHER x='a MATCH (n) RETURN n",
+			"CYPHER x='a MATCH (n) RETURN n");
+}
+
+TEST_LIST = {
+	{"liftLiterals", test_liftLiterals},
+	{"keepLiterals", test_keepLiterals},
+	{"canonicalize", test_canonicalize},
+	{"cacheKey", test_cacheKey},
+	{NULL, NULL}
+};
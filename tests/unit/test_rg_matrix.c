@@ -1539,6 +1539,112 @@ void test_RGMatrix_resize() {
 	RG_Matrix_free(&A);
 }
 
+// flush pending changes off-lock, apply once no longer in use
+void test_RGMatrix_background_flush() {
+	GrB_Type    t      =  GrB_BOOL;
+	RG_Matrix   A      =  NULL;
+	GrB_Matrix  M      =  NULL;
+	GrB_Matrix  DP     =  NULL;
+	GrB_Matrix  DM     =  NULL;
+	GrB_Info    info   =  GrB_SUCCESS;
+	GrB_Index   nvals  =  0;
+	GrB_Index   nrows  =  100;
+	GrB_Index   ncols  =  100;
+
+	// lower flush threshold
+	Config_Option_set(Config_DELTA_MAX_PENDING_CHANGES, "10", NULL);
+
+	info = RG_Matrix_new(&A, t, nrows, ncols);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	// set element at position 0,0 and sync
+	info = RG_Matrix_setElement_BOOL(A, 0, 0);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	RG_Matrix_wait(A, true);
+
+	// pending changes: one deletion and 15 additions
+	info = RG_Matrix_removeElement_BOOL(A, 0, 0);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	for(GrB_Index i = 1; i < 16; i++) {
+		info = RG_Matrix_setElement_BOOL(A, i, i);
+		TEST_ASSERT(info == GrB_SUCCESS);
+	}
+
+	// deferred wait leaves deltas in place
+	info = RG_Matrix_waitDeferred(A);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	TEST_ASSERT(RG_Matrix_requiresFlush(A));
+
+	//--------------------------------------------------------------------------
+	// prepare flush
+	//--------------------------------------------------------------------------
+
+	info = RG_Matrix_prepareFlush(A);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	// matrix is unchanged
+	M   =  RG_MATRIX_M(A);
+	DP  =  RG_MATRIX_DELTA_PLUS(A);
+	DM  =  RG_MATRIX_DELTA_MINUS(A);
+	GrB_Matrix_nvals(&nvals, M);
+	TEST_ASSERT(nvals == 1);
+	GrB_Matrix_nvals(&nvals, DP);
+	TEST_ASSERT(nvals == 15);
+	GrB_Matrix_nvals(&nvals, DM);
+	TEST_ASSERT(nvals == 1);
+
+	//--------------------------------------------------------------------------
+	// apply flush
+	//--------------------------------------------------------------------------
+
+	TEST_ASSERT(RG_Matrix_applyFlush(A));
+
+	M = RG_MATRIX_M(A);
+	GrB_Matrix_nvals(&nvals, M);
+	TEST_ASSERT(nvals == 15);
+	DP_EMPTY();
+	DM_EMPTY();
+
+	bool x;
+	info = RG_Matrix_extractElement_BOOL(&x, A, 0, 0);
+	TEST_ASSERT(info == GrB_NO_VALUE);
+	info = RG_Matrix_extractElement_BOOL(&x, A, 15, 15);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	// nothing left to apply
+	TEST_ASSERT(!RG_Matrix_applyFlush(A));
+
+	//--------------------------------------------------------------------------
+	// modifications discard prepared flush
+	//--------------------------------------------------------------------------
+
+	for(GrB_Index i = 20; i < 40; i++) {
+		info = RG_Matrix_setElement_BOOL(A, i, i);
+		TEST_ASSERT(info == GrB_SUCCESS);
+	}
+	RG_Matrix_waitDeferred(A);
+
+	info = RG_Matrix_prepareFlush(A);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	info = RG_Matrix_setElement_BOOL(A, 50, 50);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	TEST_ASSERT(!RG_Matrix_applyFlush(A));
+	GrB_Matrix_nvals(&nvals, DP);
+	TEST_ASSERT(nvals == 21);
+
+	RG_Matrix_nvals(&nvals, A);
+	TEST_ASSERT(nvals == 36);
+
+	// clean up
+	RG_Matrix_free(&A);
+	TEST_ASSERT(A == NULL);
+
+	// restore flush threshold
+	Config_Option_set(Config_DELTA_MAX_PENDING_CHANGES, "10000", NULL);
+}
+
 TEST_LIST = {
 	{"RGMatrix_new", test_RGMatrix_new},
 	{"RGMatrix_simple_set", test_RGMatrix_simple_set},
@@ -1553,6 +1659,7 @@ TEST_LIST = {
 	{"RGMatrix_copy", test_RGMatrix_copy},
 	{"RGMatrix_mxm", test_RGMatrix_mxm},
 	{"RGMatrix_resize", test_RGMatrix_resize},
+	{"RGMatrix_background_flush", test_RGMatrix_background_flush},
 	{NULL, NULL}
 };
 
@@ -9,6 +9,8 @@
 #include "src/configuration/config.h"
 
 #include <assert.h>
+#include <stdint.h>
+#include <unistd.h>
 
 #define READER_COUNT 4
 #define WRITER_COUNT 1
@@ -74,8 +76,85 @@ void test_threadPools_threadID() {
 	}
 }
 
+static _Atomic bool blocked = true;
+static volatile int order[3];
+static _Atomic int order_len = 0;
+
+static void block_thread(void *arg) {
+	while(blocked) { usleep(1000); }
+}
+
+static void record_order(void *arg) {
+	order[order_len++] = (int)(intptr_t)arg;
+}
+
+void test_threadPools_priority() {
+	threadpool pool = thpool_init(1, "priority");
+	TEST_ASSERT(pool != NULL);
+
+	// occupy the pool's only thread
+	TEST_ASSERT(0 == thpool_add_work(pool, block_thread, NULL));
+
+	TEST_ASSERT(0 == thpool_add_work_priority(pool, record_order, (void *)1,
+				THPOOL_PRIORITY_LOW));
+	TEST_ASSERT(0 == thpool_add_work_priority(pool, record_order, (void *)2,
+				THPOOL_PRIORITY_HIGH));
+	TEST_ASSERT(0 == thpool_add_work_priority(pool, record_order, (void *)3,
+				THPOOL_PRIORITY_LOW));
+
+	blocked = false;
+	thpool_wait(pool);
+
+	// high priority job overtakes queued low priority jobs
+	TEST_ASSERT(order_len == 3);
+	TEST_ASSERT(order[0] == 2);
+	TEST_ASSERT(order[1] == 1);
+	TEST_ASSERT(order[2] == 3);
+
+	uint64_t jobs;
+	double   wait_ms;
+
+	thpool_get_wait_stats(pool, THPOOL_PRIORITY_HIGH, &jobs, &wait_ms);
+	TEST_ASSERT(jobs == 2);
+	thpool_get_wait_stats(pool, THPOOL_PRIORITY_LOW, &jobs, &wait_ms);
+	TEST_ASSERT(jobs == 2);
+	TEST_ASSERT(wait_ms > 0);
+
+	thpool_destroy(pool);
+}
+
+#define PARALLEL_ITEMS 64
+
+static _Atomic int processed[PARALLEL_ITEMS];
+
+static void process_item(void *arg, uint64_t i) {
+	processed[i]++;
+}
+
+// every item spawns a nested parallel for, occupying reader threads
+// with callers waiting on nested items
+static void process_nested(void *arg, uint64_t i) {
+	ThreadPools_ReadersParallelFor(process_item, NULL, PARALLEL_ITEMS);
+}
+
+void test_threadPools_parallelFor() {
+	ThreadPools_CreatePools(READER_COUNT, WRITER_COUNT, UINT64_MAX);
+
+	// each item is processed exactly once
+	ThreadPools_ReadersParallelFor(process_item, NULL, PARALLEL_ITEMS);
+	for(int i = 0; i < PARALLEL_ITEMS; i++) TEST_ASSERT(processed[i] == 1);
+
+	// nesting doesn't deadlock, even once all reader threads are waiting
+	ThreadPools_ReadersParallelFor(process_nested, NULL, READER_COUNT * 2);
+	for(int i = 0; i < PARALLEL_ITEMS; i++) {
+		TEST_ASSERT(processed[i] == 1 + READER_COUNT * 2);
+	}
+}
+
 TEST_LIST = {
 	{"threadPools_threadID", test_threadPools_threadID},
+	{"threadPools_priority", test_threadPools_priority},
+	{"threadPools_parallelFor", test_threadPools_parallelFor},
 	{NULL, NULL}
 };
 
@@ -6,12 +6,16 @@
 
 #include "src/value.h"
 #include "src/util/rmalloc.h"
+#include "src/util/string_pool.h"
 #include "src/datatypes/set.h"
 #include "src/datatypes/array.h"
 #include "src/datatypes/path/path.h"
 #include "src/graph/entities/node.h"
 #include "src/graph/entities/edge.h"
 
+#include <stdio.h>
+#include <pthread.h>
+
 void setup() {
 	Alloc_Reset();
 }
@@ -448,6 +452,100 @@ void test_path() {
 	Path_Free(clone);
 }
 
+void test_internedStrings() {
+	uint64_t pool_size = StringPool_Size();
+
+	SIValue a = SI_InternStringVal("active");
+	SIValue b = SI_InternStringVal("active");
+	SIValue c = SI_InternStringVal("inactive");
+	SIValue d = SI_DuplicateStringVal("active");
+
+	// interned strings are shared
+	TEST_ASSERT(a.allocation == M_INTERN);
+	TEST_ASSERT(a.stringval == b.stringval);
+	TEST_ASSERT(a.stringval != c.stringval);
+	TEST_ASSERT(StringPool_Size() == pool_size + 2);
+
+	// interned and non interned strings are interchangeable
+	TEST_ASSERT(SIValue_Compare(a, b, NULL) == 0);
+	TEST_ASSERT(SIValue_Compare(a, d, NULL) == 0);
+	TEST_ASSERT(SIValue_Compare(a, c, NULL) < 0);
+	TEST_ASSERT(SIValue_HashCode(a) == SIValue_HashCode(d));
+	TEST_ASSERT(SIValue_HashCode(a) != SIValue_HashCode(c));
+
+	// const views keep their precomputed hash
+	SIValue e = SI_ConstValue(&a);
+	TEST_ASSERT(e.allocation == (M_CONST | M_INTERN));
+	TEST_ASSERT(SIValue_HashCode(e) == SIValue_HashCode(d));
+
+	// clones share the interned string
+	SIValue f = SI_CloneValue(e);
+	TEST_ASSERT(f.allocation == M_INTERN);
+	TEST_ASSERT(f.stringval == a.stringval);
+
+	// interning takes ownership of the value
+	SIValue g = SI_InternValue(d);
+	TEST_ASSERT(g.allocation == M_INTERN);
+	TEST_ASSERT(g.stringval == a.stringval);
+
+	// long strings aren't interned
+	char long_str[STRING_POOL_MAX_LEN + 2];
+	memset(long_str, 'x', sizeof(long_str) - 1);
+	long_str[sizeof(long_str) - 1] = '\0';
+	SIValue h = SI_InternStringVal(long_str);
+	TEST_ASSERT(h.allocation == M_SELF);
+	TEST_ASSERT(StringPool_Size() == pool_size + 2);
+
+	// strings are removed once their last reference is released
+	SIValue_Free(a);
+	SIValue_Free(b);
+	SIValue_Free(f);
+	TEST_ASSERT(StringPool_Size() == pool_size + 2);
+	SIValue_Free(g);
+	TEST_ASSERT(StringPool_Size() == pool_size + 1);
+	SIValue_Free(c);
+	SIValue_Free(h);
+	TEST_ASSERT(StringPool_Size() == pool_size);
+}
+
+#define INTERN_THREADS 8
+#define INTERN_ROUNDS 2000
+
+// repeatedly intern and release a set of strings shared by all threads
+static void *_intern_strings(void *arg) {
+	char buf[16];
+	SIValue vals[64];
+
+	for(int r = 0; r < INTERN_ROUNDS; r++) {
+		for(int i = 0; i < 64; i++) {
+			snprintf(buf, sizeof(buf), "str_%d", (i + r) % 64);
+			vals[i] = SI_InternStringVal(buf);
+		}
+		for(int i = 0; i < 64; i++) {
+			snprintf(buf, sizeof(buf), "str_%d", (i + r) % 64);
+			TEST_ASSERT(strcmp(vals[i].stringval, buf) == 0);
+			SIValue_Free(vals[i]);
+		}
+	}
+
+	return NULL;
+}
+
+void test_internedStringsConcurrent() {
+	uint64_t pool_size = StringPool_Size();
+
+	pthread_t threads[INTERN_THREADS];
+	for(int i = 0; i < INTERN_THREADS; i++) {
+		pthread_create(threads + i, NULL, _intern_strings, NULL);
+	}
+	for(int i = 0; i < INTERN_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	// every reference was released
+	TEST_ASSERT(StringPool_Size() == pool_size);
+}
+
 TEST_LIST = {
 	{"numerics", test_numerics},
 	{"strings", test_strings},
@@ -463,5 +561,7 @@ TEST_LIST = {
 	{"edgeAndNode", test_edgeAndNode},
 	{"set", test_set},
 	{"path", test_path},
+	{"internedStrings", test_internedStrings},
+	{"internedStringsConcurrent", test_internedStringsConcurrent},
 	{NULL, NULL}
 };